@@ -51,6 +51,8 @@ class Message
     friend class TCP_SocketSSL;
     friend class TCP_SocketNoDelay;
     friend class MPI_Channel;
+    friend class MemoryDatastore;
+    friend class CheckpointDatastore;
     
   private:
     int length;
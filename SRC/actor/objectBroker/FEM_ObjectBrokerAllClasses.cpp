@@ -53,6 +53,8 @@
 // graph numbering schemes
 #include <RCM.h>
 #include <MyRCM.h>
+#include <AMDNumberer.h>
+#include <NestedDissection.h>
 #include <SimpleNumberer.h>
 
 
@@ -453,6 +455,14 @@ FEM_ObjectBrokerAllClasses::getPtrNewGraphNumberer(int classTag)
 	     return new SimpleNumberer();				
 	     
 	     
+	case GraphNUMBERER_TAG_AMD:  
+	     return new AMD();
+	     
+	     
+	case GraphNUMBERER_TAG_NestedDissection:  
+	     return new NestedDissection();
+	     
+	     
 	default:
 	     opserr << "ObjectBrokerAllClasses::getPtrNewGraphNumberer - ";
 	     opserr << " - no GraphNumberer type exists for class tag " ;
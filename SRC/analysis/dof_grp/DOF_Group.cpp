@@ -569,8 +569,11 @@ DOF_Group::setNodeDisp(const Vector &u)
 	return;
     }
     
-    Vector &disp = *unbalance;
-    disp = myNode->getTrialDisp();
+    // the values go through a vector of this call, the class wide
+    // vector of this size may be in use on another thread
+    double work[MAX_NUM_DOF];
+    Vector disp(numDOF <= MAX_NUM_DOF ? work : &(*unbalance)(0), numDOF);
+    disp.addVector(0.0, myNode->getTrialDisp(), 1.0);
     int i;
     
     // get disp for my dof out of vector u
@@ -597,8 +600,11 @@ DOF_Group::setNodeVel(const Vector &udot)
 	return;
     }
     
-    Vector &vel = *unbalance;
-    vel = myNode->getTrialVel();
+    // the values go through a vector of this call, the class wide
+    // vector of this size may be in use on another thread
+    double work[MAX_NUM_DOF];
+    Vector vel(numDOF <= MAX_NUM_DOF ? work : &(*unbalance)(0), numDOF);
+    vel.addVector(0.0, myNode->getTrialVel(), 1.0);
     int i;
     
     // get vel for my dof out of vector udot
@@ -627,8 +633,11 @@ DOF_Group::setNodeAccel(const Vector &udotdot)
 	return;
     }
 
-    Vector &accel = *unbalance;;
-    accel = myNode->getTrialAccel();
+    // the values go through a vector of this call, the class wide
+    // vector of this size may be in use on another thread
+    double work[MAX_NUM_DOF];
+    Vector accel(numDOF <= MAX_NUM_DOF ? work : &(*unbalance)(0), numDOF);
+    accel.addVector(0.0, myNode->getTrialAccel(), 1.0);
     int i;
     
     // get disp for the unconstrained dof
@@ -654,7 +663,10 @@ DOF_Group::incrNodeDisp(const Vector &u)
 	exit(-1);
     }
 
-    Vector &disp = *unbalance;;
+    // the values go through a vector of this call, the class wide
+    // vector of this size may be in use on another thread
+    double work[MAX_NUM_DOF];
+    Vector disp(numDOF <= MAX_NUM_DOF ? work : &(*unbalance)(0), numDOF);
 
     if (disp.Size() == 0) {
       opserr << "DOF_Group::setNodeIncrDisp - out of space\n";
@@ -687,7 +699,10 @@ DOF_Group::incrNodeVel(const Vector &udot)
 	exit(-1);
     }
     
-    Vector &vel = *unbalance;
+    // the values go through a vector of this call, the class wide
+    // vector of this size may be in use on another thread
+    double work[MAX_NUM_DOF];
+    Vector vel(numDOF <= MAX_NUM_DOF ? work : &(*unbalance)(0), numDOF);
     int i;
     
     // get vel for my dof out of vector udot
@@ -715,7 +730,10 @@ DOF_Group::incrNodeAccel(const Vector &udotdot)
 	exit(-1);
     }
 
-    Vector &accel = *unbalance;
+    // the values go through a vector of this call, the class wide
+    // vector of this size may be in use on another thread
+    double work[MAX_NUM_DOF];
+    Vector accel(numDOF <= MAX_NUM_DOF ? work : &(*unbalance)(0), numDOF);
     int i;
     
     // get disp for the unconstrained dof
@@ -729,6 +747,12 @@ DOF_Group::incrNodeAccel(const Vector &udotdot)
 }
 
 
+bool
+DOF_Group::isThreadSafe(void)
+{
+    return true;
+}
+
 
 void
 DOF_Group::setEigenvector(int mode, const Vector &theVector)
@@ -760,6 +784,18 @@ DOF_Group::getT(void)
 }
 
 
+// int getSparseT(int &numRows, int &numCols, const int *&colStart,
+//                const int *&rowIndex, const double *&values);
+//	returns 0, no transformation (the identity), arguments are untouched.
+
+int
+DOF_Group::getSparseT(int &numRows, int &numCols, const int *&colStart,
+		      const int *&rowIndex, const double *&values)
+{
+    return 0;
+}
+
+
 
 void  
 DOF_Group::addLocalM_Force(const Vector &accel, double fact)
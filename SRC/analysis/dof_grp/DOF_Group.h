@@ -97,11 +97,17 @@ class DOF_Group: public TaggedObject
     virtual void incrNodeVel(const Vector &udot);
     virtual void incrNodeAccel(const Vector &udotdot);
 
+    // true if the methods updating the trial response at the node can be
+    // invoked while other threads invoke them on other DOF_Groups
+    virtual bool isThreadSafe(void);
+
     // methods to set the eigen vectors
     virtual void setEigenvector(int mode, const Vector &eigenvalue);
 	
     // method added for TransformationDOF_Groups
     virtual Matrix *getT(void);
+    virtual int getSparseT(int &numRows, int &numCols, const int *&colStart,
+			   const int *&rowIndex, const double *&values);
 
 // AddingSensitivity:BEGIN ////////////////////////////////////
     virtual void addM_ForceSensitivity(const Vector &Udotdot, double fact = 1.0);        
@@ -45,8 +45,12 @@
 #include <SP_ConstraintIter.h>
 #include <TransformationConstraintHandler.h>
 
+#include <WorkArea.h>
+
 #define MAX_NUM_DOF 16
 
+static WorkArea theWorkArea("TransformationDOF_Group");
+
 // static variables initialisation
 Matrix **TransformationDOF_Group::modMatrices; 
 Vector **TransformationDOF_Group::modVectors;  
@@ -57,7 +61,8 @@ TransformationDOF_Group::TransformationDOF_Group(int tag, Node *node,
 						 MP_Constraint *mp,
 						 TransformationConstraintHandler *theTHandler)  
 :DOF_Group(tag,node),
- theMP(mp),Trans(0),modTangent(0),modUnbalance(0),modID(0),theSPs(0)
+ theMP(mp),Trans(0),TransColStart(0),TransRow(0),TransValue(0),
+ modTangent(0),modUnbalance(0),modID(0),theSPs(0)
 {
     // determine the number of DOF 
     int numNodalDOF = node->getNumberDOF();
@@ -106,6 +111,15 @@ TransformationDOF_Group::TransformationDOF_Group(int tag, Node *node,
 	exit(-1);
     }
 
+    // the nonzeros of Trans: one for each dof of the constrained node that
+    // is retained, the constraint matrix for the others
+    int maxNonZeros = numConstrainedNodeRetainedDOF + 
+	numNodalDOFConstrained*numRetainedNodeDOF;
+    TransColStart = new int[modNumDOF+1];
+    TransRow = new int[maxNonZeros+1];
+    TransValue = new double[maxNonZeros+1];
+    this->formSparseT();
+
     // initially set the id values to -2 for any dof still due to constrained node
     for (int i=0; i<numConstrainedNodeRetainedDOF; i++)
 	(*modID)(i) = -2;
@@ -189,7 +203,8 @@ TransformationDOF_Group::TransformationDOF_Group(int tag,
 						 Node *node, 
 						 TransformationConstraintHandler *theTHandler)
 :DOF_Group(tag,node),
- theMP(0),Trans(0),modTangent(0),modUnbalance(0),modID(0),theSPs(0) 
+ theMP(0),Trans(0),TransColStart(0),TransRow(0),TransValue(0),
+ modTangent(0),modUnbalance(0),modID(0),theSPs(0) 
 {
     modNumDOF = node->getNumberDOF();
     // create space for the SP_Constraint array
@@ -246,6 +261,9 @@ TransformationDOF_Group::~TransformationDOF_Group()
     
     if (modID != 0) delete modID;
     if (Trans != 0) delete Trans;
+    if (TransColStart != 0) delete [] TransColStart;
+    if (TransRow != 0) delete [] TransRow;
+    if (TransValue != 0) delete [] TransValue;
     if (theSPs != 0) delete [] theSPs;
 
     // if this is the last FE_Element, clean up the
@@ -314,10 +332,13 @@ TransformationDOF_Group::getTangent(Integrator *theIntegrator)
 
 
     const Matrix &unmodTangent = this->DOF_Group::getTangent(theIntegrator);
-    Matrix *T = this->getT();
-    if (T != 0) {
+
+    int numRows, numCols;
+    const int *colStart, *rowIndex;
+    const double *values;
+    if (this->getSparseT(numRows, numCols, colStart, rowIndex, values) != 0) {
 	// *modTangent = (*T) ^ unmodTangent * (*T);
-	modTangent->addMatrixTripleProduct(0.0, *T, unmodTangent, 1.0);
+	formTtKT(*modTangent, unmodTangent, numCols, colStart, rowIndex, values);
 	return *modTangent;
 	
     } else 
@@ -330,10 +351,12 @@ TransformationDOF_Group::getUnbalance(Integrator *theIntegrator)
     const Vector &unmodUnbalance = 
 	this->DOF_Group::getUnbalance(theIntegrator);
 
-    Matrix *T = this->getT();
-    if (T != 0) {
+    int numRows, numCols;
+    const int *colStart, *rowIndex;
+    const double *values;
+    if (this->getSparseT(numRows, numCols, colStart, rowIndex, values) != 0) {
 	// *modUnbalance = (*T) ^ unmodUnbalance;
-	modUnbalance->addMatrixTransposeVector(0.0, *T, unmodUnbalance, 1.0);
+	formTtV(*modUnbalance, unmodUnbalance, numCols, colStart, rowIndex, values);
 	return *modUnbalance;    
     } else
 	return unmodUnbalance;
@@ -480,9 +503,8 @@ TransformationDOF_Group::setNodeDisp(const Vector &u)
     }
   }
 
-  Matrix *T = this->getT();
   // *unbalance = (*T) * (*modUnbalance);
-  unbalance->addMatrixVector(0.0, *T, *modUnbalance, 1.0);
+  this->transformUnbalance();
 
   const Vector &disp = myNode->getTrialDisp();
 
@@ -526,9 +548,8 @@ TransformationDOF_Group::setNodeVel(const Vector &u)
     }
   }
 
-  Matrix *T = this->getT();
   // *unbalance = (*T) * (*modUnbalance);
-  unbalance->addMatrixVector(0.0, *T, *modUnbalance, 1.0);
+  this->transformUnbalance();
 
   const Vector &vel = myNode->getTrialVel();
   int numDOF = myNode->getNumberDOF();
@@ -573,9 +594,8 @@ TransformationDOF_Group::setNodeAccel(const Vector &u)
     }
   }
 
-    Matrix *T = this->getT();
     // *unbalance = (*T) * (*modUnbalance);
-    unbalance->addMatrixVector(0.0, *T, *modUnbalance, 1.0);
+    this->transformUnbalance();
     const Vector &accel = myNode->getTrialAccel();
     int numDOF = myNode->getNumberDOF();
     for (int i=0; i<numDOF; i++) {
@@ -609,9 +629,8 @@ TransformationDOF_Group::incrNodeDisp(const Vector &u)
        (*modUnbalance)(i) = 0.0;	    
    }    
    
-   Matrix *T = this->getT();
    // *unbalance = (*T) * (*modUnbalance);
-   unbalance->addMatrixVector(0.0, *T, *modUnbalance, 1.0);
+   this->transformUnbalance();
    
    int numDOF = myNode->getNumberDOF();
    for (int i=0; i<numDOF; i++) {
@@ -639,10 +658,8 @@ TransformationDOF_Group::incrNodeVel(const Vector &u)
     else   
       (*modUnbalance)(i) = 0.0;	    
   }    
-  Matrix *T = this->getT();
-  
   // *unbalance = (*T) * (*modUnbalance);
-  unbalance->addMatrixVector(0.0, *T, *modUnbalance, 1.0);
+  this->transformUnbalance();
   
   int numDOF = myNode->getNumberDOF();
   for (int i=0; i<numDOF; i++) {
@@ -670,10 +687,8 @@ TransformationDOF_Group::incrNodeAccel(const Vector &u)
     else 	
       (*modUnbalance)(i) = 0.0;	    
   }    
-  Matrix *T = this->getT();
-
   // *unbalance = (*T) * (*modUnbalance);
-  unbalance->addMatrixVector(0.0, *T, *modUnbalance, 1.0);
+  this->transformUnbalance();
   int numDOF = myNode->getNumberDOF();
   for (int i=0; i<numDOF; i++) {
     if (theSPs[i] != 0)
@@ -700,14 +715,18 @@ TransformationDOF_Group::setEigenvector(int mode, const Vector &u)
     else 	
       (*modUnbalance)(i) = 0.0;	    
   }    
-  Matrix *T = this->getT();
 
-    if (T != 0) {
-      // *unbalance = (*T) * (*modUnbalance);
-      unbalance->addMatrixVector(0.0, *T, *modUnbalance, 1.0);
-      myNode->setEigenvector(mode, *unbalance);
-    } else
-      myNode->setEigenvector(mode, *modUnbalance);
+  // *unbalance = (*T) * (*modUnbalance);
+  this->transformUnbalance();
+  myNode->setEigenvector(mode, *unbalance);
+}
+
+
+// the transformed responses go through the class wide modVectors
+bool
+TransformationDOF_Group::isThreadSafe(void)
+{
+    return false;
 }
 
 
@@ -741,11 +760,143 @@ TransformationDOF_Group::getT(void)
 	  (*Trans)(i,j+numRetainedDOF) = Ccr(loc,j);
       }
     }
+    this->formSparseT();
 
     return Trans;    
 }
 
 
+// int getSparseT(int &numRows, int &numCols, const int *&colStart,
+//                const int *&rowIndex, const double *&values);
+//	returns 0 if there is no MP_Constraint. Otherwise sets numRows and 
+//	numCols to the size of T, and the 3 arrays to the nonzeros of T by
+//	column: the nonzeros of column j are in locations colStart[j] to 
+//	colStart[j+1]-1 of rowIndex and values, in increasing row order.
+
+int
+TransformationDOF_Group::getSparseT(int &numRows, int &numCols, 
+				    const int *&colStart,
+				    const int *&rowIndex, 
+				    const double *&values)
+{
+    if (theMP == 0)
+	return 0;
+
+    // a time varying T is formed again by getT()
+    if (theMP->isTimeVarying() == true)
+	this->getT();
+
+    numRows = Trans->noRows();
+    numCols = modNumDOF;
+    colStart = TransColStart;
+    rowIndex = TransRow;
+    values = TransValue;
+
+    return 1;
+}
+
+
+void
+TransformationDOF_Group::formSparseT(void)
+{
+    int numRows = Trans->noRows();
+    int nnz = 0;
+    for (int j=0; j<modNumDOF; j++) {
+	TransColStart[j] = nnz;
+	for (int i=0; i<numRows; i++) {
+	    double value = (*Trans)(i,j);
+	    if (value != 0.0) {
+		TransRow[nnz] = i;
+		TransValue[nnz++] = value;
+	    }
+	}
+    }
+    TransColStart[modNumDOF] = nnz;
+}
+
+
+// void transformUnbalance(void);
+//	sets unbalance to T times modUnbalance.
+
+void
+TransformationDOF_Group::transformUnbalance(void)
+{
+    int numRows, numCols;
+    const int *colStart, *rowIndex;
+    const double *values;
+    this->getSparseT(numRows, numCols, colStart, rowIndex, values);
+    formTV(*unbalance, *modUnbalance, numCols, colStart, rowIndex, values);
+}
+
+
+int
+TransformationDOF_Group::formTtKT(Matrix &TtKT, const Matrix &K, int numCols, 
+				  const int *colStart, const int *rowIndex, 
+				  const double *values)
+{
+    int numRows = K.noRows();
+    double *work = theWorkArea.getDoubles(numRows*numCols);
+
+    // work = K * T, adding the columns of K for the nonzeros of T
+    for (int j=0; j<numCols; j++) {
+	double *workj = &work[j*numRows];
+	for (int i=0; i<numRows; i++)
+	    workj[i] = 0.0;
+	for (int p=colStart[j]; p<colStart[j+1]; p++) {
+	    int k = rowIndex[p];
+	    double tkj = values[p];
+	    for (int i=0; i<numRows; i++)
+		workj[i] += K(i,k) * tkj;
+	}
+    }
+
+    // TtKT = T' * work
+    for (int j=0; j<numCols; j++) {
+	double *workj = &work[j*numRows];
+	for (int i=0; i<numCols; i++) {
+	    double sum = 0.0;
+	    for (int p=colStart[i]; p<colStart[i+1]; p++)
+		sum += values[p] * workj[rowIndex[p]];
+	    TtKT(i,j) = sum;
+	}
+    }
+
+    return 0;
+}
+
+
+int
+TransformationDOF_Group::formTtV(Vector &TtV, const Vector &V, int numCols,
+				 const int *colStart, const int *rowIndex, 
+				 const double *values)
+{
+    for (int i=0; i<numCols; i++) {
+	double sum = 0.0;
+	for (int p=colStart[i]; p<colStart[i+1]; p++)
+	    sum += values[p] * V(rowIndex[p]);
+	TtV(i) = sum;
+    }
+
+    return 0;
+}
+
+
+int
+TransformationDOF_Group::formTV(Vector &TV, const Vector &V, int numCols,
+				const int *colStart, const int *rowIndex, 
+				const double *values)
+{
+    TV.Zero();
+    for (int j=0; j<numCols; j++) {
+	double vj = V(j);
+	for (int p=colStart[j]; p<colStart[j+1]; p++)
+	    TV(rowIndex[p]) += values[p] * vj;
+    }
+
+    return 0;
+}
+
+
 int
 TransformationDOF_Group::doneID(void)
 {
@@ -788,6 +939,7 @@ TransformationDOF_Group::doneID(void)
 		    (*Trans)(i,j+numRetainedDOF) = Ccr(loc,j);
 	    }
 	}
+	this->formSparseT();
     }
 	
     // set the pointers for the tangent and residual
@@ -888,17 +1040,13 @@ TransformationDOF_Group::enforceSPs(int doMP)
 	    (*modUnbalance)(i) = responseR(retainedDOF(j));
 	}
 	
-	Matrix *T = this->getT();
-	if (T != 0) {
+	// *unbalance = (*T) * (*modUnbalance);
+	this->transformUnbalance();
 	  
-	  // *unbalance = (*T) * (*modUnbalance);
-	  unbalance->addMatrixVector(0.0, *T, *modUnbalance, 1.0);
-	  
-	  const ID &constrainedDOF = theMP->getConstrainedDOFs();
-	  for (int i=0; i<constrainedDOF.Size(); i++) {
-	    int cDOF = constrainedDOF(i);
-	    myNode->setTrialDisp((*unbalance)(cDOF), cDOF);
-	  }
+	const ID &constrainedDOF = theMP->getConstrainedDOFs();
+	for (int i=0; i<constrainedDOF.Size(); i++) {
+	  int cDOF = constrainedDOF(i);
+	  myNode->setTrialDisp((*unbalance)(cDOF), cDOF);
 	}
       }
     }
@@ -924,9 +1072,14 @@ TransformationDOF_Group::addM_Force(const Vector &Udotdot, double fact)
 	    (*modUnbalance)(i) = 0.0;	    
     }    
 
-    Vector unmod(Trans->noRows());
+    int numRows, numCols;
+    const int *colStart, *rowIndex;
+    const double *values;
+    this->getSparseT(numRows, numCols, colStart, rowIndex, values);
+
+    Vector unmod(numRows);
     //unmod = (*Trans) * (*modUnbalance);
-    unmod.addMatrixVector(0.0, *Trans, *modUnbalance, 1.0);
+    formTV(unmod, *modUnbalance, numCols, colStart, rowIndex, values);
     this->addLocalM_Force(unmod, fact);
 }
 
@@ -953,17 +1106,16 @@ TransformationDOF_Group::getM_Force(const Vector &Udotdot, double fact)
       data(i) = 0.0;	    
   }    
 
-  Matrix *T = this->getT();
-  if (T != 0) {
-    // *modTangent = (*T) ^ unmodTangent * (*T);
-    modTangent->addMatrixTripleProduct(0.0, *T, unmodTangent, 1.0);
-    modUnbalance->addMatrixVector(0.0, *modTangent, data, 1.0);
+  int numRows, numCols;
+  const int *colStart, *rowIndex;
+  const double *values;
+  this->getSparseT(numRows, numCols, colStart, rowIndex, values);
+
+  // *modTangent = (*T) ^ unmodTangent * (*T);
+  formTtKT(*modTangent, unmodTangent, numCols, colStart, rowIndex, values);
+  modUnbalance->addMatrixVector(0.0, *modTangent, data, 1.0);
     
-    return *modUnbalance;
-  } else {
-      modUnbalance->addMatrixVector(0.0, unmodTangent, data, 1.0);
-      return *modUnbalance;
-  }
+  return *modUnbalance;
 }
 
 const Vector &
@@ -56,6 +56,8 @@ class TransformationDOF_Group: public DOF_Group
     const ID &getID(void) const; 
     virtual void setID(int dof, int value);    
     Matrix *getT(void);
+    int getSparseT(int &numRows, int &numCols, const int *&colStart,
+		   const int *&rowIndex, const double *&values);
     virtual int getNumDOF(void) const;    
     virtual int getNumFreeDOF(void) const;
     virtual int getNumConstrainedDOF(void) const;
@@ -84,6 +86,7 @@ class TransformationDOF_Group: public DOF_Group
     void incrNodeDisp(const Vector &u);
     void incrNodeVel(const Vector &udot);
     void incrNodeAccel(const Vector &udotdot);
+    bool isThreadSafe(void);
 
     virtual void setEigenvector(int mode, const Vector &eigenvalue);
 
@@ -104,13 +107,32 @@ class TransformationDOF_Group: public DOF_Group
     int saveSensitivity(const Vector &v, const Vector &vdot,
 			const Vector &vdotdot, int gradNum, int numGrads);
 // AddingSensitivity:END //////////////////////////////////////
+
+    // products with a transformation T stored by columns: only the 
+    // nonzeros of T are visited, in the order the dense Matrix and Vector
+    // methods visit them, so that the results are the same
+    static int formTtKT(Matrix &TtKT, const Matrix &K, int numCols, 
+			const int *colStart, const int *rowIndex, 
+			const double *values);
+    static int formTtV(Vector &TtV, const Vector &V, int numCols,
+		       const int *colStart, const int *rowIndex, 
+		       const double *values);
+    static int formTV(Vector &TV, const Vector &V, int numCols,
+		      const int *colStart, const int *rowIndex, 
+		      const double *values);
     
   protected:
     
   private:
+    void formSparseT(void);
+    void transformUnbalance(void);
+    
     // private variables - a copy for each object of the class            
     MP_Constraint *theMP;
     Matrix *Trans;
+    int *TransColStart;    // the nonzeros of Trans by column
+    int *TransRow;
+    double *TransValue;
     Matrix *modTangent;
     Vector *modUnbalance;
     ID *modID;
@@ -50,6 +50,8 @@ Matrix FE_Element::errMatrix(1,1);
 Vector FE_Element::errVector(1);
 Matrix **FE_Element::theMatrices; // pointers to class wide matrices
 Vector **FE_Element::theVectors;  // pointers to class widde vectors
+Matrix **FE_Element::theThreadMatrices[OPS_MAX_THREADS]; // per worker thread
+Vector **FE_Element::theThreadVectors[OPS_MAX_THREADS];
 int FE_Element::numFEs(0);           // number of objects
 
 //  FE_Element(Element *, Integrator *theIntegrator);
@@ -220,6 +222,21 @@ FE_Element::~FE_Element()
 	}	
 	delete [] theMatrices;
 	delete [] theVectors;
+
+	for (int j=0; j<OPS_MAX_THREADS; j++) {
+	    if (theThreadMatrices[j] != 0) {
+		for (int i=0; i<=MAX_NUM_DOF; i++) {
+		    if (theThreadVectors[j][i] != 0)
+			delete theThreadVectors[j][i];
+		    if (theThreadMatrices[j][i] != 0)
+			delete theThreadMatrices[j][i];
+		}
+		delete [] theThreadMatrices[j];
+		delete [] theThreadVectors[j];
+		theThreadMatrices[j] = 0;
+		theThreadVectors[j] = 0;
+	    }
+	}
     }
 }    
 
@@ -297,6 +314,7 @@ FE_Element::getTangent(Integrator *theNewIntegrator)
     }
 
     if (myEle->isSubdomain() == false) {
+      this->setThreadStorage();
       if (theNewIntegrator != 0)
 	theNewIntegrator->formEleTangent(this);	    	    
 
@@ -324,6 +342,7 @@ FE_Element::getResidual(Integrator *theNewIntegrator)
     }    
 
     if (myEle->isSubdomain() == false) {
+      this->setThreadStorage();
       theNewIntegrator->formEleResidual(this);
       return *theResidual;
     } else {
@@ -682,6 +701,52 @@ FE_Element::getC_Force(const Vector &disp, double fact)
 
 
 
+bool
+FE_Element::isThreadSafe(void)
+{
+    if (myEle == 0 || myEle->isSubdomain() == true)
+	return false;
+
+    return myEle->isThreadSafe();
+}
+
+// void setThreadStorage(void);
+//	Method to point theTangent and theResidual at the class wide objects
+//	of the calling thread, so that the FE_Elements of a thread safe
+//	Element can be formed by several threads at once. Worker threads
+//	create their own set of objects the first time they are needed.
+
+void
+FE_Element::setThreadStorage(void)
+{
+    if (numDOF > MAX_NUM_DOF)
+	return;
+
+    int threadID = ThreadPool::getThreadID();
+    if (threadID == 0) {
+	theTangent = theMatrices[numDOF];
+	theResidual = theVectors[numDOF];
+	return;
+    }
+
+    if (theThreadMatrices[threadID] == 0) {
+	theThreadMatrices[threadID] = new Matrix *[MAX_NUM_DOF+1];
+	theThreadVectors[threadID] = new Vector *[MAX_NUM_DOF+1];
+	for (int i=0; i<=MAX_NUM_DOF; i++) {
+	    theThreadMatrices[threadID][i] = 0;
+	    theThreadVectors[threadID][i] = 0;
+	}
+    }
+
+    if (theThreadMatrices[threadID][numDOF] == 0) {
+	theThreadMatrices[threadID][numDOF] = new Matrix(numDOF,numDOF);
+	theThreadVectors[threadID][numDOF] = new Vector(numDOF);
+    }
+
+    theTangent = theThreadMatrices[threadID][numDOF];
+    theResidual = theThreadVectors[threadID][numDOF];
+}
+
 Integrator *
 FE_Element::getLastIntegrator(void)
 {
@@ -40,6 +40,7 @@
 #include <Matrix.h>
 #include <Vector.h>
 #include <TaggedObject.h>
+#include <ThreadPool.h>
 
 class TransientIntegrator;
 class Element;
@@ -85,6 +86,7 @@ class FE_Element: public TaggedObject
     virtual void  addD_Force(const Vector &vel, double fact = 1.0);    
 
     virtual int updateElement(void);
+    virtual bool isThreadSafe(void);
 
     virtual Integrator *getLastIntegrator(void);
     virtual const Vector &getLastResponse(void);
@@ -104,6 +106,7 @@ class FE_Element: public TaggedObject
     void  addLocalD_Force(const Vector &vel, double fact = 1.0);    
     void  addLocalM_ForceSensitivity(int gradNumber, const Vector &accel, double fact = 1.0);    
     void  addLocalD_ForceSensitivity(int gradNumber, const Vector &vel, double fact = 1.0);    
+    void  setThreadStorage(void);
 
 
     // protected variables - a copy for each object of the class        
@@ -125,6 +128,8 @@ class FE_Element: public TaggedObject
     static Vector errVector;
     static Matrix **theMatrices; // array of pointers to class wide matrices
     static Vector **theVectors;  // array of pointers to class widde vectors
+    static Matrix **theThreadMatrices[OPS_MAX_THREADS]; // class wide matrices of worker threads
+    static Vector **theThreadVectors[OPS_MAX_THREADS];  // class wide vectors of worker threads
     static int numFEs;           // number of objects
     
 
@@ -41,19 +41,19 @@
 #include <Matrix.h>
 #include <Vector.h>
 #include <TransformationConstraintHandler.h>
+#include <TransformationDOF_Group.h>
+#include <WorkArea.h>
 
 #define MAX_NUM_DOF 64
 
+static WorkArea theWorkArea("TransformationFE");
+
 // static variables initialisation
 Matrix **TransformationFE::modMatrices; 
 Vector **TransformationFE::modVectors;  
-Matrix **TransformationFE::theTransformations; 
 int TransformationFE::numTransFE(0);           
 int TransformationFE::transCounter(0);           
-int TransformationFE::sizeTransformations(0);          
 double *TransformationFE::dataBuffer = 0;          
-double *TransformationFE::localKbuffer = 0;          
-int    *TransformationFE::dofData = 0;    ;          
 int TransformationFE::sizeBuffer(0);            
 
 //  TransformationFE(Element *, Integrator *theIntegrator);
@@ -95,22 +95,6 @@ TransformationFE::TransformationFE(int tag, Element *ele)
 	theDOFs[i] = theDofGroup;
     }
 
-    // see if theTransformation array is big enough
-    // if not delete the old and create a new one
-    if (numNodes > sizeTransformations) {
-	if (theTransformations != 0) 
-	    delete [] theTransformations;
-	
-	theTransformations = new Matrix *[numNodes];
-	if (theTransformations == 0) {
-	    opserr << "FATAL TransformationFE::TransformationFE() - out of memory ";
-	    opserr << "for array of pointers for Transformation matrices of size ";
-	    opserr << numNodes;
-	    exit(-1);
-	}		    
-	sizeTransformations = numNodes;
-    }	
-
     // if this is the first element of this type create the arrays for 
     // modified tangent and residual matrices
     if (numTransFE == 0) {
@@ -118,12 +102,9 @@ TransformationFE::TransformationFE(int tag, Element *ele)
 	modMatrices = new Matrix *[MAX_NUM_DOF+1];
 	modVectors  = new Vector *[MAX_NUM_DOF+1];
 	dataBuffer = new double[MAX_NUM_DOF*MAX_NUM_DOF];
-	localKbuffer = new double[MAX_NUM_DOF*MAX_NUM_DOF];
-	dofData      = new int[MAX_NUM_DOF];
 	sizeBuffer = MAX_NUM_DOF*MAX_NUM_DOF;
 	
-	if (modMatrices == 0 || modVectors == 0 || dataBuffer == 0 ||
-	    localKbuffer == 0 || dofData == 0) {
+	if (modMatrices == 0 || modVectors == 0 || dataBuffer == 0) {
 	    opserr << "TransformationFE::TransformationFE(Element *) ";
 	    opserr << " ran out of memory";	    
 	}
@@ -176,17 +157,10 @@ TransformationFE::~TransformationFE()
 	}
 	delete [] modMatrices;
 	delete [] modVectors;
-	delete [] theTransformations;
 	delete [] dataBuffer;
-	delete [] localKbuffer;
-	delete [] dofData;
 	modMatrices = 0;
 	modVectors = 0;
-	theTransformations = 0;
 	dataBuffer = 0;
-	localKbuffer = 0;
-	dofData = 0;
-	sizeTransformations = 0;
 	sizeBuffer = 0;
 	transCounter = 0;
     }
@@ -200,6 +174,15 @@ TransformationFE::getDOFtags(void) const
 }
 
 
+// the transformations are applied using the class wide modMatrices
+// and modVectors, which only one thread at a time may use
+bool
+TransformationFE::isThreadSafe(void)
+{
+    return false;
+}
+
+
 const ID &
 TransformationFE::getID(void) const
 {
@@ -288,102 +271,100 @@ TransformationFE::setID(void)
     return 0;
 }
 
-const Matrix &
-TransformationFE::getTangent(Integrator *theNewIntegrator)
-{
-    const Matrix &theTangent = this->FE_Element::getTangent(theNewIntegrator);
+// int getT(int &numCols, const int *&colStart, const int *&rowIndex,
+//          const double *&values);
+//	forms the nonzeros of the block diagonal T of the element by column,
+//	a block for each DOF_Group, the identity if the DOF_Group has no T.
+//	returns 0 if T is the identity.
 
-    static ID numDOFs(dofData, 1);
-    numDOFs.setData(dofData, numGroups);
-    
-    // DO THE SP STUFF TO THE TANGENT 
-    
-    // get the transformation matrix from each dof group & number of local dof
-    // for original node.
-    int numNode = numGroups;
-    for (int a = 0; a<numNode; a++) {
-      Matrix *theT = theDOFs[a]->getT();
-      theTransformations[a] = theT;
-      if (theT != 0)
-	numDOFs[a] = theT->noRows(); // T^ 
-      else
-	numDOFs[a] = theDOFs[a]->getNumDOF();
+int
+TransformationFE::getT(const int *&colStart, const int *&rowIndex, 
+		       const double *&values)
+{
+    int numRows, numCols;
+    const int *groupColStart, *groupRowIndex;
+    const double *groupValues;
+
+    // count the nonzeros
+    int numNonZeros = 0;
+    int numT = 0;
+    for (int a=0; a<numGroups; a++) {
+	if (theDOFs[a]->getSparseT(numRows, numCols, groupColStart, 
+				   groupRowIndex, groupValues) != 0) {
+	    numNonZeros += groupColStart[numCols];
+	    numT++;
+	} else
+	    numNonZeros += theDOFs[a]->getNumDOF();
     }
 
-    // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-    // where blocks are of size equal to num ele dof at a node
+    if (numT == 0)
+	return 0;
 
-    int startRow = 0;
-    int noRowsTransformed = 0;
-    int noRowsOriginal = 0;
+    int *theColStart = theWorkArea.getInts(numTransformedDOF+1, 0);
+    int *theRowIndex = theWorkArea.getInts(numNonZeros, 1);
+    double *theValues = theWorkArea.getDoubles(numNonZeros, 0);
 
-    static Matrix localK;
+    int col = 0;
+    int nnz = 0;
+    int startRow = 0;
+    for (int a=0; a<numGroups; a++) {
+	if (theDOFs[a]->getSparseT(numRows, numCols, groupColStart, 
+				   groupRowIndex, groupValues) != 0) {
+	    for (int j=0; j<numCols; j++) {
+		theColStart[col++] = nnz;
+		for (int p=groupColStart[j]; p<groupColStart[j+1]; p++) {
+		    theRowIndex[nnz] = startRow + groupRowIndex[p];
+		    theValues[nnz++] = groupValues[p];
+		}
+	    }
+	    startRow += numRows;
+	} else {
+	    int numDOF = theDOFs[a]->getNumDOF();
+	    for (int j=0; j<numDOF; j++) {
+		theColStart[col++] = nnz;
+		theRowIndex[nnz] = startRow + j;
+		theValues[nnz++] = 1.0;
+	    }
+	    startRow += numDOF;
+	}
+    }
+    theColStart[col] = nnz;
 
-    // foreach block row, for each block col do
-    for (int i=0; i<numNode; i++) {
+    colStart = theColStart;
+    rowIndex = theRowIndex;
+    values = theValues;
 
-	int startCol = 0;
-	int numDOFi = numDOFs[i];	
-	int noColsOriginal = 0;
+    return numT;
+}
 
-	for (int j=0; j<numNode; j++) {
 
-	    const Matrix *Ti = theTransformations[i];
-	    const Matrix *Tj = theTransformations[j];
-	    int numDOFj = numDOFs[j];	
-	    localK.setData(localKbuffer, numDOFi, numDOFj);
+// const Matrix &transformTangent(const Matrix &theTangent);
+//	returns T^t K T, K itself when T is the identity. only the nonzeros
+//	of T are used, the retained dofs copy their rows and columns of K.
 
-	    // copy K(i,j) into localK matrix
-	    // CHECK SIZE OF BUFFFER	    
-	    for (int a=0; a<numDOFi; a++)
-		for (int b=0; b<numDOFj; b++)
-		    localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
+const Matrix &
+TransformationFE::transformTangent(const Matrix &theTangent)
+{
+    const int *colStart, *rowIndex;
+    const double *values;
+    if (this->getT(colStart, rowIndex, values) == 0)
+	return theTangent;
+
+    TransformationDOF_Group::formTtKT(*modTangent, theTangent, 
+				      numTransformedDOF, 
+				      colStart, rowIndex, values);
+    return *modTangent;
+}
 
-	    // now perform the matrix computation T(i)^T localK T(j)
-	    // note: if T == 0 then the Identity is assumed
-	    int noColsTransformed = 0;
-	    static Matrix localTtKT;
-	    
-	    if (Ti != 0 && Tj != 0) {
-		noRowsTransformed = Ti->noCols();
-		noColsTransformed = Tj->noCols();
-		// CHECK SIZE OF BUFFFER
-		localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-		//localTtKT = (*Ti) ^ localK * (*Tj);
-		localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-	    } else if (Ti == 0 && Tj != 0) {
-		noRowsTransformed = numDOFi;
-		noColsTransformed = Tj->noCols();
-		// CHECK SIZE OF BUFFFER
-		localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-		// localTtKT = localK * (*Tj);	       
-		localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-	    } else if (Ti != 0 && Tj == 0) {
-		noRowsTransformed = Ti->noCols();
-		noColsTransformed = numDOFj;
-		localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-		//localTtKT = (*Ti) ^ localK;
-		localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-	    } else {
-		noRowsTransformed = numDOFi;
-		noColsTransformed = numDOFj;
-		localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-		localTtKT = localK;
-	    }
-	    // now copy into modTangent the T(i)^t K(i,j) T(j) product
-	    for (int c=0; c<noRowsTransformed; c++) 
-		for (int d=0; d<noColsTransformed; d++) 
-		    (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-	    
-	    startCol += noColsTransformed;
-	    noColsOriginal += numDOFj;
-	}
 
-	noRowsOriginal += numDOFi;
-	startRow += noRowsTransformed;
-    }
+const Matrix &
+TransformationFE::getTangent(Integrator *theNewIntegrator)
+{
+    const Matrix &theTangent = this->FE_Element::getTangent(theNewIntegrator);
 
-    return *modTangent;
+    // DO THE SP STUFF TO THE TANGENT 
+    
+    return this->transformTangent(theTangent);
 }
 
 
@@ -394,50 +375,15 @@ TransformationFE::getResidual(Integrator *theNewIntegrator)
     const Vector &theResidual = this->FE_Element::getResidual(theNewIntegrator);
     // DO THE SP STUFF TO THE TANGENT
     
-    // perform Tt R  -- as T is block diagonal do T(i)^T R(i)
-    // where blocks are of size equal to num ele dof at a node
-
-    int startRowTransformed = 0;
-    int startRowOriginal = 0;
-    int numNode = numGroups;
-
-    // foreach block row, for each block col do
-    for (int i=0; i<numNode; i++) {
-	int noRows = 0;
-	int noCols = 0;
-	const Matrix *Ti = theDOFs[i]->getT();
-	if (Ti != 0) {
-	  noRows = Ti->noCols(); // T^
-	  noCols = Ti->noRows();
-
-	  /*
-	  Vector orig(noCols);
-	  Vector mod(noRows);
-	  for (int k=startRowOriginal; k<startRowOriginal+noCols; k++)
-	    orig(k-startRowOriginal)= theResidual(k);
-	  mod = (*Ti)^orig;
-	  for (int k=startRowTransformed; k<startRowTransformed+noRows; k++)
-	    (*modResidual)(k) = mod (k-startRowTransformed);
-
-	  */
-
-	  for (int j=0; j<noRows; j++) {
-	    double sum = 0.0;
-	    for (int k=0; k<noCols; k++)
-	      sum += (*Ti)(k,j) * theResidual(startRowOriginal + k);
-	    (*modResidual)(startRowTransformed +j) = sum;
-	  }
-
-	} else {
-	  noCols = theDOFs[i]->getNumDOF();
-	  noRows = noCols;
-	  for (int j=0; j<noRows; j++)
-	    (*modResidual)(startRowTransformed +j) = theResidual(startRowOriginal + j);
-	}
-	startRowTransformed += noRows;
-	startRowOriginal += noCols;
-    }
-
+    // perform Tt R 
+    const int *colStart, *rowIndex;
+    const double *values;
+    if (this->getT(colStart, rowIndex, values) == 0)
+	return theResidual;
+
+    TransformationDOF_Group::formTtV(*modResidual, theResidual, 
+				     numTransformedDOF,
+				     colStart, rowIndex, values);
     return *modResidual;
 }
 
@@ -457,99 +403,8 @@ TransformationFE::getK_Force(const Vector &accel, double fact)
 {
   this->FE_Element::zeroTangent();    
   this->FE_Element::addKtToTang();    
-  const Matrix &theTangent = this->FE_Element::getTangent(0);
+  const Matrix &theTangent = this->transformTangent(this->FE_Element::getTangent(0));
 
-  static ID numDOFs(dofData, 1);
-  numDOFs.setData(dofData, numGroups);
-    
-  // DO THE SP STUFF TO THE TANGENT 
-  
-  // get the transformation matrix from each dof group & number of local dof
-  // for original node.
-  int numNode = numGroups;
-  for (int a = 0; a<numNode; a++) {
-    Matrix *theT = theDOFs[a]->getT();
-    theTransformations[a] = theT;
-    if (theT != 0)
-      numDOFs[a] = theT->noRows(); // T^ 
-    else
-      numDOFs[a] = theDOFs[a]->getNumDOF();
-  }
-  
-  // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-  // where blocks are of size equal to num ele dof at a node
-  
-  int startRow = 0;
-  int noRowsTransformed = 0;
-  int noRowsOriginal = 0;
-  
-  static Matrix localK;
-  
-  // foreach block row, for each block col do
-  for (int i=0; i<numNode; i++) {
-    
-    int startCol = 0;
-    int numDOFi = numDOFs[i];	
-    int noColsOriginal = 0;
-    
-    for (int j=0; j<numNode; j++) {
-      
-      const Matrix *Ti = theTransformations[i];
-      const Matrix *Tj = theTransformations[j];
-      int numDOFj = numDOFs[j];	
-      localK.setData(localKbuffer, numDOFi, numDOFj);
-      
-      // copy K(i,j) into localK matrix
-      // CHECK SIZE OF BUFFFER	    
-      for (int a=0; a<numDOFi; a++)
-	for (int b=0; b<numDOFj; b++)
-	  localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-      
-      // now perform the matrix computation T(i)^T localK T(j)
-      // note: if T == 0 then the Identity is assumed
-      int noColsTransformed = 0;
-      static Matrix localTtKT;
-      
-      if (Ti != 0 && Tj != 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK * (*Tj);
-	localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-      } else if (Ti == 0 && Tj != 0) {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	// localTtKT = localK * (*Tj);	       
-	localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-      } else if (Ti != 0 && Tj == 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = numDOFj;
-	// CHECK SIZE OF BUFFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK;
-	localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-      } else {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = numDOFj;
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	localTtKT = localK;
-      }
-      // now copy into modTangent the T(i)^t K(i,j) T(j) product
-      for (int c=0; c<noRowsTransformed; c++) 
-	for (int d=0; d<noColsTransformed; d++) 
-	  (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-      
-      startCol += noColsTransformed;
-      noColsOriginal += numDOFj;
-    }
-    
-    noRowsOriginal += numDOFi;
-    startRow += noRowsTransformed;
-  }
-  
   // get the components we need out of the vector
   // and place in a temporary vector
   Vector tmp(numTransformedDOF);
@@ -561,7 +416,7 @@ TransformationFE::getK_Force(const Vector &accel, double fact)
       tmp(j) = 0.0;
   }
 
-  modResidual->addMatrixVector(0.0, *modTangent, tmp, 1.0);
+  modResidual->addMatrixVector(0.0, theTangent, tmp, 1.0);
 
   return *modResidual;
 }
@@ -572,99 +427,8 @@ TransformationFE::getKi_Force(const Vector &accel, double fact)
 {
   this->FE_Element::zeroTangent();    
   this->FE_Element::addKiToTang();    
-  const Matrix &theTangent = this->FE_Element::getTangent(0);
+  const Matrix &theTangent = this->transformTangent(this->FE_Element::getTangent(0));
 
-  static ID numDOFs(dofData, 1);
-  numDOFs.setData(dofData, numGroups);
-    
-  // DO THE SP STUFF TO THE TANGENT 
-  
-  // get the transformation matrix from each dof group & number of local dof
-  // for original node.
-  int numNode = numGroups;
-  for (int a = 0; a<numNode; a++) {
-    Matrix *theT = theDOFs[a]->getT();
-    theTransformations[a] = theT;
-    if (theT != 0)
-      numDOFs[a] = theT->noRows(); // T^ 
-    else
-      numDOFs[a] = theDOFs[a]->getNumDOF();
-  }
-  
-  // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-  // where blocks are of size equal to num ele dof at a node
-  
-  int startRow = 0;
-  int noRowsTransformed = 0;
-  int noRowsOriginal = 0;
-  
-  static Matrix localK;
-  
-  // foreach block row, for each block col do
-  for (int i=0; i<numNode; i++) {
-    
-    int startCol = 0;
-    int numDOFi = numDOFs[i];	
-    int noColsOriginal = 0;
-    
-    for (int j=0; j<numNode; j++) {
-      
-      const Matrix *Ti = theTransformations[i];
-      const Matrix *Tj = theTransformations[j];
-      int numDOFj = numDOFs[j];	
-      localK.setData(localKbuffer, numDOFi, numDOFj);
-      
-      // copy K(i,j) into localK matrix
-      // CHECK SIZE OF BUFFFER	    
-      for (int a=0; a<numDOFi; a++)
-	for (int b=0; b<numDOFj; b++)
-	  localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-      
-      // now perform the matrix computation T(i)^T localK T(j)
-      // note: if T == 0 then the Identity is assumed
-      int noColsTransformed = 0;
-      static Matrix localTtKT;
-      
-      if (Ti != 0 && Tj != 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK * (*Tj);
-	localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-      } else if (Ti == 0 && Tj != 0) {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	// localTtKT = localK * (*Tj);	       
-	localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-      } else if (Ti != 0 && Tj == 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = numDOFj;
-	// CHECK SIZE OF BUFFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK;
-	localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-      } else {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = numDOFj;
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	localTtKT = localK;
-      }
-      // now copy into modTangent the T(i)^t K(i,j) T(j) product
-      for (int c=0; c<noRowsTransformed; c++) 
-	for (int d=0; d<noColsTransformed; d++) 
-	  (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-      
-      startCol += noColsTransformed;
-      noColsOriginal += numDOFj;
-    }
-    
-    noRowsOriginal += numDOFi;
-    startRow += noRowsTransformed;
-  }
-  
   // get the components we need out of the vector
   // and place in a temporary vector
   Vector tmp(numTransformedDOF);
@@ -676,7 +440,7 @@ TransformationFE::getKi_Force(const Vector &accel, double fact)
       tmp(j) = 0.0;
   }
 
-  modResidual->addMatrixVector(0.0, *modTangent, tmp, 1.0);
+  modResidual->addMatrixVector(0.0, theTangent, tmp, 1.0);
 
   return *modResidual;
 }
@@ -686,99 +450,8 @@ TransformationFE::getM_Force(const Vector &accel, double fact)
 {
   this->FE_Element::zeroTangent();    
   this->FE_Element::addMtoTang();    
-  const Matrix &theTangent = this->FE_Element::getTangent(0);
+  const Matrix &theTangent = this->transformTangent(this->FE_Element::getTangent(0));
 
-  static ID numDOFs(dofData, 1);
-  numDOFs.setData(dofData, numGroups);
-    
-  // DO THE SP STUFF TO THE TANGENT 
-  
-  // get the transformation matrix from each dof group & number of local dof
-  // for original node.
-  int numNode = numGroups;
-  for (int a = 0; a<numNode; a++) {
-    Matrix *theT = theDOFs[a]->getT();
-    theTransformations[a] = theT;
-    if (theT != 0)
-      numDOFs[a] = theT->noRows(); // T^ 
-    else
-      numDOFs[a] = theDOFs[a]->getNumDOF();
-  }
-  
-  // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-  // where blocks are of size equal to num ele dof at a node
-  
-  int startRow = 0;
-  int noRowsTransformed = 0;
-  int noRowsOriginal = 0;
-  
-  static Matrix localK;
-  
-  // foreach block row, for each block col do
-  for (int i=0; i<numNode; i++) {
-    
-    int startCol = 0;
-    int numDOFi = numDOFs[i];	
-    int noColsOriginal = 0;
-    
-    for (int j=0; j<numNode; j++) {
-      
-      const Matrix *Ti = theTransformations[i];
-      const Matrix *Tj = theTransformations[j];
-      int numDOFj = numDOFs[j];	
-      localK.setData(localKbuffer, numDOFi, numDOFj);
-      
-      // copy K(i,j) into localK matrix
-      // CHECK SIZE OF BUFFFER	    
-      for (int a=0; a<numDOFi; a++)
-	for (int b=0; b<numDOFj; b++)
-	  localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-      
-      // now perform the matrix computation T(i)^T localK T(j)
-      // note: if T == 0 then the Identity is assumed
-      int noColsTransformed = 0;
-      static Matrix localTtKT;
-      
-      if (Ti != 0 && Tj != 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK * (*Tj);
-	localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-      } else if (Ti == 0 && Tj != 0) {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	// localTtKT = localK * (*Tj);	       
-	localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-      } else if (Ti != 0 && Tj == 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = numDOFj;
-	// CHECK SIZE OF BUFFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK;
-	localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-      } else {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = numDOFj;
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	localTtKT = localK;
-      }
-      // now copy into modTangent the T(i)^t K(i,j) T(j) product
-      for (int c=0; c<noRowsTransformed; c++) 
-	for (int d=0; d<noColsTransformed; d++) 
-	  (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-      
-      startCol += noColsTransformed;
-      noColsOriginal += numDOFj;
-    }
-    
-    noRowsOriginal += numDOFi;
-    startRow += noRowsTransformed;
-  }
-  
   // get the components we need out of the vector
   // and place in a temporary vector
   Vector tmp(numTransformedDOF);
@@ -790,7 +463,7 @@ TransformationFE::getM_Force(const Vector &accel, double fact)
       tmp(j) = 0.0;
   }
 
-  modResidual->addMatrixVector(0.0, *modTangent, tmp, 1.0);
+  modResidual->addMatrixVector(0.0, theTangent, tmp, 1.0);
 
   return *modResidual;
 }
@@ -800,99 +473,8 @@ TransformationFE::getC_Force(const Vector &accel, double fact)
 {
   this->FE_Element::zeroTangent();    
   this->FE_Element::addCtoTang();    
-  const Matrix &theTangent = this->FE_Element::getTangent(0);
+  const Matrix &theTangent = this->transformTangent(this->FE_Element::getTangent(0));
 
-  static ID numDOFs(dofData, 1);
-  numDOFs.setData(dofData, numGroups);
-    
-  // DO THE SP STUFF TO THE TANGENT 
-  
-  // get the transformation matrix from each dof group & number of local dof
-  // for original node.
-  int numNode = numGroups;
-  for (int a = 0; a<numNode; a++) {
-    Matrix *theT = theDOFs[a]->getT();
-    theTransformations[a] = theT;
-    if (theT != 0)
-      numDOFs[a] = theT->noRows(); // T^ 
-    else
-      numDOFs[a] = theDOFs[a]->getNumDOF();
-  }
-  
-  // perform Tt K T -- as T is block diagonal do T(i)^T K(i,j) T(j)
-  // where blocks are of size equal to num ele dof at a node
-  
-  int startRow = 0;
-  int noRowsTransformed = 0;
-  int noRowsOriginal = 0;
-  
-  static Matrix localK;
-  
-  // foreach block row, for each block col do
-  for (int i=0; i<numNode; i++) {
-    
-    int startCol = 0;
-    int numDOFi = numDOFs[i];	
-    int noColsOriginal = 0;
-    
-    for (int j=0; j<numNode; j++) {
-      
-      const Matrix *Ti = theTransformations[i];
-      const Matrix *Tj = theTransformations[j];
-      int numDOFj = numDOFs[j];	
-      localK.setData(localKbuffer, numDOFi, numDOFj);
-      
-      // copy K(i,j) into localK matrix
-      // CHECK SIZE OF BUFFFER	    
-      for (int a=0; a<numDOFi; a++)
-	for (int b=0; b<numDOFj; b++)
-	  localK(a,b) = theTangent(noRowsOriginal+a, noColsOriginal+b);
-      
-      // now perform the matrix computation T(i)^T localK T(j)
-      // note: if T == 0 then the Identity is assumed
-      int noColsTransformed = 0;
-      static Matrix localTtKT;
-      
-      if (Ti != 0 && Tj != 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK * (*Tj);
-	localTtKT.addMatrixTripleProduct(0.0, *Ti, localK, *Tj, 1.0);
-      } else if (Ti == 0 && Tj != 0) {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = Tj->noCols();
-	// CHECK SIZE OF BUFFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	// localTtKT = localK * (*Tj);	       
-	localTtKT.addMatrixProduct(0.0, localK, *Tj, 1.0);
-      } else if (Ti != 0 && Tj == 0) {
-	noRowsTransformed = Ti->noCols();
-	noColsTransformed = numDOFj;
-	// CHECK SIZE OF BUFFFER
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	//localTtKT = (*Ti) ^ localK;
-	localTtKT.addMatrixTransposeProduct(0.0, *Ti, localK, 1.0);
-      } else {
-	noRowsTransformed = numDOFi;
-	noColsTransformed = numDOFj;
-	localTtKT.setData(dataBuffer, noRowsTransformed, noColsTransformed);
-	localTtKT = localK;
-      }
-      // now copy into modTangent the T(i)^t K(i,j) T(j) product
-      for (int c=0; c<noRowsTransformed; c++) 
-	for (int d=0; d<noColsTransformed; d++) 
-	  (*modTangent)(startRow+c, startCol+d) = localTtKT(c,d);
-      
-      startCol += noColsTransformed;
-      noColsOriginal += numDOFj;
-    }
-    
-    noRowsOriginal += numDOFi;
-    startRow += noRowsTransformed;
-  }
-  
   // get the components we need out of the vector
   // and place in a temporary vector
   Vector tmp(numTransformedDOF);
@@ -904,7 +486,7 @@ TransformationFE::getC_Force(const Vector &accel, double fact)
       tmp(j) = 0.0;
   }
 
-  modResidual->addMatrixVector(0.0, *modTangent, tmp, 1.0);
+  modResidual->addMatrixVector(0.0, theTangent, tmp, 1.0);
 
   return *modResidual;
 }
@@ -978,37 +560,18 @@ int
 TransformationFE::transformResponse(const Vector &modResp, 
 				    Vector &unmodResp)
 {
-    // perform T R  -- as T is block diagonal do T(i) R(i)
-    // where blocks are of size equal to num ele dof at a node
-
-    int startRowOriginal = 0;
-    int startRowTransformed = 0;
-    int numNode = numGroups;
-    int noRows = 0;
-    int noCols = 0;
-
-    for (int i=0; i<numNode; i++) {
-	const Matrix *Ti = theDOFs[i]->getT();
-	if (Ti != 0) {
-	    noRows = Ti->noRows();
-	    noCols = Ti->noCols();
-	    for (int j=0; j<noRows; j++) {
-		double sum = 0.0;
-		for (int k=0; k<noCols; k++)
-		    sum += (*Ti)(j,k) * modResp(startRowTransformed +k) ;
-		unmodResp(startRowOriginal + j) = sum;
-	    }
-	} else {
-	    noCols = theDOFs[i]->getNumDOF();
-	    noRows = noCols;
-	    for (int j=0; j<noCols; j++)
-		unmodResp(startRowOriginal + j) = modResp(startRowTransformed +j);
-	}
-	startRowOriginal += noRows;
-	startRowTransformed += noCols;
+    // perform T R
+    const int *colStart, *rowIndex;
+    const double *values;
+    if (this->getT(colStart, rowIndex, values) == 0) {
+	for (int i=0; i<numOriginalDOF; i++)
+	    unmodResp(i) = modResp(i);
+	return 0;
     }
 
-    return 0;
+    return TransformationDOF_Group::formTV(unmodResp, modResp, 
+					   numTransformedDOF,
+					   colStart, rowIndex, values);
 }
 
 
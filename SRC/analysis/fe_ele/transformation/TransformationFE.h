@@ -56,6 +56,7 @@ class TransformationFE: public FE_Element
     // methods to form and obtain the tangent and residual
     virtual const Matrix &getTangent(Integrator *theIntegrator);
     virtual const Vector &getResidual(Integrator *theIntegrator);
+    virtual bool isThreadSafe(void);
     
     // methods for ele-by-ele strategies
     virtual const Vector &getTangForce(const Vector &x, double fact = 1.0);
@@ -79,6 +80,8 @@ class TransformationFE: public FE_Element
     int transformResponse(const Vector &modResponse, Vector &unmodResponse);
     
   private:
+    int getT(const int *&colStart, const int *&rowIndex, const double *&values);
+    const Matrix &transformTangent(const Matrix &theTangent);
     
     // private variables - a copy for each object of the class        
     DOF_Group **theDOFs;
@@ -94,13 +97,9 @@ class TransformationFE: public FE_Element
     // static variables - single copy for all objects of the class	
     static Matrix **modMatrices; // array of pointers to class wide matrices
     static Vector **modVectors;  // array of pointers to class widde vectors
-    static Matrix **theTransformations; // for holding pointers to the T matrices
     static int numTransFE;     // number of objects    
     static int transCounter;   // a counter used to indicate when to do something
-    static int sizeTransformations; // size of theTransformations array
     static double *dataBuffer;
-    static double *localKbuffer;
-    static int    *dofData;
     static int sizeBuffer;
 };
 
@@ -35,18 +35,22 @@
 #include <LinearSOE.h>
 #include <AnalysisModel.h>
 #include <Vector.h>
+#include <ID.h>
 #include <DOF_Group.h>
 #include <DOF_GrpIter.h>
 #include <AnalysisModel.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
+#include <ElementColoring.h>
 
-CentralDifferenceNoDamping::CentralDifferenceNoDamping()
+CentralDifferenceNoDamping::CentralDifferenceNoDamping(bool reuse)
 :TransientIntegrator(INTEGRATOR_TAGS_CentralDifferenceNoDamping),
  updateCount(0), 
- U(0), Udot(0), Udotdot(0), deltaT(0)
+ U(0), Udot(0), Udotdot(0), deltaT(0), reuseMass(reuse), theMassSOE(0)
 {
-    
+  // no tangent to assemble, so the residuals are added one color of
+  // elements at a time whenever there are threads to do it
+  this->setElementColoring(ELEMENT_COLORING_GREEDY);
 }
 
 CentralDifferenceNoDamping::~CentralDifferenceNoDamping()
@@ -80,6 +84,20 @@ CentralDifferenceNoDamping::newStep(double _deltaT)
   return 0;
 }
 
+int
+CentralDifferenceNoDamping::formTangent(int statFlag)
+{
+  // the A of the SOE still holds the factored mass from an earlier step
+  if (reuseMass == true && theMassSOE != 0 && theMassSOE == this->getLinearSOE())
+    return 0;
+
+  // until the solve with it succeeds and update() is invoked, A is not
+  // known to hold the factored mass
+  theMassSOE = 0;
+
+  return this->TransientIntegrator::formTangent(statFlag);
+}
+
 int
 CentralDifferenceNoDamping::formEleTangent(FE_Element *theEle)
 {
@@ -121,6 +139,9 @@ CentralDifferenceNoDamping::domainChanged()
   LinearSOE *theLinSOE = this->getLinearSOE();
   const Vector &x = theLinSOE->getX();
   int size = x.Size();
+
+  // the mass must be formed again on the next step
+  theMassSOE = 0;
   
   // create the new Vector objects
   if (U == 0 || U->Size() != size) {
@@ -219,14 +240,28 @@ CentralDifferenceNoDamping::update(const Vector &X)
     return -3;
   }
 
+  // the solve succeeded, so A now holds the factored mass
+  if (reuseMass == true)
+    theMassSOE = this->getLinearSOE();
+
   //  determine the acceleration at time t 
   (*Udotdot) = X;
 
-  //  determine the vel at t+ 0.5 * delta t 
-  Udot->addVector(1.0, X, deltaT);
-  
-  //  determine the displacement at t+delta t 
-  U->addVector(1.0, *Udot, deltaT);
+  // determine the vel at t+ 0.5 * delta t and the displacement at t+delta t
+  // in one pass over the equations
+  int size = U->Size();
+  if (size > 0) {
+    double *dispPtr = &(*U)(0);
+    double *velPtr = &(*Udot)(0);
+    const double *accelPtr = &(*Udotdot)(0);
+    double dt = deltaT;
+
+    for (int i=0; i<size; i++) {
+      double v = velPtr[i] + dt*accelPtr[i];
+      velPtr[i] = v;
+      dispPtr[i] += dt*v;
+    }
+  }
 
   // update the disp & responses at the DOFs
   theModel->setDisp(*U);
@@ -256,12 +291,25 @@ CentralDifferenceNoDamping::commit(void)
 int
 CentralDifferenceNoDamping::sendSelf(int cTag, Channel &theChannel)
 {
+  static ID data(1);
+  data(0) = (reuseMass == true) ? 1 : 0;
+  if (theChannel.sendID(this->getDbTag(), cTag, data) < 0) {
+    opserr << "WARNING CentralDifferenceNoDamping::sendSelf() - could not send data\n";
+    return -1;
+  }
   return 0;
 }
 
 int
 CentralDifferenceNoDamping::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
 {
+    static ID data(1);
+    if (theChannel.recvID(this->getDbTag(), cTag, data) < 0) {
+	opserr << "WARNING CentralDifferenceNoDamping::recvSelf() - could not receive data\n";
+	return -1;
+    }
+    reuseMass = (data(0) == 1);
+    theMassSOE = 0;
     return 0;
 }
 
@@ -272,6 +320,8 @@ CentralDifferenceNoDamping::Print(OPS_Stream &s, int flag)
     if (theModel != 0) {
 	double currentTime = theModel->getCurrentDomainTime();
 	s << "\t CentralDifferenceNoDamping - currentTime: " << currentTime;
+	if (reuseMass == true)
+	    s << " (mass reused between steps)";
     } else 
 	s << "\t CentralDifferenceNoDamping - no associated AnalysisModel\n";
 }
@@ -39,6 +39,16 @@
 // Goudreau, G.L. and J.O. Hallquist, "Recent Developments in Large Scale Finite Element Lagrangian 
 // Hydrocode Technology", Journal of Computer Methods in Applied Mechanics and Engineering, 30, 1982.
 //
+// With reuseMass set the lumped mass is assumed constant between changes 
+// to the domain: it is only formed, and inverted by the solver, on the first
+// step after domainChanged() and the following steps just form the residual
+// and reuse the stored inverse. Changes to the mass that do not change the 
+// domain, e.g. the mass command or a parameter update of a density, are 
+// then not seen; by default the mass is formed on every step. Reusing
+// the mass only takes the mass loop and the inversion of the diagonal out
+// of a step; the residual of every element and node is still formed
+// through the FE_Element and DOF_Group objects on each step.
+//
 // What: "@(#) CentralDifferenceNoDamping.h, revA"
 
 #include <TransientIntegrator.h>
@@ -46,15 +56,17 @@
 class DOF_Group;
 class FE_Element;
 class Vector;
+class LinearSOE;
 
 class CentralDifferenceNoDamping : public TransientIntegrator
 {
   public:
-    CentralDifferenceNoDamping();
+    CentralDifferenceNoDamping(bool reuseMass = false);
     ~CentralDifferenceNoDamping();
 
     // methods which define what the FE_Element and DOF_Groups add
     // to the system of equation object.
+    int formTangent(int statFlag);
     int formEleTangent(FE_Element *theEle);
     int formNodTangent(DOF_Group *theDof);        
     int formEleResidual(FE_Element *theEle);
@@ -80,6 +92,8 @@ class CentralDifferenceNoDamping : public TransientIntegrator
     Vector *Udot;       // vel response quantity at time t-1/2 delta t
     Vector *Udotdot;    // accel response at time t
     double deltaT;
+    bool reuseMass;        // true if the inverse mass is kept between steps
+    LinearSOE *theMassSOE; // SOE holding the inverse mass, 0 until a step solved with it
 };
 
 #endif
@@ -38,18 +38,107 @@
 #include <DOF_Group.h>
 #include <FE_EleIter.h>
 #include <DOF_GrpIter.h>
+#include <Matrix.h>
+#include <ThreadPool.h>
+#include <ElementColoring.h>
+
+// number of FE_Elements formed by each thread before the block is
+// assembled into the LinearSOE; bounds the size of stageData
+#define ELEMENTS_PER_THREAD_BLOCK 256
+
+struct IncrementalIntegratorTask {
+  IncrementalIntegrator *theIntegrator;
+  FE_Element **theFEs;
+  int *stageLoc;
+  double *stageData;
+};
+
+// forms the tangents of the thread safe FE_Elements in [start, end) of the
+// current block and copies them into the stage area; the others are
+// formed afterwards by the main thread
+static void
+formTangentTask(int start, int end, int threadID, void *data)
+{
+  IncrementalIntegratorTask *theTask = (IncrementalIntegratorTask *)data;
+  Matrix theStage;
+  for (int i=start; i<end; i++) {
+    int loc = theTask->stageLoc[i];
+    if (loc < 0)
+      continue;
+    FE_Element *elePtr = theTask->theFEs[i];
+    const Matrix &theTangent = elePtr->getTangent(theTask->theIntegrator);
+    theStage.setData(&(theTask->stageData[loc]), theTangent.noRows(), theTangent.noCols());
+    theStage.addMatrix(0.0, theTangent, 1.0);
+  }
+}
+
+struct IncrementalIntegratorColorTask {
+  IncrementalIntegrator *theIntegrator;
+  LinearSOE *theSOE;
+  FE_Element **theFEs;
+  int results[OPS_MAX_THREADS];
+};
+
+// forms the tangents of FE_Elements of one color in [start, end) and
+// adds them to the LinearSOE; no two of them share an equation
+static void
+addTangentTask(int start, int end, int threadID, void *data)
+{
+  IncrementalIntegratorColorTask *theTask = (IncrementalIntegratorColorTask *)data;
+  for (int i=start; i<end; i++) {
+    FE_Element *elePtr = theTask->theFEs[i];
+    if (theTask->theSOE->addA(elePtr->getTangent(theTask->theIntegrator), elePtr->getID()) < 0)
+      theTask->results[threadID] = -3;
+  }
+}
+
+static void
+addResidualTask(int start, int end, int threadID, void *data)
+{
+  IncrementalIntegratorColorTask *theTask = (IncrementalIntegratorColorTask *)data;
+  for (int i=start; i<end; i++) {
+    FE_Element *elePtr = theTask->theFEs[i];
+    if (theTask->theSOE->addB(elePtr->getResidual(theTask->theIntegrator), elePtr->getID()) < 0)
+      theTask->results[threadID] = -2;
+  }
+}
+
+static void
+formResidualTask(int start, int end, int threadID, void *data)
+{
+  IncrementalIntegratorTask *theTask = (IncrementalIntegratorTask *)data;
+  Vector theStage;
+  for (int i=start; i<end; i++) {
+    int loc = theTask->stageLoc[i];
+    if (loc < 0)
+      continue;
+    FE_Element *elePtr = theTask->theFEs[i];
+    const Vector &theResidual = elePtr->getResidual(theTask->theIntegrator);
+    theStage.setData(&(theTask->stageData[loc]), theResidual.Size());
+    theStage.addVector(0.0, theResidual, 1.0);
+  }
+}
 
 IncrementalIntegrator::IncrementalIntegrator(int clasTag)
 :Integrator(clasTag),
  statusFlag(CURRENT_TANGENT),
- theSOE(0), theAnalysisModel(0), theTest(0)
+ theSOE(0), theAnalysisModel(0), theTest(0),
+ theThreadPool(0), printTiming(false), theFEs(0), sizeFEs(0),
+ stageLoc(0), stageData(0), sizeStageData(0), coloringMethod(0)
 {
 
 }
 
 IncrementalIntegrator::~IncrementalIntegrator()
 {
-
+    if (theThreadPool != 0)
+	delete theThreadPool;
+    if (theFEs != 0)
+	delete [] theFEs;
+    if (stageLoc != 0)
+	delete [] stageLoc;
+    if (stageData != 0)
+	delete [] stageData;
 }
 
 void
@@ -80,14 +169,8 @@ IncrementalIntegrator::formTangent(int statFlag)
     // efficiency when performing parallel computations - CHANGE
 
     // loop through the FE_Elements adding their contributions to the tangent
-    FE_Element *elePtr;
-    FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
-    while((elePtr = theEles2()) != 0)     
-	if (theSOE->addA(elePtr->getTangent(this),elePtr->getID()) < 0) {
-	    opserr << "WARNING IncrementalIntegrator::formTangent -";
-	    opserr << " failed in addA for ID " << elePtr->getID();	    
-	    result = -3;
-	}
+    if (this->formElementTangent() < 0)
+	result = -3;
 
     return result;
 }
@@ -119,6 +202,37 @@ IncrementalIntegrator::formUnbalance(void)
     return 0;
 }
     
+
+int
+IncrementalIntegrator::setElementColoring(int method)
+{
+    coloringMethod = method;
+    return 0;
+}
+
+int
+IncrementalIntegrator::setNumThreads(int numThreads, bool printTimes)
+{
+    if (theThreadPool != 0) {
+	delete theThreadPool;
+	theThreadPool = 0;
+    }
+
+    printTiming = printTimes;
+
+    // with one thread the original serial loops are used
+    if (numThreads > 1) {
+	theThreadPool = new ThreadPool(numThreads);
+	if (theThreadPool->getNumThreads() == 1) {
+	    delete theThreadPool;
+	    theThreadPool = 0;
+	}
+    }
+
+    return 0;
+}
+
+
 int
 IncrementalIntegrator::getLastResponse(Vector &result, const ID &id)
 {
@@ -238,17 +352,307 @@ IncrementalIntegrator::formElementResidual(void)
 
     int res = 0;    
 
-    FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
-    while((elePtr = theEles2()) != 0) {
-      //      opserr << "ELEPTR " << elePtr->getResidual(this);
+    // the threads of this integrator, else those of the default pool
+    ThreadPool *thePool = theThreadPool;
+    if (thePool == 0)
+	thePool = ThreadPool::getDefault();
+
+    if (thePool == 0) {
+	FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
+	while((elePtr = theEles2()) != 0) {
+	  //      opserr << "ELEPTR " << elePtr->getResidual(this);
+
+	    if (theSOE->addB(elePtr->getResidual(this),elePtr->getID()) <0) {
+		opserr << "WARNING IncrementalIntegrator::formElementResidual -";
+		opserr << " failed in addB for ID " << elePtr->getID();
+		res = -2;
+	    }
+	}
 
-	if (theSOE->addB(elePtr->getResidual(this),elePtr->getID()) <0) {
-	    opserr << "WARNING IncrementalIntegrator::formElementResidual -";
-	    opserr << " failed in addB for ID " << elePtr->getID();
-	    res = -2;
+	return res;	    
+    }
+
+    if (coloringMethod != 0 && theSOE->isThreadSafe() == true)
+	return this->formByColor(thePool, false);
+
+    // threads form the residuals of a block of thread safe FE_Elements, 
+    // which are then added in iterator order so that the result does not 
+    // depend on the number of threads
+    double formTime = 0.0;
+    double assembleTime = 0.0;
+    double time0 = ThreadPool::getWallTime();
+
+    int numFEs = this->setStageLocations(0, 0, false);
+    int blockSize = ELEMENTS_PER_THREAD_BLOCK * thePool->getNumThreads();
+
+    Vector theStage;
+    for (int start = 0; start < numFEs; start += blockSize) {
+	int end = start + blockSize;
+	if (end > numFEs)
+	    end = numFEs;
+
+	if (this->setStageLocations(start, end, false) < 0)
+	    return -1;
+
+	IncrementalIntegratorTask theTask;
+	theTask.theIntegrator = this;
+	theTask.theFEs = &theFEs[start];
+	theTask.stageLoc = &stageLoc[start];
+	theTask.stageData = stageData;
+	thePool->parallelFor(end-start, formResidualTask, &theTask);
+
+	double time1 = ThreadPool::getWallTime();
+	formTime += time1 - time0;
+
+	for (int i=start; i<end; i++) {
+	    elePtr = theFEs[i];
+	    int loc = stageLoc[i];
+	    int result;
+	    if (loc >= 0) {
+		theStage.setData(&stageData[loc], elePtr->getID().Size());
+		result = theSOE->addB(theStage, elePtr->getID());
+	    } else
+		result = theSOE->addB(elePtr->getResidual(this), elePtr->getID());
+
+	    if (result < 0) {
+		opserr << "WARNING IncrementalIntegrator::formElementResidual -";
+		opserr << " failed in addB for ID " << elePtr->getID();
+		res = -2;
+	    }
 	}
+
+	time0 = ThreadPool::getWallTime();
+	assembleTime += time0 - time1;
+    }
+
+    if (printTiming == true) {
+	opserr << "IncrementalIntegrator::formElementResidual - threads: ";
+	opserr << thePool->getNumThreads() << " form: " << formTime;
+	opserr << " assemble: " << assembleTime << " (sec)\n";
     }
 
     return res;	    
 }
 
+int 
+IncrementalIntegrator::formElementTangent(void)
+{
+    // loop through the FE_Elements and add the tangent
+    FE_Element *elePtr;
+
+    int res = 0;    
+
+    // the threads of this integrator, else those of the default pool
+    ThreadPool *thePool = theThreadPool;
+    if (thePool == 0)
+	thePool = ThreadPool::getDefault();
+
+    if (thePool == 0) {
+	FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
+	while((elePtr = theEles2()) != 0)     
+	    if (theSOE->addA(elePtr->getTangent(this),elePtr->getID()) < 0) {
+		opserr << "WARNING IncrementalIntegrator::formTangent -";
+		opserr << " failed in addA for ID " << elePtr->getID();	    
+		res = -3;
+	    }
+
+	return res;
+    }
+
+    if (coloringMethod != 0 && theSOE->isThreadSafe() == true)
+	return this->formByColor(thePool, true);
+
+    // as for the residual, the tangents of a block are formed by the
+    // threads and then added in iterator order by this thread
+    double formTime = 0.0;
+    double assembleTime = 0.0;
+    double time0 = ThreadPool::getWallTime();
+
+    int numFEs = this->setStageLocations(0, 0, true);
+    int blockSize = ELEMENTS_PER_THREAD_BLOCK * thePool->getNumThreads();
+
+    Matrix theStage;
+    for (int start = 0; start < numFEs; start += blockSize) {
+	int end = start + blockSize;
+	if (end > numFEs)
+	    end = numFEs;
+
+	if (this->setStageLocations(start, end, true) < 0)
+	    return -1;
+
+	IncrementalIntegratorTask theTask;
+	theTask.theIntegrator = this;
+	theTask.theFEs = &theFEs[start];
+	theTask.stageLoc = &stageLoc[start];
+	theTask.stageData = stageData;
+	thePool->parallelFor(end-start, formTangentTask, &theTask);
+
+	double time1 = ThreadPool::getWallTime();
+	formTime += time1 - time0;
+
+	for (int i=start; i<end; i++) {
+	    elePtr = theFEs[i];
+	    int loc = stageLoc[i];
+	    int result;
+	    if (loc >= 0) {
+		int numDOF = elePtr->getID().Size();
+		theStage.setData(&stageData[loc], numDOF, numDOF);
+		result = theSOE->addA(theStage, elePtr->getID());
+	    } else
+		result = theSOE->addA(elePtr->getTangent(this), elePtr->getID());
+
+	    if (result < 0) {
+		opserr << "WARNING IncrementalIntegrator::formTangent -";
+		opserr << " failed in addA for ID " << elePtr->getID();	    
+		res = -3;
+	    }
+	}
+
+	time0 = ThreadPool::getWallTime();
+	assembleTime += time0 - time1;
+    }
+
+    if (printTiming == true) {
+	opserr << "IncrementalIntegrator::formElementTangent - threads: ";
+	opserr << thePool->getNumThreads() << " form: " << formTime;
+	opserr << " assemble: " << assembleTime << " (sec)\n";
+    }
+
+    return res;
+}
+
+// int formByColor(ThreadPool *thePool, bool tangent);
+//	Forms the tangents (or residuals) of the FE_Elements of each color
+//	of the ElementColoring of the model on the threads, which add them
+//	to the LinearSOE directly; those not thread safe are then formed and
+//	added by this thread. The result depends on the colors, but not on
+//	the number of threads.
+
+int
+IncrementalIntegrator::formByColor(ThreadPool *thePool, bool tangent)
+{
+    ElementColoring *theColoring = theAnalysisModel->getElementColoring(coloringMethod);
+    if (theColoring == 0) {
+	opserr << "WARNING IncrementalIntegrator::formByColor -";
+	opserr << " no coloring of the FE_Elements\n";
+	return -1;
+    }
+
+    double time0 = ThreadPool::getWallTime();
+
+    IncrementalIntegratorColorTask theTask;
+    theTask.theIntegrator = this;
+    theTask.theSOE = theSOE;
+    int i;
+    for (i=0; i<OPS_MAX_THREADS; i++)
+	theTask.results[i] = 0;
+
+    int numColors = theColoring->getNumColors();
+    for (int c=0; c<numColors; c++) {
+	int numFEs;
+	theTask.theFEs = theColoring->getElements(c, numFEs);
+	if (tangent == true)
+	    thePool->parallelFor(numFEs, addTangentTask, &theTask);
+	else
+	    thePool->parallelFor(numFEs, addResidualTask, &theTask);
+    }
+
+    double time1 = ThreadPool::getWallTime();
+
+    int res = 0;
+    for (i=0; i<OPS_MAX_THREADS; i++)
+	if (theTask.results[i] < 0)
+	    res = theTask.results[i];
+    if (res < 0) {
+	opserr << "WARNING IncrementalIntegrator::formByColor -";
+	opserr << " failed to add the contribution of an FE_Element\n";
+    }
+
+    int numSerial;
+    FE_Element **theSerialFEs = theColoring->getSerialElements(numSerial);
+    for (i=0; i<numSerial; i++) {
+	FE_Element *elePtr = theSerialFEs[i];
+	int result;
+	if (tangent == true)
+	    result = theSOE->addA(elePtr->getTangent(this), elePtr->getID());
+	else
+	    result = theSOE->addB(elePtr->getResidual(this), elePtr->getID());
+
+	if (result < 0) {
+	    opserr << "WARNING IncrementalIntegrator::formByColor -";
+	    opserr << " failed to add the contribution for ID " << elePtr->getID();
+	    res = (tangent == true) ? -3 : -2;
+	}
+    }
+
+    if (printTiming == true) {
+	opserr << "IncrementalIntegrator::formByColor - threads: ";
+	opserr << thePool->getNumThreads() << " colors: " << numColors;
+	opserr << " colored: " << time1 - time0;
+	opserr << " serial: " << ThreadPool::getWallTime() - time1 << " (sec)\n";
+    }
+
+    return res;
+}
+
+// int setStageLocations(int start, int end, bool tangent);
+//	With start == end the FE_Elements of the model are collected into
+//	theFEs and their number returned. Otherwise the location in stageData 
+//	of the tangent (or residual) of each thread safe FE_Element in 
+//	[start, end) is set, -1 marking those that must be formed serially.
+
+int
+IncrementalIntegrator::setStageLocations(int start, int end, bool tangent)
+{
+    if (start == end) {
+	int numFEs = 0;
+	FE_Element *elePtr;
+	FE_EleIter &theEles = theAnalysisModel->getFEs();    
+	while((elePtr = theEles()) != 0) 
+	    numFEs++;
+
+	if (numFEs > sizeFEs) {
+	    if (theFEs != 0)
+		delete [] theFEs;
+	    if (stageLoc != 0)
+		delete [] stageLoc;
+	    theFEs = new FE_Element *[numFEs];
+	    stageLoc = new int[numFEs];
+	    sizeFEs = numFEs;
+	}
+
+	numFEs = 0;
+	FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
+	while((elePtr = theEles2()) != 0) 
+	    theFEs[numFEs++] = elePtr;
+
+	return numFEs;
+    }
+
+    int size = 0;
+    for (int i=start; i<end; i++) {
+	FE_Element *elePtr = theFEs[i];
+	if (elePtr->isThreadSafe() == true) {
+	    int numDOF = elePtr->getID().Size();
+	    stageLoc[i] = size;
+	    size += (tangent == true) ? numDOF*numDOF : numDOF;
+	} else
+	    stageLoc[i] = -1;
+    }
+
+    if (size > sizeStageData) {
+	if (stageData != 0)
+	    delete [] stageData;
+	stageData = new double[size];
+	if (stageData == 0) {
+	    opserr << "WARNING IncrementalIntegrator::setStageLocations -";
+	    opserr << " out of memory\n";
+	    sizeStageData = 0;
+	    return -1;
+	}
+	sizeStageData = size;
+    }
+
+    return size;
+}
+
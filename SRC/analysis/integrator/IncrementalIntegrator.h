@@ -45,6 +45,7 @@ class ConvergenceTest;
 class FE_Element;
 class DOF_Group;
 class Vector;
+class ThreadPool;
 
 #define CURRENT_TANGENT 0
 #define INITIAL_TANGENT 1
@@ -86,6 +87,13 @@ class IncrementalIntegrator : public Integrator
     
     // method introduced for domain decomposition
     virtual int getLastResponse(Vector &result, const ID &id);
+
+    // method to form the element contributions using several threads
+    int setNumThreads(int numThreads, bool printTiming = false);
+
+    // method to add the element contributions to the LinearSOE on the
+    // threads, one color of FE_Elements at a time (0 to stop)
+    int setElementColoring(int method);
     
   protected:
     LinearSOE *getLinearSOE(void) const;
@@ -94,12 +102,26 @@ class IncrementalIntegrator : public Integrator
 
     virtual int  formNodalUnbalance(void);        
     virtual int  formElementResidual(void);            
+    virtual int  formElementTangent(void);
     int statusFlag;
     
   private:
+    int setStageLocations(int start, int end, bool tangent);
+    int formByColor(ThreadPool *thePool, bool tangent);
+
     LinearSOE *theSOE;
     AnalysisModel *theAnalysisModel;
     ConvergenceTest *theTest;
+
+    // data for forming the element contributions in parallel
+    ThreadPool *theThreadPool;
+    bool printTiming;
+    FE_Element **theFEs;   // FE_Elements of the model, in iterator order
+    int sizeFEs;
+    int *stageLoc;         // location in stageData of each FE_Element of a block
+    double *stageData;     // contributions formed by the threads for a block
+    int sizeStageData;
+    int coloringMethod;    // ElementColoring method, 0 if not colored
 };
 
 #endif
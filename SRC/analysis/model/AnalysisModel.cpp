@@ -49,6 +49,8 @@
 #include <Node.h>
 #include <NodeIter.h>
 #include <ConstraintHandler.h>
+#include <ElementColoring.h>
+#include <ThreadPool.h>
 
 
 #include <MapOfTaggedObjects.h>
@@ -56,14 +58,53 @@
 #define START_EQN_NUM 0
 #define START_VERTEX_NUM 0
 
+// what the threads of the default pool are to set at the nodes
+#define SET_DISP   1
+#define SET_VEL    2
+#define SET_ACCEL  4
+#define INCR_DISP  8
+#define INCR_VEL  16
+#define INCR_ACCEL 32
+
+struct AnalysisModelTask {
+  DOF_Group **theDOFs;
+  int what;
+  const Vector *disp;
+  const Vector *vel;
+  const Vector *accel;
+};
+
+static void
+setResponseTask(int start, int end, int threadID, void *data)
+{
+  AnalysisModelTask *theTask = (AnalysisModelTask *)data;
+  int what = theTask->what;
+  for (int i=start; i<end; i++) {
+    DOF_Group *dofPtr = theTask->theDOFs[i];
+    if (what & SET_DISP)
+      dofPtr->setNodeDisp(*(theTask->disp));
+    if (what & SET_VEL)
+      dofPtr->setNodeVel(*(theTask->vel));
+    if (what & SET_ACCEL)
+      dofPtr->setNodeAccel(*(theTask->accel));
+    if (what & INCR_DISP)
+      dofPtr->incrNodeDisp(*(theTask->disp));
+    if (what & INCR_VEL)
+      dofPtr->incrNodeVel(*(theTask->vel));
+    if (what & INCR_ACCEL)
+      dofPtr->incrNodeAccel(*(theTask->accel));
+  }
+}
+
 //  AnalysisModel();
 //	constructor
 
 AnalysisModel::AnalysisModel(int theClassTag)
 :MovableObject(theClassTag),
  myDomain(0), myHandler(0),
- myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ myDOFGraph(0), myGroupGraph(0), myColoring(0),
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ theDOF_Array(0), numDOF_Array(-1), numSafeDOF_Grps(0), sizeDOF_Array(0)
 {
     theFEs     = new ArrayOfTaggedObjects(1024);
     theDOFs    =  new ArrayOfTaggedObjects(1024);
@@ -76,8 +117,9 @@ AnalysisModel::AnalysisModel(int theClassTag)
 AnalysisModel::AnalysisModel()
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
- myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ myDOFGraph(0), myGroupGraph(0), myColoring(0),
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ theDOF_Array(0), numDOF_Array(-1), numSafeDOF_Grps(0), sizeDOF_Array(0)
 {
   theFEs     = new ArrayOfTaggedObjects(256);
   theDOFs    = new ArrayOfTaggedObjects(256);
@@ -89,8 +131,9 @@ AnalysisModel::AnalysisModel()
 AnalysisModel::AnalysisModel(TaggedObjectStorage &theFes, TaggedObjectStorage &theDofs)
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
- myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ myDOFGraph(0), myGroupGraph(0), myColoring(0),
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ theDOF_Array(0), numDOF_Array(-1), numSafeDOF_Grps(0), sizeDOF_Array(0)
 {
   theFEs     = &theFes;
   theDOFs    = &theDofs;
@@ -118,6 +161,9 @@ AnalysisModel::~AnalysisModel()
   if (theDOFiter != 0)
     delete theDOFiter;
 
+  if (theDOF_Array != 0)
+    delete [] theDOF_Array;
+
   if (myGroupGraph != 0) {
     delete myGroupGraph;    
   }	
@@ -125,6 +171,9 @@ AnalysisModel::~AnalysisModel()
   if (myDOFGraph != 0) {
     delete myDOFGraph;
   }
+
+  if (myColoring != 0)
+    delete myColoring;
 }    
 
 void
@@ -159,6 +208,7 @@ AnalysisModel::addFE_Element(FE_Element *theElement)
   if (result == true) {
     theElement->setAnalysisModel(*this);
     numFE_Ele++;
+    this->clearElementColoring();
     return true;  // o.k.
   } else
     return false;
@@ -195,6 +245,7 @@ AnalysisModel::addDOF_Group(DOF_Group *theGroup)
   bool result = theDOFs->addComponent(theGroup);
   if (result == true) {
     numDOF_Grp++;
+    numDOF_Array = -1;
     return true;  // o.k.
   } else
     return false;
@@ -215,10 +266,12 @@ AnalysisModel::clearAll(void)
 
     myDOFGraph = 0;
     myGroupGraph = 0;
+    this->clearElementColoring();
     
     numFE_Ele =0;
     numDOF_Grp = 0;
     numEqn = 0;    
+    numDOF_Array = -1;
 }
 
 void
@@ -230,6 +283,15 @@ AnalysisModel::clearDOFGraph(void)
     myDOFGraph = 0;
 }
 
+void
+AnalysisModel::clearElementColoring(void) 
+{
+  if (myColoring != 0)
+    delete myColoring;
+
+  myColoring = 0;
+}
+
 void
 AnalysisModel::clearDOFGroupGraph(void) 
 {
@@ -279,6 +341,9 @@ void
 AnalysisModel::setNumEqn(int theNumEqn)
 {
     numEqn = theNumEqn;
+
+    // the equations have been numbered again
+    this->clearElementColoring();
 }
 
 int 
@@ -429,6 +494,26 @@ AnalysisModel::getDOFGroupGraph(void)
 }
 
 
+// the coloring of the FE_Elements is built when first asked for after
+// the FE_Elements are added or the equations numbered, and kept
+ElementColoring *
+AnalysisModel::getElementColoring(int method)
+{
+  if (myColoring != 0 && myColoring->getMethod() != method)
+    this->clearElementColoring();
+
+  if (myColoring == 0) {
+    myColoring = new ElementColoring(method);
+    if (myColoring == 0 || myColoring->color(*this) < 0) {
+      opserr << "WARNING AnalysisModel::getElementColoring - failed to color the FE_Elements\n";
+      this->clearElementColoring();
+    }
+  }
+
+  return myColoring;
+}
+
+
 
 
 void 
@@ -436,6 +521,9 @@ AnalysisModel::setResponse(const Vector &disp,
 			   const Vector &vel, 
 			   const Vector &accel)
 {
+    if (this->setNodeResponse(SET_DISP | SET_VEL | SET_ACCEL, &disp, &vel, &accel) == 0)
+	return;
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
@@ -449,6 +537,9 @@ AnalysisModel::setResponse(const Vector &disp,
 void 
 AnalysisModel::setDisp(const Vector &disp)
 {
+    if (this->setNodeResponse(SET_DISP, &disp, 0, 0) == 0)
+	return;
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
@@ -459,6 +550,9 @@ AnalysisModel::setDisp(const Vector &disp)
 void 
 AnalysisModel::setVel(const Vector &vel)
 {
+    if (this->setNodeResponse(SET_VEL, 0, &vel, 0) == 0)
+	return;
+
         DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
@@ -470,6 +564,9 @@ AnalysisModel::setVel(const Vector &vel)
 void 
 AnalysisModel::setAccel(const Vector &accel)
 {
+    if (this->setNodeResponse(SET_ACCEL, 0, 0, &accel) == 0)
+	return;
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
@@ -480,6 +577,9 @@ AnalysisModel::setAccel(const Vector &accel)
 void 
 AnalysisModel::incrDisp(const Vector &disp)
 {
+    if (this->setNodeResponse(INCR_DISP, &disp, 0, 0) == 0)
+	return;
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
@@ -490,6 +590,9 @@ AnalysisModel::incrDisp(const Vector &disp)
 void 
 AnalysisModel::incrVel(const Vector &vel)
 {
+    if (this->setNodeResponse(INCR_VEL, 0, &vel, 0) == 0)
+	return;
+
         DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
@@ -500,6 +603,9 @@ AnalysisModel::incrVel(const Vector &vel)
 void 
 AnalysisModel::incrAccel(const Vector &accel)
 {
+    if (this->setNodeResponse(INCR_ACCEL, 0, 0, &accel) == 0)
+	return;
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
@@ -508,6 +614,67 @@ AnalysisModel::incrAccel(const Vector &accel)
 }	
 
 
+// with a default ThreadPool the thread safe DOF_Groups set the response
+// at their nodes on its threads and the others on this thread; returns
+// -1 if the caller is to loop over the DOF_Groups itself
+int
+AnalysisModel::setNodeResponse(int what, const Vector *disp, 
+			       const Vector *vel, const Vector *accel)
+{
+    ThreadPool *thePool = ThreadPool::getDefault();
+    if (thePool == 0)
+	return -1;
+
+    // the DOF_Groups are placed in an array, the thread safe ones first
+    if (numDOF_Array < 0) {
+	DOF_GrpIter &theDOFGrps = this->getDOFs();
+	DOF_Group *dofPtr;
+	int numGroups = 0;
+	while ((dofPtr = theDOFGrps()) != 0) 
+	    numGroups++;
+
+	if (numGroups > sizeDOF_Array) {
+	    if (theDOF_Array != 0)
+		delete [] theDOF_Array;
+	    theDOF_Array = new DOF_Group *[numGroups];
+	    if (theDOF_Array == 0) {
+		opserr << "WARNING AnalysisModel::setNodeResponse() - out of memory\n";
+		sizeDOF_Array = 0;
+		return -1;
+	    }
+	    sizeDOF_Array = numGroups;
+	}
+
+	numSafeDOF_Grps = 0;
+	DOF_GrpIter &theSafeGrps = this->getDOFs();
+	while ((dofPtr = theSafeGrps()) != 0) 
+	    if (dofPtr->isThreadSafe() == true)
+		theDOF_Array[numSafeDOF_Grps++] = dofPtr;
+
+	int loc = numSafeDOF_Grps;
+	DOF_GrpIter &theOtherGrps = this->getDOFs();
+	while ((dofPtr = theOtherGrps()) != 0) 
+	    if (dofPtr->isThreadSafe() == false)
+		theDOF_Array[loc++] = dofPtr;
+
+	numDOF_Array = numGroups;
+    }
+
+    AnalysisModelTask theTask;
+    theTask.theDOFs = theDOF_Array;
+    theTask.what = what;
+    theTask.disp = disp;
+    theTask.vel = vel;
+    theTask.accel = accel;
+    thePool->parallelFor(numSafeDOF_Grps, setResponseTask, &theTask);
+
+    if (numDOF_Array > numSafeDOF_Grps)
+	setResponseTask(numSafeDOF_Grps, numDOF_Array, 0, &theTask);
+
+    return 0;
+}
+
+
 void 
 AnalysisModel::setNumEigenvectors(int numEigenvectors)
 {
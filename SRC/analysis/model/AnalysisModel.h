@@ -51,6 +51,7 @@ class DOF_Group;
 class Vector;
 class FEM_ObjectBroker;
 class ConstraintHandler;
+class ElementColoring;
 
 class AnalysisModel: public MovableObject
 {
@@ -79,6 +80,11 @@ class AnalysisModel: public MovableObject
     virtual int getNumEqn(void) const ; 
     virtual Graph &getDOFGraph(void);
     virtual Graph &getDOFGroupGraph(void);
+
+    // method to access the colors of the FE_Elements, used to add their
+    // contributions to the SysOfEqn on several threads
+    virtual ElementColoring *getElementColoring(int method);
+    virtual void clearElementColoring(void);
     
     // methods to update the response quantities at the DOF_Groups,
     // which in turn set the new nodal trial response quantities.
@@ -127,6 +133,7 @@ class AnalysisModel: public MovableObject
 
     Graph *myDOFGraph;
     Graph *myGroupGraph;    
+    ElementColoring *myColoring;
     
     int numFE_Ele;             // number of FE_Elements objects added
     int numDOF_Grp;            // number of DOF_Group objects added
@@ -137,6 +144,14 @@ class AnalysisModel: public MovableObject
     
     FE_EleIter    *theFEiter;     
     DOF_GrpIter   *theDOFiter;    
+
+    // the DOF_Groups handed to the threads of the default ThreadPool
+    int setNodeResponse(int what, const Vector *disp, 
+			const Vector *vel, const Vector *accel);
+    DOF_Group    **theDOF_Array;  // thread safe DOF_Groups first
+    int numDOF_Array;             // -1 if to be built again
+    int numSafeDOF_Grps;
+    int sizeDOF_Array;
 };
 
 #endif
@@ -616,6 +616,7 @@
 #define GraphNUMBERER_TAG_MyRCM   		3
 #define GraphNUMBERER_TAG_Metis   		4
 #define GraphNUMBERER_TAG_AMD   		5
+#define GraphNUMBERER_TAG_NestedDissection	6
 
 
 #define AnaMODEL_TAGS_AnalysisModel 	1
@@ -766,6 +767,8 @@
 #define OPS_STREAM_TAGS_TCP_Stream              8
 #define OPS_STREAM_TAGS_ChannelStream           9
 #define OPS_STREAM_TAGS_DataTurbineStream      10
+#define OPS_STREAM_TAGS_ColumnarFileStream     11
+#define OPS_STREAM_TAGS_AsyncStream            12
 
 
 #define DomDecompALGORITHM_TAGS_DomainDecompAlgo 1
@@ -0,0 +1,582 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/database/CheckpointDatastore.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class implementation for
+// CheckpointDatastore.
+//
+// What: "@(#) CheckpointDatastore.C, revA"
+
+#include <CheckpointDatastore.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <FEM_ObjectBroker.h>
+#include <Domain.h>
+#include <Message.h>
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+
+#define CHECKPOINT_FILE_MAGIC    "OPSCKPT1"
+#define CHECKPOINT_SEGMENT_MAGIC "OPSCKSEG"
+#define CHECKPOINT_FOOTER_MAGIC  "OPSCKIDX"
+
+typedef struct checkpointFileHeader {
+  char magic[8];
+  int version;
+  int sizeOfLong;
+} CheckpointFileHeader;
+
+typedef struct checkpointSegmentHeader {
+  char magic[8];
+  int commitTag;
+  int numEntries;
+  long payloadBytes;
+} CheckpointSegmentHeader;
+
+typedef struct checkpointSegmentFooter {
+  char magic[8];
+  int numEntries;
+  int unused;
+  long segmentStart;
+} CheckpointSegmentFooter;
+
+CheckpointDatastore::CheckpointDatastore(const char *name,
+					 Domain &theDomain,
+					 FEM_ObjectBroker &theObjBroker)
+  :FE_Datastore(theDomain, theObjBroker),
+   fileName(0), theFile(0), fileEnd(0), mappedData(0), mappedSize(0),
+   data(0), sizeData(0), maxSizeData(0),
+   numBytesWritten(0), numBytesSaved(0)
+{
+  fileName = new char[strlen(name)+1];
+  strcpy(fileName, name);
+
+  if (this->openFile() < 0) {
+    opserr << "CheckpointDatastore::CheckpointDatastore() - could not open file ";
+    opserr << fileName << endln;
+  }
+}
+
+CheckpointDatastore::~CheckpointDatastore()
+{
+  // anything sent since the last commitState
+  if (theFile != 0) {
+    this->writeSegment(-1);
+    fclose(theFile);
+  }
+
+  this->unmapFile();
+
+  if (data != 0)
+    delete [] data;
+  if (fileName != 0)
+    delete [] fileName;
+}
+
+long
+CheckpointDatastore::getNumBytesWritten(void)
+{
+  return numBytesWritten;
+}
+
+long
+CheckpointDatastore::getNumBytesSaved(void)
+{
+  return numBytesSaved;
+}
+
+int
+CheckpointDatastore::openFile(void)
+{
+  // a new file is given just the header
+  theFile = fopen(fileName, "r+b");
+  if (theFile == 0) {
+    theFile = fopen(fileName, "w+b");
+    if (theFile == 0)
+      return -1;
+
+    CheckpointFileHeader header;
+    memcpy(header.magic, CHECKPOINT_FILE_MAGIC, 8);
+    header.version = 1;
+    header.sizeOfLong = sizeof(long);
+    if (fwrite(&header, sizeof(CheckpointFileHeader), 1, theFile) != 1) {
+      fclose(theFile);
+      theFile = 0;
+      return -1;
+    }
+    fflush(theFile);
+
+    fileEnd = sizeof(CheckpointFileHeader);
+    return 0;
+  }
+
+  // an existing file is checked and its index read
+  if (this->mapFile() < 0 || mappedSize < (long)sizeof(CheckpointFileHeader)) {
+    opserr << "CheckpointDatastore::openFile() - could not read " << fileName << endln;
+    this->unmapFile();
+    fclose(theFile);
+    theFile = 0;
+    return -1;
+  }
+
+  CheckpointFileHeader header;
+  memcpy(&header, mappedData, sizeof(CheckpointFileHeader));
+  if (memcmp(header.magic, CHECKPOINT_FILE_MAGIC, 8) != 0 ||
+      header.sizeOfLong != (int)sizeof(long)) {
+    opserr << "CheckpointDatastore::openFile() - " << fileName;
+    opserr << " is not a checkpoint file written on this type of machine\n";
+    this->unmapFile();
+    fclose(theFile);
+    theFile = 0;
+    return -1;
+  }
+
+  return this->readSegments();
+}
+
+int
+CheckpointDatastore::readSegments(void)
+{
+  long location = sizeof(CheckpointFileHeader);
+
+  while (location + (long)sizeof(CheckpointSegmentHeader) <= mappedSize) {
+    CheckpointSegmentHeader header;
+    memcpy(&header, &mappedData[location], sizeof(CheckpointSegmentHeader));
+    if (memcmp(header.magic, CHECKPOINT_SEGMENT_MAGIC, 8) != 0 ||
+	header.numEntries < 0 || header.payloadBytes < 0)
+      break;
+
+    long indexStart = location + sizeof(CheckpointSegmentHeader) + header.payloadBytes;
+    long footerStart = indexStart + header.numEntries*(long)sizeof(CheckpointDatastoreEntry);
+    long segmentEnd = footerStart + sizeof(CheckpointSegmentFooter);
+    if (segmentEnd > mappedSize)
+      break;
+
+    CheckpointSegmentFooter footer;
+    memcpy(&footer, &mappedData[footerStart], sizeof(CheckpointSegmentFooter));
+    if (memcmp(footer.magic, CHECKPOINT_FOOTER_MAGIC, 8) != 0 ||
+	footer.numEntries != header.numEntries || footer.segmentStart != location)
+      break;
+
+    for (int i=0; i<header.numEntries; i++) {
+      CheckpointDatastoreEntry theEntry;
+      memcpy(&theEntry, &mappedData[indexStart + i*sizeof(CheckpointDatastoreEntry)],
+	     sizeof(CheckpointDatastoreEntry));
+
+      CheckpointDatastoreLocation theLocation;
+      theLocation.offset = theEntry.offset;
+      theLocation.numBytes = theEntry.numBytes;
+      theIndex[theEntry.key] = theLocation;
+
+      CheckpointDatastoreKey lastKey = theEntry.key;
+      lastKey.commitTag = 0;
+      theLastSent[lastKey] = theLocation;
+    }
+
+    location = segmentEnd;
+  }
+
+  fileEnd = location;
+
+  // drop what a crash left of a segment
+  if (fileEnd < mappedSize) {
+    opserr << "WARNING CheckpointDatastore - dropping " << (int)(mappedSize - fileEnd);
+    opserr << " bytes of an incomplete segment at the end of " << fileName << endln;
+    this->unmapFile();
+#ifndef _WIN32
+    if (ftruncate(fileno(theFile), fileEnd) != 0) {
+      opserr << "CheckpointDatastore::readSegments() - could not truncate ";
+      opserr << fileName << endln;
+      return -1;
+    }
+#endif
+    return this->mapFile();
+  }
+
+  return 0;
+}
+
+int
+CheckpointDatastore::mapFile(void)
+{
+  if (theFile == 0)
+    return -1;
+
+  fflush(theFile);
+
+  struct stat fileInfo;
+  if (fstat(fileno(theFile), &fileInfo) != 0)
+    return -1;
+
+  long size = fileInfo.st_size;
+  if (size == mappedSize && mappedData != 0)
+    return 0;
+
+  this->unmapFile();
+  if (size == 0)
+    return 0;
+
+#ifndef _WIN32
+  void *theMap = mmap(0, size, PROT_READ, MAP_SHARED, fileno(theFile), 0);
+  if (theMap == MAP_FAILED) {
+    opserr << "CheckpointDatastore::mapFile() - could not map " << fileName << endln;
+    return -1;
+  }
+  mappedData = (char *)theMap;
+#else
+  // without mmap the file is read into memory
+  mappedData = new char[size];
+  if (fseek(theFile, 0, SEEK_SET) != 0 ||
+      fread(mappedData, 1, size, theFile) != (size_t)size) {
+    opserr << "CheckpointDatastore::mapFile() - could not read " << fileName << endln;
+    delete [] mappedData;
+    mappedData = 0;
+    return -1;
+  }
+#endif
+
+  mappedSize = size;
+  return 0;
+}
+
+void
+CheckpointDatastore::unmapFile(void)
+{
+  if (mappedData != 0) {
+#ifndef _WIN32
+    munmap(mappedData, mappedSize);
+#else
+    delete [] mappedData;
+#endif
+  }
+
+  mappedData = 0;
+  mappedSize = 0;
+}
+
+int
+CheckpointDatastore::writeSegment(int commitTag)
+{
+  int numEntries = theSegmentEntries.size();
+  if (numEntries == 0 || theFile == 0)
+    return 0;
+
+  CheckpointSegmentHeader header;
+  memcpy(header.magic, CHECKPOINT_SEGMENT_MAGIC, 8);
+  header.commitTag = commitTag;
+  header.numEntries = numEntries;
+  header.payloadBytes = sizeData;
+
+  CheckpointSegmentFooter footer;
+  memcpy(footer.magic, CHECKPOINT_FOOTER_MAGIC, 8);
+  footer.numEntries = numEntries;
+  footer.unused = 0;
+  footer.segmentStart = fileEnd;
+
+  // the segment goes to the end of the file in one sequential write
+  bool ok = (fseek(theFile, fileEnd, SEEK_SET) == 0);
+  ok = ok && fwrite(&header, sizeof(CheckpointSegmentHeader), 1, theFile) == 1;
+  ok = ok && (sizeData == 0 || fwrite(data, sizeData, 1, theFile) == 1);
+  ok = ok && fwrite(&theSegmentEntries[0], sizeof(CheckpointDatastoreEntry),
+		    numEntries, theFile) == (size_t)numEntries;
+  ok = ok && fwrite(&footer, sizeof(CheckpointSegmentFooter), 1, theFile) == 1;
+  ok = ok && fflush(theFile) == 0;
+
+  if (ok == false) {
+    opserr << "CheckpointDatastore::writeSegment() - failed to write commitTag ";
+    opserr << commitTag << " to " << fileName << endln;
+    return -1;
+  }
+
+  long numBytes = sizeof(CheckpointSegmentHeader) + sizeData +
+    numEntries*(long)sizeof(CheckpointDatastoreEntry) + sizeof(CheckpointSegmentFooter);
+  fileEnd += numBytes;
+  numBytesWritten += numBytes;
+
+  sizeData = 0;
+  theSegmentEntries.clear();
+
+  return 0;
+}
+
+const char *
+CheckpointDatastore::getBytes(long offset, int numBytes)
+{
+  // bytes of the segment not yet written
+  long payloadStart = fileEnd + sizeof(CheckpointSegmentHeader);
+  if (offset >= payloadStart)
+    return &data[offset - payloadStart];
+
+  if (offset + numBytes <= mappedSize)
+    return &mappedData[offset];
+
+  return 0;
+}
+
+int
+CheckpointDatastore::store(int type, int dbTag, int commitTag, int size,
+			   const void *theData, int numBytes)
+{
+  if (theFile == 0) {
+    opserr << "CheckpointDatastore::store() - no file open\n";
+    return -1;
+  }
+
+  CheckpointDatastoreKey key;
+  key.type = type;
+  key.dbTag = dbTag;
+  key.commitTag = commitTag;
+  key.size = size;
+
+  CheckpointDatastoreKey lastKey = key;
+  lastKey.commitTag = 0;
+
+  CheckpointDatastoreLocation theLocation;
+  theLocation.offset = -1;
+  theLocation.numBytes = numBytes;
+
+  // bytes the same as those last sent are not written again
+  MAP_CHECKPOINT_ITERATOR theLast = theLastSent.find(lastKey);
+  if (theLast != theLastSent.end() && (theLast->second).numBytes == numBytes) {
+    const char *lastData = this->getBytes((theLast->second).offset, numBytes);
+    if (lastData != 0 && (numBytes == 0 || memcmp(lastData, theData, numBytes) == 0)) {
+      theLocation.offset = (theLast->second).offset;
+      numBytesSaved += numBytes;
+    }
+  }
+
+  if (theLocation.offset < 0) {
+    if (sizeData + numBytes > maxSizeData) {
+      int newMaxSize = 2*maxSizeData;
+      if (newMaxSize < sizeData + numBytes)
+	newMaxSize = sizeData + numBytes;
+      if (newMaxSize < 1024)
+	newMaxSize = 1024;
+
+      char *newData = new char[newMaxSize];
+      if (newData == 0) {
+	opserr << "CheckpointDatastore::store() - out of memory for " << newMaxSize << " bytes\n";
+	return -1;
+      }
+      if (data != 0) {
+	memcpy(newData, data, sizeData);
+	delete [] data;
+      }
+      data = newData;
+      maxSizeData = newMaxSize;
+    }
+
+    theLocation.offset = fileEnd + sizeof(CheckpointSegmentHeader) + sizeData;
+    if (numBytes != 0)
+      memcpy(&data[sizeData], theData, numBytes);
+    sizeData += numBytes;
+  }
+
+  theIndex[key] = theLocation;
+  theLastSent[lastKey] = theLocation;
+
+  CheckpointDatastoreEntry theEntry;
+  theEntry.key = key;
+  theEntry.offset = theLocation.offset;
+  theEntry.numBytes = numBytes;
+  theEntry.unused = 0;
+  theSegmentEntries.push_back(theEntry);
+
+  return 0;
+}
+
+const char *
+CheckpointDatastore::find(int type, int dbTag, int commitTag, int size, int &numBytes)
+{
+  CheckpointDatastoreKey key;
+  key.type = type;
+  key.dbTag = dbTag;
+  key.commitTag = commitTag;
+  key.size = size;
+
+  MAP_CHECKPOINT_ITERATOR theEntry = theIndex.find(key);
+  if (theEntry == theIndex.end())
+    return 0;
+
+  numBytes = (theEntry->second).numBytes;
+  long offset = (theEntry->second).offset;
+
+  const char *theData = this->getBytes(offset, numBytes);
+  if (theData == 0 && this->mapFile() == 0)
+    theData = this->getBytes(offset, numBytes);
+
+  return theData;
+}
+
+int
+CheckpointDatastore::commitState(int commitTag)
+{
+#ifndef _WIN32
+  // so that the bytes of the earlier segments can be compared with those sent
+  this->mapFile();
+#endif
+
+  int result = FE_Datastore::commitState(commitTag);
+
+  if (this->writeSegment(commitTag) < 0)
+    return -1;
+
+  return result;
+}
+
+int
+CheckpointDatastore::restoreState(int commitTag)
+{
+  if (this->mapFile() < 0)
+    return -1;
+
+  return FE_Datastore::restoreState(commitTag);
+}
+
+int
+CheckpointDatastore::sendMsg(int dataTag, int commitTag,
+			     const Message &theMessage,
+			     ChannelAddress *theAddress)
+{
+  return this->store(CHECKPOINT_DATASTORE_MSG, dataTag, commitTag, 0,
+		     theMessage.data, theMessage.length);
+}
+
+int
+CheckpointDatastore::recvMsg(int dataTag, int commitTag,
+			     Message &theMessage,
+			     ChannelAddress *theAddress)
+{
+  int numBytes = 0;
+  const char *theData = this->find(CHECKPOINT_DATASTORE_MSG, dataTag, commitTag, 0,
+				   numBytes);
+  if (theData == 0 || numBytes != theMessage.length)
+    return -1;
+
+  memcpy(theMessage.data, theData, numBytes);
+  return 0;
+}
+
+int
+CheckpointDatastore::recvMsgUnknownSize(int dataTag, int commitTag,
+					Message &theMessage,
+					ChannelAddress *theAddress)
+{
+  int numBytes = 0;
+  const char *theData = this->find(CHECKPOINT_DATASTORE_MSG, dataTag, commitTag, 0,
+				   numBytes);
+  if (theData == 0)
+    return -1;
+
+  // the message has to be big enough for what was sent
+  if (numBytes > theMessage.length) {
+    opserr << "CheckpointDatastore::recvMsgUnknownSize() - message too small for the ";
+    opserr << numBytes << " bytes stored\n";
+    return -1;
+  }
+
+  memcpy(theMessage.data, theData, numBytes);
+  return 0;
+}
+
+int
+CheckpointDatastore::sendMatrix(int dataTag, int commitTag,
+				const Matrix &theMatrix,
+				ChannelAddress *theAddress)
+{
+  return this->store(CHECKPOINT_DATASTORE_MATRIX, dataTag, commitTag, theMatrix.dataSize,
+		     theMatrix.data, theMatrix.dataSize*sizeof(double));
+}
+
+int
+CheckpointDatastore::recvMatrix(int dataTag, int commitTag,
+				Matrix &theMatrix,
+				ChannelAddress *theAddress)
+{
+  int numBytes = 0;
+  const char *theData = this->find(CHECKPOINT_DATASTORE_MATRIX, dataTag, commitTag,
+				   theMatrix.dataSize, numBytes);
+  if (theData == 0 || numBytes != theMatrix.dataSize*(int)sizeof(double))
+    return -1;
+
+  memcpy(theMatrix.data, theData, numBytes);
+  return 0;
+}
+
+int
+CheckpointDatastore::sendVector(int dataTag, int commitTag,
+				const Vector &theVector,
+				ChannelAddress *theAddress)
+{
+  return this->store(CHECKPOINT_DATASTORE_VECTOR, dataTag, commitTag, theVector.sz,
+		     theVector.theData, theVector.sz*sizeof(double));
+}
+
+int
+CheckpointDatastore::recvVector(int dataTag, int commitTag,
+				Vector &theVector,
+				ChannelAddress *theAddress)
+{
+  int numBytes = 0;
+  const char *theData = this->find(CHECKPOINT_DATASTORE_VECTOR, dataTag, commitTag,
+				   theVector.sz, numBytes);
+  if (theData == 0 || numBytes != theVector.sz*(int)sizeof(double))
+    return -1;
+
+  memcpy(theVector.theData, theData, numBytes);
+  return 0;
+}
+
+int
+CheckpointDatastore::sendID(int dataTag, int commitTag,
+			    const ID &theID,
+			    ChannelAddress *theAddress)
+{
+  return this->store(CHECKPOINT_DATASTORE_ID, dataTag, commitTag, theID.sz,
+		     theID.data, theID.sz*sizeof(int));
+}
+
+int
+CheckpointDatastore::recvID(int dataTag, int commitTag,
+			    ID &theID,
+			    ChannelAddress *theAddress)
+{
+  int numBytes = 0;
+  const char *theData = this->find(CHECKPOINT_DATASTORE_ID, dataTag, commitTag,
+				   theID.sz, numBytes);
+  if (theData == 0 || numBytes != theID.sz*(int)sizeof(int))
+    return -1;
+
+  memcpy(theID.data, theData, numBytes);
+  return 0;
+}
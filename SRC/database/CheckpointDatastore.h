@@ -0,0 +1,174 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// $Source: /usr/local/cvs/OpenSees/SRC/database/CheckpointDatastore.h,v $
+
+#ifndef CheckpointDatastore_h
+#define CheckpointDatastore_h
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for 
+// CheckpointDatastore. CheckpointDatastore is a concrete subclass of 
+// FE_Datastore. A CheckpointDatastore object is used in the program to 
+// store/restore the geometry and state information in a domain at a 
+// particular instance in the analysis. Unlike the FileDatastore, which
+// seeks to a fixed place in a file per size of object, each commitState()
+// appends one segment to a single binary file:
+//
+//   segment header: magic, commitTag, number of entries, payload bytes
+//   payload:        the bytes of the objects sent
+//   index:          type, dbTag, commitTag, size, file offset and bytes
+//                   of every object sent during the commitState()
+//   footer:         magic, number of entries, offset of the segment
+//
+// An object whose bytes are the same as when it was last sent (same type,
+// dbTag and size) is not written again, its index entry refers to the old
+// bytes, so a segment only holds what has changed since the last commit.
+// The file is mapped into memory to restore a state. When an existing 
+// file is opened the index is rebuilt from its segments and new segments
+// are appended; a segment left incomplete by a crash is dropped.
+//
+// What: "@(#) CheckpointDatastore.h, revA"
+
+#include <FE_Datastore.h>
+
+#include <stdio.h>
+#include <map>
+#include <vector>
+using std::map;
+using std::vector;
+
+#define CHECKPOINT_DATASTORE_MSG    0
+#define CHECKPOINT_DATASTORE_MATRIX 1
+#define CHECKPOINT_DATASTORE_VECTOR 2
+#define CHECKPOINT_DATASTORE_ID     3
+
+typedef struct checkpointDatastoreKey {
+  int type;
+  int dbTag;
+  int commitTag;
+  int size;
+  bool operator<(const struct checkpointDatastoreKey &other) const {
+    if (type != other.type) return type < other.type;
+    if (dbTag != other.dbTag) return dbTag < other.dbTag;
+    if (commitTag != other.commitTag) return commitTag < other.commitTag;
+    return size < other.size;
+  }
+} CheckpointDatastoreKey;
+
+// an entry of the index, as stored in the file
+typedef struct checkpointDatastoreEntry {
+  CheckpointDatastoreKey key;
+  long offset;        // location of the bytes in the file
+  int numBytes;
+  int unused;
+} CheckpointDatastoreEntry;
+
+typedef struct checkpointDatastoreLocation {
+  long offset;
+  int numBytes;
+} CheckpointDatastoreLocation;
+
+typedef map<CheckpointDatastoreKey, CheckpointDatastoreLocation> MAP_CHECKPOINT;
+typedef MAP_CHECKPOINT::value_type                               MAP_CHECKPOINT_TYPE;
+typedef MAP_CHECKPOINT::iterator                                 MAP_CHECKPOINT_ITERATOR;
+
+class CheckpointDatastore: public FE_Datastore
+{
+  public:
+    CheckpointDatastore(const char *fileName,
+			Domain &theDomain, 
+			FEM_ObjectBroker &theBroker);    
+    ~CheckpointDatastore();
+
+    // methods for sending and receiving the data
+    int sendMsg(int dbTag, int commitTag, 
+		const Message &, 
+		ChannelAddress *theAddress =0);    
+    int recvMsg(int dbTag, int commitTag, 
+		Message &, 
+		ChannelAddress *theAddress =0);        
+    int recvMsgUnknownSize(int dbTag, int commitTag, 
+		Message &, 
+		ChannelAddress *theAddress =0);        
+
+    int sendMatrix(int dbTag, int commitTag, 
+		   const Matrix &theMatrix, 
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag, 
+		   Matrix &theMatrix, 
+		   ChannelAddress *theAddress =0);
+    
+    int sendVector(int dbTag, int commitTag, 
+		   const Vector &theVector, 
+		   ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag, 
+		   Vector &theVector, 
+		   ChannelAddress *theAddress =0);
+    
+    int sendID(int dbTag, int commitTag,
+	       const ID &theID,
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag,
+	       ID &theID,
+	       ChannelAddress *theAddress =0);
+
+    int commitState(int commitTag);        
+    int restoreState(int commitTag);        
+
+    // bytes written to, and saved by not writing, the file so far
+    long getNumBytesWritten(void);
+    long getNumBytesSaved(void);
+    
+  protected:
+
+  private:
+    int openFile(void);
+    int readSegments(void);
+    int mapFile(void);
+    void unmapFile(void);
+    int writeSegment(int commitTag);
+    int store(int type, int dbTag, int commitTag, int size,
+	      const void *theData, int numBytes);
+    const char *find(int type, int dbTag, int commitTag, int size, 
+		     int &numBytes);
+    const char *getBytes(long offset, int numBytes);
+
+    char *fileName;
+    FILE *theFile;
+    long fileEnd;              // end of the last complete segment
+
+    char *mappedData;          // the file up to mappedSize
+    long mappedSize;
+
+    char *data;                // payload of the segment being formed
+    int sizeData;
+    int maxSizeData;
+    vector<CheckpointDatastoreEntry> theSegmentEntries;
+
+    MAP_CHECKPOINT theIndex;   // every object in the file
+    MAP_CHECKPOINT theLastSent; // last bytes of each type, dbTag and size
+
+    long numBytesWritten;
+    long numBytesSaved;
+};
+
+#endif
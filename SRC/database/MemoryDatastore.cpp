@@ -0,0 +1,257 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/database/MemoryDatastore.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class implementation for 
+// MemoryDatastore.
+//
+// What: "@(#) MemoryDatastore.C, revA"
+
+#include <MemoryDatastore.h>
+
+#include <string.h>
+
+#include <FEM_ObjectBroker.h>
+#include <Domain.h>
+#include <Message.h>
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+
+MemoryDatastore::MemoryDatastore(Domain &theDomain, 
+				 FEM_ObjectBroker &theObjBroker) 
+  :FE_Datastore(theDomain, theObjBroker), 
+   data(0), sizeData(0), maxSizeData(0)
+{
+
+}
+
+MemoryDatastore::~MemoryDatastore() 
+{
+  if (data != 0)
+    delete [] data;
+}
+
+int
+MemoryDatastore::getNumBytes(void)
+{
+  return sizeData;
+}
+
+void
+MemoryDatastore::clear(void)
+{
+  theEntries.clear();
+  sizeData = 0;
+}
+
+int
+MemoryDatastore::store(int type, int dbTag, int commitTag, int size,
+		       const void *theData, int numBytes)
+{
+  MemoryDatastoreKey key;
+  key.type = type;
+  key.dbTag = dbTag;
+  key.commitTag = commitTag;
+  key.size = size;
+
+  // data sent before with the same key is replaced in place
+  MAP_MEMORY_ITERATOR theEntry = theEntries.find(key);
+  if (theEntry != theEntries.end() && (theEntry->second).numBytes == numBytes) {
+    if (numBytes != 0)
+      memcpy(&data[(theEntry->second).location], theData, numBytes);
+    return 0;
+  }
+
+  if (sizeData + numBytes > maxSizeData) {
+    int newMaxSize = 2*maxSizeData;
+    if (newMaxSize < sizeData + numBytes)
+      newMaxSize = sizeData + numBytes;
+    if (newMaxSize < 1024)
+      newMaxSize = 1024;
+
+    char *newData = new char[newMaxSize];
+    if (newData == 0) {
+      opserr << "MemoryDatastore::store() - out of memory for " << newMaxSize << " bytes\n";
+      return -1;
+    }
+    if (data != 0) {
+      memcpy(newData, data, sizeData);
+      delete [] data;
+    }
+    data = newData;
+    maxSizeData = newMaxSize;
+  }
+
+  MemoryDatastoreEntry newEntry;
+  newEntry.location = sizeData;
+  newEntry.numBytes = numBytes;
+  if (numBytes != 0)
+    memcpy(&data[sizeData], theData, numBytes);
+  sizeData += numBytes;
+
+  if (theEntry != theEntries.end())
+    theEntry->second = newEntry;
+  else
+    theEntries.insert(MAP_MEMORY_TYPE(key, newEntry));
+
+  return 0;
+}
+
+const char *
+MemoryDatastore::find(int type, int dbTag, int commitTag, int size, int numBytes)
+{
+  MemoryDatastoreKey key;
+  key.type = type;
+  key.dbTag = dbTag;
+  key.commitTag = commitTag;
+  key.size = size;
+
+  MAP_MEMORY_ITERATOR theEntry = theEntries.find(key);
+  if (theEntry == theEntries.end() || (theEntry->second).numBytes != numBytes)
+    return 0;
+
+  return &data[(theEntry->second).location];
+}
+
+int 
+MemoryDatastore::sendMsg(int dataTag, int commitTag, 
+			 const Message &theMessage, 
+			 ChannelAddress *theAddress)
+{
+  return this->store(MEMORY_DATASTORE_MSG, dataTag, commitTag, 0, 
+		     theMessage.data, theMessage.length);
+}		       
+
+int 
+MemoryDatastore::recvMsg(int dataTag, int commitTag, 
+			 Message &theMessage, 
+			 ChannelAddress *theAddress)
+{
+  const char *theData = this->find(MEMORY_DATASTORE_MSG, dataTag, commitTag, 0,
+				   theMessage.length);
+  if (theData == 0)
+    return -1;
+
+  memcpy(theMessage.data, theData, theMessage.length);
+  return 0;
+}		       
+
+int 
+MemoryDatastore::recvMsgUnknownSize(int dataTag, int commitTag, 
+				    Message &theMessage, 
+				    ChannelAddress *theAddress)
+{
+  MemoryDatastoreKey key;
+  key.type = MEMORY_DATASTORE_MSG;
+  key.dbTag = dataTag;
+  key.commitTag = commitTag;
+  key.size = 0;
+
+  MAP_MEMORY_ITERATOR theEntry = theEntries.find(key);
+  if (theEntry == theEntries.end())
+    return -1;
+
+  // the message has to be big enough for what was sent
+  int numBytes = (theEntry->second).numBytes;
+  if (numBytes > theMessage.length) {
+    opserr << "MemoryDatastore::recvMsgUnknownSize() - message too small for the ";
+    opserr << numBytes << " bytes stored\n";
+    return -1;
+  }
+
+  memcpy(theMessage.data, &data[(theEntry->second).location], numBytes);
+  return 0;
+}		       
+
+int 
+MemoryDatastore::sendMatrix(int dataTag, int commitTag, 
+			    const Matrix &theMatrix, 
+			    ChannelAddress *theAddress)
+{
+  return this->store(MEMORY_DATASTORE_MATRIX, dataTag, commitTag, theMatrix.dataSize,
+		     theMatrix.data, theMatrix.dataSize*sizeof(double));
+}		       
+
+int 
+MemoryDatastore::recvMatrix(int dataTag, int commitTag, 
+			    Matrix &theMatrix, 
+			    ChannelAddress *theAddress)
+{
+  int numBytes = theMatrix.dataSize*sizeof(double);
+  const char *theData = this->find(MEMORY_DATASTORE_MATRIX, dataTag, commitTag, 
+				   theMatrix.dataSize, numBytes);
+  if (theData == 0)
+    return -1;
+
+  memcpy(theMatrix.data, theData, numBytes);
+  return 0;
+}		       
+
+int 
+MemoryDatastore::sendVector(int dataTag, int commitTag, 
+			    const Vector &theVector, 
+			    ChannelAddress *theAddress)
+{
+  return this->store(MEMORY_DATASTORE_VECTOR, dataTag, commitTag, theVector.sz,
+		     theVector.theData, theVector.sz*sizeof(double));
+}		       
+
+int 
+MemoryDatastore::recvVector(int dataTag, int commitTag, 
+			    Vector &theVector, 
+			    ChannelAddress *theAddress)
+{
+  int numBytes = theVector.sz*sizeof(double);
+  const char *theData = this->find(MEMORY_DATASTORE_VECTOR, dataTag, commitTag, 
+				   theVector.sz, numBytes);
+  if (theData == 0)
+    return -1;
+
+  memcpy(theVector.theData, theData, numBytes);
+  return 0;
+}		       
+
+int 
+MemoryDatastore::sendID(int dataTag, int commitTag, 
+			const ID &theID, 
+			ChannelAddress *theAddress)
+{
+  return this->store(MEMORY_DATASTORE_ID, dataTag, commitTag, theID.sz,
+		     theID.data, theID.sz*sizeof(int));
+}		       
+
+int 
+MemoryDatastore::recvID(int dataTag, int commitTag, 
+			ID &theID, 
+			ChannelAddress *theAddress)
+{
+  int numBytes = theID.sz*sizeof(int);
+  const char *theData = this->find(MEMORY_DATASTORE_ID, dataTag, commitTag, 
+				   theID.sz, numBytes);
+  if (theData == 0)
+    return -1;
+
+  memcpy(theID.data, theData, numBytes);
+  return 0;
+}
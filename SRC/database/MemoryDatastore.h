@@ -0,0 +1,130 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/database/MemoryDatastore.h,v $
+
+#ifndef MemoryDatastore_h
+#define MemoryDatastore_h
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for MemoryDatastore.
+// MemoryDatastore is a concrete subclass of FE_Datastore. A MemoryDatastore
+// object is used in the program to store/restore the geometry and state
+// information in a domain at a particular instance in the analysis. The
+// information is kept in memory as binary data, so that a domain can be
+// put back in the state it was committed in many times over without
+// rebuilding it, as done for each realization in a simulation.
+//
+// As for the FileDatastore, an object stored again with the same dbTag,
+// commitTag and size replaces the old data in place.
+//
+// What: "@(#) MemoryDatastore.h, revA"
+
+#include <FE_Datastore.h>
+
+#include <map>
+using std::map;
+
+#define MEMORY_DATASTORE_MSG    0
+#define MEMORY_DATASTORE_MATRIX 1
+#define MEMORY_DATASTORE_VECTOR 2
+#define MEMORY_DATASTORE_ID     3
+
+typedef struct memoryDatastoreKey {
+  int type;
+  int dbTag;
+  int commitTag;
+  int size;
+  bool operator<(const struct memoryDatastoreKey &other) const {
+    if (type != other.type) return type < other.type;
+    if (dbTag != other.dbTag) return dbTag < other.dbTag;
+    if (commitTag != other.commitTag) return commitTag < other.commitTag;
+    return size < other.size;
+  }
+} MemoryDatastoreKey;
+
+typedef struct memoryDatastoreEntry {
+  int location;   // offset into the data, in bytes
+  int numBytes;
+} MemoryDatastoreEntry;
+
+typedef map<MemoryDatastoreKey, MemoryDatastoreEntry> MAP_MEMORY;
+typedef MAP_MEMORY::value_type                        MAP_MEMORY_TYPE;
+typedef MAP_MEMORY::iterator                          MAP_MEMORY_ITERATOR;
+
+class MemoryDatastore: public FE_Datastore
+{
+  public:
+    MemoryDatastore(Domain &theDomain, 
+		    FEM_ObjectBroker &theBroker);    
+    ~MemoryDatastore();
+
+    // methods for sending and receiving the data
+    int sendMsg(int dbTag, int commitTag, 
+		const Message &, 
+		ChannelAddress *theAddress =0);    
+    int recvMsg(int dbTag, int commitTag, 
+		Message &, 
+		ChannelAddress *theAddress =0);        
+    int recvMsgUnknownSize(int dbTag, int commitTag, 
+		Message &, 
+		ChannelAddress *theAddress =0);        
+
+    int sendMatrix(int dbTag, int commitTag, 
+		   const Matrix &theMatrix, 
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag, 
+		   Matrix &theMatrix, 
+		   ChannelAddress *theAddress =0);
+    
+    int sendVector(int dbTag, int commitTag, 
+		   const Vector &theVector, 
+		   ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag, 
+		   Vector &theVector, 
+		   ChannelAddress *theAddress =0);
+    
+    int sendID(int dbTag, int commitTag,
+	       const ID &theID,
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag,
+	       ID &theID,
+	       ChannelAddress *theAddress =0);
+
+    // number of bytes of data held
+    int getNumBytes(void);
+    void clear(void);
+    
+  protected:
+
+  private:
+    int store(int type, int dbTag, int commitTag, int size,
+	      const void *theData, int numBytes);
+    const char *find(int type, int dbTag, int commitTag, int size, 
+		     int numBytes);
+
+    MAP_MEMORY theEntries;
+    char *data;
+    int sizeData;
+    int maxSizeData;
+};
+
+#endif
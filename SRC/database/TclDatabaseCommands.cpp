@@ -46,6 +46,8 @@
 
 // known databases
 #include <FileDatastore.h>
+#include <MemoryDatastore.h>
+#include <CheckpointDatastore.h>
 
 // linked list of struct for other types of
 // databases that can be added dynamically
@@ -96,7 +98,7 @@ TclAddDatabase(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **a
 
   // make sure at least one other argument to contain integrator
   if (argc < 2) {
-    opserr << "WARNING need to specify a Database type; valid type File, MySQL, BerkeleyDB \n";
+    opserr << "WARNING need to specify a Database type; valid type File, Memory, Checkpoint, MySQL, BerkeleyDB \n";
     return TCL_ERROR;
   }    
 
@@ -123,6 +125,40 @@ TclAddDatabase(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **a
       return TCL_ERROR;
     } 
     
+    return TCL_OK;
+
+  // a Memory Database, kept in memory for the life of the program
+  } else if (strcmp(argv[1],"Memory") == 0) {
+
+    // delete the old database
+    if (theDatabase != 0)
+      delete theDatabase;
+
+    theDatabase = new MemoryDatastore(theDomain, theBroker);
+    if (theDatabase == 0) {
+      opserr << "WARNING ran out of memory - database Memory\n";
+      return TCL_ERROR;
+    } 
+    
+    return TCL_OK;
+
+  // a Checkpoint Database, each save appended to a single file
+  } else if (strcmp(argv[1],"Checkpoint") == 0) {
+    if (argc < 3) {
+      opserr << "WARNING database Checkpoint fileName? ";
+      return TCL_ERROR;
+    }    
+
+    // delete the old database
+    if (theDatabase != 0)
+      delete theDatabase;
+
+    theDatabase = new CheckpointDatastore(argv[2], theDomain, theBroker);
+    if (theDatabase == 0) {
+      opserr << "WARNING ran out of memory - database Checkpoint " << argv[2] << endln;
+      return TCL_ERROR;
+    } 
+    
     return TCL_OK;
   } else {
 
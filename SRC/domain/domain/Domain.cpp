@@ -50,6 +50,8 @@
 #include <ElementalLoad.h>
 #include <LoadPattern.h>
 #include <Parameter.h>
+#include <NodeStateStore.h>
+#include <ThreadPool.h>
 
 #include <MapOfTaggedObjects.h>
 #include <MapOfTaggedObjectsIter.h>
@@ -72,6 +74,56 @@
 
 Domain       *ops_TheActiveDomain = 0;
 
+struct DomainTask {
+  Element **theElements;
+  Node **theNodes;
+  int results[OPS_MAX_THREADS];
+};
+
+// the functions invoked by the threads of the default pool on a range
+// of the thread safe elements, or of the nodes
+static void
+updateElementsTask(int start, int end, int threadID, void *data)
+{
+  DomainTask *theTask = (DomainTask *)data;
+  int ok = 0;
+  for (int i=start; i<end; i++)
+    ok += theTask->theElements[i]->update();
+  theTask->results[threadID] += ok;
+}
+
+static void
+commitElementsTask(int start, int end, int threadID, void *data)
+{
+  DomainTask *theTask = (DomainTask *)data;
+  for (int i=start; i<end; i++)
+    theTask->theElements[i]->commitState();
+}
+
+static void
+revertElementsTask(int start, int end, int threadID, void *data)
+{
+  DomainTask *theTask = (DomainTask *)data;
+  for (int i=start; i<end; i++)
+    theTask->theElements[i]->revertToLastCommit();
+}
+
+static void
+commitNodesTask(int start, int end, int threadID, void *data)
+{
+  DomainTask *theTask = (DomainTask *)data;
+  for (int i=start; i<end; i++)
+    theTask->theNodes[i]->commitState();
+}
+
+static void
+revertNodesTask(int start, int end, int threadID, void *data)
+{
+  DomainTask *theTask = (DomainTask *)data;
+  for (int i=start; i<end; i++)
+    theTask->theNodes[i]->revertToLastCommit();
+}
+
 Domain::Domain()
 :theRecorders(0), numRecorders(0),
  currentTime(0.0), committedTime(0.0), dT(0.0), currentGeoTag(0),
@@ -80,7 +132,10 @@ Domain::Domain()
  eleGraphBuiltFlag(false),  nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0), 
  theRegions(0), numRegions(0), commitTag(0),
- theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), lastChannel(0)
+ theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), lastChannel(0),
+ theNodeStateStore(0), nodeStateStoreTag(-1),
+ theElementArray(0), numElementArray(0), sizeElementArray(0), numSafeElements(0),
+ theNodeArray(0), numNodeArray(0), sizeNodeArray(0), componentArrayTag(-1)
 {
   
     // init the arrays for storing the domain components
@@ -130,7 +185,10 @@ Domain::Domain(int numNodes, int numElements, int numSPs, int numMPs,
  eleGraphBuiltFlag(false), nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0),
  theRegions(0), numRegions(0), commitTag(0),
- theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), lastChannel(0)
+ theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), lastChannel(0),
+ theNodeStateStore(0), nodeStateStoreTag(-1),
+ theElementArray(0), numElementArray(0), sizeElementArray(0), numSafeElements(0),
+ theNodeArray(0), numNodeArray(0), sizeNodeArray(0), componentArrayTag(-1)
 {
     // init the arrays for storing the domain components
     theElements = new MapOfTaggedObjects();
@@ -186,7 +244,10 @@ Domain::Domain(TaggedObjectStorage &theNodesStorage,
  theMPs(&theMPsStorage), 
  theLoadPatterns(&theLoadPatternsStorage),
  theRegions(0), numRegions(0), commitTag(0),
- theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), lastChannel(0)
+ theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), lastChannel(0),
+ theNodeStateStore(0), nodeStateStoreTag(-1),
+ theElementArray(0), numElementArray(0), sizeElementArray(0), numSafeElements(0),
+ theNodeArray(0), numNodeArray(0), sizeNodeArray(0), componentArrayTag(-1)
 {
     // init the iters    
     theEleIter = new SingleDomEleIter(theElements);    
@@ -238,7 +299,10 @@ Domain::Domain(TaggedObjectStorage &theStorage)
  eleGraphBuiltFlag(false), nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0), 
  theRegions(0), numRegions(0), commitTag(0),
- theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), lastChannel(0)
+ theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), lastChannel(0),
+ theNodeStateStore(0), nodeStateStoreTag(-1),
+ theElementArray(0), numElementArray(0), sizeElementArray(0), numSafeElements(0),
+ theNodeArray(0), numNodeArray(0), sizeNodeArray(0), componentArrayTag(-1)
 {
     // init the arrays for storing the domain components
     theStorage.clearAll(); // clear the storage just in case populated
@@ -313,6 +377,15 @@ Domain::~Domain()
 
   if (theParameters != 0)
     delete theParameters;
+
+  if (theNodeStateStore != 0)
+    delete theNodeStateStore;
+
+  if (theElementArray != 0)
+    delete [] theElementArray;
+
+  if (theNodeArray != 0)
+    delete [] theNodeArray;
   
   if (theEleIter != 0)
     delete theEleIter;
@@ -807,6 +880,11 @@ Domain::clearAll(void) {
   // clean out the containers
   theElements->clearAll();
   theNodes->clearAll();
+  if (theNodeStateStore != 0) {
+    theNodeStateStore->clearAll();
+    nodeStateStoreTag = -1;
+  }
+  componentArrayTag = -1;
   theSPs->clearAll();
   theMPs->clearAll();
   theLoadPatterns->clearAll();
@@ -879,6 +957,83 @@ Domain::clearAll(void) {
 }
 
 
+// int setStorage(TaggedObjectStorage &theStorage);
+//	Method to change the type of container used for the components of 
+//	an empty domain, as the Domain(TaggedObjectStorage &) constructor
+//	does. theStorage must have been created with new, the domain takes 
+//	it over for the elements and uses empty copies for the others.
+
+int
+Domain::setStorage(TaggedObjectStorage &theStorage)
+{
+  if (theElements->getNumComponents() != 0 || theNodes->getNumComponents() != 0 ||
+      theSPs->getNumComponents() != 0 || theMPs->getNumComponents() != 0 ||
+      theLoadPatterns->getNumComponents() != 0 || 
+      theParameters->getNumComponents() != 0) {
+    opserr << "Domain::setStorage() - domain is not empty\n";
+    return -1;
+  }
+
+  theStorage.clearAll();
+  TaggedObjectStorage *newNodes = theStorage.getEmptyCopy();
+  TaggedObjectStorage *newSPs = theStorage.getEmptyCopy();
+  TaggedObjectStorage *newMPs = theStorage.getEmptyCopy();
+  TaggedObjectStorage *newLoadPatterns = theStorage.getEmptyCopy();
+  TaggedObjectStorage *newParameters = theStorage.getEmptyCopy();
+
+  if (newNodes == 0 || newSPs == 0 || newMPs == 0 || 
+      newLoadPatterns == 0 || newParameters == 0) {
+    opserr << "Domain::setStorage() - out of memory\n";
+    if (newNodes != 0) delete newNodes;
+    if (newSPs != 0) delete newSPs;
+    if (newMPs != 0) delete newMPs;
+    if (newLoadPatterns != 0) delete newLoadPatterns;
+    if (newParameters != 0) delete newParameters;
+    return -2;
+  }
+
+  delete theElements;
+  delete theNodes;
+  delete theSPs;
+  delete theMPs;
+  delete theLoadPatterns;
+  delete theParameters;
+
+  theElements = &theStorage;
+  theNodes    = newNodes;
+  theSPs      = newSPs;
+  theMPs      = newMPs;
+  theLoadPatterns = newLoadPatterns;
+  theParameters   = newParameters;
+
+  // the iters hold on to the old containers
+  delete theEleIter;
+  delete theNodIter;
+  delete theSP_Iter;
+  delete theMP_Iter;
+  delete theLoadPatternIter;
+  delete theParamIter;
+
+  theEleIter = new SingleDomEleIter(theElements);    
+  theNodIter = new SingleDomNodIter(theNodes);
+  theSP_Iter = new SingleDomSP_Iter(theSPs);
+  theMP_Iter = new SingleDomMP_Iter(theMPs);
+  theLoadPatternIter = new LoadPatternIter(theLoadPatterns);
+  theParamIter = new SingleDomParamIter(theParameters);
+
+  if (theEleIter == 0 || theNodIter == 0 ||
+      theMP_Iter == 0 || theSP_Iter == 0 ||
+      theLoadPatternIter == 0 || theParamIter == 0) {
+    opserr << "FATAL Domain::setStorage() - out of memory\n";
+    exit(-1);
+  }
+
+  this->domainChange();
+
+  return 0;
+}
+
+
 Element *
 Domain::removeElement(int tag)
 {
@@ -915,6 +1070,7 @@ Domain::removeNode(int tag)
   // perform a downward cast to a Node (safe as only Node added to
   // this container and return the result of the cast
   Node *result = (Node *)mc;
+  this->releaseNodeState(result);
   // result->setDomain(0);
   return result;
 }
@@ -1646,16 +1802,36 @@ Domain::commit(void)
     // 
     // first invoke commit on all nodes and elements in the domain
     //
-    Node *nodePtr;
-    NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0) {
-      nodePtr->commitState();
+    ThreadPool *thePool = ThreadPool::getDefault();
+    if (thePool != 0 && this->buildComponentArrays() < 0)
+      thePool = 0;
+
+    if (theNodeStateStore != 0 && this->buildNodeStateStore() == 0)
+      theNodeStateStore->commitState();
+    else if (thePool != 0) {
+      DomainTask theTask;
+      theTask.theNodes = theNodeArray;
+      thePool->parallelFor(numNodeArray, commitNodesTask, &theTask);
+    } else {
+      Node *nodePtr;
+      NodeIter &theNodeIter = this->getNodes();
+      while ((nodePtr = theNodeIter()) != 0) {
+	nodePtr->commitState();
+      }
     }
 
-    Element *elePtr;
-    ElementIter &theElemIter = this->getElements();    
-    while ((elePtr = theElemIter()) != 0) {
-      elePtr->commitState();
+    if (thePool != 0) {
+      DomainTask theTask;
+      theTask.theElements = theElementArray;
+      thePool->parallelFor(numSafeElements, commitElementsTask, &theTask);
+      for (int i=numSafeElements; i<numElementArray; i++)
+	theElementArray[i]->commitState();
+    } else {
+      Element *elePtr;
+      ElementIter &theElemIter = this->getElements();    
+      while ((elePtr = theElemIter()) != 0) {
+	elePtr->commitState();
+      }
     }
 
     // set the new committed time in the domain
@@ -1679,15 +1855,35 @@ Domain::revertToLastCommit(void)
     // first invoke revertToLastCommit  on all nodes and elements in the domain
     //
     
-    Node *nodePtr;
-    NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0)
+    ThreadPool *thePool = ThreadPool::getDefault();
+    if (thePool != 0 && this->buildComponentArrays() < 0)
+      thePool = 0;
+
+    if (theNodeStateStore != 0 && this->buildNodeStateStore() == 0)
+      theNodeStateStore->revertToLastCommit();
+    else if (thePool != 0) {
+      DomainTask theTask;
+      theTask.theNodes = theNodeArray;
+      thePool->parallelFor(numNodeArray, revertNodesTask, &theTask);
+    } else {
+      Node *nodePtr;
+      NodeIter &theNodeIter = this->getNodes();
+      while ((nodePtr = theNodeIter()) != 0)
 	nodePtr->revertToLastCommit();
+    }
     
-    Element *elePtr;
-    ElementIter &theElemIter = this->getElements();    
-    while ((elePtr = theElemIter()) != 0) {
+    if (thePool != 0) {
+      DomainTask theTask;
+      theTask.theElements = theElementArray;
+      thePool->parallelFor(numSafeElements, revertElementsTask, &theTask);
+      for (int i=numSafeElements; i<numElementArray; i++)
+	theElementArray[i]->revertToLastCommit();
+    } else {
+      Element *elePtr;
+      ElementIter &theElemIter = this->getElements();    
+      while ((elePtr = theElemIter()) != 0) {
 	elePtr->revertToLastCommit();
+      }
     }
 
     // set the current time and load factor in the domain to last committed
@@ -1746,13 +1942,31 @@ Domain::update(void)
 
   int ok = 0;
 
-  // invoke update on all the ele's
-  ElementIter &theEles = this->getElements();
-  Element *theEle;
+  // with a default thread pool the thread safe elements are updated by
+  // its threads, the others by this thread afterwards
+  ThreadPool *thePool = ThreadPool::getDefault();
+  if (thePool != 0 && this->buildComponentArrays() == 0) {
+    DomainTask theTask;
+    theTask.theElements = theElementArray;
+    for (int i=0; i<OPS_MAX_THREADS; i++)
+      theTask.results[i] = 0;
+    thePool->parallelFor(numSafeElements, updateElementsTask, &theTask);
+    for (int i=0; i<OPS_MAX_THREADS; i++)
+      ok += theTask.results[i];
+
+    for (int i=numSafeElements; i<numElementArray; i++) {
+      ops_TheActiveElement = theElementArray[i];
+      ok += theElementArray[i]->update();
+    }
+  } else {
+    // invoke update on all the ele's
+    ElementIter &theEles = this->getElements();
+    Element *theEle;
 
-  while ((theEle = theEles()) != 0) {
-    ops_TheActiveElement = theEle;
-    ok += theEle->update();
+    while ((theEle = theEles()) != 0) {
+      ops_TheActiveElement = theEle;
+      ok += theEle->update();
+    }
   }
 
   if (ok != 0)
@@ -1858,6 +2072,140 @@ Domain::getTimeEigenvaluesSet(void)
   return theEigenvalueSetTime;
 }
 
+int
+Domain::setNodeStateStore(bool useStore)
+{
+  if (useStore == true) {
+    if (theNodeStateStore == 0) {
+      theNodeStateStore = new NodeStateStore();
+      if (theNodeStateStore == 0) {
+	opserr << "WARNING Domain::setNodeStateStore() - out of memory\n";
+	return -1;
+      }
+      nodeStateStoreTag = -1;
+    }
+    return this->buildNodeStateStore();
+  }
+
+  // the nodes get arrays of their own again
+  if (theNodeStateStore != 0) {
+    delete theNodeStateStore;
+    theNodeStateStore = 0;
+  }
+  return 0;
+}
+
+
+// rebuilds the node state store if nodes may have been added or
+// removed since it was last built
+int
+Domain::buildNodeStateStore(void)
+{
+  if (hasDomainChangedFlag == false && nodeStateStoreTag == currentGeoTag)
+    return 0;
+
+  if (theNodeStateStore->build(*this) < 0) {
+    opserr << "WARNING Domain::buildNodeStateStore() - failed to build store, ";
+    opserr << "nodes keep their own storage\n";
+    theNodeStateStore->detachNodes();
+    nodeStateStoreTag = -1;
+    return -1;
+  }
+
+  // built again once the change has been counted
+  if (hasDomainChangedFlag == false)
+    nodeStateStoreTag = currentGeoTag;
+  else
+    nodeStateStoreTag = -1;
+
+  return 0;
+}
+
+
+// rebuilds the arrays of elements and nodes handed to the threads of
+// the default pool if components may have been added or removed since
+// they were last built; the thread safe elements are placed first
+int
+Domain::buildComponentArrays(void)
+{
+  if (hasDomainChangedFlag == false && componentArrayTag == currentGeoTag)
+    return 0;
+
+  // counted through the iterators, which subclasses may redefine
+  Element *elePtr;
+  ElementIter &theEles = this->getElements();
+  int numEle = 0;
+  while ((elePtr = theEles()) != 0)
+    numEle++;
+
+  Node *nodePtr;
+  NodeIter &theNodeIter = this->getNodes();
+  int numNod = 0;
+  while ((nodePtr = theNodeIter()) != 0)
+    numNod++;
+
+  if (numEle > sizeElementArray) {
+    if (theElementArray != 0)
+      delete [] theElementArray;
+    theElementArray = new Element *[numEle];
+    sizeElementArray = numEle;
+  }
+  if (numNod > sizeNodeArray) {
+    if (theNodeArray != 0)
+      delete [] theNodeArray;
+    theNodeArray = new Node *[numNod];
+    sizeNodeArray = numNod;
+  }
+  if ((numEle != 0 && theElementArray == 0) || (numNod != 0 && theNodeArray == 0)) {
+    opserr << "WARNING Domain::buildComponentArrays() - out of memory\n";
+    sizeElementArray = 0;
+    sizeNodeArray = 0;
+    numElementArray = 0;
+    numNodeArray = 0;
+    componentArrayTag = -1;
+    return -1;
+  }
+
+  ElementIter &theSafeEles = this->getElements();
+  numSafeElements = 0;
+  while ((elePtr = theSafeEles()) != 0)
+    if (elePtr->isThreadSafe() == true)
+      theElementArray[numSafeElements++] = elePtr;
+
+  int loc = numSafeElements;
+  ElementIter &theOtherEles = this->getElements();
+  while ((elePtr = theOtherEles()) != 0)
+    if (elePtr->isThreadSafe() == false)
+      theElementArray[loc++] = elePtr;
+
+  NodeIter &theOtherNodes = this->getNodes();
+  loc = 0;
+  while ((nodePtr = theOtherNodes()) != 0)
+    theNodeArray[loc++] = nodePtr;
+
+  numElementArray = numEle;
+  numNodeArray = numNod;
+
+  // built again once the change has been counted
+  if (hasDomainChangedFlag == false)
+    componentArrayTag = currentGeoTag;
+  else
+    componentArrayTag = -1;
+
+  return 0;
+}
+
+
+// a node removed from the domain may be deleted, it can no longer
+// keep its values in the store
+void
+Domain::releaseNodeState(Node *theNode)
+{
+  if (theNodeStateStore != 0)
+    theNodeStateStore->detachNode(theNode);
+}
+
+
 void
 Domain::setDomainChangeStamp(int newStamp)
 {
@@ -2010,6 +2358,16 @@ Domain::removeRecorders(void)
     return 0;
 }
 
+// the recorders are forgotten without being deleted; used in a forked
+// process, which is neither to record nor to close the files of its parent
+int
+Domain::detachRecorders(void)
+{
+    theRecorders = 0;
+    numRecorders = 0;
+    return 0;
+}
+
 int
 Domain::removeRecorder(int tag)
 {
@@ -71,6 +71,7 @@ class Channel;
 class FEM_ObjectBroker;
 
 class TaggedObjectStorage;
+class NodeStateStore;
 
 class Domain
 {
@@ -108,6 +109,7 @@ class Domain
     
     // methods to remove the components 
     virtual void clearAll(void);	
+    virtual int setStorage(TaggedObjectStorage &theStorage);
     virtual Element       *removeElement(int tag);
     virtual Node          *removeNode(int tag);    
     virtual SP_Constraint *removeSP_Constraint(int tag);
@@ -194,11 +196,15 @@ class Domain
     virtual void domainChange(void);    
     virtual void setDomainChangeStamp(int newStamp);
 
+    // keep the nodal disp, vel and accel values in contiguous buffers
+    virtual int setNodeStateStore(bool useStore);
+
 
     // methods for output
     virtual int  addRecorder(Recorder &theRecorder);    	
     virtual int  removeRecorders(void);
     virtual int  removeRecorder(int tag);
+    virtual int  detachRecorders(void);
     virtual int  record(void);
 
     virtual int  addRegion(MeshRegion &theRegion);    	
@@ -223,6 +229,7 @@ class Domain
 
     virtual int buildEleGraph(Graph *theEleGraph);
     virtual int buildNodeGraph(Graph *theNodeGraph);
+    void releaseNodeState(Node *theNode);
 
     Recorder **theRecorders;
     int numRecorders;    
@@ -277,6 +284,21 @@ class Domain
     enum {paramSize_grow = 20};
     int paramSize;
     int numParameters;
+
+    NodeStateStore *theNodeStateStore;
+    int nodeStateStoreTag;            // currentGeoTag when the store was built
+    int buildNodeStateStore(void);
+
+    // the components handed to the threads of the default ThreadPool
+    Element **theElementArray;        // thread safe elements first
+    int numElementArray;
+    int sizeElementArray;
+    int numSafeElements;
+    Node **theNodeArray;
+    int numNodeArray;
+    int sizeNodeArray;
+    int componentArrayTag;            // currentGeoTag when they were built
+    int buildComponentArrays(void);
 };
 
 #endif
@@ -182,6 +182,52 @@ PartitionedDomain::clearAll(void)
 
   elements->clearAll();
 }
+
+
+// int setStorage(TaggedObjectStorage &theStorage);
+//	Method to change the type of container used for the components of 
+//	an empty domain. The elements not in a subdomain are kept in 
+//	theStorage, which the domain takes over; Domain::setStorage() is 
+//	given an empty copy for the elements and the other components.
+
+int
+PartitionedDomain::setStorage(TaggedObjectStorage &theStorage)
+{
+  if (elements->getNumComponents() != 0 || 
+      theSubdomains->getNumComponents() != 0) {
+    opserr << "PartitionedDomain::setStorage() - domain is not empty\n";
+    return -1;
+  }
+
+  TaggedObjectStorage *theCopy = theStorage.getEmptyCopy();
+  if (theCopy == 0) {
+    opserr << "PartitionedDomain::setStorage() - out of memory\n";
+    return -2;
+  }
+
+  int result = this->Domain::setStorage(*theCopy);
+  if (result < 0) {
+    delete theCopy;
+    return result;
+  }
+
+  theStorage.clearAll();
+  delete elements;
+  elements = &theStorage;
+
+  // the iters hold on to the old container
+  delete mainEleIter;
+  delete theEleIter;
+  mainEleIter = new SingleDomEleIter(elements);    
+  theEleIter = new PartitionedDomainEleIter(this);
+
+  if (mainEleIter == 0 || theEleIter == 0) {
+    opserr << "FATAL PartitionedDomain::setStorage() - out of memory\n";
+    exit(-1);
+  }
+
+  return 0;
+}
     
 
 
@@ -80,6 +80,7 @@ class PartitionedDomain: public Domain
 
     // methods to remove the components     
     virtual void clearAll(void);
+    virtual int setStorage(TaggedObjectStorage &theStorage);
     virtual Element *removeElement(int tag);
     virtual Node *removeNode(int tag);        
     virtual SP_Constraint *removeSP_Constraint(int tag);
@@ -52,9 +52,10 @@
 // AddingSensitivity:END ////////////////////////////
 
 #include <OPS_Globals.h>
+#include <WorkArea.h>
 
-Matrix **Node::theMatrices = 0;
-int Node::numMatrices = 0;
+// work area for the Matrix returned when a node has no mass
+static WorkArea theWorkArea("Node");
 
 // for FEM_Object Broker to use
 Node::Node(int theClassTag)
@@ -63,9 +64,9 @@ Node::Node(int theClassTag)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0), 
  incrDeltaDisp(0),
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), ownsState(true), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
- index(-1), reaction(0)
+ reaction(0)
 {
   // for FEM_ObjectBroker, recvSelf() must be invoked on object
 
@@ -84,9 +85,9 @@ Node::Node(int tag, int theClassTag)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), ownsState(true), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
   R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
- index(-1), reaction(0)
+ reaction(0)
 {
   // for subclasses - they must implement all the methods with
   // their own data structures.
@@ -105,9 +106,9 @@ Node::Node(int tag, int ndof, double Crd1)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), ownsState(true), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
- index(-1), reaction(0)
+ reaction(0)
 {
   // AddingSensitivity:BEGIN /////////////////////////////////////////
   dispSensitivity = 0;
@@ -119,34 +120,6 @@ Node::Node(int tag, int ndof, double Crd1)
   Crd = new Vector(1);
   (*Crd)(0) = Crd1;
   
-  index = -1;
-  if (numMatrices != 0) {
-    for (int i=0; i<numMatrices; i++)
-      if (theMatrices[i]->noRows() == ndof) {
-	index = i;
-	i = numMatrices;
-      }
-  }
-  if (index == -1) {
-    Matrix **nextMatrices = new Matrix *[numMatrices+1];
-    if (nextMatrices == 0) {
-      opserr << "Element::getTheMatrix - out of memory\n";
-      exit(-1);
-    }
-    for (int j=0; j<numMatrices; j++)
-      nextMatrices[j] = theMatrices[j];
-    Matrix *theMatrix = new Matrix(ndof, ndof);
-    if (theMatrix == 0) {
-      opserr << "Element::getTheMatrix - out of memory\n";
-      exit(-1);
-    }
-    nextMatrices[numMatrices] = theMatrix;
-    if (numMatrices != 0) 
-      delete [] theMatrices;
-    index = numMatrices;
-    numMatrices++;
-    theMatrices = nextMatrices;
-  }
 }
 
 
@@ -158,7 +131,7 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), ownsState(true), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
  reaction(0)
 {
@@ -173,34 +146,6 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2)
   (*Crd)(0) = Crd1;
   (*Crd)(1) = Crd2;
   
-  index = -1;
-  if (numMatrices != 0) {
-    for (int i=0; i<numMatrices; i++)
-      if (theMatrices[i]->noRows() == ndof) {
-	index = i;
-	i = numMatrices;
-      }
-  }
-  if (index == -1) {
-    Matrix **nextMatrices = new Matrix *[numMatrices+1];
-    if (nextMatrices == 0) {
-      opserr << "Element::getTheMatrix - out of memory\n";
-      exit(-1);
-    }
-    for (int j=0; j<numMatrices; j++)
-      nextMatrices[j] = theMatrices[j];
-    Matrix *theMatrix = new Matrix(ndof, ndof);
-    if (theMatrix == 0) {
-      opserr << "Element::getTheMatrix - out of memory\n";
-      exit(-1);
-    }
-    nextMatrices[numMatrices] = theMatrix;
-    if (numMatrices != 0) 
-      delete [] theMatrices;
-    index = numMatrices;
-    numMatrices++;
-    theMatrices = nextMatrices;
-  }
 }
 
 
@@ -213,7 +158,7 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, double Crd3)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), ownsState(true), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
  reaction(0)
 {
@@ -229,34 +174,6 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, double Crd3)
   (*Crd)(1) = Crd2;
   (*Crd)(2) = Crd3;    
   
-  index = -1;
-  if (numMatrices != 0) {
-    for (int i=0; i<numMatrices; i++)
-      if (theMatrices[i]->noRows() == ndof) {
-	index = i;
-	i = numMatrices;
-      }
-  }
-  if (index == -1) {
-    Matrix **nextMatrices = new Matrix *[numMatrices+1];
-    if (nextMatrices == 0) {
-      opserr << "Element::getTheMatrix - out of memory\n";
-      exit(-1);
-    }
-    for (int j=0; j<numMatrices; j++)
-      nextMatrices[j] = theMatrices[j];
-    Matrix *theMatrix = new Matrix(ndof, ndof);
-    if (theMatrix == 0) {
-      opserr << "Element::getTheMatrix - out of memory\n";
-      exit(-1);
-    }
-    nextMatrices[numMatrices] = theMatrix;
-    if (numMatrices != 0) 
-      delete [] theMatrices;
-    index = numMatrices;
-    numMatrices++;
-    theMatrices = nextMatrices;
-  }
 }
 
 
@@ -269,7 +186,7 @@ Node::Node(const Node &otherNode, bool copyMass)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), ownsState(true), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
  reaction(0)
 {
@@ -291,8 +208,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for displacement\n";
       exit(-1);
     }
-    for (int i=0; i<4*numberDOF; i++)
-      disp[i] = otherNode.disp[i];
+    for (int j=0; j<4; j++)
+      for (int i=0; i<numberDOF; i++)
+	disp[j*stateStride+i] = otherNode.disp[j*otherNode.stateStride+i];
   }    
   
   if (otherNode.commitVel != 0) {
@@ -300,8 +218,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for velocity\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      vel[i] = otherNode.vel[i];
+    for (int j=0; j<2; j++)
+      for (int i=0; i<numberDOF; i++)
+	vel[j*stateStride+i] = otherNode.vel[j*otherNode.stateStride+i];
   }    
   
   if (otherNode.commitAccel != 0) {
@@ -309,8 +228,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for acceleration\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      accel[i] = otherNode.accel[i];
+    for (int j=0; j<2; j++)
+      for (int i=0; i<numberDOF; i++)
+	accel[j*stateStride+i] = otherNode.accel[j*otherNode.stateStride+i];
   }    
   
   
@@ -338,35 +258,6 @@ Node::Node(const Node &otherNode, bool copyMass)
       exit(-1);
     }
   }
-
-  index = -1;
-  if (numMatrices != 0) {
-    for (int i=0; i<numMatrices; i++)
-      if (theMatrices[i]->noRows() == numberDOF) {
-	index = i;
-	i = numMatrices;
-      }
-  }
-  if (index == -1) {
-    Matrix **nextMatrices = new Matrix *[numMatrices+1];
-    if (nextMatrices == 0) {
-      opserr << "Element::getTheMatrix - out of memory\n";
-      exit(-1);
-    }
-    for (int j=0; j<numMatrices; j++)
-      nextMatrices[j] = theMatrices[j];
-    Matrix *theMatrix = new Matrix(numberDOF, numberDOF);
-    if (theMatrix == 0) {
-      opserr << "Element::getTheMatrix - out of memory\n";
-      exit(-1);
-    }
-    nextMatrices[numMatrices] = theMatrix;
-    if (numMatrices != 0) 
-      delete [] theMatrices;
-    index = numMatrices;
-    numMatrices++;
-    theMatrices = nextMatrices;
-  }  
 }
 
 
@@ -406,14 +297,17 @@ Node::~Node()
     if (unbalLoad != 0)
 	delete unbalLoad;
     
-    if (disp != 0)
+    // arrays in a NodeStateStore are freed by the store
+    if (ownsState == true) {
+      if (disp != 0)
 	delete [] disp;
 
-    if (vel != 0)
+      if (vel != 0)
 	delete [] vel;
 
-    if (accel != 0)
+      if (accel != 0)
 	delete [] accel;
+    }
 
     if (mass != 0)
 	delete mass;
@@ -627,8 +521,8 @@ Node::setTrialDisp(double value, int dof)
     // perform the assignment .. we dont't go through Vector interface
     // as we are sure of size and this way is quicker
     double tDisp = value;
-    disp[dof+2*numberDOF] = tDisp - disp[dof+numberDOF];
-    disp[dof+3*numberDOF] = tDisp - disp[dof];	
+    disp[dof+2*stateStride] = tDisp - disp[dof+stateStride];
+    disp[dof+3*stateStride] = tDisp - disp[dof];	
     disp[dof] = tDisp;
 
     return 0;
@@ -657,8 +551,8 @@ Node::setTrialDisp(const Vector &newTrialDisp)
     // as we are sure of size and this way is quicker
     for (int i=0; i<numberDOF; i++) {
         double tDisp = newTrialDisp(i);
-	disp[i+2*numberDOF] = tDisp - disp[i+numberDOF];
-	disp[i+3*numberDOF] = tDisp - disp[i];	
+	disp[i+2*stateStride] = tDisp - disp[i+stateStride];
+	disp[i+3*stateStride] = tDisp - disp[i];	
 	disp[i] = tDisp;
     }
 
@@ -733,8 +627,8 @@ Node::incrTrialDisp(const Vector &incrDispl)
 	for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] = incrDispI;
-	  disp[i+2*numberDOF] = incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] = incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
 	}
 	return 0;
     }
@@ -743,8 +637,8 @@ Node::incrTrialDisp(const Vector &incrDispl)
     for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] += incrDispI;
-	  disp[i+2*numberDOF] += incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] += incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
     }
 
     return 0;
@@ -981,22 +875,22 @@ Node::commitState()
     // check disp exists, if does set commit = trial, incr = 0.0
     if (trialDisp != 0) {
       for (int i=0; i<numberDOF; i++) {
-	disp[i+numberDOF] = disp[i];  
-        disp[i+2*numberDOF] = 0.0;
-        disp[i+3*numberDOF] = 0.0;
+	disp[i+stateStride] = disp[i];  
+        disp[i+2*stateStride] = 0.0;
+        disp[i+3*stateStride] = 0.0;
       }
     }		    
     
     // check vel exists, if does set commit = trial    
     if (trialVel != 0) {
       for (int i=0; i<numberDOF; i++)
-	vel[i+numberDOF] = vel[i];
+	vel[i+stateStride] = vel[i];
     }
     
     // check accel exists, if does set commit = trial        
     if (trialAccel != 0) {
       for (int i=0; i<numberDOF; i++)
-	accel[i+numberDOF] = accel[i];
+	accel[i+stateStride] = accel[i];
     }
 
     // if we get here we are done
@@ -1011,22 +905,22 @@ Node::revertToLastCommit()
     // check disp exists, if does set trial = last commit, incr = 0
     if (disp != 0) {
       for (int i=0 ; i<numberDOF; i++) {
-	disp[i] = disp[i+numberDOF];
-	disp[i+2*numberDOF] = 0.0;
-	disp[i+3*numberDOF] = 0.0;
+	disp[i] = disp[i+stateStride];
+	disp[i+2*stateStride] = 0.0;
+	disp[i+3*stateStride] = 0.0;
       }
     }
     
     // check vel exists, if does set trial = last commit
     if (vel != 0) {
       for (int i=0 ; i<numberDOF; i++)
-	vel[i] = vel[numberDOF+i];
+	vel[i] = vel[stateStride+i];
     }
 
     // check accel exists, if does set trial = last commit
     if (accel != 0) {    
       for (int i=0 ; i<numberDOF; i++)
-	accel[i] = accel[numberDOF+i];
+	accel[i] = accel[stateStride+i];
     }
 
     // if we get here we are done
@@ -1039,20 +933,23 @@ Node::revertToStart()
 {
     // check disp exists, if does set all to zero
     if (disp != 0) {
-      for (int i=0 ; i<4*numberDOF; i++)
-	disp[i] = 0.0;
+      for (int j=0 ; j<4; j++)
+	for (int i=0 ; i<numberDOF; i++)
+	  disp[j*stateStride+i] = 0.0;
     }
 
     // check vel exists, if does set all to zero
     if (vel != 0) {
-      for (int i=0 ; i<2*numberDOF; i++)
-	vel[i] = 0.0;
+      for (int j=0 ; j<2; j++)
+	for (int i=0 ; i<numberDOF; i++)
+	  vel[j*stateStride+i] = 0.0;
     }
 
     // check accel exists, if does set all to zero
     if (accel != 0) {    
-      for (int i=0 ; i<2*numberDOF; i++)
-	accel[i] = 0.0;
+      for (int j=0 ; j<2; j++)
+	for (int i=0 ; i<numberDOF; i++)
+	  accel[j*stateStride+i] = 0.0;
     }
     
     if (unbalLoad != 0) 
@@ -1084,8 +981,9 @@ Node::getMass(void)
 {
     // make sure it was created before we return it
     if (mass == 0) {
-      theMatrices[index]->Zero();
-      return *theMatrices[index];
+      Matrix &result = theWorkArea.getMatrix(numberDOF, numberDOF);
+      result.Zero();
+      return result;
     } else 
       return *mass;
 }
@@ -1102,11 +1000,11 @@ const Matrix &
 Node::getDamp(void) 
 {
     // make sure it was created before we return it
+    Matrix &result = theWorkArea.getMatrix(numberDOF, numberDOF);
     if (mass == 0 || alphaM == 0.0) {
-      theMatrices[index]->Zero();
-      return *theMatrices[index];
+      result.Zero();
+      return result;
     } else {
-      Matrix &result = *theMatrices[index];
       result = *mass;
       result *= alphaM;
       return result;
@@ -1118,11 +1016,11 @@ const Matrix &
 Node::getDampSensitivity(void) 
 {
     // make sure it was created before we return it
+    Matrix &result = theWorkArea.getMatrix(numberDOF, numberDOF);
     if (mass == 0 || alphaM == 0.0) {
-      theMatrices[index]->Zero();
-      return *theMatrices[index];
+      result.Zero();
+      return result;
     } else {
-      Matrix &result = *theMatrices[index];
 	  result.Zero();
       //result = *mass;
       //result *= alphaM;
@@ -1449,7 +1347,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantities equal to committed
       for (int i=0; i<numberDOF; i++)
-	disp[i] = disp[i+numberDOF];  // set trial equal commited
+	disp[i] = disp[i+stateStride];  // set trial equal commited
 
     } else if (commitDisp != 0) {
       // if going back to initial we will just zero the vectors
@@ -1471,7 +1369,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantity
       for (int i=0; i<numberDOF; i++)
-	vel[i] = vel[i+numberDOF];  // set trial equal commited
+	vel[i] = vel[i+stateStride];  // set trial equal commited
     }
 
     if (data(4) == 0) {
@@ -1487,7 +1385,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
       
       // set the trial values
       for (int i=0; i<numberDOF; i++)
-	accel[i] = accel[i+numberDOF];  // set trial equal commited
+	accel[i] = accel[i+stateStride];  // set trial equal commited
     }
 
     if (data(5) == 0) {
@@ -1539,34 +1437,6 @@ Node::recvSelf(int cTag, Channel &theChannel,
     }        
 
 
-  index = -1;
-  if (numMatrices != 0) {
-    for (int i=0; i<numMatrices; i++)
-      if (theMatrices[i]->noRows() == numberDOF) {
-	index = i;
-	i = numMatrices;
-      }
-  }
-  if (index == -1) {
-    Matrix **nextMatrices = new Matrix *[numMatrices+1];
-    if (nextMatrices == 0) {
-      opserr << "Element::getTheMatrix - out of memory\n";
-      exit(-1);
-    }
-    for (int j=0; j<numMatrices; j++)
-      nextMatrices[j] = theMatrices[j];
-    Matrix *theMatrix = new Matrix(numberDOF, numberDOF);
-    if (theMatrix == 0) {
-      opserr << "Element::getTheMatrix - out of memory\n";
-      exit(-1);
-    }
-    nextMatrices[numMatrices] = theMatrix;
-    if (numMatrices != 0) 
-      delete [] theMatrices;
-    index = numMatrices;
-    numMatrices++;
-    theMatrices = nextMatrices;
-  }
 
   return 0;
 }
@@ -1653,6 +1523,7 @@ Node::createDisp(void)
   }
   for (int i=0; i<4*numberDOF; i++)
     disp[i] = 0.0;
+  stateStride = numberDOF;
     
   commitDisp = new Vector(&disp[numberDOF], numberDOF); 
   trialDisp = new Vector(disp, numberDOF);
@@ -1680,6 +1551,7 @@ Node::createVel(void)
     }
     for (int i=0; i<2*numberDOF; i++)
       vel[i] = 0.0;
+    stateStride = numberDOF;
     
     commitVel = new Vector(&vel[numberDOF], numberDOF); 
     trialVel = new Vector(vel, numberDOF);
@@ -1704,6 +1576,7 @@ Node::createAccel(void)
     }
     for (int i=0; i<2*numberDOF; i++)
 	accel[i] = 0.0;
+    stateStride = numberDOF;
     
     commitAccel = new Vector(&accel[numberDOF], numberDOF);
     trialAccel = new Vector(accel, numberDOF);
@@ -1717,14 +1590,97 @@ Node::createAccel(void)
 }
 
 
+// setStateStorage():
+// moves the disp, vel and accel values into the arrays given, trial values
+// at theDisp[0], committed at theDisp[stride], incr at theDisp[2*stride] ..,
+// and makes the Vector objects views into them. With 0 pointers the node 
+// goes back to arrays of its own.
+
+int
+Node::setStateStorage(double *theDisp, double *theVel, double *theAccel,
+		      int stride)
+{
+  bool ownArrays = (theDisp == 0 || theVel == 0 || theAccel == 0);
+  
+  if (ownArrays == true) {
+    theDisp = new double[4*numberDOF];
+    theVel = new double[2*numberDOF];
+    theAccel = new double[2*numberDOF];
+    stride = numberDOF;
+  } else if (stride < numberDOF) {
+    opserr << "WARNING - Node::setStateStorage() - stride " << stride
+	   << " less than number of dof at node " << this->getTag() << endln;
+    return -1;
+  }
+
+  // copy the current values, zero if none yet
+  for (int j=0; j<4; j++)
+    for (int i=0; i<numberDOF; i++)
+      theDisp[j*stride+i] = (disp != 0) ? disp[j*stateStride+i] : 0.0;
+
+  for (int j=0; j<2; j++)
+    for (int i=0; i<numberDOF; i++) {
+      theVel[j*stride+i] = (vel != 0) ? vel[j*stateStride+i] : 0.0;
+      theAccel[j*stride+i] = (accel != 0) ? accel[j*stateStride+i] : 0.0;
+    }
+
+  if (ownsState == true) {
+    if (disp != 0)
+      delete [] disp;
+    if (vel != 0)
+      delete [] vel;
+    if (accel != 0)
+      delete [] accel;
+  }
+
+  disp = theDisp;
+  vel = theVel;
+  accel = theAccel;
+  stateStride = stride;
+  ownsState = ownArrays;
+
+  // point the Vector objects at the new location
+  if (trialDisp == 0) {
+    trialDisp = new Vector(disp, numberDOF);
+    commitDisp = new Vector(&disp[stride], numberDOF);
+    incrDisp = new Vector(&disp[2*stride], numberDOF);
+    incrDeltaDisp = new Vector(&disp[3*stride], numberDOF);
+  } else {
+    trialDisp->setData(disp, numberDOF);
+    commitDisp->setData(&disp[stride], numberDOF);
+    incrDisp->setData(&disp[2*stride], numberDOF);
+    incrDeltaDisp->setData(&disp[3*stride], numberDOF);
+  }
+
+  if (trialVel == 0) {
+    trialVel = new Vector(vel, numberDOF);
+    commitVel = new Vector(&vel[stride], numberDOF);
+  } else {
+    trialVel->setData(vel, numberDOF);
+    commitVel->setData(&vel[stride], numberDOF);
+  }
+
+  if (trialAccel == 0) {
+    trialAccel = new Vector(accel, numberDOF);
+    commitAccel = new Vector(&accel[stride], numberDOF);
+  } else {
+    trialAccel->setData(accel, numberDOF);
+    commitAccel->setData(&accel[stride], numberDOF);
+  }
+
+  return 0;
+}
+
+
 // AddingSensitivity:BEGIN ///////////////////////////////////////
 
 Matrix
 Node::getMassSensitivity(void)
 {
 	if (mass == 0) {
-		theMatrices[index]->Zero();
-		return *theMatrices[index];
+		Matrix &result = theWorkArea.getMatrix(numberDOF, numberDOF);
+		result.Zero();
+		return result;
 	} 
 	else {
 		Matrix massSens(mass->noRows(),mass->noCols());
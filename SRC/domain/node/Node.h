@@ -150,6 +150,12 @@ class Node : public DomainComponent
     virtual int   addReactionForce(const Vector &, double factor);
     virtual int   resetReactionForce(int flag);
     virtual const Vector *getResponse(NodeResponseType);
+
+    // used by NodeStateStore to place the disp, vel and accel values in
+    // its contiguous buffers; with 0 pointers the node takes back arrays
+    // of its own. The current values are kept.
+    int setStateStorage(double *theDisp, double *theVel, double *theAccel,
+			int stride);
     
   private:
     // priavte methods used to create the Vector objects 
@@ -170,6 +176,9 @@ class Node : public DomainComponent
     
     double *disp, *vel, *accel; // double arrays holding the displ, 
                                 // vel and accel values
+    int stateStride;            // distance between trial, committed, incr 
+                                // and incrDelta values in these arrays
+    bool ownsState;             // false if the arrays are in a NodeStateStore
 
     int dbTag1, dbTag2, dbTag3, dbTag4; // needed for database
     Matrix *R;                          // nodal participation matrix
@@ -186,10 +195,6 @@ class Node : public DomainComponent
     int parameterID;
     // AddingSensitivity:END ///////////////////////////////////////////
 
-    static Matrix **theMatrices;
-    static int numMatrices;
-    int index;
-
     Vector *reaction;
 };
 
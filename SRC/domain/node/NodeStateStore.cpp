@@ -0,0 +1,211 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/domain/node/NodeStateStore.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of NodeStateStore.
+//
+// What: "@(#) NodeStateStore.C, revA"
+
+#include <NodeStateStore.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Domain.h>
+#include <classTags.h>
+#include <OPS_Globals.h>
+
+#include <string.h>
+
+NodeStateStore::NodeStateStore()
+:disp(0), vel(0), accel(0), numDOF(0),
+ theNodes(0), numNodes(0), otherNodes(0), numOtherNodes(0)
+{
+
+}
+
+NodeStateStore::~NodeStateStore()
+{
+  this->detachNodes();
+}
+
+int
+NodeStateStore::build(Domain &theDomain)
+{
+  // count the nodes and dof 
+  int numAll = 0;
+  int newNumDOF = 0;
+  Node *nodePtr;
+  NodeIter &theNodeIter1 = theDomain.getNodes();
+  while ((nodePtr = theNodeIter1()) != 0) {
+    numAll++;
+    if (nodePtr->getClassTag() == NOD_TAG_Node)
+      newNumDOF += nodePtr->getNumberDOF();
+  }
+
+  double *newDisp = 0;
+  double *newVel = 0;
+  double *newAccel = 0;
+  Node **newNodes = 0;
+  if (numAll != 0) {
+    newNodes = new Node *[numAll];
+    if (newNumDOF != 0) {
+      newDisp = new double[4*newNumDOF];
+      newVel = new double[2*newNumDOF];
+      newAccel = new double[2*newNumDOF];
+    }
+    if (newNodes == 0 || (newNumDOF != 0 && (newDisp == 0 || newVel == 0 || newAccel == 0))) {
+      opserr << "WARNING NodeStateStore::build() - out of memory for " 
+	     << newNumDOF << " dof\n";
+      if (newNodes != 0) delete [] newNodes;
+      if (newDisp != 0) delete [] newDisp;
+      if (newVel != 0) delete [] newVel;
+      if (newAccel != 0) delete [] newAccel;
+      return -1;
+    }
+  }
+
+  // place the nodes, they copy their values from the old buffers
+  int newNumNodes = 0;
+  int newNumOther = 0;
+  int offset = 0;
+  NodeIter &theNodeIter2 = theDomain.getNodes();
+  while ((nodePtr = theNodeIter2()) != 0) {
+    if (nodePtr->getClassTag() == NOD_TAG_Node) {
+      nodePtr->setStateStorage(&newDisp[offset], &newVel[offset], &newAccel[offset], 
+			       newNumDOF);
+      offset += nodePtr->getNumberDOF();
+      newNodes[newNumNodes++] = nodePtr;
+    } else
+      newNodes[numAll - ++newNumOther] = nodePtr;
+  }
+
+  this->clearAll();
+
+  disp = newDisp;
+  vel = newVel;
+  accel = newAccel;
+  numDOF = newNumDOF;
+  theNodes = newNodes;
+  numNodes = newNumNodes;
+  otherNodes = (newNumOther != 0) ? &newNodes[numAll - newNumOther] : 0;
+  numOtherNodes = newNumOther;
+
+  return 0;
+}
+
+void
+NodeStateStore::detachNodes(void)
+{
+  for (int i=0; i<numNodes; i++)
+    theNodes[i]->setStateStorage(0, 0, 0, 0);
+
+  this->clearAll();
+}
+
+int
+NodeStateStore::detachNode(Node *theNode)
+{
+  for (int i=0; i<numNodes; i++)
+    if (theNodes[i] == theNode) {
+      theNode->setStateStorage(0, 0, 0, 0);
+      // its values stay in the buffers until the next build
+      theNodes[i] = theNodes[--numNodes];
+      theNodes[numNodes] = 0;
+      return 0;
+    }
+
+  for (int j=0; j<numOtherNodes; j++)
+    if (otherNodes[j] == theNode) {
+      otherNodes[j] = otherNodes[--numOtherNodes];
+      return 0;
+    }
+
+  return -1;
+}
+
+void
+NodeStateStore::clearAll(void)
+{
+  if (disp != 0)
+    delete [] disp;
+  if (vel != 0)
+    delete [] vel;
+  if (accel != 0)
+    delete [] accel;
+  if (theNodes != 0)
+    delete [] theNodes;
+
+  disp = 0;
+  vel = 0;
+  accel = 0;
+  numDOF = 0;
+  theNodes = 0;
+  numNodes = 0;
+  otherNodes = 0;
+  numOtherNodes = 0;
+}
+
+int
+NodeStateStore::commitState(void)
+{
+  // committed = trial, incr = incrDelta = 0
+  if (numDOF != 0) {
+    memcpy(&disp[numDOF], disp, numDOF*sizeof(double));
+    memset(&disp[2*numDOF], 0, 2*numDOF*sizeof(double));
+    memcpy(&vel[numDOF], vel, numDOF*sizeof(double));
+    memcpy(&accel[numDOF], accel, numDOF*sizeof(double));
+  }
+
+  for (int i=0; i<numOtherNodes; i++)
+    otherNodes[i]->commitState();
+
+  return 0;
+}
+
+int
+NodeStateStore::revertToLastCommit(void)
+{
+  // trial = committed, incr = incrDelta = 0
+  if (numDOF != 0) {
+    memcpy(disp, &disp[numDOF], numDOF*sizeof(double));
+    memset(&disp[2*numDOF], 0, 2*numDOF*sizeof(double));
+    memcpy(vel, &vel[numDOF], numDOF*sizeof(double));
+    memcpy(accel, &accel[numDOF], numDOF*sizeof(double));
+  }
+
+  for (int i=0; i<numOtherNodes; i++)
+    otherNodes[i]->revertToLastCommit();
+
+  return 0;
+}
+
+int
+NodeStateStore::getNumNodes(void) const
+{
+  return numNodes;
+}
+
+int
+NodeStateStore::getNumDOF(void) const
+{
+  return numDOF;
+}
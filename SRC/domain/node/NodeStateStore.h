@@ -0,0 +1,83 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/domain/node/NodeStateStore.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for NodeStateStore.
+// A NodeStateStore keeps the displacement, velocity and acceleration
+// values of all the nodes of a Domain in three contiguous buffers, one
+// block per quantity:
+//   disp:  trial | committed | incr | incrDelta, each of numDOF values
+//   vel:   trial | committed
+//   accel: trial | committed
+// where numDOF is the sum of the dof of the nodes, a node's values being
+// at the same offset in each block. The nodes are made views into these
+// buffers (Node::setStateStorage()), so the domain can commit or revert
+// all the nodes with a few block copies.
+//
+// Only objects of class Node are placed in the store; subclasses keep
+// their own storage and are committed through their own methods.
+//
+// What: "@(#) NodeStateStore.h, revA"
+
+#ifndef NodeStateStore_h
+#define NodeStateStore_h
+
+class Node;
+class Domain;
+
+class NodeStateStore
+{
+ public:
+  NodeStateStore();
+  ~NodeStateStore();
+
+  // places the nodes of the domain in new buffers, keeping their values
+  int build(Domain &theDomain);
+
+  // gives the nodes in the store arrays of their own again
+  void detachNodes(void);
+  int detachNode(Node *theNode);
+
+  // frees the buffers without touching the nodes, used once the 
+  // nodes have been deleted
+  void clearAll(void);
+
+  int commitState(void);
+  int revertToLastCommit(void);
+
+  int getNumNodes(void) const;
+  int getNumDOF(void) const;
+
+ private:
+  double *disp;
+  double *vel;
+  double *accel;
+  int numDOF;
+
+  Node **theNodes;      // nodes placed in the store
+  int numNodes;
+  Node **otherNodes;    // nodes of other classes in the domain
+  int numOtherNodes;
+};
+
+#endif
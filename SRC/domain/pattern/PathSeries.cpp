@@ -37,6 +37,7 @@
 #include <PathSeries.h>
 #include <Vector.h>
 #include <Channel.h>
+#include <TimeSeriesCache.h>
 #include <math.h>
 
 #include <fstream>
@@ -47,7 +48,8 @@ using std::ios;
 
 PathSeries::PathSeries()	
   :TimeSeries(TSERIES_TAG_PathSeries),
-   thePath(0), pathTimeIncr(0.0), cFactor(0.0), otherDbTag(0), lastSendCommitTag(-1)
+   thePath(0), pathTimeIncr(0.0), cFactor(0.0), otherDbTag(0), lastSendCommitTag(-1),
+   cachedPath(0)
 {
   // does nothing
 }
@@ -57,7 +59,8 @@ PathSeries::PathSeries(int tag,
 		       double theTimeIncr, 
 		       double theFactor)
   :TimeSeries(tag, TSERIES_TAG_PathSeries),
-   thePath(0), pathTimeIncr(theTimeIncr), cFactor(theFactor), otherDbTag(0), lastSendCommitTag(-1)
+   thePath(0), pathTimeIncr(theTimeIncr), cFactor(theFactor), otherDbTag(0), lastSendCommitTag(-1),
+   cachedPath(0)
 {
   // create a copy of the vector containg path points
   thePath = new Vector(theLoadPath);
@@ -78,61 +81,18 @@ PathSeries::PathSeries(int tag,
 		       double theTimeIncr, 
 		       double theFactor)
   :TimeSeries(tag, TSERIES_TAG_PathSeries),
-   thePath(0), pathTimeIncr(theTimeIncr), cFactor(theFactor), otherDbTag(0), lastSendCommitTag(-1)
+   thePath(0), pathTimeIncr(theTimeIncr), cFactor(theFactor), otherDbTag(0), lastSendCommitTag(-1),
+   cachedPath(0)
 {
-  // determine the number of data points .. open file and count num entries
-  int numDataPoints =0;
-  double dataPoint;
+  // the data of a file is read once and shared by all the series using it
+  int numDataPoints = 0;
+  cachedPath = TimeSeriesCache::getValues(fileName, numDataPoints);
 
-  ifstream theFile;
-  theFile.open(fileName);
-
-  if (theFile.bad() || !theFile.is_open()) {
+  if (numDataPoints < 0) {
     opserr << "WARNING - PathSeries::PathSeries()";
     opserr << " - could not open file " << fileName << endln;
-  } else {
-    while (theFile >> dataPoint)
-      numDataPoints++;
-  }   
-  theFile.close();
-
-  // create a vector and read in the data
-  if (numDataPoints != 0) {
-
-    // first open the file
-    ifstream theFile1;
-    theFile1.open(fileName, ios::in);
-    if (theFile1.bad() || !theFile1.is_open()) {
-      opserr << "WARNING - PathSeries::PathSeries()";
-      opserr << " - could not open file " << fileName << endln;
-    } else {
-
-      // now create the vector
-      thePath = new Vector(numDataPoints);
-
-      // ensure we did not run out of memory
-      if (thePath == 0 || thePath->Size() == 0) {
-	opserr << "PathSeries::PathSeries() - ran out of memory constructing";
-	opserr << " a Vector of size: " << numDataPoints << endln;
-
-	if (thePath != 0)
-	  delete thePath;
-	thePath = 0;
-      }
-
-      // read the data from the file
-      else {
-	int count = 0;
-	while (theFile1 >> dataPoint) {
-	  (*thePath)(count) = dataPoint;
-	  count++;
-	}
-      }
-
-      // finally close the file
-      theFile1.close();
-    }
-  }
+  } else if (cachedPath != 0)
+    thePath = new Vector(cachedPath, numDataPoints);
 }
 
 
@@ -140,11 +100,25 @@ PathSeries::~PathSeries()
 {
   if (thePath != 0)
     delete thePath;
+  if (cachedPath != 0)
+    TimeSeriesCache::release(cachedPath);
 }
 
 TimeSeries *
 PathSeries::getCopy(void) {
-  return new PathSeries(this->getTag(), *thePath, pathTimeIncr, cFactor);
+  if (cachedPath == 0)
+    return new PathSeries(this->getTag(), *thePath, pathTimeIncr, cFactor);
+
+  // the copy shares the data read from the file
+  PathSeries *theCopy = new PathSeries();
+  theCopy->setTag(this->getTag());
+  theCopy->pathTimeIncr = pathTimeIncr;
+  theCopy->cFactor = cFactor;
+  theCopy->cachedPath = cachedPath;
+  theCopy->thePath = new Vector(cachedPath, thePath->Size());
+  TimeSeriesCache::retain(cachedPath);
+
+  return theCopy;
 }
 
 double
@@ -169,6 +143,15 @@ PathSeries::getFactor(double pseudoTime)
 }
 
 
+int
+PathSeries::getFactors(const double *pseudoTimes, double *factors, int numTimes)
+{
+  for (int i = 0; i < numTimes; i++)
+    factors[i] = this->PathSeries::getFactor(pseudoTimes[i]);
+
+  return 0;
+}
+
 double
 PathSeries::getDuration()
 {
@@ -66,6 +66,7 @@ class PathSeries : public TimeSeries
 
     // method to get factor
     double getFactor(double pseudoTime);
+    int getFactors(const double *pseudoTimes, double *factors, int numTimes);
     double getDuration ();
     double getPeakFactor ();
     double getTimeIncr (double pseudoTime) {return pathTimeIncr;}
@@ -85,6 +86,7 @@ class PathSeries : public TimeSeries
     double cFactor;       // additional factor on the returned load factor
     int otherDbTag;       // a database tag needed for the vector object
     int lastSendCommitTag;
+    double *cachedPath;   // data shared through the TimeSeriesCache, 0 if own copy
 };
 
 #endif
@@ -38,6 +38,7 @@
 #include <PathTimeSeries.h>
 #include <Vector.h>
 #include <Channel.h>
+#include <TimeSeriesCache.h>
 #include <math.h>
 
 #include <fstream>
@@ -49,7 +50,8 @@ using std::ios;
 PathTimeSeries::PathTimeSeries()	
   :TimeSeries(TSERIES_TAG_PathTimeSeries),
    thePath(0), time(0), currentTimeLoc(0), 
-   cFactor(0.0), dbTag1(0), dbTag2(0), lastSendCommitTag(-1)
+   cFactor(0.0), dbTag1(0), dbTag2(0), lastSendCommitTag(-1),
+   cachedPath(0), cachedTime(0), timeIncr(-1.0)
 {
   // does nothing
 }
@@ -61,7 +63,8 @@ PathTimeSeries::PathTimeSeries(int tag,
 			       double theFactor)
   :TimeSeries(tag, TSERIES_TAG_PathTimeSeries),
    thePath(0), time(0), currentTimeLoc(0), 
-   cFactor(theFactor), dbTag1(0), dbTag2(0), lastSendCommitTag(-1), lastChannel(0)
+   cFactor(theFactor), dbTag1(0), dbTag2(0), lastSendCommitTag(-1), lastChannel(0),
+   cachedPath(0), cachedTime(0), timeIncr(-1.0)
 {
   // check vectors are of same size
   if (theLoadPath.Size() != theTimePath.Size()) {
@@ -96,106 +99,41 @@ PathTimeSeries::PathTimeSeries(int tag,
 			       
   :TimeSeries(tag, TSERIES_TAG_PathTimeSeries),
    thePath(0), time(0), currentTimeLoc(0), 
-   cFactor(theFactor), dbTag1(0), dbTag2(0), lastSendCommitTag(-1), lastChannel(0)
+   cFactor(theFactor), dbTag1(0), dbTag2(0), lastSendCommitTag(-1), lastChannel(0),
+   cachedPath(0), cachedTime(0), timeIncr(-1.0)
 {
 
-  // determine the number of data points
-  int numDataPoints1 =0;
-  int numDataPoints2 =0;
-  double dataPoint;
-  ifstream theFile;
-  
-  // first open and go through file containg path
-  theFile.open(filePathName, ios::in);
-  if (theFile.bad() || !theFile.is_open()) {
+  // the data of a file is read once and shared by all the series using it
+  int numDataPoints1 = 0;
+  int numDataPoints2 = 0;
+  cachedPath = TimeSeriesCache::getValues(filePathName, numDataPoints1);
+  cachedTime = TimeSeriesCache::getValues(fileTimeName, numDataPoints2);
+
+  if (numDataPoints1 < 0) {
     opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
     opserr << " - could not open file " << filePathName << endln;
-  } else {
-    while (theFile >> dataPoint)
-      numDataPoints1++;
-  }   
-  theFile.close();
-
-  // now open and go through file containg time
-  ifstream theFile1;
-  theFile1.open(fileTimeName, ios::in);
-  if (theFile1.bad() || !theFile1.is_open()) {
+  }
+  if (numDataPoints2 < 0) {
     opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
     opserr << " - could not open file " << fileTimeName << endln;
-  } else {
-    while (theFile1 >> dataPoint)
-      numDataPoints2++;
-  }   
-  theFile1.close();
+  }
 
   // check number of data entries in both are the same
   if (numDataPoints1 != numDataPoints2) {
     opserr << "WARNING PathTimeSeries::PathTimeSeries() - files containing data ";
     opserr << "points for path and time do not contain same number of points\n";
-  } else {
-
-
-    // create a vector and read in the data
-    if (numDataPoints1 != 0) {
-
-      // now create the two vector
-      thePath = new Vector(numDataPoints1);
-      time = new Vector(numDataPoints1);
-
-      // ensure did not run out of memory creating copies
-      if (thePath == 0 || thePath->Size() == 0 ||
-	  time == 0 || time->Size() == 0) {
-	  
-        opserr << "WARNING PathTimeSeries::PathTimeSeries() - out of memory\n ";
-	if (thePath != 0)
-	  delete thePath;
-	if (time != 0)
-	  delete time;
-	thePath = 0;
-	time = 0;
-      }
-      
-      // first open the path file and read in the data
-      ifstream theFile2;
-      theFile2.open(filePathName, ios::in);
-      if (theFile2.bad() || !theFile2.is_open()) {
-	opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
-	opserr << " - could not open file " << filePathName << endln;
-	delete thePath;
-	delete time;
-	thePath = 0;
-	time =0;
-      } else { // read in the path data and then do the time
-	int count = 0;
-	while (theFile2 >> dataPoint) {
-	  (*thePath)(count) = dataPoint;
-	  count++;
-	}
-
-	// finally close the file
-	theFile2.close();
-
-	// now open the time file and read in the data
-	ifstream theFile3;
-	theFile3.open(fileTimeName, ios::in);
-	if (theFile3.bad() || !theFile3.is_open()) {
-	  opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
-	  opserr << " - could not open file " << fileTimeName << endln;
-	  delete thePath;
-	  delete time;
-	  thePath = 0;
-	  time =0;
-	} else { // read in the data
-	  int count = 0;
-	  while (theFile3 >> dataPoint) {
-	    (*time)(count) = dataPoint;
-	    count++;
-	  }
-	  theFile3.close();
-	} // read in the data 
-      }   // read in the path data and then do the time
-    }
+  } else if (cachedPath != 0 && cachedTime != 0) {
+    thePath = new Vector(cachedPath, numDataPoints1);
+    time = new Vector(cachedTime, numDataPoints2);
+    return;
   }
+
+  if (cachedPath != 0)
+    TimeSeriesCache::release(cachedPath);
+  if (cachedTime != 0)
+    TimeSeriesCache::release(cachedTime);
+  cachedPath = 0;
+  cachedTime = 0;
 }
 
 
@@ -204,26 +142,19 @@ PathTimeSeries::PathTimeSeries(int tag,
 			       double theFactor)
   :TimeSeries(tag, TSERIES_TAG_PathTimeSeries),
    thePath(0), time(0), currentTimeLoc(0), 
-   cFactor(theFactor), dbTag1(0), dbTag2(0), lastChannel(0)
+   cFactor(theFactor), dbTag1(0), dbTag2(0), lastSendCommitTag(-1), lastChannel(0),
+   cachedPath(0), cachedTime(0), timeIncr(-1.0)
 {
 
 
-  // determine the number of data points
+  // the file holds time and value pairs
   int numDataPoints = 0;
-  double dataPoint;
-  ifstream theFile;
-  
-  // first open and go through file counting entries
-  theFile.open(fileName, ios::in);
-  if (theFile.bad() || !theFile.is_open()) {
+  double *data = TimeSeriesCache::getValues(fileName, numDataPoints);
+
+  if (numDataPoints < 0) {
     opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
     opserr << " - could not open file " << fileName << endln;
-  }
-  else {
-    while (theFile >> dataPoint) {
-      numDataPoints++;
-      theFile >> dataPoint;	// Read in second value of pair
-    }
+    return;
   }
 
   if ((numDataPoints % 2) != 0) {
@@ -232,11 +163,8 @@ PathTimeSeries::PathTimeSeries(int tag,
     numDataPoints--;
   }
 
-
-  theFile.close();
-
   // create a vector and read in the data
-  if (numDataPoints != 0) {
+  if (numDataPoints > 0) {
     
     // now create the two vector
     thePath = new Vector(numDataPoints/2);
@@ -253,33 +181,16 @@ PathTimeSeries::PathTimeSeries(int tag,
       thePath = 0;
       time = 0;
     }
-    
-    // first open the file and read in the data
-    ifstream theFile1;
-    theFile1.open(fileName, ios::in);
-    if (theFile1.bad() || !theFile1.is_open()) {
-      
-      opserr << "WARNING - PathTimeSeries::PathTimeSeries()";
-      opserr << " - could not open file " << fileName << endln;
-      delete thePath;
-      delete time;
-      thePath = 0;
-      time =0;
-    }
-    else { // read in the time and then read the value
-      int count = 0;
-      while (theFile1 >> dataPoint) {
-	(*time)(count) = dataPoint;
-	theFile1 >> dataPoint;
-	(*thePath)(count) = dataPoint;
-
-	count++;
+    else { // the time and then the value
+      for (int i = 0; i < numDataPoints/2; i++) {
+	(*time)(i) = data[2*i];
+	(*thePath)(i) = data[2*i+1];
       }
-      
-      // finally close the file
-      theFile1.close();
-    } 
+    }
   }
+
+  if (data != 0)
+    TimeSeriesCache::release(data);
 }
 
 PathTimeSeries::~PathTimeSeries()
@@ -288,12 +199,30 @@ PathTimeSeries::~PathTimeSeries()
     delete thePath;
   if (time != 0)
     delete time;
+  if (cachedPath != 0)
+    TimeSeriesCache::release(cachedPath);
+  if (cachedTime != 0)
+    TimeSeriesCache::release(cachedTime);
 }
 
 TimeSeries *
 PathTimeSeries::getCopy(void) 
 {
-  return new PathTimeSeries(this->getTag(), *thePath, *time, cFactor);
+  if (cachedPath == 0)
+    return new PathTimeSeries(this->getTag(), *thePath, *time, cFactor);
+
+  // the copy shares the data read from the files
+  PathTimeSeries *theCopy = new PathTimeSeries();
+  theCopy->setTag(this->getTag());
+  theCopy->cFactor = cFactor;
+  theCopy->cachedPath = cachedPath;
+  theCopy->cachedTime = cachedTime;
+  theCopy->thePath = new Vector(cachedPath, thePath->Size());
+  theCopy->time = new Vector(cachedTime, time->Size());
+  TimeSeriesCache::retain(cachedPath);
+  TimeSeriesCache::retain(cachedTime);
+
+  return theCopy;
 }
 
 
@@ -304,6 +233,64 @@ PathTimeSeries::getTimeIncr (double pseudoTime)
   return 1.0;
 }
 
+// checks, the first time the factor is asked for, whether the time
+// points are equally spaced
+void
+PathTimeSeries::findTimeIncr(void)
+{
+  timeIncr = 0.0;
+
+  int size = time->Size();
+  if (size < 2)
+    return;
+
+  double time0 = (*time)(0);
+  double dt = ((*time)(size-1) - time0)/(size-1);
+  if (dt <= 0.0)
+    return;
+
+  for (int i = 1; i < size; i++)
+    if (fabs((*time)(i) - (time0 + i*dt)) > 1.0e-6*dt)
+      return;
+
+  timeIncr = dt;
+}
+
+
+// the interval holding the time, found directly for equally spaced time
+// points and by bisection otherwise
+int
+PathTimeSeries::findTimeLoc(double pseudoTime)
+{
+  int sizem1 = time->Size() - 1;
+
+  if (timeIncr > 0.0) {
+    double loc = (pseudoTime - (*time)(0))/timeIncr;
+    if (loc <= 0.0)
+      return 0;
+    if (loc >= sizem1)
+      return sizem1;
+    return (int)loc;
+  }
+
+  if (pseudoTime < (*time)(0))
+    return 0;
+
+  // largest loc with time(loc) <= pseudoTime
+  int low = 0;
+  int high = sizem1;
+  while (low < high) {
+    int mid = (low + high + 1)/2;
+    if ((*time)(mid) <= pseudoTime)
+      low = mid;
+    else
+      high = mid - 1;
+  }
+
+  return low;
+}
+
+
 double
 PathTimeSeries::getFactor(double pseudoTime)
 {
@@ -311,6 +298,16 @@ PathTimeSeries::getFactor(double pseudoTime)
   if (thePath == 0)
     return 0.0;
 
+  if (timeIncr < 0.0)
+    this->findTimeIncr();
+
+  // jump to the interval if the time is not in or next to the current
+  // one; the search below then only walks over a point or two
+  int loc = currentTimeLoc;
+  if (pseudoTime < (*time)(loc) ||
+      (loc < time->Size() - 2 && pseudoTime > (*time)(loc+2)))
+    currentTimeLoc = this->findTimeLoc(pseudoTime);
+
   // determine indexes into the data array whose boundary holds the time
   double time1 = (*time)(currentTimeLoc);
 
@@ -357,6 +354,15 @@ PathTimeSeries::getFactor(double pseudoTime)
   return cFactor*(value1 + (value2-value1)*(pseudoTime-time1)/(time2 - time1));
 }
 
+int
+PathTimeSeries::getFactors(const double *pseudoTimes, double *factors, int numTimes)
+{
+  for (int i = 0; i < numTimes; i++)
+    factors[i] = this->PathTimeSeries::getFactor(pseudoTimes[i]);
+
+  return 0;
+}
+
 double
 PathTimeSeries::getDuration()
 {
@@ -500,6 +506,7 @@ PathTimeSeries::recvSelf(int commitTag, Channel &theChannel,
       opserr << "channel failed to receive tha time Vector\n";
       return result;  
     }
+    timeIncr = -1.0;
   }
   return 0;    
 }
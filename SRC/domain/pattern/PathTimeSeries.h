@@ -72,6 +72,7 @@ class PathTimeSeries : public TimeSeries
 
     // method to get factor
     double getFactor(double pseudoTime);
+    int getFactors(const double *pseudoTimes, double *factors, int numTimes);
     double getDuration ();
     double getPeakFactor ();
     double getTimeIncr (double pseudoTime);
@@ -86,6 +87,9 @@ class PathTimeSeries : public TimeSeries
   protected:
     
   private:
+    void findTimeIncr(void);
+    int findTimeLoc(double pseudoTime);
+
     Vector *thePath;      // vector containg the data points
     Vector *time;		  // vector containg the time values of data points
     int currentTimeLoc;   // current location in time
@@ -94,6 +98,12 @@ class PathTimeSeries : public TimeSeries
     int lastSendCommitTag;
 
     Channel *lastChannel;
+
+    // data shared through the TimeSeriesCache, 0 if own copies
+    double *cachedPath;
+    double *cachedTime;
+
+    double timeIncr;      // spacing of equally spaced time points, 0 if not, -1 if not checked
 };
 
 #endif
@@ -163,45 +163,9 @@ PeerNGAMotion::PeerNGAMotion(int tag,
     return;
   }
   
-  nextData = strstr(eqData,"NPTS");
-  if (nextData == NULL) {
-    opserr << "PeerNGAMotion::PeerNGAMotion() - could not find nPts in record, send email opensees-support@berkeley.edu";
-    free(eqData);
-    return;
-  }
-
-  nextData+=5; // NPTS=
-  nPts = atoi(nextData);
-  
-  nextData = strstr(eqData, "DT");
-  if (nextData == NULL) {
-    nextData = strstr(eqData, "dt");
-    if (nextData == NULL) {
-      opserr << "PeerNGAMotion::PeerNGAMotion() - could not find dt in record, send email opensees-support@berkeley.edu";
-      free(eqData);
-      return;
-    }
-  }
-
-  nextData+=4; //DT= dT UNIT
-  dT = strtod(nextData, &nextData);
-  
-  sscanf(nextData, "%s", tmp1);
-  nextData += strlen(tmp1)+1;
-  
-  sscanf(nextData, "%s", tmp1);
-
-  thePath = new Vector(nPts);
-  //  data = (double *)malloc(nPts*sizeof(double));
-  
-  for (i=0; i<nPts; i++) {
-    double value = strtod(nextData, &nextData);
-    (*thePath)(i) = value;
-  }
+  thePath = parseRecord(eqData, dT);
   
   free(eqData);
-  
-  // create copies of the vectors
 }
 
 
@@ -286,6 +250,56 @@ PeerNGAMotion::PeerNGAMotion(int tag,
 }
 
 
+// parses the text of an NGA record (.AT2), also used to convert records
+// to binary time series files
+Vector *
+PeerNGAMotion::parseRecord(char *eqData, double &dT)
+{
+  char *nextData;
+  int nPts,i;
+  char tmp1[100];
+
+  nextData = strstr(eqData,"NPTS");
+  if (nextData == NULL) {
+    opserr << "PeerNGAMotion::PeerNGAMotion() - could not find nPts in record, send email opensees-support@berkeley.edu";
+    return 0;
+  }
+
+  nextData+=5; // NPTS=
+  nPts = atoi(nextData);
+  
+  nextData = strstr(eqData, "DT");
+  if (nextData == NULL) {
+    nextData = strstr(eqData, "dt");
+    if (nextData == NULL) {
+      opserr << "PeerNGAMotion::PeerNGAMotion() - could not find dt in record, send email opensees-support@berkeley.edu";
+      return 0;
+    }
+  }
+
+  nextData+=4; //DT= dT UNIT
+  dT = strtod(nextData, &nextData);
+  
+  sscanf(nextData, "%s", tmp1);
+  nextData += strlen(tmp1)+1;
+  
+  sscanf(nextData, "%s", tmp1);
+
+  if (nPts <= 0)
+    return 0;
+
+  Vector *thePath = new Vector(nPts);
+  //  data = (double *)malloc(nPts*sizeof(double));
+  
+  for (i=0; i<nPts; i++) {
+    double value = strtod(nextData, &nextData);
+    (*thePath)(i) = value;
+  }
+
+  return thePath;
+}
+
+
 TimeSeries *
 PeerNGAMotion::getCopy(void) 
 {
@@ -65,6 +65,8 @@ class PeerNGAMotion : public TimeSeries
   
   TimeSeries *getCopy(void);
 
+  static Vector *parseRecord(char *eqData, double &dT);
+
 
   // method to get factor
   double getFactor(double pseudoTime);
@@ -81,3 +81,12 @@ TimeSeries::~TimeSeries()
 {
 
 }
+
+int
+TimeSeries::getFactors(const double *pseudoTimes, double *factors, int numTimes)
+{
+  for (int i = 0; i < numTimes; i++)
+    factors[i] = this->getFactor(pseudoTimes[i]);
+
+  return 0;
+}
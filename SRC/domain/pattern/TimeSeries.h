@@ -56,6 +56,9 @@ class TimeSeries : public TaggedObject, public MovableObject
     virtual double getDuration () = 0;
     virtual double getPeakFactor () = 0;
 
+    // factors at a number of times, in the order given
+    virtual int getFactors(const double *pseudoTimes, double *factors, int numTimes);
+
     virtual double getTimeIncr (double pseudoTime) = 0;
     // This is defined to be the time increment from the argument
     // 'pseudoTime' to the NEXT point in the time series path
@@ -0,0 +1,430 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/domain/pattern/TimeSeriesCache.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of TimeSeriesCache.
+//
+// What: "@(#) TimeSeriesCache.C, revA"
+
+#include <TimeSeriesCache.h>
+#include <PeerNGAMotion.h>
+#include <Vector.h>
+#include <OPS_Globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <map>
+#include <string>
+using std::map;
+using std::string;
+
+struct TimeSeriesCacheEntry
+{
+  double *values;
+  int numValues;
+  double dt;
+  int refCount;
+  void *mappedData;    // start of the mapped file, 0 if values is new'ed
+  size_t mappedSize;
+};
+
+typedef map<string, TimeSeriesCacheEntry>           MAP_TIMESERIES_TYPE;
+typedef MAP_TIMESERIES_TYPE::iterator               MAP_TIMESERIES_ITERATOR;
+
+static MAP_TIMESERIES_TYPE theCachedSeries;
+
+
+// reads the whole file, terminated by a 0
+static char *
+readFile(const char *fileName, long &numBytes)
+{
+  FILE *theFile = fopen(fileName, "rb");
+  if (theFile == 0)
+    return 0;
+
+  fseek(theFile, 0, SEEK_END);
+  numBytes = ftell(theFile);
+  fseek(theFile, 0, SEEK_SET);
+  if (numBytes < 0) {
+    fclose(theFile);
+    return 0;
+  }
+
+  char *data = new char[numBytes+1];
+  if (numBytes > 0 && fread(data, 1, numBytes, theFile) != (size_t)numBytes) {
+    delete [] data;
+    fclose(theFile);
+    return 0;
+  }
+  data[numBytes] = '\0';
+  fclose(theFile);
+
+  return data;
+}
+
+
+// all the numbers of the text, up to the first thing that is not one
+static double *
+parseText(const char *text, int &numValues)
+{
+  int maxValues = 1024;
+  double *values = new double[maxValues];
+  numValues = 0;
+
+  const char *ptr = text;
+  while (true) {
+    char *end;
+    double value = strtod(ptr, &end);
+    if (end == ptr)
+      break;
+    ptr = end;
+
+    if (numValues == maxValues) {
+      double *newValues = new double[2*maxValues];
+      memcpy(newValues, values, numValues*sizeof(double));
+      delete [] values;
+      values = newValues;
+      maxValues *= 2;
+    }
+    values[numValues++] = value;
+  }
+
+  return values;
+}
+
+
+static int
+readHeader(const char *header, long numBytes, const char *fileName,
+	   int &numValues, double &dt)
+{
+  if (numBytes < TIME_SERIES_HEADER_SIZE || memcmp(header, TIME_SERIES_FILE_MAGIC, 8) != 0)
+    return -1;
+
+  int info[4];
+  memcpy(info, &header[8], 4*sizeof(int));
+  if (info[0] != 0x01020304) {
+    opserr << "WARNING TimeSeriesCache - " << fileName;
+    opserr << " was written on a machine with a different byte order\n";
+    return -1;
+  }
+  if (info[1] != TIME_SERIES_FILE_VERSION) {
+    opserr << "WARNING TimeSeriesCache - " << fileName << " has unknown version " << info[1] << endln;
+    return -1;
+  }
+
+  numValues = info[2];
+  memcpy(&dt, &header[24], sizeof(double));
+  if (numValues < 0 || TIME_SERIES_HEADER_SIZE + (long)numValues*(long)sizeof(double) > numBytes) {
+    opserr << "WARNING TimeSeriesCache - " << fileName << " is truncated\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+
+bool
+isTimeSeriesFile(const char *fileName)
+{
+  FILE *theFile = fopen(fileName, "rb");
+  if (theFile == 0)
+    return false;
+
+  char magic[8];
+  bool result = (fread(magic, 1, 8, theFile) == 8 && memcmp(magic, TIME_SERIES_FILE_MAGIC, 8) == 0);
+  fclose(theFile);
+
+  return result;
+}
+
+
+static int
+loadEntry(const char *fileName, TimeSeriesCacheEntry &theEntry)
+{
+  theEntry.values = 0;
+  theEntry.numValues = 0;
+  theEntry.dt = 0.0;
+  theEntry.refCount = 0;
+  theEntry.mappedData = 0;
+  theEntry.mappedSize = 0;
+
+#ifndef _WIN32
+  // binary files are mapped, nothing is copied
+  if (isTimeSeriesFile(fileName) == true) {
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+      return -1;
+
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) != 0) {
+      close(fd);
+      return -1;
+    }
+
+    size_t size = fileInfo.st_size;
+    void *mappedData = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mappedData == MAP_FAILED)
+      return -1;
+
+    if (readHeader((const char *)mappedData, size, fileName, theEntry.numValues, theEntry.dt) < 0) {
+      munmap(mappedData, size);
+      return -1;
+    }
+
+    theEntry.values = (double *)((char *)mappedData + TIME_SERIES_HEADER_SIZE);
+    theEntry.mappedData = mappedData;
+    theEntry.mappedSize = size;
+    return 0;
+  }
+#endif
+
+  long numBytes = 0;
+  char *data = readFile(fileName, numBytes);
+  if (data == 0)
+    return -1;
+
+  if (numBytes >= 8 && memcmp(data, TIME_SERIES_FILE_MAGIC, 8) == 0) {
+    // binary file read into memory where it can not be mapped
+    int result = readHeader(data, numBytes, fileName, theEntry.numValues, theEntry.dt);
+    if (result == 0) {
+      theEntry.values = new double[(theEntry.numValues > 0) ? theEntry.numValues : 1];
+      memcpy(theEntry.values, &data[TIME_SERIES_HEADER_SIZE], theEntry.numValues*sizeof(double));
+    }
+    delete [] data;
+    return result;
+  }
+
+  theEntry.values = parseText(data, theEntry.numValues);
+  delete [] data;
+
+  return 0;
+}
+
+
+static void
+freeEntry(TimeSeriesCacheEntry &theEntry)
+{
+#ifndef _WIN32
+  if (theEntry.mappedData != 0) {
+    munmap(theEntry.mappedData, theEntry.mappedSize);
+    return;
+  }
+#endif
+  if (theEntry.values != 0)
+    delete [] theEntry.values;
+}
+
+
+double *
+TimeSeriesCache::getValues(const char *fileName, int &numValues, double *dt)
+{
+  numValues = -1;
+
+  // the key changes when the file is rewritten
+  struct stat fileInfo;
+  if (stat(fileName, &fileInfo) != 0)
+    return 0;
+
+  // st_mtime is in seconds, a file rewritten within the same second is
+  // told apart by the nanoseconds and, if it was replaced, by the inode
+  long mtimeNsec = 0;
+#if defined(__APPLE__)
+  mtimeNsec = (long)fileInfo.st_mtimespec.tv_nsec;
+#elif !defined(_WIN32)
+  mtimeNsec = (long)fileInfo.st_mtim.tv_nsec;
+#endif
+
+  char fileKey[128];
+  sprintf(fileKey, ":%ld:%ld:%ld:%lu", (long)fileInfo.st_size, (long)fileInfo.st_mtime,
+	  mtimeNsec, (unsigned long)fileInfo.st_ino);
+  string key(fileName);
+  key += fileKey;
+
+  MAP_TIMESERIES_ITERATOR theSeries = theCachedSeries.find(key);
+  if (theSeries == theCachedSeries.end()) {
+    TimeSeriesCacheEntry theEntry;
+    if (loadEntry(fileName, theEntry) < 0)
+      return 0;
+
+    // nothing is kept for a file without data
+    if (theEntry.numValues == 0) {
+      freeEntry(theEntry);
+      numValues = 0;
+      return 0;
+    }
+
+    theSeries = theCachedSeries.insert(MAP_TIMESERIES_TYPE::value_type(key, theEntry)).first;
+  }
+
+  TimeSeriesCacheEntry &theEntry = theSeries->second;
+  theEntry.refCount++;
+
+  numValues = theEntry.numValues;
+  if (dt != 0)
+    *dt = theEntry.dt;
+
+  return theEntry.values;
+}
+
+
+void
+TimeSeriesCache::retain(const double *values)
+{
+  MAP_TIMESERIES_ITERATOR theSeries = theCachedSeries.begin();
+  for ( ; theSeries != theCachedSeries.end(); theSeries++)
+    if ((theSeries->second).values == values) {
+      (theSeries->second).refCount++;
+      return;
+    }
+}
+
+
+void
+TimeSeriesCache::release(const double *values)
+{
+  MAP_TIMESERIES_ITERATOR theSeries = theCachedSeries.begin();
+  for ( ; theSeries != theCachedSeries.end(); theSeries++)
+    if ((theSeries->second).values == values) {
+      TimeSeriesCacheEntry &theEntry = theSeries->second;
+      theEntry.refCount--;
+      if (theEntry.refCount <= 0) {
+	freeEntry(theEntry);
+	theCachedSeries.erase(theSeries);
+      }
+      return;
+    }
+}
+
+
+int
+TimeSeriesCache::writeFile(const char *fileName, const double *values,
+			   int numValues, double dt)
+{
+  FILE *theFile = fopen(fileName, "wb");
+  if (theFile == 0) {
+    opserr << "WARNING TimeSeriesCache::writeFile() - could not open file " << fileName << endln;
+    return -1;
+  }
+
+  char header[TIME_SERIES_HEADER_SIZE];
+  memcpy(header, TIME_SERIES_FILE_MAGIC, 8);
+  int info[4];
+  info[0] = 0x01020304;
+  info[1] = TIME_SERIES_FILE_VERSION;
+  info[2] = numValues;
+  info[3] = 0;
+  memcpy(&header[8], info, 4*sizeof(int));
+  memcpy(&header[24], &dt, sizeof(double));
+
+  int result = 0;
+  if (fwrite(header, 1, TIME_SERIES_HEADER_SIZE, theFile) != TIME_SERIES_HEADER_SIZE ||
+      (numValues > 0 && fwrite(values, sizeof(double), numValues, theFile) != (size_t)numValues)) {
+    opserr << "WARNING TimeSeriesCache::writeFile() - could not write file " << fileName << endln;
+    result = -1;
+  }
+  fclose(theFile);
+
+  return result;
+}
+
+
+int
+textToTimeSeriesFile(const char *inputFilename, const char *outputFilename, bool peerNGA)
+{
+  long numBytes = 0;
+  char *data = readFile(inputFilename, numBytes);
+  if (data == 0) {
+    opserr << "WARNING textToTimeSeriesFile() - could not open file " << inputFilename << endln;
+    return -1;
+  }
+
+  int result;
+  if (peerNGA == true) {
+    double dt = 0.0;
+    Vector *thePath = PeerNGAMotion::parseRecord(data, dt);
+    if (thePath == 0) {
+      opserr << "WARNING textToTimeSeriesFile() - no record in file " << inputFilename << endln;
+      result = -1;
+    } else {
+      result = TimeSeriesCache::writeFile(outputFilename, &(*thePath)(0), thePath->Size(), dt);
+      delete thePath;
+    }
+  } else {
+    int numValues;
+    double *values = parseText(data, numValues);
+    result = TimeSeriesCache::writeFile(outputFilename, values, numValues, 0.0);
+    delete [] values;
+  }
+
+  delete [] data;
+  return result;
+}
+
+
+int
+timeSeriesFileToText(const char *inputFilename, const char *outputFilename)
+{
+  long numBytes = 0;
+  char *data = readFile(inputFilename, numBytes);
+  if (data == 0) {
+    opserr << "WARNING timeSeriesFileToText() - could not open file " << inputFilename << endln;
+    return -1;
+  }
+
+  int numValues;
+  double dt;
+  if (readHeader(data, numBytes, inputFilename, numValues, dt) < 0) {
+    delete [] data;
+    return -1;
+  }
+
+  FILE *theFile = fopen(outputFilename, "w");
+  if (theFile == 0) {
+    opserr << "WARNING timeSeriesFileToText() - could not open file " << outputFilename << endln;
+    delete [] data;
+    return -1;
+  }
+
+  const double *values = (const double *)&data[TIME_SERIES_HEADER_SIZE];
+  for (int i = 0; i < numValues; i++) {
+    double value;
+    memcpy(&value, &values[i], sizeof(double));
+    fprintf(theFile, "%.17g\n", value);
+  }
+
+  fclose(theFile);
+  delete [] data;
+
+  return 0;
+}
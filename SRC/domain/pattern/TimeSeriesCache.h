@@ -0,0 +1,67 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/domain/pattern/TimeSeriesCache.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for TimeSeriesCache.
+// The TimeSeriesCache reads the values of a time series file once for the
+// whole process: every PathSeries, PathTimeSeries or GroundMotionRecord
+// created from the same file shares the same values, which are released
+// when the last of them is deleted. The key is the file name together with
+// its size and modification time, so a file rewritten during the run is
+// read again.
+//
+// A file is either text, all the numbers in it being read, or a binary
+// time series file, which is mapped into memory read only:
+//   "OPSTS1\n\0", 0x01020304, version, numValues, 0 (all ints 32 bit),
+//   dt (double, 0 if not known), numValues doubles
+// in the byte order of the writer. Binary files are written from text or
+// PEER NGA (.AT2) files with convertTextToBinary.
+//
+// What: "@(#) TimeSeriesCache.h, revA"
+
+#ifndef TimeSeriesCache_h
+#define TimeSeriesCache_h
+
+#define TIME_SERIES_FILE_MAGIC   "OPSTS1\n"
+#define TIME_SERIES_FILE_VERSION 1
+#define TIME_SERIES_HEADER_SIZE  32
+
+bool isTimeSeriesFile(const char *fileName);
+int textToTimeSeriesFile(const char *inputFilename, const char *outputFilename,
+			 bool peerNGA = false);
+int timeSeriesFileToText(const char *inputFilename, const char *outputFilename);
+
+class TimeSeriesCache
+{
+ public:
+  // numValues is -1 if the file could not be read; the values must not
+  // be changed and are given back with release()
+  static double *getValues(const char *fileName, int &numValues, double *dt = 0);
+  static void retain(const double *values);
+  static void release(const double *values);
+
+  static int writeFile(const char *fileName, const double *values,
+		       int numValues, double dt);
+};
+
+#endif
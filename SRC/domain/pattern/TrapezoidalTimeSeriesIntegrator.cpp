@@ -88,19 +88,28 @@ TrapezoidalTimeSeriesIntegrator::integrate(TimeSeries *theSeries, double delta)
   double previousValue; // Temporary storage to avoid accessing same value twice
 	                        // through identical method calls
   double currentValue;
+
+  // get all the factors in one call
+  double *theTimes = new double[2*numSteps];
+  double *theFactors = &theTimes[numSteps];
+  theTimes[0] = 0.0;
+  dummyTime = delta;
+  for (i = 1; i < numSteps; i++, dummyTime += delta)
+    theTimes[i] = dummyTime;
+  theSeries->getFactors(theTimes, theFactors, numSteps);
       
   // Set the first point
   // Assuming initial condition is zero, i.e. F(0) = 0
 
 
-  (*theIntegratedValues)[0] = theSeries->getFactor(0.0) * delta * 0.5;
+  (*theIntegratedValues)[0] = theFactors[0] * delta * 0.5;
 
   previousValue = (*theIntegratedValues)[0];
   
   dummyTime = delta;
     
   for (i = 1; i < numSteps; i++, dummyTime += delta) {
-    currentValue = theSeries->getFactor(dummyTime);
+    currentValue = theFactors[i];
     
     // Apply the trapezoidal rule to update the integrated value
     (*theIntegratedValues)[i] = (*theIntegratedValues)[i-1] +
@@ -109,6 +118,8 @@ TrapezoidalTimeSeriesIntegrator::integrate(TimeSeries *theSeries, double delta)
     previousValue = currentValue;
   }
 
+  delete [] theTimes;
+
   /*
   // Set the last point
   (*theIntegratedValues)[i] = (*theIntegratedValues)[i-1] +
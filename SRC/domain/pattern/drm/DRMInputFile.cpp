@@ -0,0 +1,302 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/domain/pattern/drm/DRMInputFile.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of DRMInputFile.
+//
+// What: "@(#) DRMInputFile.C, revA"
+
+#include <DRMInputFile.h>
+#include <OPS_Globals.h>
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#define DRM_SEEK _fseeki64
+typedef __int64 drm_offset;
+#else
+#include <sys/types.h>
+#define DRM_SEEK fseeko
+typedef off_t drm_offset;
+#endif
+
+// values converted or skipped at a time
+#define DRM_INPUT_BLOCK_SIZE 65536
+
+static int
+readHeader(FILE *theFile)
+{
+  char magic[8];
+  int info[2];
+  if (fread(magic, 1, 8, theFile) != 8 || memcmp(magic, DRM_INPUT_FILE_MAGIC, 8) != 0)
+    return -1;
+  if (fread(info, sizeof(int), 2, theFile) != 2)
+    return -1;
+  if (info[0] != 0x01020304) {
+    opserr << "WARNING DRMInputFile - file was written on a machine of different byte order\n";
+    return -2;
+  }
+  if (info[1] != DRM_INPUT_FILE_VERSION) {
+    opserr << "WARNING DRMInputFile - unknown version " << info[1] << endln;
+    return -2;
+  }
+  return 0;
+}
+
+bool
+isDRMInputFile(const char *fileName)
+{
+  FILE *theFile = fopen(fileName, "rb");
+  if (theFile == 0)
+    return false;
+
+  char magic[8];
+  bool result = (fread(magic, 1, 8, theFile) == 8 &&
+		 memcmp(magic, DRM_INPUT_FILE_MAGIC, 8) == 0);
+  fclose(theFile);
+  return result;
+}
+
+int
+textToDRMInputFile(const char *inputFilename, const char *outputFilename)
+{
+  FILE *in = fopen(inputFilename, "r");
+  if (in == 0) {
+    opserr << "textToDRMInputFile - could not open file " << inputFilename << endln;
+    return -1;
+  }
+  FILE *out = fopen(outputFilename, "wb");
+  if (out == 0) {
+    opserr << "textToDRMInputFile - could not open file " << outputFilename << endln;
+    fclose(in);
+    return -1;
+  }
+
+  int info[2];
+  info[0] = 0x01020304;
+  info[1] = DRM_INPUT_FILE_VERSION;
+  fwrite(DRM_INPUT_FILE_MAGIC, 1, 8, out);
+  fwrite(info, sizeof(int), 2, out);
+
+  // the text is parsed a block at a time, the number cut at the end of
+  // a block is moved to the front of the next one
+  char *text = new char[DRM_INPUT_BLOCK_SIZE+1];
+  double *values = new double[DRM_INPUT_BLOCK_SIZE];
+  int numValues = 0;
+  int numText = 0;
+  int result = 0;
+  bool done = false;
+
+  while (done == false) {
+    int numRead = fread(&text[numText], 1, DRM_INPUT_BLOCK_SIZE - numText, in);
+    numText += numRead;
+    done = (numText < DRM_INPUT_BLOCK_SIZE);
+    text[numText] = '\0';
+
+    char *start = text;
+    char *end = &text[numText];
+    if (done == false) {
+      // keep the last, possibly incomplete, number for the next block
+      while (end > start && strchr(" \t\r\n,", end[-1]) == 0)
+	end--;
+      if (end == start) {
+	opserr << "textToDRMInputFile - value too long in file " << inputFilename << endln;
+	result = -1;
+	break;
+      }
+    }
+
+    char *next;
+    while (start < end) {
+      // skip the separators here, strtod() would run past the end
+      if (strchr(" \t\r\n,", *start) != 0) {
+	start++;
+	continue;
+      }
+      double value = strtod(start, &next);
+      if (next == start) {
+	opserr << "textToDRMInputFile - could not read a value in file " << inputFilename << endln;
+	result = -1;
+	done = true;
+	break;
+      }
+      values[numValues++] = value;
+      if (numValues == DRM_INPUT_BLOCK_SIZE) {
+	fwrite(values, sizeof(double), numValues, out);
+	numValues = 0;
+      }
+      start = next;
+    }
+
+    numText = &text[numText] - end;
+    memmove(text, end, numText);
+  }
+
+  if (numValues != 0)
+    fwrite(values, sizeof(double), numValues, out);
+
+  if (ferror(out) != 0) {
+    opserr << "textToDRMInputFile - could not write file " << outputFilename << endln;
+    result = -1;
+  }
+
+  delete [] text;
+  delete [] values;
+  fclose(in);
+  fclose(out);
+
+  return result;
+}
+
+int
+drmInputFileToText(const char *inputFilename, const char *outputFilename)
+{
+  FILE *in = fopen(inputFilename, "rb");
+  if (in == 0) {
+    opserr << "drmInputFileToText - could not open file " << inputFilename << endln;
+    return -1;
+  }
+  if (readHeader(in) != 0) {
+    opserr << "drmInputFileToText - " << inputFilename << " is not a DRM input file\n";
+    fclose(in);
+    return -1;
+  }
+  FILE *out = fopen(outputFilename, "w");
+  if (out == 0) {
+    opserr << "drmInputFileToText - could not open file " << outputFilename << endln;
+    fclose(in);
+    return -1;
+  }
+
+  // three values, the motion of a grid point, on each line
+  double *values = new double[DRM_INPUT_BLOCK_SIZE];
+  int count = 0;
+  int numRead;
+  while ((numRead = fread(values, sizeof(double), DRM_INPUT_BLOCK_SIZE, in)) > 0) {
+    for (int i=0; i<numRead; i++) {
+      fprintf(out, "%.17g", values[i]);
+      count++;
+      fputc((count % 3 == 0) ? '\n' : ' ', out);
+    }
+  }
+  if (count % 3 != 0)
+    fputc('\n', out);
+
+  delete [] values;
+  fclose(in);
+  fclose(out);
+
+  return 0;
+}
+
+DRMInputFile::DRMInputFile()
+  :theBinary(0)
+{
+
+}
+
+DRMInputFile::~DRMInputFile()
+{
+  if (theBinary != 0)
+    fclose(theBinary);
+}
+
+int
+DRMInputFile::open(const char *fileName)
+{
+  if (isDRMInputFile(fileName) == true) {
+    theBinary = fopen(fileName, "rb");
+    if (theBinary == 0 || readHeader(theBinary) != 0) {
+      opserr << "WARNING DRMInputFile::open() - could not read file " << fileName << endln;
+      return -1;
+    }
+    return 0;
+  }
+
+  theText.open(fileName);
+  if (theText.bad() || !theText.is_open()) {
+    opserr << "WARNING DRMInputFile::open() - could not open file " << fileName << endln;
+    return -1;
+  }
+
+  return 0;
+}
+
+bool
+DRMInputFile::isBinary(void)
+{
+  return (theBinary != 0);
+}
+
+int
+DRMInputFile::read(double *data, int numPoints, const char *mask)
+{
+  if (theBinary == 0) {
+    // all the text has to be parsed, the values not needed are stored too
+    int result = 0;
+    double value;
+    for (int i=0; i<3*numPoints; i++) {
+      if (theText >> value)
+	data[i] = value;
+      else {
+	data[i] = 0.0;
+	result = -1;
+      }
+    }
+    return result;
+  }
+
+  // read the runs of needed points, seek over the others
+  int result = 0;
+  drm_offset skip = 0;
+  int i = 0;
+  while (i < numPoints) {
+    int j = i;
+    if (mask != 0 && mask[i] == 0) {
+      while (j < numPoints && mask[j] == 0)
+	j++;
+      for (int k=3*i; k<3*j; k++)
+	data[k] = 0.0;
+      skip += (drm_offset)(3*(j-i))*sizeof(double);
+    } else {
+      while (j < numPoints && (mask == 0 || mask[j] != 0))
+	j++;
+      if (skip != 0) {
+	DRM_SEEK(theBinary, skip, SEEK_CUR);
+	skip = 0;
+      }
+      int numValues = 3*(j-i);
+      int numRead = fread(&data[3*i], sizeof(double), numValues, theBinary);
+      for (int k=3*i+numRead; k<3*j; k++)
+	data[k] = 0.0;
+      if (numRead < numValues)
+	result = -1;
+    }
+    i = j;
+  }
+
+  if (skip != 0)
+    DRM_SEEK(theBinary, skip, SEEK_CUR);
+
+  return result;
+}
@@ -0,0 +1,69 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/domain/pattern/drm/DRMInputFile.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for DRMInputFile.
+// A DRMInputFile reads the free field motions of one face of the DRM box
+// as a stream of values, three for each grid point and time step. The file
+// is either text, as written by the free field programs, or binary:
+//   "OPSDRM1\n", 0x01020304, version (ints 32 bit), the values as doubles
+// in the byte order of the writer. Binary files are written from the text
+// files with convertTextToBinary -drm. In a binary file the grid points
+// not needed by the process are skipped instead of being read.
+//
+// What: "@(#) DRMInputFile.h, revA"
+
+#ifndef DRMInputFile_h
+#define DRMInputFile_h
+
+#include <fstream>
+#include <stdio.h>
+
+#define DRM_INPUT_FILE_MAGIC   "OPSDRM1\n"
+#define DRM_INPUT_FILE_VERSION 1
+#define DRM_INPUT_HEADER_SIZE  16
+
+bool isDRMInputFile(const char *fileName);
+int textToDRMInputFile(const char *inputFilename, const char *outputFilename);
+int drmInputFileToText(const char *inputFilename, const char *outputFilename);
+
+class DRMInputFile
+{
+ public:
+  DRMInputFile();
+  ~DRMInputFile();
+
+  int open(const char *fileName);
+  bool isBinary(void);
+
+  // reads the next numPoints grid points into data, the points for which
+  // mask is 0 are set to 0, as are the values past the end of the file;
+  // a missing mask reads all of them. Returns -1 at the end of the file.
+  int read(double *data, int numPoints, const char *mask = 0);
+
+ private:
+  std::ifstream theText;
+  FILE *theBinary;
+};
+
+#endif
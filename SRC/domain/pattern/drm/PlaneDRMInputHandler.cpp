@@ -8,6 +8,7 @@
  */
 
 #include "PlaneDRMInputHandler.h"
+#include <string.h>
 
 Vector PlaneDRMInputHandler::Vtm2(24);
 Vector PlaneDRMInputHandler::Vtm1(24);
@@ -112,39 +113,22 @@ PlaneDRMInputHandler::PlaneDRMInputHandler(int tag, char** in_files, int files,
     exit(-1);
   }
 	
-  // Open File streams
+  // Open File streams, text or binary
   
-  this->ifile1.open(filePtrs[0]);
-  this->ifile2.open(filePtrs[1]);
-  this->ifile3.open(filePtrs[2]);
-  this->ifile4.open(filePtrs[3]);
-  this->ifile5a.open(filePtrs[4]);
-  this->ifile5b.open(filePtrs[5]);
-
-  if (ifile1.bad() ) {
-    opserr << " Bad file 1 " << endln;
-    exit(-1);
-  }
-  if (ifile2.bad() ) {
-    opserr << " Bad file 2 " << endln;
-    exit(-1);
-  }
-  if (ifile3.bad() ) {
-    opserr << " Bad file 3 " << endln;
-    exit(-1);
-  }
-  if (ifile4.bad() ) {
-    opserr << " Bad file 4 " << endln;
-    exit(-1);
-  }
-  if (ifile5a.bad() ) {
-    opserr << " Bad file 5a " << endln;
-    exit(-1);
+  static const char *fileNames[6] = {"1", "2", "3", "4", "5a", "5b"};
+  for (int i=0; i<6; i++) {
+    if (theFiles[i].open(filePtrs[i]) != 0) {
+      opserr << " Bad file " << fileNames[i] << endln;
+      exit(-1);
+    }
   }
-  if (ifile5b.bad() ) {
-    opserr << " Bad file 5b " << endln;
-    exit(-1);
+
+  // buffers for the steps read ahead
+  for (int i=0; i<5; i++) {
+    this->nextBuffers[i] = new double[3*(this->cacheValue + 1)*this->fileData[3*i]];
+    this->pointMasks[i] = 0;
   }
+  this->reading = false;
 
   this->cacheValue = cacheValue;
   this->initial = true;
@@ -169,12 +153,24 @@ PlaneDRMInputHandler::PlaneDRMInputHandler(int tag, char** in_files, int files,
 
   nd1 = _nd1;
   nd2 = _nd2;
+  if (nd1 + nd2 > this->fileData[12]) {
+    opserr << " grid points of files 5a and 5b exceed those of face 5 " << endln;
+    exit(-1);
+  }
 
-  populateBuffers();
+  // the buffers are first filled in getIndex(), once the elements of the
+  // pattern are known
 }
 
 PlaneDRMInputHandler::~PlaneDRMInputHandler()
 {
+  this->waitReading();
+  for (int i=0; i<5; i++) {
+    delete [] nextBuffers[i];
+    if (pointMasks[i] != 0)
+      delete [] pointMasks[i];
+  }
+
   delete [] f1buffer;
   delete [] f2buffer;
   delete [] f3buffer;
@@ -195,53 +191,25 @@ void PlaneDRMInputHandler::populateBuffers()
   
   if (this->initial) {
     
-    int temp = this->fileData[0];
-    double dataIn;
-    for (int i=0; i<3*temp; i++) {
-      f1buffer[i] = 0.0;
-    }
-    for (int i=3*temp; i<3*(cacheValue + 4)*temp; i++) {
-      ifile1 >> dataIn;
-      f1buffer[i] = dataIn;
-    }
-    temp = this->fileData[3];
-    for (int i=0; i<3*temp; i++) {
-      f2buffer[i] = 0.0;
-    }
-    for (int i=3*temp; i<3*(cacheValue + 4)*temp; i++) {
-      ifile2 >> dataIn;
-      f2buffer[i] = dataIn;
-    }
-    temp = this->fileData[6];
-    for (int i=0; i<3*temp; i++) {
-      f3buffer[i] = 0.0;
-    }
-    for (int i=3*temp; i<3*(cacheValue + 4)*temp; i++) {
-      ifile3 >> dataIn;
-      f3buffer[i] = dataIn;
-    }
-    temp = this->fileData[9];
-    for (int i=0; i<3*temp; i++) {
-      f4buffer[i] = 0.0;
-    }
-    for (int i=3*temp; i<3*(cacheValue + 4)*temp; i++) {
-      ifile4 >> dataIn;
-      f4buffer[i] = dataIn;
+    // binary files are only read at the grid points of the local elements
+    this->setPointMasks();
+
+    for (int f=0; f<4; f++) {
+      int temp = this->fileData[3*f];
+      for (int i=0; i<3*temp; i++) {
+	buffers[f][i] = 0.0;
+      }
+      for (int k=1; k<(cacheValue +4); k++)
+	theFiles[f].read(&buffers[f][3*k*temp], temp, pointMasks[f]);
     }
-    temp = this->fileData[12];
+    int temp = this->fileData[12];
     for (int i=0; i<3*temp; i++) {
       f5buffer[i] = 0.0;
     }
-    int index = 3*temp;
     for (int k=1; k<(cacheValue +4); k++) {
-      for (int i=0; i<3*nd1; i++) {
-	ifile5a >> dataIn;
-	f5buffer[index++] = dataIn;
-      }
-      for (int i=0; i<3*nd2; i++) {
-	ifile5b >> dataIn;
-	f5buffer[index++] = dataIn;
-      }
+      theFiles[4].read(&f5buffer[3*k*temp], nd1, pointMasks[4]);
+      theFiles[5].read(&f5buffer[3*k*temp + 3*nd1], nd2, 
+		       (pointMasks[4] != 0) ? &pointMasks[4][nd1] : 0);
     } 
     initial = false;
     globalCounter += cacheValue + 1;
@@ -263,69 +231,21 @@ void PlaneDRMInputHandler::populateBuffers()
     else {
       rem = cacheValue;
     }
-    int temp = this->fileData[0];
-    for (int i=0; i<3*temp; i++) {
-      f1buffer[i] = f1buffer[i+ 3*(cacheValue+1)*temp];
-      f1buffer[i+3*temp] = f1buffer[i+3*(cacheValue+2)*temp];			
-      f1buffer[i+6*temp] = f1buffer[i+3*(cacheValue+3)*temp];			
-    }
-    double dataIn=0.0;
-    for (int i=9*temp; i<3*(rem + 4)*temp; i++) {
-      ifile1 >> dataIn;
-      f1buffer[i] = dataIn;
-    }
-    temp = this->fileData[3];
-    for (int i=0; i<3*temp; i++) {
-      f2buffer[i] = f2buffer[i+ 3*(cacheValue+1)*temp];
-      f2buffer[i+3*temp] = f2buffer[i+3*(cacheValue+2)*temp];			
-      f2buffer[i+6*temp] = f2buffer[i+3*(cacheValue+3)*temp];			
-    }
-    dataIn=0.0;
-    for (int i=9*temp; i<3*(rem + 4)*temp; i++) {
-      ifile2 >> dataIn;
-      f2buffer[i] = dataIn;
-    }
-    temp = this->fileData[6];
-    for (int i=0; i<3*temp; i++) {
-      f3buffer[i] = f3buffer[i+ 3*(cacheValue+1)*temp];
-      f3buffer[i+3*temp] = f3buffer[i+3*(cacheValue+2)*temp];			
-      f3buffer[i+6*temp] = f3buffer[i+3*(cacheValue+3)*temp];			
-    }
-    dataIn=0.0;
-    for (int i=9*temp; i<3*(rem + 4)*temp; i++) {
-      ifile3 >> dataIn;
-      f3buffer[i] = dataIn;
-    }
-    temp = this->fileData[9];
-    for (int i=0; i<3*temp; i++) {
-      f4buffer[i] = f4buffer[i+ 3*(cacheValue+1)*temp];
-      f4buffer[i+3*temp] = f4buffer[i+3*(cacheValue+2)*temp];			
-      f4buffer[i+6*temp] = f4buffer[i+3*(cacheValue+3)*temp];			
-    }
-    dataIn=0.0;
-    for (int i=9*temp; i<3*(rem + 4)*temp; i++) {
-      ifile4 >> dataIn;
-      f4buffer[i] = dataIn;
-    }
-    temp = this->fileData[12];
-    for (int i=0; i<3*temp; i++) {
-      f5buffer[i] = f5buffer[i+ 3*(cacheValue+1)*temp];
-      f5buffer[i+3*temp] = f5buffer[i+3*(cacheValue+2)*temp];			
-      f5buffer[i+6*temp] = f5buffer[i+3*(cacheValue+3)*temp];			
-    }
-    dataIn=0.0;
-    int index = 9*temp;
-    //need some change here for two files
-    //for (int i=6*temp; i<3*(rem + 3)*temp; i++) {
-    for (int k=3; k<(cacheValue +4); k++) {
-      for (int i=0; i<3*nd1; i++) {
-	ifile5a >> dataIn;
-	f5buffer[index++] = dataIn;
-      }
-      for (int i=0; i<3*nd2; i++) {
-	ifile5b >> dataIn;
-	f5buffer[index++] = dataIn;
+
+    // the next steps have been read while the current ones were used
+    this->waitReading();
+
+    for (int f=0; f<5; f++) {
+      int temp = this->fileData[3*f];
+      double* buffer = buffers[f];
+      for (int i=0; i<3*temp; i++) {
+	buffer[i] = buffer[i+ 3*(cacheValue+1)*temp];
+	buffer[i+3*temp] = buffer[i+3*(cacheValue+2)*temp];			
+	buffer[i+6*temp] = buffer[i+3*(cacheValue+3)*temp];			
       }
+      //face 5 was always refilled with all the steps
+      int numValues = (f < 4) ? 3*(rem+1)*temp : 3*(cacheValue+1)*temp;
+      memcpy(&buffer[9*temp], nextBuffers[f], numValues*sizeof(double));
     }
     globalCounter += cacheValue+1;
 
@@ -337,6 +257,155 @@ void PlaneDRMInputHandler::populateBuffers()
       timeBuf[3+i] = timeBuf[2+i]+this->deltaT;
     
   }
+
+  // start reading the steps of the next refill
+  if (numSteps - globalCounter >= 0)
+    this->startReading();
+}
+
+void PlaneDRMInputHandler::readNextSteps()
+{
+  for (int f=0; f<4; f++) {
+    int temp = this->fileData[3*f];
+    for (int k=0; k<(cacheValue +1); k++)
+      theFiles[f].read(&nextBuffers[f][3*k*temp], temp, pointMasks[f]);
+  }
+  int temp = this->fileData[12];
+  for (int k=0; k<(cacheValue +1); k++) {
+    theFiles[4].read(&nextBuffers[4][3*k*temp], nd1, pointMasks[4]);
+    theFiles[5].read(&nextBuffers[4][3*k*temp + 3*nd1], nd2, 
+		     (pointMasks[4] != 0) ? &pointMasks[4][nd1] : 0);
+  }
+}
+
+#ifdef _THREADS
+void *PlaneDRMInputHandler::readerMain(void *arg)
+{
+  ((PlaneDRMInputHandler *)arg)->readNextSteps();
+  return 0;
+}
+#endif
+
+void PlaneDRMInputHandler::startReading()
+{
+#ifdef _THREADS
+  if (pthread_create(&theReader, 0, PlaneDRMInputHandler::readerMain, this) == 0) {
+    reading = true;
+    return;
+  }
+#endif
+  // no thread, the steps are read now
+  this->readNextSteps();
+}
+
+void PlaneDRMInputHandler::waitReading()
+{
+#ifdef _THREADS
+  if (reading == true)
+    pthread_join(theReader, 0);
+#endif
+  reading = false;
+}
+
+void PlaneDRMInputHandler::setPointMasks()
+{
+  bool binary = false;
+  for (int i=0; i<6; i++)
+    if (theFiles[i].isBinary() == true)
+      binary = true;
+  if (binary == false)
+    return;
+
+  // a text file has to be parsed through anyway
+  if (fileData[12] != nd1 + nd2)
+    return;
+
+  for (int f=0; f<5; f++) {
+    int temp = fileData[3*f];
+    pointMasks[f] = new char[temp];
+    for (int i=0; i<temp; i++)
+      pointMasks[f][i] = 0;
+  }
+
+  // the face nodes of each element as in handle_elementAtfaceN()
+  static const int faceNodes[5][4] = {{1,2,5,6}, {0,3,4,7}, {0,1,4,5}, {3,2,7,6}, {0,1,2,3}};
+
+  double xMin = this->drm_box_Crds[0];
+  double xMax = this->drm_box_Crds[1];
+  double yMin = this->drm_box_Crds[2];
+  double yMax = this->drm_box_Crds[3];
+  double zMin = this->drm_box_Crds[4];
+  double zMax = this->drm_box_Crds[5];
+
+  for (std::map<int,Vector*>::iterator pos=ele_str.begin(); pos!=ele_str.end(); pos++) {
+    Element* eletag = myDomain->getElement(pos->first);
+    if (eletag == 0)
+      continue;
+
+    // same order of checks as getMotions()
+    this->myDecorator->setBrick(eletag);
+    int face = -1;
+    if (this->myDecorator->isLeftBoundary(xMin, xMax,  yMin,  yMax,  zMin,  zMax)) 
+      face = 1;
+    if (this->myDecorator->isRightBoundary(xMin,xMax,  yMin,  yMax,  zMin,  zMax)) 
+      face = 0;
+    if (this->myDecorator->isFrontBoundary(xMin,xMax,  yMin,  yMax,  zMin,  zMax)) 
+      face = 2;
+    if (this->myDecorator->isRearBoundary(xMin, xMax,  yMin,  yMax,  zMin,  zMax)) 
+      face = 3;
+    if (this->myDecorator->isBottomBoundary(xMin,xMax, yMin,  yMax,  zMin,  zMax)) 
+      face = 4;
+    if (face < 0)
+      continue;
+
+    Node** nodes = eletag->getNodePtrs();
+    int temp = fileData[3*face];
+    int numh = fileData[3*face+1];
+    for (int i=0; i<4; i++) {
+      int point = this->getPoint(nodes[faceNodes[face][i]], face);
+      // the point and its neighbours used in populateTempBuffers()
+      int used[4] = {point, point+1, point+numh+1, point+numh+2};
+      for (int j=0; j<4; j++)
+	if (used[j] >= 0 && used[j] < temp)
+	  pointMasks[face][used[j]] = 1;
+    }
+  }
+}
+
+int PlaneDRMInputHandler::getPoint(Node* node_tag, int face)
+{
+  // grid point in the file of the face, as in getfNpointer()
+  const Vector& crd = node_tag->getCrds();
+  double x = crd(0);
+  double y = crd(1);
+  double z = crd(2);
+  double dx = this->eleD[0];
+  double dy = this->eleD[1];
+  double dz = this->eleD[2];
+  int numh = this->fileData[3*face+1];
+  int numv = this->fileData[3*face+2];
+  int hloc, vloc;
+
+  switch (face) {
+  case 0:
+  case 1:
+    z = -z +numv*dz; //change of crds for cmu crd system
+    getLocations(y,z, dy,dz, &hloc, &vloc);
+    break;
+  case 2:
+  case 3:
+    x = -x +numh*dx; //change of crds for cmu crd system
+    z = -z +numv*dz;
+    getLocations(x,z, dx,dz, &hloc, &vloc);
+    break;
+  default:
+    x = -x +numh*dx; //change of crds for cmu crd system
+    y = -y +numv*dy;
+    getLocations(x,y, dx,dy, &hloc, &vloc);
+    break;
+  }
+
+  return (numh+1)*vloc + hloc;
 }
 
 void PlaneDRMInputHandler::getMotions(Element* eletag, double time, Vector& U, Vector& Ud, Vector& Udd)
@@ -594,7 +663,7 @@ int PlaneDRMInputHandler::getIndex(double time)
   // kill roundoffs
   double tmptime = time + 0.0000000001;
 
-  if (tmptime >= timeBuf[this->cacheValue+2]) {
+  if (this->initial || tmptime >= timeBuf[this->cacheValue+2]) {
     populateBuffers();
   }
 
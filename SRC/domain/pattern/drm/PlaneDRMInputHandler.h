@@ -19,8 +19,13 @@
 #include "DRMInputHandler.h"
 #include "GeometricBrickDecorator.h"
 #include "Mesh3DSubdomain.h"
+#include "DRMInputFile.h"
 #include <math.h>
 
+#ifdef _THREADS
+#include <pthread.h>
+#endif
+
 class PlaneDRMInputHandler : public DRMInputHandler {
   
  public:
@@ -51,6 +56,11 @@ class PlaneDRMInputHandler : public DRMInputHandler {
   void getf4pointer(Node* node_tag, int local_tag, int index);
   void pointerCopy(int node_from, int node_to);
   void populateTempBuffers(int index, int fileptr, double ksi, double eta);
+  void setPointMasks(void);
+  int getPoint(Node* node_tag, int face);
+  void readNextSteps(void);
+  void startReading(void);
+  void waitReading(void);
 
   
   private :
@@ -70,13 +80,20 @@ class PlaneDRMInputHandler : public DRMInputHandler {
   
   Domain* myDomain;
 
-  std::ifstream ifile1;
-  std::ifstream ifile2;
-  std::ifstream ifile3;
-  std::ifstream ifile4;
-  std::ifstream ifile5a;
-  std::ifstream ifile5b;
-  
+  // faces 1 to 4, 5a and 5b
+  DRMInputFile theFiles[6];
+
+  // the next cacheValue+1 steps of each face, read while the current
+  // ones are used; pointMasks marks the grid points used by the
+  // elements of this process, 0 if all are read
+  double* nextBuffers[5];
+  char* pointMasks[5];
+  bool reading;
+
+#ifdef _THREADS
+  static void *readerMain(void *arg);
+  pthread_t theReader;
+#endif
 
   static Vector Vtm2;
   static Vector Vtm1;
@@ -161,6 +161,58 @@ Subdomain::clearAll(void)
   if (externalNodes != 0)
     externalNodes->clearAll();
 }
+
+
+// int setStorage(TaggedObjectStorage &theStorage);
+//	Method to change the type of container used for the components of 
+//	an empty subdomain. Domain::setStorage() takes theStorage over for 
+//	the elements, the internal and external nodes are kept in empty 
+//	copies of it.
+
+int
+Subdomain::setStorage(TaggedObjectStorage &theStorage)
+{
+  if (internalNodes->getNumComponents() != 0 || 
+      externalNodes->getNumComponents() != 0) {
+    opserr << "Subdomain::setStorage() - subdomain is not empty\n";
+    return -1;
+  }
+
+  TaggedObjectStorage *newInternalNodes = theStorage.getEmptyCopy();
+  TaggedObjectStorage *newExternalNodes = theStorage.getEmptyCopy();
+
+  if (newInternalNodes == 0 || newExternalNodes == 0) {
+    opserr << "Subdomain::setStorage() - out of memory\n";
+    if (newInternalNodes != 0) delete newInternalNodes;
+    if (newExternalNodes != 0) delete newExternalNodes;
+    return -2;
+  }
+
+  int result = this->Domain::setStorage(theStorage);
+  if (result < 0) {
+    delete newInternalNodes;
+    delete newExternalNodes;
+    return result;
+  }
+
+  delete internalNodes;
+  delete externalNodes;
+  internalNodes = newInternalNodes;
+  externalNodes = newExternalNodes;
+
+  // the iters hold on to the old containers
+  delete internalNodeIter;
+  delete externalNodeIter;
+  internalNodeIter = new SingleDomNodIter(internalNodes);
+  externalNodeIter = new SingleDomNodIter(externalNodes);    
+
+  if (internalNodeIter == 0 || externalNodeIter == 0) {
+    opserr << "FATAL Subdomain::setStorage() - out of memory\n";
+    exit(-1);
+  }
+
+  return 0;
+}
 /*
 int 
 Subdomain::buildSubdomain(int numSubdomains, PartitionedModelBuilder &theBuilder)
@@ -243,6 +295,7 @@ Subdomain::removeNode(int tag)
         //	  Node *dummy = (Node *)object;
 	//	  object = realExternalNodes->removeComponent(tag);      	  
 	Node *result = (Node *)object;
+	this->releaseNodeState(result);
 	this->domainChange();          
 	//	  delete dummy;
 	return result;	  
@@ -251,6 +304,7 @@ Subdomain::removeNode(int tag)
   else {
       this->domainChange();          
       Node *result = (Node *)object;
+      this->releaseNodeState(result);
       return result;	  
   }
   
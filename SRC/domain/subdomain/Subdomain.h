@@ -76,6 +76,7 @@ class Subdomain: public Element, public Domain
 
     // Domain methods which must be rewritten
     virtual void clearAll(void);
+    virtual int setStorage(TaggedObjectStorage &theStorage);
     virtual bool addNode(Node *);	
     virtual Node *removeNode(int tag);        
     virtual NodeIter &getNodes(void);    
@@ -43,14 +43,14 @@
 #include <Matrix.h>
 #include <Node.h>
 #include <Domain.h>
+#include <WorkArea.h>
 
 
 Element  *ops_TheActiveElement = 0;
 
-Matrix **Element::theMatrices; 
-Vector **Element::theVectors1; 
-Vector **Element::theVectors2; 
-int  Element::numMatrices(0);
+// work area for the damping and mass matrices and the residual vectors
+// computed by the base class, one of each for every element size
+static WorkArea theWorkArea("Element");
 
 // Element(int tag, int noExtNodes);
 // 	constructor that takes the element's unique tag and the number
@@ -59,7 +59,7 @@ int  Element::numMatrices(0);
 Element::Element(int tag, int cTag) 
   :DomainComponent(tag, cTag), alphaM(0.0), 
   betaK(0.0), betaK0(0.0), betaKc(0.0), 
-  Kc(0), index(-1), nodeIndex(-1)
+  Kc(0), nodeIndex(-1)
 {
     // does nothing
   ops_TheActiveElement = this;
@@ -115,68 +115,6 @@ Element::setRayleighDampingFactors(double alpham, double betak, double betak0, d
   betaK0 = betak0;
   betaKc = betakc;
 
-  // check that memory has been allocated to store compute/return
-  // damping matrix & residual force calculations
-  if (index == -1) {
-    int numDOF = this->getNumDOF();
-
-    for (int i=0; i<numMatrices; i++) {
-      Matrix *aMatrix = theMatrices[i];
-      if (aMatrix->noRows() == numDOF) {
-	index = i;
-	i = numMatrices;
-      }
-    }
-    if (index == -1) {
-      Matrix **nextMatrices = new Matrix *[numMatrices+1];
-      if (nextMatrices == 0) {
-	opserr << "Element::getTheMatrix - out of memory\n";
-      }
-	  int j;
-      for (j=0; j<numMatrices; j++)
-	nextMatrices[j] = theMatrices[j];
-      Matrix *theMatrix = new Matrix(numDOF, numDOF);
-      if (theMatrix == 0) {
-	opserr << "Element::getTheMatrix - out of memory\n";
-	exit(-1);
-      }
-      nextMatrices[numMatrices] = theMatrix;
-
-      Vector **nextVectors1 = new Vector *[numMatrices+1];
-      Vector **nextVectors2 = new Vector *[numMatrices+1];
-      if (nextVectors1 == 0 || nextVectors2 == 0) {
-	opserr << "Element::getTheVector - out of memory\n";
-	exit(-1);
-      }
-
-      for (j=0; j<numMatrices; j++) {
-	nextVectors1[j] = theVectors1[j];
-	nextVectors2[j] = theVectors2[j];
-      }
-	
-      Vector *theVector1 = new Vector(numDOF);
-      Vector *theVector2 = new Vector(numDOF);
-      if (theVector1 == 0 || theVector2 == 0) {
-	opserr << "Element::getTheVector - out of memory\n";
-	exit(-1);
-      }
-
-      nextVectors1[numMatrices] = theVector1;
-      nextVectors2[numMatrices] = theVector2;
-
-      if (numMatrices != 0) {
-	delete [] theMatrices;
-	delete [] theVectors1;
-	delete [] theVectors2;
-      }
-      index = numMatrices;
-      numMatrices++;
-      theMatrices = nextMatrices;
-      theVectors1 = nextVectors1;
-      theVectors2 = nextVectors2;
-    }
-  }
-
   // if need storage for Kc go get it
   if (betaKc != 0.0) {  
     if (Kc == 0) 
@@ -198,12 +136,10 @@ Element::setRayleighDampingFactors(double alpham, double betak, double betak0, d
 const Matrix &
 Element::getDamp(void) 
 {
-  if (index  == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  int numDOF = this->getNumDOF();
 
   // now compute the damping matrix
-  Matrix *theMatrix = theMatrices[index]; 
+  Matrix *theMatrix = &theWorkArea.getMatrix(numDOF, numDOF); 
   theMatrix->Zero();
   if (alphaM != 0.0)
     theMatrix->addMatrix(0.0, this->getMass(), alphaM);
@@ -223,12 +159,10 @@ Element::getDamp(void)
 const Matrix &
 Element::getMass(void)
 {
-  if (index  == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  int numDOF = this->getNumDOF();
 
   // zero the matrix & return it
-  Matrix *theMatrix = theMatrices[index]; 
+  Matrix *theMatrix = &theWorkArea.getMatrix(numDOF, numDOF); 
   theMatrix->Zero();
   return *theMatrix;
 }
@@ -236,13 +170,11 @@ Element::getMass(void)
 const Vector &
 Element::getResistingForceIncInertia(void) 
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  int numDOF = this->getNumDOF();
 
-  Matrix *theMatrix = theMatrices[index]; 
-  Vector *theVector = theVectors2[index];
-  Vector *theVector2 = theVectors1[index];
+  Matrix *theMatrix = &theWorkArea.getMatrix(numDOF, numDOF); 
+  Vector *theVector = &theWorkArea.getVector(numDOF, 2);
+  Vector *theVector2 = &theWorkArea.getVector(numDOF, 1);
 
   //
   // perform: R = P(U) - Pext(t);
@@ -303,13 +235,11 @@ const Vector &
 Element::getRayleighDampingForces(void) 
 {
 
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  int numDOF = this->getNumDOF();
 
-  Matrix *theMatrix = theMatrices[index]; 
-  Vector *theVector = theVectors2[index];
-  Vector *theVector2 = theVectors1[index];
+  Matrix *theMatrix = &theWorkArea.getMatrix(numDOF, numDOF); 
+  Vector *theVector = &theWorkArea.getVector(numDOF, 2);
+  Vector *theVector2 = &theWorkArea.getVector(numDOF, 1);
 
   //
   // perform: R = (alphaM * M + betaK0 * K0 + betaK * K) * v
@@ -398,6 +328,12 @@ Element::isSubdomain(void)
     return false;
 }
 
+bool
+Element::isThreadSafe(void)
+{
+    return false;
+}
+
 Response*
 Element::setResponse(const char **argv, int argc, OPS_Stream &output)
 {
@@ -463,11 +399,9 @@ Element::getResponseSensitivity(int responseID, int gradIndex,
 const Vector &
 Element::getResistingForceSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  int numDOF = this->getNumDOF();
 
-  Vector *theVector = theVectors1[index];
+  Vector *theVector = &theWorkArea.getVector(numDOF, 1);
   theVector->Zero();
 
   return *theVector;
@@ -476,11 +410,9 @@ Element::getResistingForceSensitivity(int gradIndex)
 const Matrix &
 Element::getInitialStiffSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  int numDOF = this->getNumDOF();
 
-  Matrix *theMatrix = theMatrices[index];
+  Matrix *theMatrix = &theWorkArea.getMatrix(numDOF, numDOF);
   theMatrix->Zero();
 
   return *theMatrix;
@@ -489,11 +421,9 @@ Element::getInitialStiffSensitivity(int gradIndex)
 const Matrix &
 Element::getMassSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  int numDOF = this->getNumDOF();
 
-  Matrix *theMatrix = theMatrices[index];
+  Matrix *theMatrix = &theWorkArea.getMatrix(numDOF, numDOF);
   theMatrix->Zero();
 
   return *theMatrix;
@@ -519,12 +449,10 @@ Element::addInertiaLoadSensitivityToUnbalance(const Vector &accel, bool tag)
 const Matrix &
 Element::getDampSensitivity(int gradIndex) 
 {
-  if (index  == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
+  int numDOF = this->getNumDOF();
 
   // now compute the damping matrix
-  Matrix *theMatrix = theMatrices[index]; 
+  Matrix *theMatrix = &theWorkArea.getMatrix(numDOF, numDOF); 
   theMatrix->Zero();
   if (alphaM != 0.0) {
     theMatrix->addMatrix(0.0, this->getMassSensitivity(gradIndex), alphaM);
@@ -72,6 +72,11 @@ class Element : public DomainComponent
     virtual int revertToStart(void);                
     virtual int update(void);
     virtual bool isSubdomain(void);
+
+    // true if getTangentStiff(), getResistingForce() and the other state
+    // methods can be invoked on this object while other threads invoke them
+    // on other elements, i.e. the class keeps no shared (static) work space
+    virtual bool isThreadSafe(void);
     
     // methods to return the current linearized stiffness,
     // damping and mass matrices
@@ -119,12 +124,7 @@ class Element : public DomainComponent
     Matrix *Kc; // pointer to hold last committed matrix if needed for rayleigh damping
 
   private:
-    int index, nodeIndex;
-
-    static Matrix ** theMatrices; 
-    static Vector ** theVectors1; 
-    static Vector ** theVectors2; 
-    static int numMatrices;
+    int nodeIndex;
 };
 
 
@@ -35,28 +35,28 @@
 
 Information::Information() 
   :theType(UnknownType),
-   theID(0), theVector(0), theMatrix(0), theString(0)
+   theID(0), theVector(0), theMatrix(0), theString(0), theLocation(0)
 {
     // does nothing
 }
 
 Information::Information(int val) 
   :theType(IntType), theInt(val),
-  theID(0), theVector(0), theMatrix(0), theString(0)
+  theID(0), theVector(0), theMatrix(0), theString(0), theLocation(0)
 {
     // does nothing
 }
 
 Information::Information(double val) 
   :theType(DoubleType), theDouble(val),
-  theID(0), theVector(0), theMatrix(0), theString(0)
+  theID(0), theVector(0), theMatrix(0), theString(0), theLocation(0)
 {
   // does nothing
 }
 
 Information::Information(const ID &val) 
   :theType(IdType),
-  theID(0), theVector(0), theMatrix(0), theString(0)
+  theID(0), theVector(0), theMatrix(0), theString(0), theLocation(0)
 {
   // Make a copy
   theID = new ID(val);
@@ -67,7 +67,7 @@ Information::Information(const ID &val)
 
 Information::Information(const Vector &val) 
   :theType(VectorType),
-  theID(0), theVector(0), theMatrix(0), theString(0)
+  theID(0), theVector(0), theMatrix(0), theString(0), theLocation(0)
 {
   // Make a copy
   theVector = new Vector(val);
@@ -78,7 +78,7 @@ Information::Information(const Vector &val)
 
 Information::Information(const Matrix &val) 
   :theType(MatrixType),
-   theID(0), theVector(0), theMatrix(0), theString(0)
+   theID(0), theVector(0), theMatrix(0), theString(0), theLocation(0)
 {
   // Make a copy
   theMatrix = new Matrix(val);
@@ -89,7 +89,7 @@ Information::Information(const Matrix &val)
 
 Information::Information(const ID &val1, const Vector &val2) 
   :theType(IdType),
-   theID(0), theVector(0), theMatrix(0), theString(0)
+   theID(0), theVector(0), theMatrix(0), theString(0), theLocation(0)
 {
   // Make a copy
   theID = new ID(val1);
@@ -143,7 +143,12 @@ Information::setID(const ID &newID)
 int 
 Information::setVector(const Vector &newVector)
 {
-  if (theVector != 0) {
+  if (theVector != 0 && theLocation != 0 && theVector->Size() != newVector.Size()) {
+    // the memory set in setData() is not ours to resize; detach from it
+    delete theVector;
+    theVector = new Vector(newVector);
+    theLocation = 0;
+  } else if (theVector != 0) {
     *theVector = newVector;
   } else {
     theVector = new Vector(newVector);
@@ -186,6 +191,36 @@ Information::setString(const char *newString)
   return 0;
 }
 
+// the data vector is set to use the caller's memory, so that a
+// response written through setVector() or getData() lands there
+int 
+Information::setData(double *location, int size)
+{
+  if (location == 0 || size <= 0) {
+    opserr << "Information::setData() - no memory of size " << size << " given\n";
+    return -1;
+  }
+
+  if (theVector == 0) {
+    theVector = new Vector(location, size);
+  } else {
+    int numCopy = theVector->Size();
+    if (numCopy > size)
+      numCopy = size;
+    for (int i=0; i<numCopy; i++)
+      location[i] = (*theVector)(i);
+    theVector->setData(location, size);
+  }
+
+  if (theVector == 0) {
+    opserr << "Information::setData() - out of memory\n";
+    return -1;
+  }
+
+  theLocation = location;
+  return 0;
+}
+
 void 
 Information::Print(OPS_Stream &s, int flag)
 {
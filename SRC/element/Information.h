@@ -70,6 +70,7 @@ class Information
     virtual int setVector(const Vector &newVector);
     virtual int setMatrix(const Matrix &newMatrix);
     virtual int setString(const char *theString);
+    virtual int setData(double *location, int size);
     
     virtual void Print(OPS_Stream &s, int flag = 0);
     virtual void Print(ofstream &s, int flag = 0);
@@ -83,6 +84,7 @@ class Information
     Vector 	*theVector;// pointer to a Vector object, created elsewhere
     Matrix	*theMatrix;// pointer to a Matrix object, created elsewhere
     char        *theString;// pointer to string
+    double      *theLocation;// memory theVector is set to, 0 if it owns its data
 
   protected:
     
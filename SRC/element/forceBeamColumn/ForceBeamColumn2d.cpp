@@ -76,14 +76,12 @@
 #include <ElementResponse.h>
 #include <CompositeResponse.h>
 #include <ElementalLoad.h>
+#include <WorkArea.h>
 
-Matrix ForceBeamColumn2d::theMatrix(6,6);
-Vector ForceBeamColumn2d::theVector(6);
-double ForceBeamColumn2d::workArea[200];
-
-Vector *ForceBeamColumn2d::vsSubdivide = 0;
-Matrix *ForceBeamColumn2d::fsSubdivide = 0;
-Vector *ForceBeamColumn2d::SsrSubdivide = 0;
+// work area holding the returned matrices and vectors, the section
+// work arrays and the section states saved when subdividing dv; each
+// thread gets its own copy
+static WorkArea theWorkArea("ForceBeamColumn2d");
 
 // constructor:
 // invoked by a FEM_ObjectBroker, recvSelf() needs to be invoked on this object.
@@ -100,17 +98,6 @@ ForceBeamColumn2d::ForceBeamColumn2d():
 {
   theNodes[0] = 0;  
   theNodes[1] = 0;
-
-  if (vsSubdivide == 0)
-    vsSubdivide  = new Vector [maxNumSections];
-  if (fsSubdivide == 0)
-    fsSubdivide  = new Matrix [maxNumSections];
-  if (SsrSubdivide == 0)
-    SsrSubdivide  = new Vector [maxNumSections];
-  if (!vsSubdivide || !fsSubdivide || !SsrSubdivide) {
-    opserr << "ForceBeamColumn2d::ForceBeamColumn2d() -- failed to allocate Subdivide arrays";   
-    exit(-1);
-  }
 }
 
 // constructor which takes the unique element tag, sections,
@@ -151,17 +138,6 @@ ForceBeamColumn2d::ForceBeamColumn2d (int tag, int nodeI, int nodeJ,
   }
 
   this->setSectionPointers(numSec, sec);
-  
-  if (vsSubdivide == 0)
-    vsSubdivide  = new Vector [maxNumSections];
-  if (fsSubdivide == 0)
-    fsSubdivide  = new Matrix [maxNumSections];
-  if (SsrSubdivide == 0)
-    SsrSubdivide  = new Vector [maxNumSections];
-  if (!vsSubdivide || !fsSubdivide || !SsrSubdivide) {
-    opserr << "ForceBeamColumn2d::ForceBeamColumn2d() -- failed to allocate Subdivide arrays";   
-    exit(-1);
-  }
 }
 
 // ~ForceBeamColumn2d():
@@ -405,7 +381,7 @@ ForceBeamColumn2d::getInitialStiff(void)
     Ki = new Matrix(this->getTangentStiff());
   */
 
-  static Matrix f(NEBD, NEBD);   // element flexibility matrix  
+  Matrix &f = theWorkArea.getMatrix(NEBD, NEBD, 5);   // element flexibility matrix  
   this->getInitialFlexibility(f);
 
   /*
@@ -422,7 +398,7 @@ ForceBeamColumn2d::getInitialStiff(void)
     opserr << "ForceBeamColumn2d::getInitialStiff() -- could not invert flexibility\n";
   */
 
-  static Matrix kvInit(NEBD, NEBD);
+  Matrix &kvInit = theWorkArea.getMatrix(NEBD, NEBD, 6);
   f.Invert(kvInit);
   Ki = new Matrix(crdTransf->getInitialGlobalStiffMatrix(kvInit));
 
@@ -569,6 +545,11 @@ ForceBeamColumn2d::initializeSectionHistoryVariables (void)
 int
 ForceBeamColumn2d::update()
 {
+  double *workArea = theWorkArea.getDoubles(200);
+  Vector *vsSubdivide = theWorkArea.getVectors(maxNumSections, 1);
+  Matrix *fsSubdivide = theWorkArea.getMatrices(maxNumSections, 1);
+  Vector *SsrSubdivide = theWorkArea.getVectors(maxNumSections, 2);
+
   // if have completed a recvSelf() - do a revertToLastCommit
   // to get Ssr, etc. set correctly
   if (initialFlag == 2)
@@ -580,14 +561,16 @@ ForceBeamColumn2d::update()
   // get basic displacements and increments
   const Vector &v = crdTransf->getBasicTrialDisp();    
 
-  static Vector dv(NEBD);
+  double dvData[NEBD];
+  Vector dv(dvData, NEBD);
 
   dv = crdTransf->getBasicIncrDeltaDisp();    
 
   if (initialFlag != 0 && dv.Norm() <= DBL_EPSILON && numEleLoads == 0)
     return 0;
 
-  static Vector vin(NEBD);
+  double vinData[NEBD];
+  Vector vin(vinData, NEBD);
   vin = v;
   vin -= dv;
 
@@ -600,10 +583,13 @@ ForceBeamColumn2d::update()
   double wt[maxNumSections];
   beamIntegr->getSectionWeights(numSections, L, wt);
 
-  static Vector vr(NEBD);       // element residual displacements
-  static Matrix f(NEBD,NEBD);   // element flexibility matrix
+  double vrData[NEBD];
+  Vector vr(vrData, NEBD);       // element residual displacements
+  double fData[NEBD*NEBD];
+  Matrix f(fData, NEBD, NEBD);   // element flexibility matrix
   
-  static Matrix I(NEBD,NEBD);   // an identity matrix for matrix inverse
+  double IData[NEBD*NEBD];
+  Matrix I(IData, NEBD, NEBD);   // an identity matrix for matrix inverse
   double dW;                    // section strain energy (work) norm 
   int i, j;
   
@@ -613,16 +599,21 @@ ForceBeamColumn2d::update()
 
   int numSubdivide = 1;
   bool converged = false;
-  static Vector dSe(NEBD);
-  static Vector dvToDo(NEBD);
-  static Vector dvTrial(NEBD);
-  static Vector SeTrial(NEBD);
-  static Matrix kvTrial(NEBD, NEBD);
+  double dSeData[NEBD];
+  Vector dSe(dSeData, NEBD);
+  double dvToDoData[NEBD];
+  Vector dvToDo(dvToDoData, NEBD);
+  double dvTrialData[NEBD];
+  Vector dvTrial(dvTrialData, NEBD);
+  double SeTrialData[NEBD];
+  Vector SeTrial(SeTrialData, NEBD);
+  double kvTrialData[NEBD*NEBD];
+  Matrix kvTrial(kvTrialData, NEBD, NEBD);
 
   dvToDo = dv;
   dvTrial = dvToDo;
 
-  static double factor = 10;
+  double factor = 10;
 
   maxSubdivisions = 4;
 
@@ -691,15 +682,10 @@ ForceBeamColumn2d::update()
             int order      = sections[i]->getOrder();
             const ID &code = sections[i]->getType();
 	    
-            static Vector Ss;
-            static Vector dSs;
-            static Vector dvs;
-            static Matrix fb;
-	    
-            Ss.setData(workArea, order);
-            dSs.setData(&workArea[order], order);
-            dvs.setData(&workArea[2*order], order);
-            fb.setData(&workArea[3*order], order, NEBD);
+            Vector Ss(workArea, order);
+            Vector dSs(&workArea[order], order);
+            Vector dvs(&workArea[2*order], order);
+            Matrix fb(&workArea[3*order], order, NEBD);
 	    
             double xL  = xi[i];
             double xL1 = xL-1.0;
@@ -997,6 +983,8 @@ void ForceBeamColumn2d::getDistrLoadInterpolatMatrix(double xi, Matrix &bp, cons
 const Matrix &
 ForceBeamColumn2d::getMass(void)
 { 
+  Matrix &theMatrix = theWorkArea.getMatrix(6, 6);
+
   theMatrix.Zero();
   
   double L = crdTransf->getInitialLength();
@@ -1285,6 +1273,8 @@ ForceBeamColumn2d::addInertiaLoadToUnbalance(const Vector &accel)
 const Vector &
 ForceBeamColumn2d::getResistingForceIncInertia()
 {	
+  Vector &theVector = theWorkArea.getVector(6);
+
   // Compute the current resisting force
   theVector = this->getResistingForce();
 
@@ -1725,6 +1715,8 @@ ForceBeamColumn2d::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker
 int
 ForceBeamColumn2d::getInitialFlexibility(Matrix &fe)
 {
+  double *workArea = theWorkArea.getDoubles(200);
+
   fe.Zero();
   
   double L = crdTransf->getInitialLength();
@@ -1810,6 +1802,8 @@ ForceBeamColumn2d::getInitialFlexibility(Matrix &fe)
 int
 ForceBeamColumn2d::getInitialDeformations(Vector &v0)
 {
+  double *workArea = theWorkArea.getDoubles(200);
+
   v0.Zero();
   if (numEleLoads < 1)
     return 0;
@@ -1832,16 +1826,14 @@ ForceBeamColumn2d::getInitialDeformations(Vector &v0)
     double xL1 = xL-1.0;
     double wtL = wt[i]*L;
 
-    static Vector sp;
-    sp.setData(workArea, order);
+    Vector sp(workArea, order);
     sp.Zero();
 
     this->computeSectionForces(sp, i);
 
     const Matrix &fse = sections[i]->getInitialFlexibility();
 
-    static Vector e;
-    e.setData(&workArea[order], order);
+    Vector e(&workArea[order], order);
 
     e.addMatrixVector(0.0, fse, sp, 1.0);
 
@@ -1871,7 +1863,7 @@ ForceBeamColumn2d::getInitialDeformations(Vector &v0)
 void ForceBeamColumn2d::compSectionDisplacements(Vector sectionCoords[], Vector sectionDispls[]) const
 {
   // get basic displacements and increments
-  static Vector ub(NEBD);
+  Vector &ub = theWorkArea.getVector(NEBD, 6);
   ub = crdTransf->getBasicTrialDisp();    
 
   double L = crdTransf->getInitialLength();
@@ -1879,7 +1871,7 @@ void ForceBeamColumn2d::compSectionDisplacements(Vector sectionCoords[], Vector
   // get integration point positions and weights
   //   const Matrix &xi_pt  = quadRule.getIntegrPointCoords(numSections);
   // get integration point positions and weights
-  static double xi_pts[maxNumSections];
+  double xi_pts[maxNumSections];
   beamIntegr->getSectionLocations(numSections, L, xi_pts);
 
   // setup Vandermode and CBDI influence matrices
@@ -1892,7 +1884,6 @@ void ForceBeamColumn2d::compSectionDisplacements(Vector sectionCoords[], Vector
 
   // get section curvatures
   Vector kappa(numSections);  // curvature
-  static Vector vs;              // section deformations 
 
   for (i=0; i<numSections; i++)
     {
@@ -1913,13 +1904,13 @@ void ForceBeamColumn2d::compSectionDisplacements(Vector sectionCoords[], Vector
       }
 			
       // get section deformations
-      vs = sections[i]->getSectionDeformation();
+      const Vector &vs = sections[i]->getSectionDeformation();
       kappa(i) = vs(sectionKey);
     }
 
   Vector w(numSections);
-  static Vector xl(NDM), uxb(NDM);
-  static Vector xg(NDM), uxg(NDM); 
+  Vector &xl = theWorkArea.getVector(NDM, 1);
+  Vector &uxb = theWorkArea.getVector(NDM, 2);
 
   // w = ls * kappa;  
   w.addMatrixVector (0.0, ls, kappa, 1.0);
@@ -1947,6 +1938,8 @@ void ForceBeamColumn2d::compSectionDisplacements(Vector sectionCoords[], Vector
 void
 ForceBeamColumn2d::Print(OPS_Stream &s, int flag)
 {
+  Vector &theVector = theWorkArea.getVector(6);
+
   if (flag == 2) {
 
     s << "#ForceBeamColumn2D\n";
@@ -2158,6 +2151,8 @@ ForceBeamColumn2d::displaySelf(Renderer &theViewer, int displayMode, float fact)
 Response*
 ForceBeamColumn2d::setResponse(const char **argv, int argc, OPS_Stream &output)
 {
+  Vector &theVector = theWorkArea.getVector(6);
+
   Response *theResponse = 0;
 
   output.tag("ElementOutput");
@@ -2369,8 +2364,7 @@ ForceBeamColumn2d::setResponse(const char **argv, int argc, OPS_Stream &output)
 int 
 ForceBeamColumn2d::getResponse(int responseID, Information &eleInfo)
 {
-  static Vector vp(3);
-  static Matrix fe(3,3);
+  Vector &theVector = theWorkArea.getVector(6);
 
   if (responseID == 1)
     return eleInfo.setVector(this->getResistingForce());
@@ -2399,16 +2393,17 @@ ForceBeamColumn2d::getResponse(int responseID, Information &eleInfo)
       
   // Chord rotation
   else if (responseID == 3) {
-    vp = crdTransf->getBasicTrialDisp();
-    return eleInfo.setVector(vp);
+    return eleInfo.setVector(crdTransf->getBasicTrialDisp());
   }
 
   // Plastic rotation
   else if (responseID == 4) {
+    Vector &vp = theWorkArea.getVector(3, 4);
+    Matrix &fe = theWorkArea.getMatrix(3, 3, 3);
     this->getInitialFlexibility(fe);
     vp = crdTransf->getBasicTrialDisp();
     vp.addMatrixVector(1.0, fe, Se, -1.0);
-    static Vector v0(3);
+    Vector &v0 = theWorkArea.getVector(3, 5);
     this->getInitialDeformations(v0);
     vp.addVector(1.0, v0, -1.0);
     return eleInfo.setVector(vp);
@@ -2478,7 +2473,7 @@ ForceBeamColumn2d::getResponse(int responseID, Information &eleInfo)
     
     d3 += beamIntegr->getTangentDriftJ(L, LI, Se(1), Se(2));
 
-    static Vector d(2);
+    Vector &d = theWorkArea.getVector(2);
     d(0) = d2;
     d(1) = d3;
 
@@ -2541,7 +2536,7 @@ ForceBeamColumn2d::getResponseSensitivity(int responseID, int gradNumber,
 
   // Basic force sensitivity
   else if (responseID == 7) {
-    static Vector dqdh(3);
+    Vector &dqdh = theWorkArea.getVector(3, 3);
 
     const Vector &dvdh = crdTransf->getBasicDisplSensitivity(gradNumber);
 
@@ -2566,7 +2561,7 @@ ForceBeamColumn2d::getResponseSensitivity(int responseID, int gradNumber,
       this->computeSectionForceSensitivity(dsdh, sectionNum-1, gradNumber);
     }
     //opserr << "FBC2d::getRespSens dspdh: " << dsdh;
-    static Vector dqdh(3);
+    Vector &dqdh = theWorkArea.getVector(3, 3);
 
     const Vector &dvdh = crdTransf->getBasicDisplSensitivity(gradNumber);
 
@@ -2643,14 +2638,14 @@ ForceBeamColumn2d::getResponseSensitivity(int responseID, int gradNumber,
 
   // Plastic deformation sensitivity
   else if (responseID == 4) {
-    static Vector dvpdh(3);
+    Vector &dvpdh = theWorkArea.getVector(3, 4);
 
     const Vector &dvdh = crdTransf->getBasicDisplSensitivity(gradNumber);
 
     dvpdh = dvdh;
     //opserr << dvpdh;
 
-    static Matrix fe(3,3);
+    Matrix &fe = theWorkArea.getMatrix(3, 3, 3);
     this->getInitialFlexibility(fe);
 
     const Vector &dqdh = this->computedqdh(gradNumber);
@@ -2658,7 +2653,7 @@ ForceBeamColumn2d::getResponseSensitivity(int responseID, int gradNumber,
     dvpdh.addMatrixVector(1.0, fe, dqdh, -1.0);
     //opserr << dvpdh;
 
-    static Matrix fek(3,3);
+    Matrix &fek = theWorkArea.getMatrix(3, 3, 4);
     fek.addMatrixProduct(0.0, fe, kv, 1.0);
 
     dvpdh.addMatrixVector(1.0, fek, dvdh, -1.0);
@@ -2788,6 +2783,8 @@ ForceBeamColumn2d::activateParameter(int passedParameterID)
 const Matrix&
 ForceBeamColumn2d::getKiSensitivity(int gradNumber)
 {
+  Matrix &theMatrix = theWorkArea.getMatrix(6, 6);
+
   theMatrix.Zero();
   return theMatrix;
 }
@@ -2795,6 +2792,8 @@ ForceBeamColumn2d::getKiSensitivity(int gradNumber)
 const Matrix&
 ForceBeamColumn2d::getMassSensitivity(int gradNumber)
 {
+  Matrix &theMatrix = theWorkArea.getMatrix(6, 6);
+
   theMatrix.Zero();
   return theMatrix;
 }
@@ -2802,7 +2801,7 @@ ForceBeamColumn2d::getMassSensitivity(int gradNumber)
 const Vector&
 ForceBeamColumn2d::getResistingForceSensitivity(int gradNumber)
 {
-  static Vector dqdh(3);
+  Vector &dqdh = theWorkArea.getVector(3, 3);
   dqdh = this->computedqdh(gradNumber);
 
   // Transform forces
@@ -2810,7 +2809,7 @@ ForceBeamColumn2d::getResistingForceSensitivity(int gradNumber)
   this->computeReactionSensitivity(dp0dh, gradNumber);
   Vector dp0dhVec(dp0dh, 3);
 
-  static Vector P(6);
+  Vector &P = theWorkArea.getVector(6, 1);
   P.Zero();
 
   if (crdTransf->isShapeSensitivity()) {
@@ -2830,6 +2829,8 @@ ForceBeamColumn2d::getResistingForceSensitivity(int gradNumber)
 int
 ForceBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
 {
+  double *workArea = theWorkArea.getDoubles(200);
+
   int err = 0;
 
   double L = crdTransf->getInitialLength();
@@ -2848,7 +2849,7 @@ ForceBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
 
   double d1oLdh = crdTransf->getd1overLdh();
 
-  static Vector dqdh(3);
+  Vector &dqdh = theWorkArea.getVector(3, 3);
   dqdh = this->computedqdh(gradNumber);
 
   // dvdh = A dudh + dAdh u
@@ -2926,6 +2927,8 @@ ForceBeamColumn2d::commitSensitivity(int gradNumber, int numGrads)
 const Vector &
 ForceBeamColumn2d::computedqdh(int gradNumber)
 {
+  double *workArea = theWorkArea.getDoubles(200);
+
   //opserr << "FBC2d::computedqdh " << gradNumber << endln;
 
   double L = crdTransf->getInitialLength();
@@ -2947,7 +2950,7 @@ ForceBeamColumn2d::computedqdh(int gradNumber)
 
   double d1oLdh = crdTransf->getd1overLdh();
 
-  static Vector dvdh(3);
+  Vector &dvdh = theWorkArea.getVector(3, 1);
   dvdh.Zero();
 
   // Loop over the integration points
@@ -3042,7 +3045,7 @@ ForceBeamColumn2d::computedqdh(int gradNumber)
     }
   }
 
-  static Matrix dfedh(3,3);
+  Matrix &dfedh = theWorkArea.getMatrix(3, 3, 1);
   dfedh.Zero();
 
   if (beamIntegr->addElasticFlexDeriv(L, dfedh, dLdh) < 0)
@@ -3050,7 +3053,7 @@ ForceBeamColumn2d::computedqdh(int gradNumber)
   
   //opserr << "dfedh: " << dfedh << endln;
 
-  static Vector dqdh(3);
+  Vector &dqdh = theWorkArea.getVector(3, 2);
   dqdh.addMatrixVector(0.0, kv, dvdh, 1.0);
   
   //opserr << "dqdh: " << dqdh << endln;
@@ -3061,7 +3064,9 @@ ForceBeamColumn2d::computedqdh(int gradNumber)
 const Matrix&
 ForceBeamColumn2d::computedfedh(int gradNumber)
 {
-  static Matrix dfedh(3,3);
+  double *workArea = theWorkArea.getDoubles(200);
+
+  Matrix &dfedh = theWorkArea.getMatrix(3, 3, 2);
 
   dfedh.Zero();
 
@@ -197,19 +197,11 @@ class ForceBeamColumn2d: public Element
 
   Matrix *Ki;
   
-  static Matrix theMatrix;
-  static Vector theVector;
-  static double workArea[];
-  
   enum {maxNumSections = 20};
   enum {maxSectionOrder = 5};
 
   // following are added for subdivision of displacement increment
   int    maxSubdivisions;       // maximum number of subdivisons of dv for local iterations
-  
-  static Vector *vsSubdivide;
-  static Vector *SsrSubdivide;
-  static Matrix *fsSubdivide;
   //static int maxNumSections;
 
   // AddingSensitivity:BEGIN //////////////////////////////////////////
@@ -47,18 +47,12 @@
 #include <string.h>
 
 #include <ElementResponse.h>
+#include <WorkArea.h>
 
 //#include <fstream>
 
-// initialise the class wide variables
-Matrix Truss::trussM2(2,2);
-Matrix Truss::trussM4(4,4);
-Matrix Truss::trussM6(6,6);
-Matrix Truss::trussM12(12,12);
-Vector Truss::trussV2(2);
-Vector Truss::trussV4(4);
-Vector Truss::trussV6(6);
-Vector Truss::trussV12(12);
+// per-thread work space for the matrices and vectors returned
+static WorkArea theWorkArea("Truss");
 
 // constructor:
 //  responsible for allocating the necessary space needed by each object
@@ -168,7 +162,6 @@ Truss::Truss(int tag,
  :Element(tag,ELE_TAG_Truss),     
   theMaterial(0), connectedExternalNodes(2),
   dimension(dim), numDOF(0), theLoad(0),
-  theMatrix(0), theVector(0),
   L(0.0), A(a), rho(r), doRayleighDamping(damp), initialDisp(0)
 {
     // get a copy of the material and check we obtained a valid copy
@@ -209,7 +202,6 @@ Truss::Truss()
 :Element(0,ELE_TAG_Truss),     
  theMaterial(0),connectedExternalNodes(2),
  dimension(0), numDOF(0), theLoad(0),
- theMatrix(0), theVector(0),
  L(0.0), A(0.0), rho(0.0), initialDisp(0)
 {
     // ensure the connectedExternalNode ID is of correct size 
@@ -308,8 +300,6 @@ Truss::setDomain(Domain *theDomain)
 
       // fill this in so don't segment fault later
       numDOF = 2;    
-      theMatrix = &trussM2;
-      theVector = &trussV2;	
 
       return;
     }
@@ -325,8 +315,6 @@ Truss::setDomain(Domain *theDomain)
 
       // fill this in so don't segment fault later
       numDOF = 2;    
-      theMatrix = &trussM2;
-      theVector = &trussV2;	
 	
       return;
     }	
@@ -334,39 +322,27 @@ Truss::setDomain(Domain *theDomain)
     // call the base class method
     this->DomainComponent::setDomain(theDomain);
 
-    // now set the number of dof for element and set matrix and vector pointer
+    // now set the number of dof for element
     if (dimension == 1 && dofNd1 == 1) {
 	numDOF = 2;    
-	theMatrix = &trussM2;
-	theVector = &trussV2;
     }
     else if (dimension == 2 && dofNd1 == 2) {
 	numDOF = 4;
-	theMatrix = &trussM4;
-	theVector = &trussV4;	
     }
     else if (dimension == 2 && dofNd1 == 3) {
 	numDOF = 6;	
-	theMatrix = &trussM6;
-	theVector = &trussV6;		
     }
     else if (dimension == 3 && dofNd1 == 3) {
 	numDOF = 6;	
-	theMatrix = &trussM6;
-	theVector = &trussV6;			
     }
     else if (dimension == 3 && dofNd1 == 6) {
 	numDOF = 12;	    
-	theMatrix = &trussM12;
-	theVector = &trussV12;			
     }
     else {
       opserr <<"WARNING Truss::setDomain cannot handle " << dimension << " dofs at nodes in " << 
 	dofNd1  << " problem\n";
 
       numDOF = 2;    
-      theMatrix = &trussM2;
-      theVector = &trussV2;	
       return;
     }
 
@@ -506,19 +482,27 @@ Truss::update(void)
     return theMaterial->setTrialStrain(strain, rate);
 }
 
+bool
+Truss::isThreadSafe(void)
+{
+    // the work space is per thread, the material decides
+    return theMaterial->isThreadSafe();
+}
+
 
 const Matrix &
 Truss::getTangentStiff(void)
 {
+    Matrix &theMatrix = theWorkArea.getMatrix(numDOF, numDOF);
     if (L == 0.0) { // - problem in setDomain() no further warnings
-	theMatrix->Zero();
-	return *theMatrix;
+	theMatrix.Zero();
+	return theMatrix;
     }
     
     double E = theMaterial->getTangent();
 
     // come back later and redo this if too slow
-    Matrix &stiff = *theMatrix;
+    Matrix &stiff = theMatrix;
 
     int numDOF2 = numDOF/2;
     double temp;
@@ -540,15 +524,16 @@ Truss::getTangentStiff(void)
 const Matrix &
 Truss::getInitialStiff(void)
 {
+    Matrix &theMatrix = theWorkArea.getMatrix(numDOF, numDOF);
     if (L == 0.0) { // - problem in setDomain() no further warnings
-	theMatrix->Zero();
-	return *theMatrix;
+	theMatrix.Zero();
+	return theMatrix;
     }
     
     double E = theMaterial->getInitialTangent();
 
     // come back later and redo this if too slow
-    Matrix &stiff = *theMatrix;
+    Matrix &stiff = theMatrix;
 
     int numDOF2 = numDOF/2;
     double temp;
@@ -563,26 +548,27 @@ Truss::getInitialStiff(void)
       }
     }
 
-    return *theMatrix;
+    return theMatrix;
 }
 
 const Matrix &
 Truss::getDamp(void)
 {
+  Matrix &theMatrix = theWorkArea.getMatrix(numDOF, numDOF);
   if (L == 0.0) { // - problem in setDomain() no further warnings
-    theMatrix->Zero();
-    return *theMatrix;
+    theMatrix.Zero();
+    return theMatrix;
   }
 
-  theMatrix->Zero();
+  theMatrix.Zero();
   
   if (doRayleighDamping == 1)
-    *theMatrix = this->Element::getDamp();
+    theMatrix = this->Element::getDamp();
 
   double eta = theMaterial->getDampTangent();
   
   // come back later and redo this if too slow
-  Matrix &damp = *theMatrix;
+  Matrix &damp = theMatrix;
 
   int numDOF2 = numDOF/2;
   double temp;
@@ -605,7 +591,7 @@ const Matrix &
 Truss::getMass(void)
 {   
   // zero the matrix
-  Matrix &mass = *theMatrix;
+  Matrix &mass = theWorkArea.getMatrix(numDOF, numDOF);
   mass.Zero();    
   
   // check for quick return
@@ -768,9 +754,10 @@ Truss::addInertiaLoadSensitivityToUnbalance(const Vector &accel, bool somethingR
 const Vector &
 Truss::getResistingForce()
 {	
+    Vector &theVector = theWorkArea.getVector(numDOF);
     if (L == 0.0) { // - problem in setDomain() no further warnings
-	theVector->Zero();
-	return *theVector;
+	theVector.Zero();
+	return theVector;
     }
     
     // R = Ku - Pext
@@ -780,20 +767,21 @@ Truss::getResistingForce()
     double temp;
     for (int i = 0; i < dimension; i++) {
       temp = cosX[i]*force;
-      (*theVector)(i) = -temp;
-      (*theVector)(i+numDOF2) = temp;
+      theVector(i) = -temp;
+      theVector(i+numDOF2) = temp;
     }
 
     // subtract external load:  Ku - P
-    (*theVector) -= *theLoad;
+    theVector -= *theLoad;
 
-    return *theVector;
+    return theVector;
 }
 
 
 const Vector &
 Truss::getResistingForceIncInertia()
 {	
+  Vector &theVector = theWorkArea.getVector(numDOF);
   this->getResistingForce();
   
   // now include the mass portion
@@ -805,21 +793,21 @@ Truss::getResistingForceIncInertia()
     int numDOF2 = numDOF/2;
     double M = 0.5*rho*L;
     for (int i = 0; i < dimension; i++) {
-      (*theVector)(i) += M*accel1(i);
-      (*theVector)(i+numDOF2) += M*accel2(i);
+      theVector(i) += M*accel1(i);
+      theVector(i+numDOF2) += M*accel2(i);
     }
     
     // add the damping forces if rayleigh damping
     if (doRayleighDamping == 1 && (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0))
-      (*theVector) += this->getRayleighDampingForces();
+      theVector += this->getRayleighDampingForces();
   }  else {
     
     // add the damping forces if rayleigh damping
     if (doRayleighDamping == 1 && (betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0))
-      (*theVector) += this->getRayleighDampingForces();
+      theVector += this->getRayleighDampingForces();
   }
   
-  return *theVector;
+  return theVector;
 }
 
 int
@@ -1039,6 +1027,7 @@ Truss::displaySelf(Renderer &theViewer, int displayMode, float fact)
 void
 Truss::Print(OPS_Stream &s, int flag)
 {
+    Vector &theVector = theWorkArea.getVector(numDOF);
     // compute the strain and axial force in the member
     double strain, force;
     strain = theMaterial->getStrain();
@@ -1064,10 +1053,10 @@ Truss::Print(OPS_Stream &s, int flag)
 	  double temp;
 	  for (int i = 0; i < dimension; i++) {
 	    temp = cosX[i]*force;
-	    (*theVector)(i) = -temp;
-	    (*theVector)(i+numDOF2) = temp;
+	    theVector(i) = -temp;
+	    theVector(i+numDOF2) = temp;
 	  }
-	  s << " \n\t unbalanced load: " << *theVector;	
+	  s << " \n\t unbalanced load: " << theVector;	
 	}
 
 	s << " \t Material: " << *theMaterial;
@@ -1253,7 +1242,7 @@ Truss::activateParameter(int passedParameterID)
 const Matrix &
 Truss::getKiSensitivity(int gradNumber)
 {
-  Matrix &stiff = *theMatrix;
+  Matrix &stiff = theWorkArea.getMatrix(numDOF, numDOF);
   stiff.Zero();
     
   if (parameterID == 0) {
@@ -1301,7 +1290,7 @@ Truss::getKiSensitivity(int gradNumber)
 const Matrix &
 Truss::getMassSensitivity(int gradNumber)
 {
-  Matrix &mass = *theMatrix;
+  Matrix &mass = theWorkArea.getMatrix(numDOF, numDOF);
   mass.Zero();
 
   if (parameterID == 2) {
@@ -1320,7 +1309,8 @@ Truss::getMassSensitivity(int gradNumber)
 const Vector &
 Truss::getResistingForceSensitivity(int gradNumber)
 {
-	theVector->Zero();
+	Vector &theVector = theWorkArea.getVector(numDOF);
+	theVector.Zero();
 
 	// Initial declarations
 	int i;
@@ -1427,15 +1417,15 @@ Truss::getResistingForceSensitivity(int gradNumber)
 	if (parameterID == 1) {			// Cross-sectional area
 	  for (i = 0; i < dimension; i++) {
 	    temp = (stress + A*stressSensitivity)*cosX[i];
-	    (*theVector)(i) = -temp;
-	    (*theVector)(i+numDOF2) = temp;
+	    theVector(i) = -temp;
+	    theVector(i+numDOF2) = temp;
 	  }
 	}
 	else {		// Density, material parameter or nodal coordinate
 	  for (i = 0; i < dimension; i++) {
 	    temp = A*(stressSensitivity*cosX[i] + stress*dcosXdh[i]);
-	    (*theVector)(i) = -temp;
-	    (*theVector)(i+numDOF2) = temp;
+	    theVector(i) = -temp;
+	    theVector(i+numDOF2) = temp;
 	  }
 	}
 
@@ -1443,9 +1433,9 @@ Truss::getResistingForceSensitivity(int gradNumber)
 	if (theLoadSens == 0) {
 		theLoadSens = new Vector(numDOF);
 	}
-	(*theVector) -= *theLoadSens;
+	theVector -= *theLoadSens;
 
-	return *theVector;
+	return theVector;
 }
 
 int
@@ -73,6 +73,7 @@ class Truss : public Element
     int revertToLastCommit(void);        
     int revertToStart(void);        
     int update(void);
+    bool isThreadSafe(void);
     
     // public methods to obtain stiffness, mass, damping and residual information    
     const Matrix &getKi(void);
@@ -121,8 +122,6 @@ class Truss : public Element
     int numDOF;	                    // number of dof for truss
 
     Vector *theLoad;     // pointer to the load vector P
-    Matrix *theMatrix; // pointer to objects matrix (a class wide Matrix)
-    Vector *theVector; // pointer to objects vector (a clas wide Vector)
 
     double L;	    // length of truss based on undeformed configuration
     double A; 	    // area of truss
@@ -140,15 +139,6 @@ class Truss : public Element
     Vector *theLoadSens;
 // AddingSensitivity:END ///////////////////////////////////////////
 
-    // static data - single copy for all objects of the class	
-    static Matrix trussM2;   // class wide matrix for 2*2
-    static Matrix trussM4;   // class wide matrix for 4*4
-    static Matrix trussM6;   // class wide matrix for 6*6
-    static Matrix trussM12;  // class wide matrix for 12*12
-    static Vector trussV2;   // class wide Vector for size 2
-    static Vector trussV4;   // class wide Vector for size 44
-    static Vector trussV6;   // class wide Vector for size 6
-    static Vector trussV12;  // class wide Vector for size 12
 };
 
 #endif
@@ -0,0 +1,483 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/graph/graph/ElementColoring.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of ElementColoring.
+//
+// What: "@(#) ElementColoring.C, revA"
+
+#include <ElementColoring.h>
+#include <AnalysisModel.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <ID.h>
+#include <OPS_Globals.h>
+#include <ThreadPool.h>
+#include <WorkArea.h>
+
+// per-thread marks of the colors used by the neighbours
+static WorkArea theWorkArea("ElementColoring");
+
+struct ElementColoringTask {
+  const int *adjStart;
+  const int *adjacent;
+  int *colors;
+  const int *active;       // the FE_Elements still uncolored
+  char *selected;          // set for those colored in this round
+  int maxDegree;
+};
+
+// pseudo random weight of the i'th FE_Element
+static unsigned int
+jonesPlassmannWeight(int i)
+{
+  unsigned int w = (unsigned int)(i+1) * 2654435761u;
+  return w ^ (w >> 16);
+}
+
+// selects the uncolored FE_Elements whose weight is larger than that
+// of each uncolored neighbour; these form an independent set
+static void
+selectTask(int start, int end, int threadID, void *data)
+{
+  ElementColoringTask *theTask = (ElementColoringTask *)data;
+  const int *adjStart = theTask->adjStart;
+  const int *adjacent = theTask->adjacent;
+  const int *colors = theTask->colors;
+
+  for (int k=start; k<end; k++) {
+    int i = theTask->active[k];
+    unsigned int wi = jonesPlassmannWeight(i);
+    char select = 1;
+    for (int a=adjStart[i]; a<adjStart[i+1]; a++) {
+      int j = adjacent[a];
+      if (colors[j] < 0) {
+	unsigned int wj = jonesPlassmannWeight(j);
+	if (wj > wi || (wj == wi && j > i)) {
+	  select = 0;
+	  break;
+	}
+      }
+    }
+    theTask->selected[k] = select;
+  }
+}
+
+// gives each selected FE_Element the lowest color none of its
+// neighbours has; as no two of them are adjacent the colors read
+// are those of earlier rounds
+static void
+assignTask(int start, int end, int threadID, void *data)
+{
+  ElementColoringTask *theTask = (ElementColoringTask *)data;
+  const int *adjStart = theTask->adjStart;
+  const int *adjacent = theTask->adjacent;
+  int *colors = theTask->colors;
+
+  int *forbidden = theWorkArea.getInts(theTask->maxDegree+1);
+  for (int c=0; c<=theTask->maxDegree; c++)
+    forbidden[c] = -1;
+
+  for (int k=start; k<end; k++) {
+    if (theTask->selected[k] == 0)
+      continue;
+    int i = theTask->active[k];
+    for (int a=adjStart[i]; a<adjStart[i+1]; a++) {
+      int c = colors[adjacent[a]];
+      if (c >= 0)
+	forbidden[c] = i;
+    }
+    int c = 0;
+    while (forbidden[c] == i)
+      c++;
+    colors[i] = c;
+  }
+}
+
+ElementColoring::ElementColoring(int meth)
+:method(meth), numFEs(0), numSerial(0), theFEs(0), sizeFEs(0),
+ numColors(0), colorStart(0),
+ adjStart(0), adjacent(0), maxDegree(0), colors(0)
+{
+  if (method != ELEMENT_COLORING_GREEDY && method != ELEMENT_COLORING_JP) {
+    opserr << "WARNING ElementColoring::ElementColoring() - unknown method ";
+    opserr << method << ", greedy coloring used\n";
+    method = ELEMENT_COLORING_GREEDY;
+  }
+}
+
+ElementColoring::~ElementColoring()
+{
+  if (theFEs != 0)
+    delete [] theFEs;
+  if (colorStart != 0)
+    delete [] colorStart;
+  if (adjStart != 0)
+    delete [] adjStart;
+  if (adjacent != 0)
+    delete [] adjacent;
+  if (colors != 0)
+    delete [] colors;
+}
+
+int
+ElementColoring::color(AnalysisModel &theModel)
+{
+  numFEs = 0;
+  numSerial = 0;
+  numColors = 0;
+
+  // collect the FE_Elements, the thread safe ones first
+  FE_Element *elePtr;
+  FE_EleIter &theEles = theModel.getFEs();
+  int numTotal = 0;
+  while ((elePtr = theEles()) != 0)
+    numTotal++;
+
+  if (numTotal > sizeFEs) {
+    if (theFEs != 0)
+      delete [] theFEs;
+    theFEs = new FE_Element *[numTotal];
+    if (theFEs == 0) {
+      opserr << "WARNING ElementColoring::color() - out of memory\n";
+      sizeFEs = 0;
+      return -1;
+    }
+    sizeFEs = numTotal;
+  }
+
+  FE_EleIter &theSafeEles = theModel.getFEs();
+  while ((elePtr = theSafeEles()) != 0)
+    if (elePtr->isThreadSafe() == true)
+      theFEs[numFEs++] = elePtr;
+
+  FE_EleIter &theOtherEles = theModel.getFEs();
+  while ((elePtr = theOtherEles()) != 0)
+    if (elePtr->isThreadSafe() == false)
+      theFEs[numFEs + numSerial++] = elePtr;
+
+  int result = this->buildAdjacency(theModel.getNumEqn());
+  if (result == 0) {
+    if (method == ELEMENT_COLORING_JP)
+      result = this->colorJonesPlassmann();
+    else
+      result = this->colorGreedy();
+  }
+  if (result == 0)
+    result = this->sortByColor();
+
+  // the adjacency is not needed once colored
+  if (adjStart != 0)
+    delete [] adjStart;
+  if (adjacent != 0)
+    delete [] adjacent;
+  if (colors != 0)
+    delete [] colors;
+  adjStart = 0;
+  adjacent = 0;
+  colors = 0;
+
+  if (result < 0) {
+    numColors = 0;
+    return result;
+  }
+
+  return numColors;
+}
+
+int
+ElementColoring::getMethod(void) const
+{
+  return method;
+}
+
+int
+ElementColoring::getNumColors(void) const
+{
+  return numColors;
+}
+
+FE_Element **
+ElementColoring::getElements(int c, int &numElements)
+{
+  if (c < 0 || c >= numColors) {
+    numElements = 0;
+    return 0;
+  }
+
+  numElements = colorStart[c+1] - colorStart[c];
+  return &theFEs[colorStart[c]];
+}
+
+FE_Element **
+ElementColoring::getSerialElements(int &numElements)
+{
+  numElements = numSerial;
+  if (numSerial == 0)
+    return 0;
+  return &theFEs[numFEs];
+}
+
+void
+ElementColoring::Print(OPS_Stream &s, int flag)
+{
+  s << "ElementColoring: ";
+  if (method == ELEMENT_COLORING_JP)
+    s << "Jones-Plassmann";
+  else
+    s << "greedy";
+  s << " numColors: " << numColors << " numColored: " << numFEs;
+  s << " numSerial: " << numSerial << endln;
+
+  if (flag == 1)
+    for (int c=0; c<numColors; c++)
+      s << "  color " << c << ": " << colorStart[c+1] - colorStart[c] << endln;
+}
+
+// builds the lists of the FE_Elements adjacent to each colored FE_Element,
+// i.e. those with an equation in common, through the lists of the
+// FE_Elements of each equation
+int
+ElementColoring::buildAdjacency(int numEqn)
+{
+  maxDegree = 0;
+  adjStart = new int[numFEs+1];
+  colors = new int[numFEs];
+  int *eqnStart = new int[numEqn+1];
+  int *mark = new int[numFEs];
+  if (adjStart == 0 || colors == 0 || eqnStart == 0 || mark == 0) {
+    opserr << "WARNING ElementColoring::buildAdjacency() - out of memory\n";
+    if (eqnStart != 0)
+      delete [] eqnStart;
+    if (mark != 0)
+      delete [] mark;
+    return -1;
+  }
+
+  int i, j, k;
+  for (k=0; k<=numEqn; k++)
+    eqnStart[k] = 0;
+
+  for (i=0; i<numFEs; i++) {
+    const ID &id = theFEs[i]->getID();
+    for (k=0; k<id.Size(); k++) {
+      int eqn = id(k);
+      if (eqn >= 0 && eqn < numEqn)
+	eqnStart[eqn+1]++;
+    }
+  }
+  for (k=0; k<numEqn; k++)
+    eqnStart[k+1] += eqnStart[k];
+
+  int *eqnFEs = new int[eqnStart[numEqn] + 1];
+  if (eqnFEs == 0) {
+    opserr << "WARNING ElementColoring::buildAdjacency() - out of memory\n";
+    delete [] eqnStart;
+    delete [] mark;
+    return -1;
+  }
+
+  // eqnStart[eqn] is moved on as the list of eqn is filled, and moved
+  // back afterwards
+  for (i=0; i<numFEs; i++) {
+    const ID &id = theFEs[i]->getID();
+    for (k=0; k<id.Size(); k++) {
+      int eqn = id(k);
+      if (eqn >= 0 && eqn < numEqn)
+	eqnFEs[eqnStart[eqn]++] = i;
+    }
+  }
+  for (k=numEqn; k>0; k--)
+    eqnStart[k] = eqnStart[k-1];
+  eqnStart[0] = 0;
+
+  // the neighbours are counted in the first pass and stored in the second
+  for (int pass=0; pass<2; pass++) {
+    for (i=0; i<numFEs; i++)
+      mark[i] = -1;
+    int numAdjacent = 0;
+    for (i=0; i<numFEs; i++) {
+      if (pass == 0)
+	adjStart[i] = numAdjacent;
+      mark[i] = i;
+      const ID &id = theFEs[i]->getID();
+      for (k=0; k<id.Size(); k++) {
+	int eqn = id(k);
+	if (eqn < 0 || eqn >= numEqn)
+	  continue;
+	for (int e=eqnStart[eqn]; e<eqnStart[eqn+1]; e++) {
+	  j = eqnFEs[e];
+	  if (mark[j] != i) {
+	    mark[j] = i;
+	    if (pass == 1)
+	      adjacent[numAdjacent] = j;
+	    numAdjacent++;
+	  }
+	}
+      }
+      if (pass == 0 && numAdjacent - adjStart[i] > maxDegree)
+	maxDegree = numAdjacent - adjStart[i];
+    }
+
+    if (pass == 0) {
+      adjStart[numFEs] = numAdjacent;
+      adjacent = new int[numAdjacent + 1];
+      if (adjacent == 0) {
+	opserr << "WARNING ElementColoring::buildAdjacency() - out of memory\n";
+	delete [] eqnStart;
+	delete [] eqnFEs;
+	delete [] mark;
+	return -1;
+      }
+    }
+  }
+
+  delete [] eqnStart;
+  delete [] eqnFEs;
+  delete [] mark;
+
+  for (i=0; i<numFEs; i++)
+    colors[i] = -1;
+
+  return 0;
+}
+
+int
+ElementColoring::colorGreedy(void)
+{
+  int *forbidden = new int[maxDegree+1];
+  if (forbidden == 0) {
+    opserr << "WARNING ElementColoring::colorGreedy() - out of memory\n";
+    return -1;
+  }
+  for (int c=0; c<=maxDegree; c++)
+    forbidden[c] = -1;
+
+  numColors = 0;
+  for (int i=0; i<numFEs; i++) {
+    for (int a=adjStart[i]; a<adjStart[i+1]; a++) {
+      int c = colors[adjacent[a]];
+      if (c >= 0)
+	forbidden[c] = i;
+    }
+    int c = 0;
+    while (forbidden[c] == i)
+      c++;
+    colors[i] = c;
+    if (c >= numColors)
+      numColors = c+1;
+  }
+
+  delete [] forbidden;
+  return 0;
+}
+
+int
+ElementColoring::colorJonesPlassmann(void)
+{
+  int *active = new int[numFEs+1];
+  char *selected = new char[numFEs+1];
+  if (active == 0 || selected == 0) {
+    opserr << "WARNING ElementColoring::colorJonesPlassmann() - out of memory\n";
+    if (active != 0)
+      delete [] active;
+    return -1;
+  }
+
+  int numActive = numFEs;
+  for (int k=0; k<numFEs; k++)
+    active[k] = k;
+
+  ElementColoringTask theTask;
+  theTask.adjStart = adjStart;
+  theTask.adjacent = adjacent;
+  theTask.colors = colors;
+  theTask.active = active;
+  theTask.selected = selected;
+  theTask.maxDegree = maxDegree;
+
+  // the uncolored FE_Element of largest weight is selected in each
+  // round, so that the loop ends
+  ThreadPool *thePool = ThreadPool::getDefault();
+  while (numActive > 0) {
+    if (thePool != 0) {
+      thePool->parallelFor(numActive, selectTask, &theTask);
+      thePool->parallelFor(numActive, assignTask, &theTask);
+    } else {
+      selectTask(0, numActive, 0, &theTask);
+      assignTask(0, numActive, 0, &theTask);
+    }
+
+    int numLeft = 0;
+    for (int k=0; k<numActive; k++)
+      if (selected[k] == 0)
+	active[numLeft++] = active[k];
+    numActive = numLeft;
+  }
+
+  numColors = 0;
+  for (int i=0; i<numFEs; i++)
+    if (colors[i] >= numColors)
+      numColors = colors[i]+1;
+
+  delete [] active;
+  delete [] selected;
+  return 0;
+}
+
+// orders the colored FE_Elements by color, keeping the iterator order
+// within each color
+int
+ElementColoring::sortByColor(void)
+{
+  if (colorStart != 0)
+    delete [] colorStart;
+  colorStart = new int[numColors+1];
+  FE_Element **sorted = new FE_Element *[numFEs+1];
+  if (colorStart == 0 || sorted == 0) {
+    opserr << "WARNING ElementColoring::sortByColor() - out of memory\n";
+    if (sorted != 0)
+      delete [] sorted;
+    return -1;
+  }
+
+  int c, i;
+  for (c=0; c<=numColors; c++)
+    colorStart[c] = 0;
+  for (i=0; i<numFEs; i++)
+    colorStart[colors[i]+1]++;
+  for (c=0; c<numColors; c++)
+    colorStart[c+1] += colorStart[c];
+
+  for (i=0; i<numFEs; i++)
+    sorted[colorStart[colors[i]]++] = theFEs[i];
+  for (c=numColors; c>0; c--)
+    colorStart[c] = colorStart[c-1];
+  colorStart[0] = 0;
+
+  for (i=0; i<numFEs; i++)
+    theFEs[i] = sorted[i];
+
+  delete [] sorted;
+  return 0;
+}
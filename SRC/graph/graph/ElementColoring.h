@@ -0,0 +1,97 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/graph/graph/ElementColoring.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for ElementColoring.
+// An ElementColoring splits the thread safe FE_Elements of an AnalysisModel
+// into colors such that no two FE_Elements of the same color have an
+// equation in common. The contributions of the FE_Elements of one color
+// can thus be added to a LinearSOE by several threads at once, without
+// locks, one color after the other. Two FE_Elements are adjacent if their
+// IDs share an equation number, which is the connectivity from which the
+// DOF_Graph of the model is built.
+//
+// The colors are found either greedily, each FE_Element taking in
+// iterator order the lowest color not used by its neighbours, or by the
+// Jones-Plassmann method, in which each round colors the FE_Elements
+// whose (pseudo random) weight is the largest of those of their neighbours
+// still uncolored. The rounds of the latter run on the threads of the
+// default ThreadPool. As the weights depend only on the position of an
+// FE_Element, both give the same colors whatever the number of threads.
+//
+// What: "@(#) ElementColoring.h, revA"
+
+#ifndef ElementColoring_h
+#define ElementColoring_h
+
+#define ELEMENT_COLORING_GREEDY 1
+#define ELEMENT_COLORING_JP     2
+
+class AnalysisModel;
+class FE_Element;
+class OPS_Stream;
+
+class ElementColoring
+{
+  public:
+    ElementColoring(int method = ELEMENT_COLORING_GREEDY);
+    ~ElementColoring();
+
+    // colors the FE_Elements of the model, returns the number of colors
+    int color(AnalysisModel &theModel);
+
+    int getMethod(void) const;
+    int getNumColors(void) const;
+
+    // the FE_Elements of color c, 0 <= c < getNumColors()
+    FE_Element **getElements(int c, int &numElements);
+
+    // the FE_Elements which are not thread safe, not colored
+    FE_Element **getSerialElements(int &numElements);
+
+    void Print(OPS_Stream &s, int flag = 0);
+
+  protected:
+
+  private:
+    int buildAdjacency(int numEqn);
+    int colorGreedy(void);
+    int colorJonesPlassmann(void);
+    int sortByColor(void);
+
+    int method;
+    int numFEs;            // number of FE_Elements colored
+    int numSerial;         // number of FE_Elements not thread safe
+    FE_Element **theFEs;   // colored FE_Elements by color, then the others
+    int sizeFEs;
+    int numColors;
+    int *colorStart;       // location in theFEs of the first of each color
+
+    // adjacency of the colored FE_Elements, only kept while coloring
+    int *adjStart;
+    int *adjacent;
+    int maxDegree;
+    int *colors;
+};
+
+#endif
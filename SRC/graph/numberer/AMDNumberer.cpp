@@ -38,10 +38,10 @@
 #include <FEM_ObjectBroker.h>
 
 // Constructor
-AMD::AMD()
-:GraphNumberer(GraphNUMBERER_TAG_AMD)
+AMD::AMD(bool print)
+:GraphNumberer(GraphNUMBERER_TAG_AMD), printCost(print)
 {
-  opserr << "AMD::AMD()\n";
+
 }
 
 // Destructor
@@ -51,54 +51,91 @@ AMD::~AMD()
 }
 
 
-// const ID &number(Graph &theGraph,int startVertexTag = -1,
-//                  bool minDegree = false)
 const ID &
-AMD::number(Graph &theGraph, int startVertex)
+AMD::number(Graph &theGraph, int lastVertex)
 {
-  int numVertex = theGraph.getNumVertex();
+  ID lastVertices(0);
+  if (lastVertex != -1) {
+    lastVertices.resize(1);
+    lastVertices(0) = lastVertex;
+  }
 
-  if (numVertex == 0) 
-    return theResult;
+  return this->number(theGraph, lastVertices);
+}
+
+
+// const ID &number(Graph &theGraph, const ID &lastVertices)
+//    Method to perform the approximate minimum degree ordering of the 
+// AMD package of Amestoy, Davis and Duff. The vertices in lastVertices are
+// moved to the end of the ordering. The result contains the tags of the
+// vertices in the order they are to be numbered.
+//
+// side effects: this routine changes the Tmp of the vertices.
+
+const ID &
+AMD::number(Graph &theGraph, const ID &lastVertices)
+{
+  int *xadj, *adjncy, *vertexTags;
+  int numVertex = getCompressedGraph(theGraph, xadj, adjncy, vertexTags);
 
   theResult.resize(numVertex);
 
-  int nnz = 0;
-  Vertex *vertexPtr;
-  VertexIter &vertexIter = theGraph.getVertices();
-  
-  while ((vertexPtr = vertexIter()) != 0) {
-    const ID &adjacency = vertexPtr->getAdjacency();
-    nnz += adjacency.Size();
+  if (numVertex == 0) {
+    delete [] xadj; delete [] adjncy; delete [] vertexTags;
+    return theResult;
   }
 
   int *P = new int[numVertex];
-  int *Ap = new int[numVertex+1];
-  int *Ai = new int[nnz];
+  bool *isLast = new bool[numVertex];
   double Control[AMD_CONTROL];
   double Info[AMD_INFO];
 
-  VertexIter &vertexIter2 = theGraph.getVertices();
+  amd_defaults(Control);
+  int status = amd_order(numVertex, xadj, adjncy, P, Control, Info);
+  if (status != AMD_OK && status != AMD_OK_BUT_JUMBLED) {
+    opserr << "WARNING AMD::number - amd_order failed with status " << status;
+    opserr << ", using the order of the vertices\n";
+    for (int i=0; i<numVertex; i++)
+      P[i] = i;
+  }
 
-  nnz = 0;
-  int count = 1;
-  Ap[0] = 0;
+  for (int i=0; i<numVertex; i++)
+    isLast[i] = false;
 
-  while ((vertexPtr = vertexIter2()) != 0) {
-    const ID &adjacency = vertexPtr->getAdjacency();
-    for (int i=0; i<adjacency.Size(); i++)
-      Ai[nnz++] = adjacency(i);
-    Ap[count++] = nnz;
-  }  
+  int numLast = lastVertices.Size();
+  for (int j=0; j<numLast; j++) {
+    Vertex *vertexPtr = theGraph.getVertexPtr(lastVertices(j));
+    if (vertexPtr != 0)
+      isLast[vertexPtr->getTmp()] = true;
+  }
 
-  amd_order(numVertex, Ap, Ai, P, (double *)NULL, (double *)NULL);
-  
+  int count = 0;
   for (int i=0; i<numVertex; i++)
-    theResult[i] = P[i];
+    if (isLast[P[i]] == false)
+      theResult(count++) = vertexTags[P[i]];
+
+  for (int j=0; j<numLast; j++) {
+    Vertex *vertexPtr = theGraph.getVertexPtr(lastVertices(j));
+    if (vertexPtr != 0 && isLast[vertexPtr->getTmp()] == true) {
+      isLast[vertexPtr->getTmp()] = false;
+      theResult(count++) = lastVertices(j);
+    }
+  }
 
   delete [] P;
-  delete [] Ap;
-  delete [] Ai;
+  delete [] isLast;
+  delete [] xadj;
+  delete [] adjncy;
+  delete [] vertexTags;
+
+  if (printCost == true) {
+    double numNonZeros, numFlops;
+    if (getFactorCost(theGraph, theResult, numNonZeros, numFlops) == 0) {
+      opserr << "AMD::number - vertices: " << numVertex;
+      opserr << " predicted nonzeros in L: " << numNonZeros;
+      opserr << " flops: " << numFlops << endln;
+    }
+  }
 
   return theResult;
 }
@@ -117,16 +154,3 @@ AMD::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
     return 0;
 }
 
-
-const ID &
-AMD::number(Graph &theGraph, const ID &startVertices)
-{
-  opserr << "WARNING:  AMD::number - Not implemented with startVertices";
-  return theResult;
-}
-
-
-
-
-
-
@@ -46,7 +46,7 @@
 class AMD: public GraphNumberer
 {
   public:
-    AMD(); 
+    AMD(bool printCost = false); 
     ~AMD();
 
     const ID &number(Graph &theGraph, int lastVertex = -1);
@@ -60,6 +60,7 @@ class AMD: public GraphNumberer
     
   private:
     ID theResult;
+    bool printCost;     // print the predicted fill and flops of each ordering
 };
 
 #endif
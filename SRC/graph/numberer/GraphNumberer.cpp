@@ -33,6 +33,10 @@
 
 
 #include <GraphNumberer.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <ID.h>
 GraphNumberer::GraphNumberer(int cTag)
 :MovableObject(cTag)
 {
@@ -47,3 +51,155 @@ GraphNumberer::~GraphNumberer()
 
 
 
+int
+GraphNumberer::getCompressedGraph(Graph &theGraph, int *&xadj, int *&adjncy,
+				  int *&vertexTags)
+{
+    int numVertex = theGraph.getNumVertex();
+
+    xadj = new int[numVertex+1];
+    vertexTags = new int[numVertex > 0 ? numVertex : 1];
+
+    Vertex *vertexPtr;
+    VertexIter &vertexIter = theGraph.getVertices();
+    int count = 0;
+    int numEdge = 0;
+    while ((vertexPtr = vertexIter()) != 0) {
+	vertexPtr->setTmp(count);
+	vertexTags[count++] = vertexPtr->getTag();
+	numEdge += vertexPtr->getAdjacency().Size();
+    }
+
+    adjncy = new int[numEdge > 0 ? numEdge : 1];
+
+    VertexIter &vertexIter2 = theGraph.getVertices();
+    numEdge = 0;
+    count = 0;
+    xadj[0] = 0;
+    while ((vertexPtr = vertexIter2()) != 0) {
+	const ID &adjacency = vertexPtr->getAdjacency();
+	int size = adjacency.Size();
+	for (int i=0; i<size; i++) {
+	    Vertex *otherPtr = theGraph.getVertexPtr(adjacency(i));
+	    if (otherPtr == 0 || otherPtr == vertexPtr)
+		continue;
+	    adjncy[numEdge++] = otherPtr->getTmp();
+	}
+	xadj[++count] = numEdge;
+    }
+
+    return numVertex;
+}
+
+int
+GraphNumberer::getFactorCost(Graph &theGraph, const ID &ordering,
+			     double &numNonZeros, double &numFlops)
+{
+    numNonZeros = 0.0;
+    numFlops = 0.0;
+
+    int *xadj, *adjncy, *vertexTags;
+    int n = getCompressedGraph(theGraph, xadj, adjncy, vertexTags);
+
+    if (ordering.Size() != n) {
+	opserr << "GraphNumberer::getFactorCost - ordering of size " << ordering.Size();
+	opserr << " for a graph of " << n << " vertices\n";
+	delete [] xadj; delete [] adjncy; delete [] vertexTags;
+	return -1;
+    }
+
+    // position of each vertex in the ordering, and its number of dofs
+    int *position = new int[n+1];
+    int *vertexAt = new int[n+1];
+    int *numDOF = new int[n+1];
+    int *parent = new int[n+1];
+    int *ancestor = new int[n+1];
+    int *mark = new int[n+1];
+    double *colDOF = new double[n+1];
+
+    int result = 0;
+    for (int i=0; i<n; i++)
+	position[i] = -1;
+    for (int k=0; k<n; k++) {
+	Vertex *vertexPtr = theGraph.getVertexPtr(ordering(k));
+	if (vertexPtr == 0 || position[vertexPtr->getTmp()] != -1) {
+	    opserr << "GraphNumberer::getFactorCost - ordering is not a permutation ";
+	    opserr << "of the vertices\n";
+	    result = -2;
+	    break;
+	}
+	int loc = vertexPtr->getTmp();
+	position[loc] = k;
+	vertexAt[k] = loc;
+	int color = vertexPtr->getColor();
+	numDOF[k] = (color > 0) ? color : 1;
+    }
+
+    if (result == 0) {
+	// elimination tree of the reordered graph
+	for (int k=0; k<n; k++) {
+	    parent[k] = -1;
+	    ancestor[k] = -1;
+	    int loc = vertexAt[k];
+	    for (int p=xadj[loc]; p<xadj[loc+1]; p++) {
+		int r = position[adjncy[p]];
+		if (r >= k)
+		    continue;
+		while (ancestor[r] != -1 && ancestor[r] != k) {
+		    int next = ancestor[r];
+		    ancestor[r] = k;
+		    r = next;
+		}
+		if (ancestor[r] == -1) {
+		    ancestor[r] = k;
+		    parent[r] = k;
+		}
+	    }
+	}
+
+	// the structure of row k of L is the subtree of the etree reached
+	// from the lower neighbours of k; sum the dofs of the rows in each column
+	for (int k=0; k<n; k++) {
+	    mark[k] = -1;
+	    colDOF[k] = 0.0;
+	}
+	for (int k=0; k<n; k++) {
+	    mark[k] = k;
+	    int loc = vertexAt[k];
+	    for (int p=xadj[loc]; p<xadj[loc+1]; p++) {
+		int r = position[adjncy[p]];
+		if (r >= k)
+		    continue;
+		while (mark[r] != k) {
+		    colDOF[r] += numDOF[k];
+		    mark[r] = k;
+		    r = parent[r];
+		}
+	    }
+	}
+
+	// each vertex is a dense block of numDOF columns
+	for (int k=0; k<n; k++) {
+	    double d = numDOF[k];
+	    numNonZeros += 0.5*d*(d-1.0) + d*colDOF[k];
+	    for (int j=1; j<=numDOF[k]; j++) {
+		double c = d - j + colDOF[k];
+		numFlops += c*c;
+	    }
+	}
+    }
+
+    delete [] position;
+    delete [] vertexAt;
+    delete [] numDOF;
+    delete [] parent;
+    delete [] ancestor;
+    delete [] mark;
+    delete [] colDOF;
+    delete [] xadj;
+    delete [] adjncy;
+    delete [] vertexTags;
+
+    return result;
+}
+
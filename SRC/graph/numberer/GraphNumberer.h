@@ -52,8 +52,19 @@ class GraphNumberer : public MovableObject
     
     virtual const ID &number(Graph &theGraph, int lastVertex = -1) =0;
     virtual const ID &number(Graph &theGraph, const ID &lastVertices) =0;
+
+    // predicted nonzeros below the diagonal and operation count of the
+    // LDL^T factor of a matrix with the structure of the graph, numbered in
+    // the order given; the color of a vertex, if > 0, is its number of dofs
+    static int getFactorCost(Graph &theGraph, const ID &ordering,
+			     double &numNonZeros, double &numFlops);
     
   protected:
+    // adjacency of the graph in compressed form, in the order of the 
+    // VertexIter, without self edges; sets the Tmp of each vertex to its 
+    // location. the caller deletes the arrays.
+    static int getCompressedGraph(Graph &theGraph, int *&xadj, int *&adjncy,
+				  int *&vertexTags);
     
   private:
     
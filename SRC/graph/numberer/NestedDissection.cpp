@@ -0,0 +1,751 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/graph/numberer/NestedDissection.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of NestedDissection.
+//
+// What: "@(#) NestedDissection.C, revA"
+
+#include <amd.h>
+
+#include <NestedDissection.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <ID.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+
+#include <stdlib.h>
+#include <set>
+#include <vector>
+using std::pair;
+using std::set;
+using std::vector;
+
+#define ND_COARSEN_TO      80    // stop coarsening at this many vertices
+#define ND_NUM_TRIES        4    // graph growing starts on the coarsest graph
+#define ND_NUM_PASSES       8    // refinement passes at each level
+#define ND_MAX_BAD_MOVES   50    // moves tried without improving the cut
+#define ND_IMBALANCE     0.03    // allowed imbalance of the two parts
+
+// a graph of the multilevel bisection, cmap maps its vertices to those
+// of the next coarser graph
+typedef struct ndGraph {
+  int n;
+  int *xadj;
+  int *adjncy;
+  int *adjwgt;
+  int *vwgt;
+  int *cmap;
+} NDGraph;
+
+static NDGraph *
+newGraph(int n, int numEdge)
+{
+  NDGraph *g = new NDGraph;
+  g->n = n;
+  g->xadj = new int[n+1];
+  g->adjncy = new int[numEdge > 0 ? numEdge : 1];
+  g->adjwgt = new int[numEdge > 0 ? numEdge : 1];
+  g->vwgt = new int[n > 0 ? n : 1];
+  g->cmap = 0;
+  return g;
+}
+
+static void
+deleteGraph(NDGraph *g)
+{
+  delete [] g->xadj;
+  delete [] g->adjncy;
+  delete [] g->adjwgt;
+  delete [] g->vwgt;
+  if (g->cmap != 0)
+    delete [] g->cmap;
+  delete g;
+}
+
+// heavy edge matching: each vertex, in a scrambled order, is matched with
+// the unmatched neighbour it shares the heaviest edge with
+static NDGraph *
+coarsen(NDGraph *g)
+{
+  int n = g->n;
+  int *match = new int[n];
+  int *visit = new int[n];
+  g->cmap = new int[n];
+
+  for (int i=0; i<n; i++) {
+    match[i] = -1;
+    g->cmap[i] = -1;
+    visit[i] = i;
+  }
+
+  unsigned int seed = 12345;
+  for (int i=n-1; i>0; i--) {
+    seed = seed*1103515245 + 12345;
+    int j = (seed >> 8) % (i+1);
+    int tmp = visit[i]; visit[i] = visit[j]; visit[j] = tmp;
+  }
+
+  for (int k=0; k<n; k++) {
+    int v = visit[k];
+    if (match[v] != -1)
+      continue;
+    int best = v;
+    int bestWgt = -1;
+    for (int p=g->xadj[v]; p<g->xadj[v+1]; p++) {
+      int u = g->adjncy[p];
+      if (match[u] == -1 && u != v && g->adjwgt[p] > bestWgt) {
+	best = u;
+	bestWgt = g->adjwgt[p];
+      }
+    }
+    match[v] = best;
+    match[best] = v;
+  }
+
+  int cn = 0;
+  for (int v=0; v<n; v++)
+    if (g->cmap[v] == -1) {
+      g->cmap[v] = cn;
+      g->cmap[match[v]] = cn;
+      cn++;
+    }
+
+  NDGraph *c = newGraph(cn, g->xadj[n]);
+  int *mark = new int[cn];
+  for (int i=0; i<cn; i++)
+    mark[i] = -1;
+
+  // merge the adjacency of the two fine vertices of each coarse vertex
+  int numEdge = 0;
+  int cv = 0;
+  c->xadj[0] = 0;
+  for (int v=0; v<n; v++) {
+    if (g->cmap[v] != cv)
+      continue;
+    int start = numEdge;
+    int u = match[v];
+    c->vwgt[cv] = g->vwgt[v] + ((u != v) ? g->vwgt[u] : 0);
+    for (int pass=0; pass<2; pass++) {
+      int w = (pass == 0) ? v : u;
+      if (pass == 1 && u == v)
+	break;
+      for (int p=g->xadj[w]; p<g->xadj[w+1]; p++) {
+	int cu = g->cmap[g->adjncy[p]];
+	if (cu == cv)
+	  continue;
+	if (mark[cu] >= start)
+	  c->adjwgt[mark[cu]] += g->adjwgt[p];
+	else {
+	  mark[cu] = numEdge;
+	  c->adjncy[numEdge] = cu;
+	  c->adjwgt[numEdge++] = g->adjwgt[p];
+	}
+      }
+    }
+    c->xadj[++cv] = numEdge;
+  }
+
+  delete [] match;
+  delete [] visit;
+  delete [] mark;
+
+  return c;
+}
+
+// Fiduccia-Mattheyses refinement of a bisection: the boundary vertex of
+// largest gain is moved, even if the cut grows, and after ND_MAX_BAD_MOVES
+// moves without improvement the moves since the best cut are undone. The
+// heavier part is not allowed to exceed maxWgt.
+static int
+refine(NDGraph *g, int *part, int maxWgt)
+{
+  int n = g->n;
+  int *id = new int[n];
+  int *ed = new int[n];
+  int *moved = new int[n];
+  bool *locked = new bool[n];
+  int pwgt[2] = {0, 0};
+  int cut = 0;
+
+  for (int v=0; v<n; v++) {
+    pwgt[part[v]] += g->vwgt[v];
+    id[v] = 0;
+    ed[v] = 0;
+    for (int p=g->xadj[v]; p<g->xadj[v+1]; p++)
+      if (part[g->adjncy[p]] == part[v])
+	id[v] += g->adjwgt[p];
+      else
+	ed[v] += g->adjwgt[p];
+    cut += ed[v];
+  }
+  cut /= 2;
+
+  for (int pass=0; pass<ND_NUM_PASSES; pass++) {
+
+    // the boundary vertices of each part, ordered by decreasing gain
+    set<pair<int,int> > queue[2];
+    for (int v=0; v<n; v++) {
+      locked[v] = false;
+      if (ed[v] > 0)
+	queue[part[v]].insert(pair<int,int>(id[v]-ed[v], v));
+    }
+
+    // an unbalanced start is replaced by the first balanced bisection
+    bool balanced = (pwgt[0] <= maxWgt && pwgt[1] <= maxWgt);
+    int bestCut = (balanced == true) ? cut : g->xadj[n] + 1;
+    int bestImbalance = abs(pwgt[0] - pwgt[1]);
+    int numMoved = 0;
+    int bestMoved = 0;
+
+    while (numMoved - bestMoved < ND_MAX_BAD_MOVES) {
+      int from;
+      if (pwgt[0] > maxWgt)
+	from = 0;
+      else if (pwgt[1] > maxWgt)
+	from = 1;
+      else if (queue[0].empty())
+	from = 1;
+      else if (queue[1].empty())
+	from = 0;
+      else
+	from = (queue[0].begin()->first <= queue[1].begin()->first) ? 0 : 1;
+
+      // the best move is not allowed, try the other part
+      if (queue[from].empty() == false) {
+	int v = queue[from].begin()->second;
+	if (pwgt[1-from] + g->vwgt[v] > maxWgt && pwgt[from] <= maxWgt)
+	  from = 1 - from;
+      }
+      if (queue[from].empty())
+	break;
+
+      int v = queue[from].begin()->second;
+      int to = 1 - from;
+      if (pwgt[to] + g->vwgt[v] > maxWgt && pwgt[from] <= maxWgt)
+	break;
+
+      queue[from].erase(queue[from].begin());
+      locked[v] = true;
+      part[v] = to;
+      pwgt[from] -= g->vwgt[v];
+      pwgt[to] += g->vwgt[v];
+      cut -= ed[v] - id[v];
+      int tmp = id[v]; id[v] = ed[v]; ed[v] = tmp;
+      moved[numMoved++] = v;
+
+      for (int p=g->xadj[v]; p<g->xadj[v+1]; p++) {
+	int u = g->adjncy[p];
+	int w = g->adjwgt[p];
+	if (locked[u] == false && ed[u] > 0)
+	  queue[part[u]].erase(pair<int,int>(id[u]-ed[u], u));
+	if (part[u] == to) {
+	  id[u] += w; ed[u] -= w;
+	} else {
+	  id[u] -= w; ed[u] += w;
+	}
+	if (locked[u] == false && ed[u] > 0)
+	  queue[part[u]].insert(pair<int,int>(id[u]-ed[u], u));
+      }
+
+      int imbalance = abs(pwgt[0] - pwgt[1]);
+      if (pwgt[0] <= maxWgt && pwgt[1] <= maxWgt &&
+	  (cut < bestCut || (cut == bestCut && imbalance < bestImbalance))) {
+	bestCut = cut;
+	bestImbalance = imbalance;
+	bestMoved = numMoved;
+      }
+    }
+
+    if (bestCut > g->xadj[n])
+      bestMoved = numMoved;
+
+    // undo the moves since the best cut
+    while (numMoved > bestMoved) {
+      int v = moved[--numMoved];
+      int from = part[v];
+      int to = 1 - from;
+      part[v] = to;
+      pwgt[from] -= g->vwgt[v];
+      pwgt[to] += g->vwgt[v];
+      cut -= ed[v] - id[v];
+      int tmp = id[v]; id[v] = ed[v]; ed[v] = tmp;
+      for (int p=g->xadj[v]; p<g->xadj[v+1]; p++) {
+	int u = g->adjncy[p];
+	int w = g->adjwgt[p];
+	if (part[u] == to) {
+	  id[u] += w; ed[u] -= w;
+	} else {
+	  id[u] -= w; ed[u] += w;
+	}
+      }
+    }
+
+    if (bestMoved == 0)
+      break;
+  }
+
+  delete [] id;
+  delete [] ed;
+  delete [] moved;
+  delete [] locked;
+
+  return cut;
+}
+
+// grow part 0 breadth first from the seed until it holds half the weight
+static void
+grow(NDGraph *g, int seed, int *part, int *queue)
+{
+  int n = g->n;
+  int total = 0;
+  for (int v=0; v<n; v++) {
+    part[v] = 1;
+    total += g->vwgt[v];
+  }
+
+  int wgt0 = 0;
+  int head = 0, tail = 0;
+  int next = 0;
+  part[seed] = 0;
+  wgt0 += g->vwgt[seed];
+  queue[tail++] = seed;
+
+  while (2*wgt0 < total) {
+    if (head == tail) {
+      // a part of the graph not connected to the seed
+      while (next < n && part[next] == 0)
+	next++;
+      if (next == n)
+	break;
+      part[next] = 0;
+      wgt0 += g->vwgt[next];
+      queue[tail++] = next;
+      continue;
+    }
+    int v = queue[head++];
+    for (int p=g->xadj[v]; p<g->xadj[v+1] && 2*wgt0 < total; p++) {
+      int u = g->adjncy[p];
+      if (part[u] == 1) {
+	part[u] = 0;
+	wgt0 += g->vwgt[u];
+	queue[tail++] = u;
+      }
+    }
+  }
+}
+
+// the last vertex reached breadth first from the start
+static int
+farthest(NDGraph *g, int start, int *queue, int *mark)
+{
+  int n = g->n;
+  for (int v=0; v<n; v++)
+    mark[v] = 0;
+
+  int head = 0, tail = 0;
+  queue[tail++] = start;
+  mark[start] = 1;
+  while (head < tail) {
+    int v = queue[head++];
+    for (int p=g->xadj[v]; p<g->xadj[v+1]; p++)
+      if (mark[g->adjncy[p]] == 0) {
+	mark[g->adjncy[p]] = 1;
+	queue[tail++] = g->adjncy[p];
+      }
+  }
+
+  return queue[tail-1];
+}
+
+NestedDissection::NestedDissection(int size, bool print)
+:GraphNumberer(GraphNUMBERER_TAG_NestedDissection),
+ leafSize(size), printCost(print),
+ xadj(0), adjncy(0), vwgt(0), local(0), order(0), numSeparators(0)
+{
+  if (leafSize < 2)
+    leafSize = 2;
+}
+
+NestedDissection::~NestedDissection()
+{
+
+}
+
+const ID &
+NestedDissection::number(Graph &theGraph, int lastVertex)
+{
+  ID lastVertices(0);
+  if (lastVertex != -1) {
+    lastVertices.resize(1);
+    lastVertices(0) = lastVertex;
+  }
+
+  return this->number(theGraph, lastVertices);
+}
+
+// const ID &number(Graph &theGraph, const ID &lastVertices)
+//    Method to perform the nested dissection ordering. The vertices in
+// lastVertices are moved to the end of the ordering. The result contains
+// the tags of the vertices in the order they are to be numbered.
+//
+// side effects: this routine changes the Tmp of the vertices.
+
+const ID &
+NestedDissection::number(Graph &theGraph, const ID &lastVertices)
+{
+  int *vertexTags;
+  int numVertex = getCompressedGraph(theGraph, xadj, adjncy, vertexTags);
+
+  theResult.resize(numVertex);
+
+  vwgt = new int[numVertex+1];
+  local = new int[numVertex+1];
+  order = new int[numVertex+1];
+  int *vertices = new int[numVertex+1];
+
+  VertexIter &vertexIter = theGraph.getVertices();
+  Vertex *vertexPtr;
+  while ((vertexPtr = vertexIter()) != 0) {
+    int color = vertexPtr->getColor();
+    vwgt[vertexPtr->getTmp()] = (color > 0) ? color : 1;
+  }
+
+  for (int i=0; i<numVertex; i++) {
+    local[i] = -1;
+    vertices[i] = i;
+  }
+
+  numSeparators = 0;
+  int last = numVertex;
+  this->dissect(vertices, numVertex, last);
+
+  // vertices asked for are numbered last
+  bool *isLast = new bool[numVertex+1];
+  for (int i=0; i<numVertex; i++)
+    isLast[i] = false;
+
+  int numLast = lastVertices.Size();
+  for (int j=0; j<numLast; j++) {
+    vertexPtr = theGraph.getVertexPtr(lastVertices(j));
+    if (vertexPtr != 0)
+      isLast[vertexPtr->getTmp()] = true;
+  }
+
+  int count = 0;
+  for (int i=0; i<numVertex; i++)
+    if (isLast[order[i]] == false)
+      theResult(count++) = vertexTags[order[i]];
+
+  for (int j=0; j<numLast; j++) {
+    vertexPtr = theGraph.getVertexPtr(lastVertices(j));
+    if (vertexPtr != 0 && isLast[vertexPtr->getTmp()] == true) {
+      isLast[vertexPtr->getTmp()] = false;
+      theResult(count++) = lastVertices(j);
+    }
+  }
+
+  delete [] isLast;
+  delete [] vertices;
+  delete [] order;
+  delete [] local;
+  delete [] vwgt;
+  delete [] xadj;
+  delete [] adjncy;
+  delete [] vertexTags;
+  order = 0; local = 0; vwgt = 0; xadj = 0; adjncy = 0;
+
+  if (printCost == true) {
+    double numNonZeros, numFlops;
+    if (getFactorCost(theGraph, theResult, numNonZeros, numFlops) == 0) {
+      opserr << "NestedDissection::number - vertices: " << numVertex;
+      opserr << " separators: " << numSeparators;
+      opserr << " predicted nonzeros in L: " << numNonZeros;
+      opserr << " flops: " << numFlops << endln;
+    }
+  }
+
+  return theResult;
+}
+
+void
+NestedDissection::dissect(int *vertices, int numVertices, int &last)
+{
+  if (numVertices <= leafSize) {
+    this->orderLeaf(vertices, numVertices, last);
+    return;
+  }
+
+  int *where = new int[numVertices];
+  this->bisect(vertices, numVertices, where);
+
+  int num[3] = {0, 0, 0};
+  for (int i=0; i<numVertices; i++)
+    num[where[i]]++;
+
+  // no progress, a dense part
+  if (num[0] == 0 || num[1] == 0) {
+    delete [] where;
+    this->orderLeaf(vertices, numVertices, last);
+    return;
+  }
+
+  int *part0 = new int[num[0]];
+  int *part1 = new int[num[1]];
+  int count0 = 0, count1 = 0;
+
+  last -= num[2];
+  int count2 = last;
+  for (int i=0; i<numVertices; i++) {
+    if (where[i] == 0)
+      part0[count0++] = vertices[i];
+    else if (where[i] == 1)
+      part1[count1++] = vertices[i];
+    else
+      order[count2++] = vertices[i];
+  }
+  if (num[2] > 0)
+    numSeparators++;
+
+  delete [] where;
+
+  this->dissect(part1, num[1], last);
+  delete [] part1;
+  this->dissect(part0, num[0], last);
+  delete [] part0;
+}
+
+void
+NestedDissection::bisect(int *vertices, int numVertices, int *where)
+{
+  for (int i=0; i<numVertices; i++)
+    local[vertices[i]] = i;
+
+  // the part as the finest graph of the multilevel bisection
+  int numEdge = 0;
+  for (int i=0; i<numVertices; i++) {
+    int v = vertices[i];
+    for (int p=xadj[v]; p<xadj[v+1]; p++)
+      if (local[adjncy[p]] >= 0)
+	numEdge++;
+  }
+
+  NDGraph *g = newGraph(numVertices, numEdge);
+  numEdge = 0;
+  g->xadj[0] = 0;
+  int total = 0;
+  int maxVertexWgt = 0;
+  for (int i=0; i<numVertices; i++) {
+    int v = vertices[i];
+    for (int p=xadj[v]; p<xadj[v+1]; p++) {
+      int u = local[adjncy[p]];
+      if (u >= 0) {
+	g->adjncy[numEdge] = u;
+	g->adjwgt[numEdge++] = 1;
+      }
+    }
+    g->xadj[i+1] = numEdge;
+    g->vwgt[i] = vwgt[v];
+    total += vwgt[v];
+    if (vwgt[v] > maxVertexWgt)
+      maxVertexWgt = vwgt[v];
+  }
+
+  int maxWgt = (int)((1.0 + ND_IMBALANCE)*total/2.0);
+  if (2*maxWgt < total + 2*maxVertexWgt)
+    maxWgt = (total + 1)/2 + maxVertexWgt;
+
+  vector<NDGraph *> levels;
+  levels.push_back(g);
+  while (g->n > ND_COARSEN_TO) {
+    NDGraph *c = coarsen(g);
+    if (c->n > 0.85*g->n) {
+      deleteGraph(c);
+      delete [] g->cmap;
+      g->cmap = 0;
+      break;
+    }
+    levels.push_back(c);
+    g = c;
+  }
+
+  // the best of a few bisections of the coarsest graph
+  int n = g->n;
+  int *part = new int[n];
+  int *bestPart = new int[n];
+  int *queue = new int[n];
+  int *mark = new int[n];
+  int bestCut = -1;
+  for (int t=0; t<ND_NUM_TRIES && t<n; t++) {
+    int seed = farthest(g, (t*n)/ND_NUM_TRIES, queue, mark);
+    grow(g, seed, part, queue);
+    int cut = refine(g, part, maxWgt);
+    if (bestCut < 0 || cut < bestCut) {
+      bestCut = cut;
+      for (int v=0; v<n; v++)
+	bestPart[v] = part[v];
+    }
+  }
+  delete [] part;
+  delete [] queue;
+  delete [] mark;
+
+  // project back to the finest graph, refining at each level
+  for (int l=levels.size()-2; l>=0; l--) {
+    NDGraph *fine = levels[l];
+    int *finePart = new int[fine->n];
+    for (int v=0; v<fine->n; v++)
+      finePart[v] = bestPart[fine->cmap[v]];
+    delete [] bestPart;
+    bestPart = finePart;
+    refine(fine, bestPart, maxWgt);
+  }
+
+  // the vertex separator is the smaller of the two sides of the cut
+  g = levels[0];
+  int boundary[2] = {0, 0};
+  for (int v=0; v<numVertices; v++) {
+    where[v] = bestPart[v];
+    for (int p=g->xadj[v]; p<g->xadj[v+1]; p++)
+      if (bestPart[g->adjncy[p]] != bestPart[v]) {
+	boundary[bestPart[v]] += g->vwgt[v];
+	break;
+      }
+  }
+  int side = (boundary[0] <= boundary[1]) ? 0 : 1;
+  for (int v=0; v<numVertices; v++) {
+    if (bestPart[v] != side)
+      continue;
+    for (int p=g->xadj[v]; p<g->xadj[v+1]; p++)
+      if (bestPart[g->adjncy[p]] != side) {
+	where[v] = 2;
+	break;
+      }
+  }
+
+  // move a separator vertex into a part when the neighbours it brings
+  // into the separator from the other part weigh less than it does
+  int pwgt[3] = {0, 0, 0};
+  for (int v=0; v<numVertices; v++)
+    pwgt[where[v]] += g->vwgt[v];
+
+  for (int pass=0; pass<ND_NUM_PASSES; pass++) {
+    int numMoved = 0;
+    for (int v=0; v<numVertices; v++) {
+      if (where[v] != 2)
+	continue;
+      int cost[2] = {0, 0};
+      for (int p=g->xadj[v]; p<g->xadj[v+1]; p++) {
+	int u = g->adjncy[p];
+	if (where[u] != 2)
+	  cost[1-where[u]] += g->vwgt[u];
+      }
+      int to = (cost[0] <= cost[1]) ? 0 : 1;
+      if (pwgt[to] + g->vwgt[v] > maxWgt)
+	to = 1 - to;
+      if (cost[to] >= g->vwgt[v] || pwgt[to] + g->vwgt[v] > maxWgt)
+	continue;
+
+      where[v] = to;
+      pwgt[to] += g->vwgt[v];
+      pwgt[2] += cost[to] - g->vwgt[v];
+      pwgt[1-to] -= cost[to];
+      for (int p=g->xadj[v]; p<g->xadj[v+1]; p++) {
+	int u = g->adjncy[p];
+	if (where[u] == 1-to)
+	  where[u] = 2;
+      }
+      numMoved++;
+    }
+    if (numMoved == 0)
+      break;
+  }
+
+  delete [] bestPart;
+  for (unsigned int l=0; l<levels.size(); l++)
+    deleteGraph(levels[l]);
+
+  for (int i=0; i<numVertices; i++)
+    local[vertices[i]] = -1;
+}
+
+void
+NestedDissection::orderLeaf(int *vertices, int numVertices, int &last)
+{
+  last -= numVertices;
+  if (numVertices == 0)
+    return;
+
+  for (int i=0; i<numVertices; i++)
+    local[vertices[i]] = i;
+
+  int numEdge = 0;
+  for (int i=0; i<numVertices; i++) {
+    int v = vertices[i];
+    for (int p=xadj[v]; p<xadj[v+1]; p++)
+      if (local[adjncy[p]] >= 0)
+	numEdge++;
+  }
+
+  int *Ap = new int[numVertices+1];
+  int *Ai = new int[numEdge > 0 ? numEdge : 1];
+  int *P = new int[numVertices];
+
+  numEdge = 0;
+  Ap[0] = 0;
+  for (int i=0; i<numVertices; i++) {
+    int v = vertices[i];
+    for (int p=xadj[v]; p<xadj[v+1]; p++)
+      if (local[adjncy[p]] >= 0)
+	Ai[numEdge++] = local[adjncy[p]];
+    Ap[i+1] = numEdge;
+  }
+
+  int status = amd_order(numVertices, Ap, Ai, P, (double *)NULL, (double *)NULL);
+  if (status != AMD_OK && status != AMD_OK_BUT_JUMBLED)
+    for (int i=0; i<numVertices; i++)
+      P[i] = i;
+
+  for (int i=0; i<numVertices; i++) {
+    order[last+i] = vertices[P[i]];
+    local[vertices[i]] = -1;
+  }
+
+  delete [] Ap;
+  delete [] Ai;
+  delete [] P;
+}
+
+int
+NestedDissection::sendSelf(int commitTag, Channel &theChannel)
+{
+  return 0;
+}
+
+int
+NestedDissection::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+  return 0;
+}
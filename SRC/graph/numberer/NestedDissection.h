@@ -0,0 +1,74 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// $Source: /usr/local/cvs/OpenSees/SRC/graph/numberer/NestedDissection.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for 
+// NestedDissection. NestedDissection is a GraphNumberer which orders the 
+// vertices for a sparse direct solver: the graph is split in two by a 
+// vertex separator, found from a multilevel (heavy edge matching, graph
+// growing, boundary refinement) bisection, the parts are numbered 
+// recursively in the same way and the separator is numbered last. Parts 
+// smaller than the leaf size are ordered by approximate minimum degree.
+//
+// What: "@(#) NestedDissection.h, revA"
+
+#ifndef NestedDissection_h
+#define NestedDissection_h
+
+#include <GraphNumberer.h>
+#include <ID.h>
+
+class NestedDissection: public GraphNumberer
+{
+  public:
+    NestedDissection(int leafSize = 64, bool printCost = false); 
+    ~NestedDissection();
+
+    const ID &number(Graph &theGraph, int lastVertex = -1);
+    const ID &number(Graph &theGraph, const ID &lastVertices);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel, 
+		 FEM_ObjectBroker &theBroker);
+    
+  protected:
+    
+  private:
+    void dissect(int *vertices, int numVertices, int &last);
+    void bisect(int *vertices, int numVertices, int *where);
+    void orderLeaf(int *vertices, int numVertices, int &last);
+
+    ID theResult;
+    int leafSize;
+    bool printCost;     // report the separators and the cost of the factor
+
+    // the graph being numbered, in compressed form
+    int *xadj;
+    int *adjncy;
+    int *vwgt;
+    int *local;         // location in the part being split, -1 if not in it
+    int *order;         // the ordering, filled from the back
+    int numSeparators;
+};
+
+#endif
@@ -0,0 +1,559 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/handler/AsyncStream.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of AsyncStream.
+//
+// What: "@(#) AsyncStream.C, revA"
+
+#include <AsyncStream.h>
+#include <Vector.h>
+#include <OPS_Globals.h>
+#include <classTags.h>
+#include <string.h>
+
+// a buffer of one stream, each row is stored as its size followed by
+// its values
+class AsyncStreamBuffer
+{
+ public:
+  AsyncStream *owner;
+  double *data;
+  int fill;
+  AsyncStreamBuffer *next;
+};
+
+static AsyncStreamBuffer *
+newAsyncStreamBuffer(AsyncStream *owner, int capacity)
+{
+  AsyncStreamBuffer *theBuffer = new AsyncStreamBuffer;
+  theBuffer->owner = owner;
+  theBuffer->data = new double[capacity];
+  theBuffer->fill = 0;
+  theBuffer->next = 0;
+  return theBuffer;
+}
+
+static void
+deleteAsyncStreamBuffers(AsyncStreamBuffer *theBuffer)
+{
+  while (theBuffer != 0) {
+    AsyncStreamBuffer *next = theBuffer->next;
+    delete [] theBuffer->data;
+    delete theBuffer;
+    theBuffer = next;
+  }
+}
+
+#ifdef _THREADS
+AsyncStreamBuffer *AsyncStream::queueHead = 0;
+AsyncStreamBuffer *AsyncStream::queueTail = 0;
+int AsyncStream::queueSize = 0;
+int AsyncStream::numStreams = 0;
+bool AsyncStream::shutDown = false;
+bool AsyncStream::writerRunning = false;
+pthread_t AsyncStream::theWriter;
+pthread_mutex_t AsyncStream::theMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t AsyncStream::workCond = PTHREAD_COND_INITIALIZER;
+pthread_cond_t AsyncStream::doneCond = PTHREAD_COND_INITIALIZER;
+#endif
+
+AsyncStream::AsyncStream(OPS_Stream *stream, int bufferSize, int thePolicy)
+  :OPS_Stream(OPS_STREAM_TAGS_AsyncStream),
+   theStream(stream), policy(thePolicy), numDropped(0),
+   capacity(bufferSize), current(0), spare(0), numQueued(0)
+{
+  if (capacity < 1024)
+    capacity = 1024;
+
+#ifdef _THREADS
+  // the streams share one writer, started with the first of them
+  pthread_mutex_lock(&theMutex);
+  if (writerRunning == false) {
+    shutDown = false;
+    if (pthread_create(&theWriter, 0, AsyncStream::writerMain, 0) == 0)
+      writerRunning = true;
+    else
+      opserr << "WARNING AsyncStream::AsyncStream() - could not start the writer thread, rows are written directly\n";
+  }
+
+  if (writerRunning == true) {
+    numStreams++;
+    current = newAsyncStreamBuffer(this, capacity);
+  }
+  pthread_mutex_unlock(&theMutex);
+#endif
+}
+
+AsyncStream::~AsyncStream()
+{
+  this->flush();
+
+#ifdef _THREADS
+  if (current != 0) {
+    pthread_mutex_lock(&theMutex);
+    numStreams--;
+    bool lastStream = (numStreams == 0);
+    if (lastStream == true) {
+      shutDown = true;
+      pthread_cond_signal(&workCond);
+    }
+    pthread_mutex_unlock(&theMutex);
+
+    if (lastStream == true) {
+      pthread_join(theWriter, 0);
+      pthread_mutex_lock(&theMutex);
+      writerRunning = false;
+      pthread_mutex_unlock(&theMutex);
+    }
+
+    // nothing is queued after the flush, all the buffers are back
+    deleteAsyncStreamBuffers(current);
+    deleteAsyncStreamBuffers(spare);
+  }
+#endif
+
+  if (numDropped != 0)
+    opserr << "WARNING AsyncStream - " << numDropped << " rows were dropped, the writer could not keep up\n";
+
+  if (theStream != 0)
+    delete theStream;
+}
+
+int
+AsyncStream::flush(void)
+{
+#ifdef _THREADS
+  if (current == 0)
+    return 0;
+
+  pthread_mutex_lock(&theMutex);
+  if (current->fill != 0)
+    this->queueBuffer(true);
+  while (numQueued != 0)
+    pthread_cond_wait(&doneCond, &theMutex);
+  pthread_mutex_unlock(&theMutex);
+#endif
+
+  return 0;
+}
+
+int
+AsyncStream::getNumDropped(void)
+{
+  return numDropped;
+}
+
+int
+AsyncStream::write(Vector &data)
+{
+  int size = data.Size();
+
+#ifdef _THREADS
+  if (current != 0 && size + 1 <= capacity) {
+
+    if (current->fill + size + 1 > capacity) {
+      pthread_mutex_lock(&theMutex);
+      int res = this->queueBuffer(policy != ASYNC_STREAM_DROP);
+      pthread_mutex_unlock(&theMutex);
+
+      // the queue is full, drop the row
+      if (res < 0) {
+	numDropped++;
+	return 0;
+      }
+    }
+
+    double *row = current->data + current->fill;
+    row[0] = size;
+    for (int i=0; i<size; i++)
+      row[i+1] = data(i);
+    current->fill += size + 1;
+
+    return 0;
+  }
+
+  // a row larger than a buffer is written once the others are
+  this->flush();
+#endif
+
+  return theStream->write(data);
+}
+
+#ifdef _THREADS
+
+// puts the current buffer on the queue and takes an empty one, called
+// with theMutex held; returns -1 if the queue is full and wait is false
+int
+AsyncStream::queueBuffer(bool wait)
+{
+  while (queueSize >= ASYNC_STREAM_QUEUE_SIZE) {
+    if (wait == false)
+      return -1;
+    pthread_cond_wait(&doneCond, &theMutex);
+  }
+
+  current->next = 0;
+  if (queueTail == 0)
+    queueHead = current;
+  else
+    queueTail->next = current;
+  queueTail = current;
+  queueSize++;
+  numQueued++;
+  pthread_cond_signal(&workCond);
+
+  if (spare != 0) {
+    current = spare;
+    spare = spare->next;
+    current->next = 0;
+  } else
+    current = newAsyncStreamBuffer(this, capacity);
+
+  return 0;
+}
+
+void *
+AsyncStream::writerMain(void *)
+{
+  pthread_mutex_lock(&theMutex);
+  while (true) {
+    while (queueHead == 0 && shutDown == false)
+      pthread_cond_wait(&workCond, &theMutex);
+
+    if (queueHead == 0)
+      break;
+
+    AsyncStreamBuffer *theBuffer = queueHead;
+    queueHead = theBuffer->next;
+    if (queueHead == 0)
+      queueTail = 0;
+
+    // write without holding the lock, the analysis keeps filling buffers
+    pthread_mutex_unlock(&theMutex);
+
+    AsyncStream *owner = theBuffer->owner;
+    owner->writeBuffer(theBuffer);
+
+    pthread_mutex_lock(&theMutex);
+    theBuffer->fill = 0;
+    theBuffer->next = owner->spare;
+    owner->spare = theBuffer;
+    owner->numQueued--;
+    queueSize--;
+    pthread_cond_broadcast(&doneCond);
+  }
+  pthread_mutex_unlock(&theMutex);
+
+  return 0;
+}
+
+void
+AsyncStream::writeBuffer(AsyncStreamBuffer *theBuffer)
+{
+  double *data = theBuffer->data;
+  int numData = theBuffer->fill;
+
+  int loc = 0;
+  while (loc < numData) {
+    int size = (int)data[loc];
+    Vector row(&data[loc+1], size);
+    theStream->write(row);
+    loc += size + 1;
+  }
+}
+
+#endif
+
+int
+AsyncStream::setFile(const char *fileName, openMode mode)
+{
+  this->flush();
+  return theStream->setFile(fileName, mode);
+}
+
+int
+AsyncStream::setPrecision(int prec)
+{
+  this->flush();
+  return theStream->setPrecision(prec);
+}
+
+int
+AsyncStream::setFloatField(floatField field)
+{
+  this->flush();
+  return theStream->setFloatField(field);
+}
+
+int
+AsyncStream::precision(int prec)
+{
+  this->flush();
+  return theStream->precision(prec);
+}
+
+int
+AsyncStream::width(int w)
+{
+  this->flush();
+  return theStream->width(w);
+}
+
+int
+AsyncStream::tag(const char *tagName)
+{
+  this->flush();
+  return theStream->tag(tagName);
+}
+
+int
+AsyncStream::tag(const char *tagName, const char *value)
+{
+  this->flush();
+  return theStream->tag(tagName, value);
+}
+
+int
+AsyncStream::endTag()
+{
+  this->flush();
+  return theStream->endTag();
+}
+
+int
+AsyncStream::attr(const char *name, int value)
+{
+  this->flush();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::attr(const char *name, double value)
+{
+  this->flush();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::attr(const char *name, const char *value)
+{
+  this->flush();
+  return theStream->attr(name, value);
+}
+
+OPS_Stream&
+AsyncStream::write(const char *s, int n)
+{
+  this->flush();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::write(const unsigned char *s, int n)
+{
+  this->flush();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::write(const signed char *s, int n)
+{
+  this->flush();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::write(const void *s, int n)
+{
+  this->flush();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::write(const double *s, int n)
+{
+  this->flush();
+  theStream->write(s, n);
+  return *this;
+}
+
+int
+AsyncStream::writeBytes(const char *data, int numBytes)
+{
+  this->flush();
+  return theStream->writeBytes(data, numBytes);
+}
+
+OPS_Stream&
+AsyncStream::operator<<(char c)
+{
+  this->flush();
+  (*theStream) << c;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(unsigned char c)
+{
+  this->flush();
+  (*theStream) << c;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(signed char c)
+{
+  this->flush();
+  (*theStream) << c;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(const char *s)
+{
+  this->flush();
+  (*theStream) << s;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(const unsigned char *s)
+{
+  this->flush();
+  (*theStream) << s;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(const signed char *s)
+{
+  this->flush();
+  (*theStream) << s;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(const void *p)
+{
+  this->flush();
+  (*theStream) << p;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(int n)
+{
+  this->flush();
+  (*theStream) << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(unsigned int n)
+{
+  this->flush();
+  (*theStream) << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(long n)
+{
+  this->flush();
+  (*theStream) << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(unsigned long n)
+{
+  this->flush();
+  (*theStream) << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(short n)
+{
+  this->flush();
+  (*theStream) << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(unsigned short n)
+{
+  this->flush();
+  (*theStream) << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(bool b)
+{
+  this->flush();
+  (*theStream) << b;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(double n)
+{
+  this->flush();
+  (*theStream) << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(float n)
+{
+  this->flush();
+  (*theStream) << n;
+  return *this;
+}
+
+int
+AsyncStream::setOrder(const ID &orderOfData)
+{
+  this->flush();
+  return theStream->setOrder(orderOfData);
+}
+
+int
+AsyncStream::sendSelf(int commitTag, Channel &theChannel)
+{
+  this->flush();
+  return theStream->sendSelf(commitTag, theChannel);
+}
+
+int
+AsyncStream::recvSelf(int commitTag, Channel &theChannel,
+		      FEM_ObjectBroker &theBroker)
+{
+  return theStream->recvSelf(commitTag, theChannel, theBroker);
+}
@@ -0,0 +1,148 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/handler/AsyncStream.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for AsyncStream.
+// An AsyncStream is put in front of another OPS_Stream, which it owns.
+// write(Vector &) only copies the data into a buffer of the stream. A
+// full buffer is put on a queue shared by all the AsyncStreams and one
+// writer thread passes its rows on to the owning stream. The queue holds
+// at most ASYNC_STREAM_QUEUE_SIZE buffers; when it is full the policy
+// decides whether the analysis waits for the writer (ASYNC_STREAM_BLOCK)
+// or the row is dropped (ASYNC_STREAM_DROP). The writer is started with
+// the first AsyncStream and stopped when the last one is deleted.
+//
+// All other calls (xml tags, text) are rare and are passed on directly,
+// after the buffered rows have been written so the order is kept. The
+// destructor writes the remaining rows. When the program is built
+// without _THREADS rows are written directly.
+//
+// What: "@(#) AsyncStream.h, revA"
+
+#ifndef AsyncStream_h
+#define AsyncStream_h
+
+#include <OPS_Stream.h>
+
+#ifdef _THREADS
+#include <pthread.h>
+#endif
+
+#define ASYNC_STREAM_BLOCK 0
+#define ASYNC_STREAM_DROP  1
+
+// default number of values held by a buffer
+#define ASYNC_STREAM_BUFFER_SIZE 8192
+
+// number of full buffers, of all the streams, waiting for the writer
+#define ASYNC_STREAM_QUEUE_SIZE 32
+
+class AsyncStreamBuffer;
+
+class AsyncStream : public OPS_Stream
+{
+ public:
+  AsyncStream(OPS_Stream *theStream, int bufferSize = ASYNC_STREAM_BUFFER_SIZE,
+	      int policy = ASYNC_STREAM_BLOCK);
+  ~AsyncStream();
+
+  // waits until all the rows have been passed on
+  int flush(void);
+  int getNumDropped(void);
+
+  int setFile(const char *fileName, openMode mode = OVERWRITE);
+  int setPrecision(int precision);
+  int setFloatField(floatField);
+  int precision(int precision);
+  int width(int width);
+
+  // xml stuff
+  int tag(const char *);
+  int tag(const char *, const char *);
+  int endTag();
+  int attr(const char *name, int value);
+  int attr(const char *name, double value);
+  int attr(const char *name, const char *value);
+  int write(Vector &data);
+
+  // regular stuff
+  OPS_Stream& write(const char *s, int n);
+  OPS_Stream& write(const unsigned char *s, int n);
+  OPS_Stream& write(const signed char *s, int n);
+  OPS_Stream& write(const void *s, int n);
+  OPS_Stream& write(const double *s, int n);
+  int writeBytes(const char *data, int numBytes);
+
+  OPS_Stream& operator<<(char c);
+  OPS_Stream& operator<<(unsigned char c);
+  OPS_Stream& operator<<(signed char c);
+  OPS_Stream& operator<<(const char *s);
+  OPS_Stream& operator<<(const unsigned char *s);
+  OPS_Stream& operator<<(const signed char *s);
+  OPS_Stream& operator<<(const void *p);
+  OPS_Stream& operator<<(int n);
+  OPS_Stream& operator<<(unsigned int n);
+  OPS_Stream& operator<<(long n);
+  OPS_Stream& operator<<(unsigned long n);
+  OPS_Stream& operator<<(short n);
+  OPS_Stream& operator<<(unsigned short n);
+  OPS_Stream& operator<<(bool b);
+  OPS_Stream& operator<<(double n);
+  OPS_Stream& operator<<(float n);
+
+  // parallel stuff
+  int setOrder(const ID &orderOfData);
+  int sendSelf(int commitTag, Channel &theChannel);
+  int recvSelf(int commitTag, Channel &theChannel,
+	       FEM_ObjectBroker &theBroker);
+
+ private:
+  OPS_Stream *theStream;
+  int policy;
+  int numDropped;
+
+  int capacity;
+  AsyncStreamBuffer *current;  // buffer filled by the analysis
+  AsyncStreamBuffer *spare;    // buffers given back by the writer
+  int numQueued;               // buffers of this stream on the queue
+
+#ifdef _THREADS
+  int queueBuffer(bool wait);
+  void writeBuffer(AsyncStreamBuffer *theBuffer);
+  static void *writerMain(void *arg);
+
+  // shared by all the streams, guarded by theMutex
+  static AsyncStreamBuffer *queueHead;
+  static AsyncStreamBuffer *queueTail;
+  static int queueSize;
+  static int numStreams;
+  static bool shutDown;
+  static bool writerRunning;
+  static pthread_t theWriter;
+  static pthread_mutex_t theMutex;
+  static pthread_cond_t workCond;
+  static pthread_cond_t doneCond;
+#endif
+};
+
+#endif
@@ -228,6 +228,20 @@ BinaryFileStream::attr(const char *name, const char *value)
   return 0;
 }
 
+// the bytes go to the file as they are, for callers with their own framing
+int
+BinaryFileStream::writeBytes(const char *data, int numBytes)
+{
+  if (fileOpen == 0)
+    this->open();
+
+  if (fileOpen == 0)
+    return -1;
+
+  theFile.write(data, numBytes);
+  return 0;
+}
+
 int 
 BinaryFileStream::write(Vector &data)
 {
@@ -61,6 +61,7 @@ class BinaryFileStream : public OPS_Stream
   int attr(const char *name, double value);
   int attr(const char *name, const char *value);
   int write(Vector &data);
+  int writeBytes(const char *data, int numBytes);
 
   // regular stuff
   OPS_Stream& write(const char *s, int n);
@@ -0,0 +1,610 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/handler/ColumnarFileStream.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of
+// ColumnarFileStream and of the functions reading its files back.
+//
+// What: "@(#) ColumnarFileStream.C, revA"
+
+#include <ColumnarFileStream.h>
+#include <Vector.h>
+#include <LZ_Codec.h>
+#include <OPS_Globals.h>
+#include <classTags.h>
+#include <iostream>
+#include <iomanip>
+#include <string.h>
+#include <stdio.h>
+
+using std::ios;
+using std::ifstream;
+using std::setprecision;
+
+ColumnarFileStream::ColumnarFileStream(const char *file, int numRowsChunk,
+				       bool compressChunks, openMode mode)
+  :OPS_Stream(OPS_STREAM_TAGS_ColumnarFileStream),
+   fileOpen(0), theOpenMode(mode), fileName(0),
+   schema(0), schemaLength(0), schemaCapacity(0),
+   tags(0), numTag(0), sizeTags(0), attributeMode(false),
+   headerWritten(false), compress(compressChunks), numColumns(0),
+   rowsPerChunk(numRowsChunk), numRows(0),
+   theData(0), workSpace1(0), workSpace2(0), sizeWorkSpace2(0)
+{
+  if (rowsPerChunk < 1)
+    rowsPerChunk = 1;
+
+  this->setFile(file, mode);
+}
+
+ColumnarFileStream::~ColumnarFileStream()
+{
+  this->close();
+
+  if (fileName != 0)
+    delete [] fileName;
+
+  if (schema != 0)
+    delete [] schema;
+
+  for (int i=0; i<numTag; i++)
+    delete [] tags[i];
+  if (tags != 0)
+    delete [] tags;
+
+  if (theData != 0)
+    delete [] theData;
+  if (workSpace1 != 0)
+    delete [] workSpace1;
+  if (workSpace2 != 0)
+    delete [] workSpace2;
+}
+
+int
+ColumnarFileStream::setFile(const char *name, openMode mode)
+{
+  if (name == 0) {
+    opserr << "ColumnarFileStream::setFile() - no name passed\n";
+    return -1;
+  }
+
+  // if file already open, close it
+  if (fileOpen == 1)
+    this->close();
+
+  if (fileName != 0)
+    delete [] fileName;
+
+  fileName = new char[strlen(name)+1];
+  strcpy(fileName, name);
+  theOpenMode = mode;
+
+  return 0;
+}
+
+int
+ColumnarFileStream::open(void)
+{
+  // check setFile has been called
+  if (fileName == 0) {
+    opserr << "ColumnarFileStream::open(void) - no file name has been set\n";
+    return -1;
+  }
+
+  // if file already open, return
+  if (fileOpen == 1)
+    return 0;
+
+  if (theOpenMode == OVERWRITE)
+    theFile.open(fileName, ios::out | ios::binary);
+  else
+    theFile.open(fileName, ios::out | ios::app | ios::binary);
+
+  if (theFile.bad() || theFile.is_open() == false) {
+    opserr << "WARNING - ColumnarFileStream::open()";
+    opserr << " - could not open file " << fileName << endln;
+    fileOpen = 0;
+    return -1;
+  }
+  fileOpen = 1;
+
+  // a file appended to already has the magic string
+  theFile.seekp(0, ios::end);
+  if (theFile.tellp() == (std::streampos)0)
+    theFile.write(COLUMNAR_FILE_MAGIC, strlen(COLUMNAR_FILE_MAGIC));
+
+  // anything written from now on follows a new header
+  theOpenMode = APPEND;
+  headerWritten = false;
+
+  return 0;
+}
+
+int
+ColumnarFileStream::close(void)
+{
+  if (fileOpen == 0)
+    return 0;
+
+  // keep the description of a recorder that never wrote any data
+  if (headerWritten == false)
+    this->writeHeader();
+
+  if (numRows != 0)
+    this->writeChunk();
+
+  theFile.close();
+  fileOpen = 0;
+
+  return 0;
+}
+
+int
+ColumnarFileStream::tag(const char *tagName)
+{
+  if (attributeMode == true)
+    this->addToSchema(">\n");
+
+  // keep the name for endTag()
+  if (numTag == sizeTags) {
+    int nextSize = (sizeTags == 0) ? 32 : 2*sizeTags;
+    char **nextTags = new char *[nextSize];
+    for (int i=0; i<numTag; i++)
+      nextTags[i] = tags[i];
+    if (tags != 0)
+      delete [] tags;
+    tags = nextTags;
+    sizeTags = nextSize;
+  }
+  tags[numTag] = new char[strlen(tagName)+1];
+  strcpy(tags[numTag], tagName);
+  numTag++;
+
+  this->addToSchema("<");
+  this->addToSchema(tagName);
+  attributeMode = true;
+
+  return 0;
+}
+
+int
+ColumnarFileStream::tag(const char *tagName, const char *value)
+{
+  if (attributeMode == true)
+    this->addToSchema(">\n");
+
+  this->addToSchema("<");
+  this->addToSchema(tagName);
+  this->addToSchema(">");
+  this->addToSchema(value);
+  this->addToSchema("</");
+  this->addToSchema(tagName);
+  this->addToSchema(">\n");
+
+  attributeMode = false;
+
+  return 0;
+}
+
+int
+ColumnarFileStream::endTag()
+{
+  if (numTag == 0)
+    return -1;
+
+  if (attributeMode == true)
+    this->addToSchema("/>\n");
+  else {
+    this->addToSchema("</");
+    this->addToSchema(tags[numTag-1]);
+    this->addToSchema(">\n");
+  }
+
+  delete [] tags[numTag-1];
+  numTag--;
+  attributeMode = false;
+
+  return 0;
+}
+
+int
+ColumnarFileStream::attr(const char *name, int value)
+{
+  char intRep[32];
+  sprintf(intRep, "%d", value);
+  return this->attr(name, intRep);
+}
+
+int
+ColumnarFileStream::attr(const char *name, double value)
+{
+  char doubleRep[32];
+  sprintf(doubleRep, "%.16g", value);
+  return this->attr(name, doubleRep);
+}
+
+int
+ColumnarFileStream::attr(const char *name, const char *value)
+{
+  this->addToSchema(" ");
+  this->addToSchema(name);
+  this->addToSchema("=\"");
+  this->addToSchema(value);
+  this->addToSchema("\"");
+
+  return 0;
+}
+
+int
+ColumnarFileStream::write(Vector &data)
+{
+  if (fileOpen == 0)
+    if (this->open() < 0)
+      return -1;
+
+  // the first row fixes the number of columns
+  if (headerWritten == false) {
+    if (theData == 0 || numColumns != data.Size()) {
+      if (numRows != 0)
+	this->writeChunk();
+      if (theData != 0)
+	delete [] theData;
+      numColumns = data.Size();
+      theData = new double[numColumns*rowsPerChunk];
+    }
+    if (this->writeHeader() < 0)
+      return -1;
+  }
+
+  int size = data.Size();
+  if (size != numColumns) {
+    opserr << "WARNING ColumnarFileStream::write() - row of size " << size;
+    opserr << " written to a file of " << numColumns << " columns\n";
+    if (size > numColumns)
+      size = numColumns;
+  }
+
+  double *dataPtr = theData + numRows;
+  for (int i=0; i<size; i++, dataPtr += rowsPerChunk)
+    *dataPtr = data(i);
+  for (int j=size; j<numColumns; j++, dataPtr += rowsPerChunk)
+    *dataPtr = 0.0;
+
+  numRows++;
+  if (numRows == rowsPerChunk)
+    return this->writeChunk();
+
+  return 0;
+}
+
+int
+ColumnarFileStream::sendSelf(int commitTag, Channel &theChannel)
+{
+  opserr << "ColumnarFileStream::sendSelf() - not available in parallel runs, use -binary\n";
+  return -1;
+}
+
+int
+ColumnarFileStream::recvSelf(int commitTag, Channel &theChannel,
+			     FEM_ObjectBroker &theBroker)
+{
+  opserr << "ColumnarFileStream::recvSelf() - not available in parallel runs, use -binary\n";
+  return -1;
+}
+
+int
+ColumnarFileStream::writeHeader(void)
+{
+  if (fileOpen == 0)
+    return -1;
+
+  // the recorder closes its outer tags only when it is destroyed, close
+  // them in the copy written so that the header is complete xml
+  int openLength = schemaLength;
+  if (attributeMode == true)
+    this->addToSchema(">\n");
+  for (int i=numTag-1; i>=0; i--) {
+    this->addToSchema("</");
+    this->addToSchema(tags[i]);
+    this->addToSchema(">\n");
+  }
+
+  this->writeInt(COLUMNAR_HEADER_BLOCK);
+  this->writeInt(0x01020304);
+  this->writeInt(COLUMNAR_FILE_VERSION);
+  this->writeInt(numColumns);
+  this->writeInt(rowsPerChunk);
+  this->writeInt(schemaLength);
+  if (schemaLength != 0)
+    theFile.write(schema, schemaLength);
+
+  schemaLength = openLength;
+
+  headerWritten = true;
+
+  if (theFile.bad()) {
+    opserr << "WARNING ColumnarFileStream::writeHeader() - failed to write to file " << fileName << endln;
+    return -1;
+  }
+
+  return 0;
+}
+
+int
+ColumnarFileStream::writeChunk(void)
+{
+  if (fileOpen == 0 || numRows == 0)
+    return 0;
+
+  int numValues = numRows*numColumns;
+  int numBytes = numValues*sizeof(double);
+
+  // columns are stored rowsPerChunk apart, close the gaps of a last
+  // chunk that is not full
+  char *rawData = (char *)theData;
+  if (numRows < rowsPerChunk)
+    for (int i=1; i<numColumns; i++)
+      memmove(theData + i*numRows, theData + i*rowsPerChunk, numRows*sizeof(double));
+
+  int compression = COLUMNAR_NO_COMPRESSION;
+  char *storedData = rawData;
+  int storedBytes = numBytes;
+
+  if (compress == true && numBytes != 0) {
+    int sizeNeeded = LZ_MaxCompressedSize(numBytes);
+    if (workSpace1 == 0 || sizeWorkSpace2 < sizeNeeded) {
+      if (workSpace1 != 0)
+	delete [] workSpace1;
+      if (workSpace2 != 0)
+	delete [] workSpace2;
+      workSpace1 = new char[sizeNeeded];
+      workSpace2 = new char[sizeNeeded];
+      sizeWorkSpace2 = sizeNeeded;
+    }
+
+    LZ_Shuffle(rawData, workSpace1, numValues, sizeof(double));
+    int size = LZ_Compress(workSpace1, numBytes, workSpace2, sizeWorkSpace2);
+
+    // data that does not compress is stored as it is
+    if (size > 0 && size < numBytes) {
+      compression = COLUMNAR_LZ_COMPRESSION;
+      storedData = workSpace2;
+      storedBytes = size;
+    }
+  }
+
+  this->writeInt(COLUMNAR_CHUNK_BLOCK);
+  this->writeInt(numRows);
+  this->writeInt(compression);
+  this->writeInt(storedBytes);
+  theFile.write(storedData, storedBytes);
+
+  numRows = 0;
+
+  if (theFile.bad()) {
+    opserr << "WARNING ColumnarFileStream::writeChunk() - failed to write to file " << fileName << endln;
+    return -1;
+  }
+
+  return 0;
+}
+
+int
+ColumnarFileStream::writeInt(int value)
+{
+  theFile.write((const char *)&value, sizeof(int));
+  return 0;
+}
+
+int
+ColumnarFileStream::addToSchema(const char *s)
+{
+  int length = strlen(s);
+  if (schemaLength + length > schemaCapacity) {
+    int nextCapacity = (schemaCapacity == 0) ? 1024 : 2*schemaCapacity;
+    while (nextCapacity < schemaLength + length)
+      nextCapacity *= 2;
+    char *nextSchema = new char[nextCapacity];
+    if (schema != 0) {
+      memcpy(nextSchema, schema, schemaLength);
+      delete [] schema;
+    }
+    schema = nextSchema;
+    schemaCapacity = nextCapacity;
+  }
+
+  memcpy(schema + schemaLength, s, length);
+  schemaLength += length;
+
+  return 0;
+}
+
+bool
+isColumnarFile(const char *fileName)
+{
+  ifstream input(fileName, ios::in | ios::binary);
+  if (input.is_open() == false)
+    return false;
+
+  char magic[8];
+  input.read(magic, 8);
+  bool result = (input.gcount() == 8 && memcmp(magic, COLUMNAR_FILE_MAGIC, 8) == 0);
+  input.close();
+
+  return result;
+}
+
+static int
+readInt(ifstream &input, int &value)
+{
+  input.read((char *)&value, sizeof(int));
+  return (input.gcount() == sizeof(int)) ? 0 : -1;
+}
+
+int
+columnarToText(const char *inputFilename, const char *outputFilename,
+	       const char *schemaFilename, int precision)
+{
+  //
+  // open the files
+  //
+
+  ifstream input(inputFilename, ios::in | ios::binary);
+  if (input.is_open() == false) {
+    opserr << "WARNING - columnarToText() - could not open file " << inputFilename << endln;
+    return -1;
+  }
+
+  char magic[8];
+  input.read(magic, 8);
+  if (input.gcount() != 8 || memcmp(magic, COLUMNAR_FILE_MAGIC, 8) != 0) {
+    opserr << "WARNING - columnarToText() - " << inputFilename;
+    opserr << " was not written by a ColumnarFileStream\n";
+    return -1;
+  }
+
+  ofstream output(outputFilename, ios::out);
+  if (output.is_open() == false) {
+    opserr << "WARNING - columnarToText() - could not open file " << outputFilename << endln;
+    return -1;
+  }
+  if (precision > 0)
+    output << setprecision(precision);
+
+  ofstream schemaOutput;
+  if (schemaFilename != 0)
+    schemaOutput.open(schemaFilename, ios::out);
+
+  //
+  // until done
+  //   read a block and write the rows of a chunk to the output file
+  //
+
+  int numColumns = 0;
+  int sizeData = 0;
+  double *theData = 0;
+  char *workSpace1 = 0;
+  char *workSpace2 = 0;
+  int sizeWorkSpace = 0;
+  int result = 0;
+
+  int blockType;
+  while (result == 0 && readInt(input, blockType) == 0) {
+
+    if (blockType == COLUMNAR_HEADER_BLOCK) {
+      int byteOrder, version, rowsPerChunk, schemaLength;
+      readInt(input, byteOrder);
+      readInt(input, version);
+      readInt(input, numColumns);
+      readInt(input, rowsPerChunk);
+      if (readInt(input, schemaLength) < 0 || byteOrder != 0x01020304 ||
+	  version > COLUMNAR_FILE_VERSION || numColumns < 0 || schemaLength < 0) {
+	opserr << "WARNING - columnarToText() - bad header in file " << inputFilename;
+	opserr << ", or written on a machine of another byte order\n";
+	result = -1;
+	break;
+      }
+
+      char *schema = new char[schemaLength+1];
+      input.read(schema, schemaLength);
+      schema[schemaLength] = '\0';
+      if (schemaOutput.is_open())
+	schemaOutput << schema;
+      delete [] schema;
+
+    } else if (blockType == COLUMNAR_CHUNK_BLOCK) {
+      int numRows, compression, storedBytes;
+      readInt(input, numRows);
+      readInt(input, compression);
+      if (readInt(input, storedBytes) < 0 || numRows < 0 || storedBytes < 0) {
+	opserr << "WARNING - columnarToText() - bad chunk in file " << inputFilename << endln;
+	result = -1;
+	break;
+      }
+
+      int numValues = numRows*numColumns;
+      int numBytes = numValues*sizeof(double);
+      if (numValues > sizeData) {
+	if (theData != 0)
+	  delete [] theData;
+	theData = new double[numValues];
+	sizeData = numValues;
+      }
+      if (storedBytes > sizeWorkSpace || numBytes > sizeWorkSpace) {
+	if (workSpace1 != 0)
+	  delete [] workSpace1;
+	if (workSpace2 != 0)
+	  delete [] workSpace2;
+	sizeWorkSpace = (storedBytes > numBytes) ? storedBytes : numBytes;
+	workSpace1 = new char[sizeWorkSpace];
+	workSpace2 = new char[sizeWorkSpace];
+      }
+
+      input.read(workSpace1, storedBytes);
+      if (input.gcount() != storedBytes) {
+	opserr << "WARNING - columnarToText() - file " << inputFilename << " is truncated\n";
+	result = -1;
+	break;
+      }
+
+      if (compression == COLUMNAR_NO_COMPRESSION && storedBytes == numBytes)
+	memcpy(theData, workSpace1, numBytes);
+      else if (compression == COLUMNAR_LZ_COMPRESSION &&
+	       LZ_Decompress(workSpace1, storedBytes, workSpace2, numBytes) == numBytes)
+	LZ_Unshuffle(workSpace2, (char *)theData, numValues, sizeof(double));
+      else {
+	opserr << "WARNING - columnarToText() - corrupt chunk in file " << inputFilename << endln;
+	result = -1;
+	break;
+      }
+
+      for (int i=0; i<numRows; i++) {
+	for (int j=0; j<numColumns; j++)
+	  output << theData[j*numRows + i] << " ";
+	output << "\n";
+      }
+
+    } else {
+      opserr << "WARNING - columnarToText() - unknown block in file " << inputFilename << endln;
+      result = -1;
+    }
+  }
+
+  if (theData != 0)
+    delete [] theData;
+  if (workSpace1 != 0)
+    delete [] workSpace1;
+  if (workSpace2 != 0)
+    delete [] workSpace2;
+
+  //
+  // close the files
+  //
+
+  input.close();
+  output.close();
+  if (schemaOutput.is_open())
+    schemaOutput.close();
+
+  return result;
+}
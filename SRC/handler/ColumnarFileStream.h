@@ -0,0 +1,120 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/handler/ColumnarFileStream.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for
+// ColumnarFileStream. A ColumnarFileStream writes the rows passed to
+// write(Vector &) as binary doubles in chunks of a fixed number of rows,
+// each chunk stored column by column and optionally compressed with the
+// LZ codec. The xml description given by the recorder through tag() and
+// attr() (node and element tags, dofs, response names) is stored once in
+// a header in front of the data, so the file describes itself.
+//
+// File layout, all ints 32 bit in the byte order of the writer:
+//   "OPSCOL1\n"
+//   header block: 1, 0x01020304, version, numColumns, rowsPerChunk,
+//                 schema length, schema (xml text)
+//   chunk block:  2, numRows, compression (0 none, 1 shuffled LZ),
+//                 number of bytes stored, data
+// A file opened in APPEND mode gets a new header block followed by its
+// own chunks.
+//
+// What: "@(#) ColumnarFileStream.h, revA"
+
+#ifndef ColumnarFileStream_h
+#define ColumnarFileStream_h
+
+#include <OPS_Stream.h>
+
+#include <fstream>
+using std::ofstream;
+
+#define COLUMNAR_FILE_MAGIC   "OPSCOL1\n"
+#define COLUMNAR_FILE_VERSION 1
+#define COLUMNAR_HEADER_BLOCK 1
+#define COLUMNAR_CHUNK_BLOCK  2
+#define COLUMNAR_NO_COMPRESSION 0
+#define COLUMNAR_LZ_COMPRESSION 1
+
+bool isColumnarFile(const char *fileName);
+int columnarToText(const char *inputFilename, const char *outputFilename,
+		   const char *schemaFilename = 0, int precision = 0);
+
+class ColumnarFileStream : public OPS_Stream
+{
+ public:
+  ColumnarFileStream(const char *fileName, int rowsPerChunk = 1024,
+		     bool compress = false, openMode mode = OVERWRITE);
+  ~ColumnarFileStream();
+
+  int setFile(const char *fileName, openMode mode = OVERWRITE);
+  int open(void);
+  int close(void);
+
+  // xml stuff, kept for the header
+  int tag(const char *);
+  int tag(const char *, const char *);
+  int endTag();
+  int attr(const char *name, int value);
+  int attr(const char *name, double value);
+  int attr(const char *name, const char *value);
+  int write(Vector &data);
+
+  // parallel stuff
+  int sendSelf(int commitTag, Channel &theChannel);
+  int recvSelf(int commitTag, Channel &theChannel,
+	       FEM_ObjectBroker &theBroker);
+
+ private:
+  int writeHeader(void);
+  int writeChunk(void);
+  int writeInt(int value);
+  int addToSchema(const char *s);
+
+  ofstream theFile;
+  int fileOpen;
+  openMode theOpenMode;
+  char *fileName;
+
+  // xml header
+  char *schema;
+  int schemaLength;
+  int schemaCapacity;
+  char **tags;
+  int numTag;
+  int sizeTags;
+  bool attributeMode;
+
+  // data of the current chunk, column c of row r at c*rowsPerChunk + r
+  bool headerWritten;
+  bool compress;
+  int numColumns;
+  int rowsPerChunk;
+  int numRows;
+  double *theData;
+  char *workSpace1;
+  char *workSpace2;
+  int sizeWorkSpace2;
+};
+
+#endif
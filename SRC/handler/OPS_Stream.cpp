@@ -38,6 +38,13 @@ OPS_Stream::~OPS_Stream()
  OPS_Stream& 
  OPS_Stream::write(const char *s, int n) {return *this;}
 
+int
+OPS_Stream::writeBytes(const char *data, int numBytes)
+{
+  this->write(data, numBytes);
+  return 0;
+}
+
 
  OPS_Stream& 
  OPS_Stream::write(const unsigned char *s, int n) {return *this;}
@@ -53,6 +53,9 @@ class OPS_Stream:  public MovableObject
   virtual int attr(const char *name, const char *value) =0;
   virtual int write(Vector &data) =0; 
 
+  // bytes written as they are; by default passed to write(const char *, int)
+  virtual int writeBytes(const char *data, int numBytes);
+
   // regular stuff
   virtual OPS_Stream& write(const char *s, int n);
   virtual OPS_Stream& write(const unsigned char *s, int n);
@@ -159,13 +159,25 @@ TCP_Stream::write(Vector &dataToSend)
 int
 TCP_Stream::write(std::string &s)
 {
-    char * cstr;
-    int size = s.size();
-    cstr = new char [size + 1];
-    strcpy (cstr, s.c_str());
-    Message *m = new Message(cstr, size);
-    theChannel->sendMsg(0, 0, *m, 0);
+    return this->writeBytes(s.c_str(), (int)s.size());
+}
+
+// raw bytes are sent as they are, without the size header used by
+// write(Vector &), so that a client can define its own framing
+
+int
+TCP_Stream::writeBytes(const char *s, int n)
+{
+  if (n <= 0 || theChannel == 0)
     return 0;
+
+  Message theMessage((char *)s, n);
+  if (theChannel->sendMsg(0, 0, theMessage, 0) < 0) {
+    opserr << "TCP_Stream - failed to send data\n";
+    return -1;
+  }
+
+  return 0;
 }
 
 OPS_Stream& 
@@ -59,6 +59,7 @@ class TCP_Stream : public OPS_Stream
     int attr(const char *name, const char *value);
     int write(Vector &data);
     int write(std::string &s);
+    int writeBytes(const char *data, int numBytes);
     
     // regular stuff
     OPS_Stream& write(const char *s, int n);
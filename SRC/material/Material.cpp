@@ -65,3 +65,9 @@ Material::getResponseSensitivity(int responseID, int gradIndex,
 {
   return -1;
 }
+
+bool
+Material::isThreadSafe(void)
+{
+  return false;
+}
@@ -59,6 +59,11 @@ class Material : public TaggedObject, public MovableObject
     // method for this material to update itself according to its new parameters
     virtual void update(void) {return;}
 
+    // true if the state methods can be invoked on this object while other
+    // threads invoke them on other materials, i.e. the class keeps no
+    // shared (static) work space in them
+    virtual bool isThreadSafe(void);
+
   protected:
     
   private:
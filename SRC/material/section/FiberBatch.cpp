@@ -0,0 +1,227 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/material/section/FiberBatch.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of FiberBatch.
+//
+// What: "@(#) FiberBatch.C, revA"
+
+#include <FiberBatch.h>
+#include <UniaxialMaterial.h>
+#include <OPS_Globals.h>
+
+#include <stdlib.h>
+
+#define FIBER_BATCH_NUM_ARRAYS 8
+
+FiberBatch::FiberBatch(int num, UniaxialMaterial **mats)
+:numFibers(num), numGroups(0), groupStart(0), order(0), theMaterials(0),
+ theData(0), theArrays(0), arraySize(0)
+{
+  if (numFibers < 0)
+    numFibers = 0;
+
+  arraySize = (numFibers + 7) & ~7;
+
+  groupStart = new int[numFibers+1];
+  order = new int[numFibers+1];
+  theMaterials = new UniaxialMaterial *[numFibers+1];
+  theData = new double[FIBER_BATCH_NUM_ARRAYS*arraySize + 8];
+
+  if (groupStart == 0 || order == 0 || theMaterials == 0 || theData == 0) {
+    opserr << "FiberBatch::FiberBatch -- out of memory for " << numFibers << " fibers\n";
+    exit(-1);
+  }
+
+  theArrays = (double *)(((size_t)theData + 63) & ~((size_t)63));
+  for (int j = 0; j < FIBER_BATCH_NUM_ARRAYS*arraySize; j++)
+    theArrays[j] = 0.0;
+
+  // group the fibers by material class, keeping their order in a group
+  int i;
+  int *classTags = new int[numFibers+1];
+  for (i = 0; i < numFibers; i++) {
+    int classTag = mats[i]->getClassTag();
+    int group = 0;
+    while (group < numGroups && classTags[group] != classTag)
+      group++;
+    if (group == numGroups)
+      classTags[numGroups++] = classTag;
+  }
+
+  int pos = 0;
+  for (int group = 0; group < numGroups; group++) {
+    groupStart[group] = pos;
+    for (i = 0; i < numFibers; i++)
+      if (mats[i]->getClassTag() == classTags[group]) {
+	order[pos] = i;
+	theMaterials[pos] = mats[i];
+	pos++;
+      }
+  }
+  groupStart[numGroups] = pos;
+
+  delete [] classTags;
+}
+
+FiberBatch::~FiberBatch()
+{
+  // the materials belong to the section
+  if (groupStart != 0)
+    delete [] groupStart;
+  if (order != 0)
+    delete [] order;
+  if (theMaterials != 0)
+    delete [] theMaterials;
+  if (theData != 0)
+    delete [] theData;
+}
+
+int
+FiberBatch::getNumFibers(void) const
+{
+  return numFibers;
+}
+
+int
+FiberBatch::getNumGroups(void) const
+{
+  return numGroups;
+}
+
+const int *
+FiberBatch::getFiberOrder(void) const
+{
+  return order;
+}
+
+double *
+FiberBatch::getY(void)
+{
+  return theArrays;
+}
+
+double *
+FiberBatch::getZ(void)
+{
+  return &theArrays[arraySize];
+}
+
+double *
+FiberBatch::getArea(void)
+{
+  return &theArrays[2*arraySize];
+}
+
+double *
+FiberBatch::getStrain(void)
+{
+  return &theArrays[3*arraySize];
+}
+
+double *
+FiberBatch::getStress(void)
+{
+  return &theArrays[4*arraySize];
+}
+
+double *
+FiberBatch::getTangent(void)
+{
+  return &theArrays[5*arraySize];
+}
+
+double *
+FiberBatch::getWork(int i)
+{
+  return &theArrays[(6 + (i != 0))*arraySize];
+}
+
+int
+FiberBatch::setTrialStrain(void)
+{
+  int res = 0;
+  double *strain = this->getStrain();
+  double *stress = this->getStress();
+  double *tangent = this->getTangent();
+
+  for (int group = 0; group < numGroups; group++) {
+    int start = groupStart[group];
+    int num = groupStart[group+1] - start;
+    res += theMaterials[start]->setTrialBatch(num, &theMaterials[start], &strain[start],
+					      &stress[start], &tangent[start]);
+  }
+
+  return res;
+}
+
+double
+FiberBatch::sum(const double *a, int n)
+{
+  double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+  int i = 0;
+  for ( ; i + 4 <= n; i += 4) {
+    s0 += a[i];
+    s1 += a[i+1];
+    s2 += a[i+2];
+    s3 += a[i+3];
+  }
+  for ( ; i < n; i++)
+    s0 += a[i];
+
+  return (s0 + s1) + (s2 + s3);
+}
+
+double
+FiberBatch::dot(const double *a, const double *b, int n)
+{
+  double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+  int i = 0;
+  for ( ; i + 4 <= n; i += 4) {
+    s0 += a[i]*b[i];
+    s1 += a[i+1]*b[i+1];
+    s2 += a[i+2]*b[i+2];
+    s3 += a[i+3]*b[i+3];
+  }
+  for ( ; i < n; i++)
+    s0 += a[i]*b[i];
+
+  return (s0 + s1) + (s2 + s3);
+}
+
+double
+FiberBatch::dot(const double *a, const double *b, const double *c, int n)
+{
+  double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+  int i = 0;
+  for ( ; i + 4 <= n; i += 4) {
+    s0 += a[i]*b[i]*c[i];
+    s1 += a[i+1]*b[i+1]*c[i+1];
+    s2 += a[i+2]*b[i+2]*c[i+2];
+    s3 += a[i+3]*b[i+3]*c[i+3];
+  }
+  for ( ; i < n; i++)
+    s0 += a[i]*b[i]*c[i];
+
+  return (s0 + s1) + (s2 + s3);
+}
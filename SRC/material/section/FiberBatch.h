@@ -0,0 +1,81 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/material/section/FiberBatch.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for FiberBatch.
+// A FiberBatch holds the fibers of a section grouped by the class of
+// their material, with the fiber data (location, area, strain, stress
+// and tangent) in aligned arrays indexed by position in the batch. The
+// section fills the locations and strains, setTrialStrain() hands each
+// group to UniaxialMaterial::setTrialBatch() of its class and the section
+// forms its stiffness and resultants with the sum() and dot() reductions,
+// which keep several partial sums so the compiler can vectorize them.
+//
+// What: "@(#) FiberBatch.h, revA"
+
+#ifndef FiberBatch_h
+#define FiberBatch_h
+
+class UniaxialMaterial;
+
+class FiberBatch
+{
+ public:
+  FiberBatch(int numFibers, UniaxialMaterial **theMaterials);
+  ~FiberBatch();
+
+  int getNumFibers(void) const;
+  int getNumGroups(void) const;
+
+  // fiber of the section at each position in the batch
+  const int *getFiberOrder(void) const;
+
+  // arrays of numFibers values, in batch order
+  double *getY(void);
+  double *getZ(void);
+  double *getArea(void);
+  double *getStrain(void);
+  double *getStress(void);
+  double *getTangent(void);
+  double *getWork(int i);   // two work arrays, i = 0 or 1
+
+  // sets the strains, filling the stresses and tangents
+  int setTrialStrain(void);
+
+  static double sum(const double *a, int n);
+  static double dot(const double *a, const double *b, int n);
+  static double dot(const double *a, const double *b, const double *c, int n);
+
+ private:
+  int numFibers;
+  int numGroups;
+  int *groupStart;                 // numGroups+1 positions
+  int *order;
+  UniaxialMaterial **theMaterials; // in batch order
+
+  double *theData;                 // as allocated
+  double *theArrays;               // theData aligned to 64 bytes
+  int arraySize;                   // numFibers rounded up to a multiple of 8
+};
+
+#endif
@@ -43,6 +43,7 @@
 #include <Information.h>
 #include <MaterialResponse.h>
 #include <UniaxialMaterial.h>
+#include <FiberBatch.h>
 #include <SectionIntegration.h>
 
 ID FiberSection2d::code(2);
@@ -51,7 +52,7 @@ ID FiberSection2d::code(2);
 FiberSection2d::FiberSection2d(int tag, int num, Fiber **fibers): 
   SectionForceDeformation(tag, SEC_TAG_FiberSection2d),
   numFibers(num), theMaterials(0), matData(0),
-  yBar(0.0), sectionIntegr(0), e(2), eCommit(2), s(0), ks(0), dedh(2)
+  yBar(0.0), sectionIntegr(0), e(2), eCommit(2), s(0), ks(0), theBatch(0), dedh(2)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -112,7 +113,7 @@ FiberSection2d::FiberSection2d(int tag, int num, UniaxialMaterial **mats,
 			       SectionIntegration &si):
   SectionForceDeformation(tag, SEC_TAG_FiberSection2d),
   numFibers(num), theMaterials(0), matData(0),
-  yBar(0.0), sectionIntegr(0), e(2), eCommit(2), s(0), ks(0), dedh(2)
+  yBar(0.0), sectionIntegr(0), e(2), eCommit(2), s(0), ks(0), theBatch(0), dedh(2)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -178,7 +179,7 @@ FiberSection2d::FiberSection2d(int tag, int num, UniaxialMaterial **mats,
 FiberSection2d::FiberSection2d():
   SectionForceDeformation(0, SEC_TAG_FiberSection2d),
   numFibers(0), theMaterials(0), matData(0),
-  yBar(0.0), sectionIntegr(0), e(2), eCommit(2), s(0), ks(0), dedh(2)
+  yBar(0.0), sectionIntegr(0), e(2), eCommit(2), s(0), ks(0), theBatch(0), dedh(2)
 {
   s = new Vector(sData, 2);
   ks = new Matrix(kData, 2, 2);
@@ -237,6 +238,12 @@ FiberSection2d::addFiber(Fiber &newFiber)
     delete [] matData;
   }
 
+  // the materials are grouped again when next needed
+  if (theBatch != 0) {
+    delete theBatch;
+    theBatch = 0;
+  }
+
   theMaterials = newArray;
   matData = newMatData;
 
@@ -271,6 +278,9 @@ FiberSection2d::~FiberSection2d()
   if (matData != 0)
     delete [] matData;
 
+  if (theBatch != 0)
+    delete theBatch;
+
   if (s != 0)
     delete s;
 
@@ -288,9 +298,6 @@ FiberSection2d::setTrialSectionDeformation (const Vector &deforms)
 
   e = deforms;
 
-  kData[0] = 0.0; kData[1] = 0.0; kData[2] = 0.0; kData[3] = 0.0;
-  sData[0] = 0.0; sData[1] = 0.0;
-
   double d0 = deforms(0);
   double d1 = deforms(1);
 
@@ -307,29 +314,47 @@ FiberSection2d::setTrialSectionDeformation (const Vector &deforms)
       fiberArea[i] = matData[2*i+1];
     }
   }
-  
-  for (int i = 0; i < numFibers; i++) {
-    UniaxialMaterial *theMat = theMaterials[i];
-    double y = fiberLocs[i] - yBar;
-    double A = fiberArea[i];
 
-    // determine material strain and set it
-    double strain = d0 - y*d1;
-    double tangent, stress;
-    res += theMat->setTrial(strain, stress, tangent);
+  // the fibers are grouped by material class, so each class sets the
+  // strains of its materials in one call
+  if (theBatch == 0)
+    theBatch = new FiberBatch(numFibers, theMaterials);
+
+  const int *order = theBatch->getFiberOrder();
+  double *y = theBatch->getY();
+  double *A = theBatch->getArea();
+  double *strain = theBatch->getStrain();
+  int k;
+
+  for (k = 0; k < numFibers; k++) {
+    int i = order[k];
+    y[k] = fiberLocs[i] - yBar;
+    A[k] = fiberArea[i];
+  }
 
-    double ks0 = tangent * A;
-    double ks1 = ks0 * -y;
-    kData[0] += ks0;
-    kData[1] += ks1;
-    kData[3] += ks1 * -y;
+  // determine material strains and set them
+  for (k = 0; k < numFibers; k++)
+    strain[k] = d0 - y[k]*d1;
 
-    double fs0 = stress * A;
-    sData[0] += fs0;
-    sData[1] += fs0 * -y;
+  res += theBatch->setTrialStrain();
+
+  const double *stress = theBatch->getStress();
+  const double *tangent = theBatch->getTangent();
+  double *ks0 = theBatch->getWork(0);
+  double *fs0 = theBatch->getWork(1);
+
+  for (k = 0; k < numFibers; k++) {
+    ks0[k] = tangent[k] * A[k];
+    fs0[k] = stress[k] * A[k];
   }
 
+  kData[0] = FiberBatch::sum(ks0, numFibers);
+  kData[1] = -FiberBatch::dot(ks0, y, numFibers);
   kData[2] = kData[1];
+  kData[3] = FiberBatch::dot(ks0, y, y, numFibers);
+
+  sData[0] = FiberBatch::sum(fs0, numFibers);
+  sData[1] = -FiberBatch::dot(fs0, y, numFibers);
 
   return res;
 }
@@ -698,6 +723,11 @@ FiberSection2d::recvSelf(int commitTag, Channel &theChannel,
       return res;
     }    
 
+    if (theBatch != 0) {
+      delete theBatch;
+      theBatch = 0;
+    }
+
     int i;
     for (i=0; i<numFibers; i++) {
       int classTag = materialData(2*i);
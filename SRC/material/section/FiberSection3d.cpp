@@ -42,6 +42,7 @@
 #include <Information.h>
 #include <MaterialResponse.h>
 #include <UniaxialMaterial.h>
+#include <FiberBatch.h>
 
 #include <string.h>
 
@@ -51,7 +52,7 @@ ID FiberSection3d::code(3);
 FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers): 
   SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
   numFibers(num), theMaterials(0), matData(0),
-  yBar(0.0), zBar(0.0), e(3), eCommit(3), s(0), ks(0)
+  yBar(0.0), zBar(0.0), e(3), eCommit(3), s(0), ks(0), theBatch(0)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -122,7 +123,7 @@ FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers):
 FiberSection3d::FiberSection3d():
   SectionForceDeformation(0, SEC_TAG_FiberSection3d),
   numFibers(0), theMaterials(0), matData(0),
-  yBar(0.0), zBar(0.0), e(3), eCommit(3), s(0), ks(0)
+  yBar(0.0), zBar(0.0), e(3), eCommit(3), s(0), ks(0), theBatch(0)
 {
   s = new Vector(sData, 3);
   ks = new Matrix(kData, 3, 3);
@@ -192,6 +193,12 @@ FiberSection3d::addFiber(Fiber &newFiber)
     delete [] matData;
   }
 
+  // the materials are grouped again when next needed
+  if (theBatch != 0) {
+    delete theBatch;
+    theBatch = 0;
+  }
+
   theMaterials = newArray;
   matData = newMatData;
 
@@ -231,6 +238,9 @@ FiberSection3d::~FiberSection3d()
   if (matData != 0)
     delete [] matData;
 
+  if (theBatch != 0)
+    delete theBatch;
+
   if (s != 0)
     delete s;
 
@@ -244,53 +254,60 @@ FiberSection3d::setTrialSectionDeformation (const Vector &deforms)
   int res = 0;
   e = deforms;
 
-  kData[0] = 0.0; kData[1] = 0.0; kData[2] = 0.0; kData[3] = 0.0;
-  kData[4] = 0.0; kData[5] = 0.0; kData[6] = 0.0; kData[7] = 0.0;
-  kData[8] = 0.0; 
-  sData[0] = 0.0; sData[1] = 0.0;  sData[2] = 0.0; 
-
-  int loc = 0;
-
   double d0 = deforms(0);
   double d1 = deforms(1);
   double d2 = deforms(2);
 
-  for (int i = 0; i < numFibers; i++) {
-    UniaxialMaterial *theMat = theMaterials[i];
-    double y = matData[loc++] - yBar;
-    double z = matData[loc++] - zBar;
-    double A = matData[loc++];
+  // the fibers are grouped by material class, so each class sets the
+  // strains of its materials in one call
+  if (theBatch == 0)
+    theBatch = new FiberBatch(numFibers, theMaterials);
+
+  const int *order = theBatch->getFiberOrder();
+  double *y = theBatch->getY();
+  double *z = theBatch->getZ();
+  double *A = theBatch->getArea();
+  double *strain = theBatch->getStrain();
+  int k;
+
+  for (k = 0; k < numFibers; k++) {
+    int loc = 3*order[k];
+    y[k] = matData[loc] - yBar;
+    z[k] = matData[loc+1] - zBar;
+    A[k] = matData[loc+2];
+  }
 
-    // determine material strain and set it
-    double strain = d0 + y*d1 + z*d2;
-    double tangent, stress;
-    res += theMat->setTrial(strain, stress, tangent);
+  // determine material strains and set them
+  for (k = 0; k < numFibers; k++)
+    strain[k] = d0 + y[k]*d1 + z[k]*d2;
 
-    double value = tangent * A;
-    double vas1 = y*value;
-    double vas2 = z*value;
-    double vas1as2 = vas1*z;
-
-    kData[0] += value;
-    kData[1] += vas1;
-    kData[2] += vas2;
-    
-    kData[4] += vas1 * y;
-    kData[5] += vas1as2;
-    
-    kData[8] += vas2 * z; 
+  res += theBatch->setTrialStrain();
 
-    double fs0 = stress * A;
+  const double *stress = theBatch->getStress();
+  const double *tangent = theBatch->getTangent();
+  double *value = theBatch->getWork(0);
+  double *fs0 = theBatch->getWork(1);
 
-    sData[0] += fs0;
-    sData[1] += fs0 * y;
-    sData[2] += fs0 * z;
+  for (k = 0; k < numFibers; k++) {
+    value[k] = tangent[k] * A[k];
+    fs0[k] = stress[k] * A[k];
   }
 
+  kData[0] = FiberBatch::sum(value, numFibers);
+  kData[1] = FiberBatch::dot(value, y, numFibers);
+  kData[2] = FiberBatch::dot(value, z, numFibers);
+  kData[4] = FiberBatch::dot(value, y, y, numFibers);
+  kData[5] = FiberBatch::dot(value, y, z, numFibers);
+  kData[8] = FiberBatch::dot(value, z, z, numFibers);
+
   kData[3] = kData[1];
   kData[6] = kData[2];
   kData[7] = kData[5];
 
+  sData[0] = FiberBatch::sum(fs0, numFibers);
+  sData[1] = FiberBatch::dot(fs0, y, numFibers);
+  sData[2] = FiberBatch::dot(fs0, z, numFibers);
+
   return res;
 }
 
@@ -666,6 +683,11 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
      return res;
     }    
     
+    if (theBatch != 0) {
+      delete theBatch;
+      theBatch = 0;
+    }
+
     int i;
     for (i=0; i<numFibers; i++) {
       int classTag = materialData(2*i);
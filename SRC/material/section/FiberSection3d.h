@@ -38,6 +38,7 @@
 #include <Matrix.h>
 
 class UniaxialMaterial;
+class FiberBatch;
 class Fiber;
 class Response;
 
@@ -106,6 +107,7 @@ class FiberSection3d : public SectionForceDeformation
     Vector eCommit;    // committed section deformations 
     Vector *s;         // section resisting forces  (axial force, bending moment)
     Matrix *ks;        // section stiffness
+    FiberBatch *theBatch; // fibers grouped by material, built when first needed
 
     // AddingSensitivity:BEGIN //////////////////////////////////////////
     int parameterID;
@@ -344,6 +344,17 @@ double Concrete01::getStress ()
    return Tstress;
 }
 
+int Concrete01::setTrialBatch (int num, UniaxialMaterial **theMaterials,
+			       const double *strain, double *stress, double *tangent)
+{
+   // all the materials are Concrete01, the qualified calls are not virtual
+   int res = 0;
+   for (int i = 0; i < num; i++)
+      res += ((Concrete01 *)theMaterials[i])->Concrete01::setTrial(strain[i], stress[i], tangent[i]);
+
+   return res;
+}
+
 double Concrete01::getStrain ()
 {
    return Tstrain;
@@ -426,6 +437,11 @@ UniaxialMaterial* Concrete01::getCopy ()
    return theCopy;
 }
 
+bool Concrete01::isThreadSafe(void)
+{
+   return true;
+}
+
 int Concrete01::sendSelf (int commitTag, Channel& theChannel)
 {
    int res = 0;
@@ -190,6 +190,22 @@ Concrete02::setTrialStrain(double trialStrain, double strainRate)
 
 
 
+int
+Concrete02::setTrialBatch(int num, UniaxialMaterial **theMaterials,
+			const double *strain, double *stress, double *tangent)
+{
+  // all the materials are Concrete02, the qualified calls are not virtual
+  int res = 0;
+  for (int i = 0; i < num; i++) {
+    Concrete02 *theMat = (Concrete02 *)theMaterials[i];
+    res += theMat->Concrete02::setTrialStrain(strain[i]);
+    stress[i] = theMat->sig;
+    tangent[i] = theMat->e;
+  }
+
+  return res;
+}
+
 double 
 Concrete02::getStrain(void)
 {
@@ -131,6 +131,22 @@ ElasticMaterial::setTrial(double strain, double &stress, double &tangent, double
     return 0;
 }
 
+int 
+ElasticMaterial::setTrialBatch(int num, UniaxialMaterial **theMaterials,
+			       const double *strain, double *stress, double *tangent)
+{
+    // all the materials are ElasticMaterial, no strain rate from a section
+    for (int i = 0; i < num; i++) {
+      ElasticMaterial *theMat = (ElasticMaterial *)theMaterials[i];
+      theMat->trialStrain = strain[i];
+      theMat->trialStrainRate = 0.0;
+      stress[i] = theMat->E*strain[i];
+      tangent[i] = theMat->E;
+    }
+
+    return 0;
+}
+
 double 
 ElasticMaterial::getStress(void)
 {
@@ -169,6 +185,12 @@ ElasticMaterial::getCopy(void)
     return theCopy;
 }
 
+bool
+ElasticMaterial::isThreadSafe(void)
+{
+  return true;
+}
+
 int 
 ElasticMaterial::sendSelf(int cTag, Channel &theChannel)
 {
@@ -52,6 +52,8 @@ class ElasticMaterial : public UniaxialMaterial
 
     int setTrialStrain(double strain, double strainRate = 0.0); 
     int setTrial(double strain, double &stress, double &tangent, double strainRate = 0.0); 
+    int setTrialBatch(int num, UniaxialMaterial **theMaterials,
+		      const double *strain, double *stress, double *tangent);
     double getStrain(void) {return trialStrain;};
     double getStrainRate(void) {return trialStrainRate;};
     double getStress(void);
@@ -64,6 +66,7 @@ class ElasticMaterial : public UniaxialMaterial
     int revertToStart(void);        
 
     UniaxialMaterial *getCopy(void);
+    bool isThreadSafe(void);
     
     int sendSelf(int commitTag, Channel &theChannel);  
     int recvSelf(int commitTag, Channel &theChannel, 
@@ -216,6 +216,12 @@ ElasticPPMaterial::getCopy(void)
   return theCopy;
 }
 
+bool
+ElasticPPMaterial::isThreadSafe(void)
+{
+  return true;
+}
+
 
 int 
 ElasticPPMaterial::sendSelf(int cTag, Channel &theChannel)
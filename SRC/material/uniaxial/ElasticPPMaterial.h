@@ -60,6 +60,7 @@ class ElasticPPMaterial : public UniaxialMaterial
     int revertToStart(void);    
 
     UniaxialMaterial *getCopy(void);
+    bool isThreadSafe(void);
     
     int sendSelf(int commitTag, Channel &theChannel);  
     int recvSelf(int commitTag, Channel &theChannel, 
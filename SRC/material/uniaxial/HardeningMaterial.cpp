@@ -218,6 +218,12 @@ HardeningMaterial::getCopy(void)
     return theCopy;
 }
 
+bool
+HardeningMaterial::isThreadSafe(void)
+{
+  return true;
+}
+
 int 
 HardeningMaterial::sendSelf(int cTag, Channel &theChannel)
 {
@@ -57,6 +57,7 @@ class HardeningMaterial : public UniaxialMaterial
     int revertToStart(void);        
 
     UniaxialMaterial *getCopy(void);
+    bool isThreadSafe(void);
     
     int sendSelf(int commitTag, Channel &theChannel);  
     int recvSelf(int commitTag, Channel &theChannel, 
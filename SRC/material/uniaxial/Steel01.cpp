@@ -266,6 +266,17 @@ void Steel01::detectLoadReversal (double dStrain)
    }
 }
 
+int Steel01::setTrialBatch (int num, UniaxialMaterial **theMaterials,
+			    const double *strain, double *stress, double *tangent)
+{
+   // all the materials are Steel01, the qualified calls are not virtual
+   int res = 0;
+   for (int i = 0; i < num; i++)
+      res += ((Steel01 *)theMaterials[i])->Steel01::setTrial(strain[i], stress[i], tangent[i]);
+
+   return res;
+}
+
 double Steel01::getStrain ()
 {
    return Tstrain;
@@ -379,6 +390,11 @@ UniaxialMaterial* Steel01::getCopy ()
    return theCopy;
 }
 
+bool Steel01::isThreadSafe(void)
+{
+   return true;
+}
+
 int Steel01::sendSelf (int commitTag, Channel& theChannel)
 {
    int res = 0;
@@ -59,6 +59,8 @@ class Steel01 : public UniaxialMaterial
 
     int setTrialStrain(double strain, double strainRate = 0.0); 
     int setTrial (double strain, double &stress, double &tangent, double strainRate = 0.0);
+    int setTrialBatch(int num, UniaxialMaterial **theMaterials,
+		      const double *strain, double *stress, double *tangent);
     double getStrain(void);              
     double getStress(void);
     double getTangent(void);
@@ -69,6 +71,7 @@ class Steel01 : public UniaxialMaterial
     int revertToStart(void);        
 
     UniaxialMaterial *getCopy(void);
+    bool isThreadSafe(void);
     
     int sendSelf(int commitTag, Channel &theChannel);  
     int recvSelf(int commitTag, Channel &theChannel, 
@@ -156,6 +156,12 @@ Steel02::getCopy(void)
   return theCopy;
 }
 
+bool
+Steel02::isThreadSafe(void)
+{
+  return true;
+}
+
 double
 Steel02::getInitialTangent(void)
 {
@@ -281,6 +287,22 @@ Steel02::setTrialStrain(double trialStrain, double strainRate)
 
 
 
+int
+Steel02::setTrialBatch(int num, UniaxialMaterial **theMaterials,
+			const double *strain, double *stress, double *tangent)
+{
+  // all the materials are Steel02, the qualified calls are not virtual
+  int res = 0;
+  for (int i = 0; i < num; i++) {
+    Steel02 *theMat = (Steel02 *)theMaterials[i];
+    res += theMat->Steel02::setTrialStrain(strain[i]);
+    stress[i] = theMat->sig;
+    tangent[i] = theMat->e;
+  }
+
+  return res;
+}
+
 double 
 Steel02::getStrain(void)
 {
@@ -66,8 +66,11 @@ class Steel02 : public UniaxialMaterial
 
     double getInitialTangent(void);
     UniaxialMaterial *getCopy(void);
+    bool isThreadSafe(void);
 
     int setTrialStrain(double strain, double strainRate = 0.0); 
+    int setTrialBatch(int num, UniaxialMaterial **theMaterials,
+		      const double *strain, double *stress, double *tangent);
     double getStrain(void);      
     double getStress(void);
     double getTangent(void);
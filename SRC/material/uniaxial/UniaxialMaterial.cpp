@@ -91,6 +91,17 @@ UniaxialMaterial::setTrial(double strain, double &stress, double &tangent, doubl
   return res;
 }
 
+int
+UniaxialMaterial::setTrialBatch(int num, UniaxialMaterial **theMaterials,
+				const double *strain, double *stress, double *tangent)
+{
+  int res = 0;
+  for (int i = 0; i < num; i++)
+    res += theMaterials[i]->setTrial(strain[i], stress[i], tangent[i]);
+
+  return res;
+}
+
 // default operation for strain rate is zero
 double
 UniaxialMaterial::getStrainRate(void)
@@ -57,6 +57,12 @@ class UniaxialMaterial : public Material
 
     virtual int setTrialStrain (double strain, double strainRate = 0.0) = 0;
     virtual int setTrial (double strain, double &stress, double &tangent, double strainRate = 0.0);
+
+    // sets the trial strain of num materials of the same class as this 
+    // one, theMaterials[i] gets strain[i]; used by the fiber sections so 
+    // a class can loop over its materials without a virtual call for each
+    virtual int setTrialBatch(int num, UniaxialMaterial **theMaterials,
+			      const double *strain, double *stress, double *tangent);
     virtual double getStrain (void) = 0;
     virtual double getStrainRate (void);
     virtual double getStress (void) = 0;
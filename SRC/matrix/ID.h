@@ -84,6 +84,8 @@ class ID
     friend class MPI_Channel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
+    friend class MemoryDatastore;
+    friend class CheckpointDatastore;
     
   private:
     static int ID_NOT_VALID_ENTRY;
@@ -34,25 +34,21 @@
 #include "Matrix.h"
 #include "Vector.h"
 #include "ID.h"
+#include "WorkArea.h"
 
 #include <stdlib.h>
 
-#define MATRIX_WORK_AREA 400
-#define INT_WORK_AREA 20
-
 #ifdef _WIN32
 #ifdef _USRDLL
 #define _DLL
 #endif
 #endif
 
-int Matrix::sizeDoubleWork = MATRIX_WORK_AREA;
-int Matrix::sizeIntWork = INT_WORK_AREA;
 double Matrix::MATRIX_NOT_VALID_ENTRY =0.0;
-double *Matrix::matrixWork = 0;
-int    *Matrix::intWork =0;
 
-//double *Matrix::matrixWork = (double *)malloc(400*sizeof(double));
+// scratch space of Solve(), Invert() and addMatrixTripleProduct(), one
+// copy for each thread
+static WorkArea theWorkArea("Matrix");
 
 //
 // CONSTRUCTORS
@@ -61,32 +57,12 @@ int    *Matrix::intWork =0;
 Matrix::Matrix()
 :numRows(0), numCols(0), dataSize(0), data(0), fromFree(0)
 {
-  // allocate work areas if the first
-  if (matrixWork == 0) {
-    matrixWork = new double[sizeDoubleWork];
-    intWork = new int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
 }
 
 
 Matrix::Matrix(int nRows,int nCols)
 :numRows(nRows), numCols(nCols), dataSize(0), data(0), fromFree(0)
 {
-
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new double[sizeDoubleWork];
-    intWork = new int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
-
 #ifdef _G3DEBUG
     if (nRows < 0) {
       opserr << "WARNING: Matrix::Matrix(int,int): tried to init matrix ";
@@ -121,15 +97,6 @@ Matrix::Matrix(int nRows,int nCols)
 Matrix::Matrix(double *theData, int row, int col) 
 :numRows(row),numCols(col),dataSize(row*col),data(theData),fromFree(1)
 {
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new double[sizeDoubleWork];
-    intWork = new int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
 
 #ifdef _G3DEBUG
     if (row < 0) {
@@ -150,15 +117,6 @@ Matrix::Matrix(double *theData, int row, int col)
 Matrix::Matrix(const Matrix &other)
 :numRows(0), numCols(0), dataSize(0), data(0), fromFree(0)
 {
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new double[sizeDoubleWork];
-    intWork = new int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
 
     numRows = other.numRows;
     numCols = other.numCols;
@@ -369,37 +327,9 @@ Matrix::Solve(const Vector &b, Vector &x) const
     }
 #endif
     
-    // check work area can hold all the data
-    if (dataSize > sizeDoubleWork) {
-
-      if (matrixWork != 0) {
-	delete [] matrixWork;
-      }
-      matrixWork = new double[dataSize];
-      sizeDoubleWork = dataSize;
-      
-      if (matrixWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeDoubleWork = 0;      
-	return -3;
-      }
-    }
-
-    // check work area can hold all the data
-    if (n > sizeIntWork) {
-
-      if (intWork != 0) {
-	delete [] intWork;
-      }
-      intWork = new int[n];
-      sizeIntWork = n;
-      
-      if (intWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeIntWork = 0;      
-	return -3;
-      }
-    }
+    // get the work areas of this thread, large enough to hold all the data
+    double *matrixWork = theWorkArea.getDoubles(dataSize);
+    int *intWork = theWorkArea.getInts(n);
 
     
     // copy the data
@@ -466,37 +396,9 @@ Matrix::Solve(const Matrix &b, Matrix &x) const
     }
 #endif
 
-    // check work area can hold all the data
-    if (dataSize > sizeDoubleWork) {
-
-      if (matrixWork != 0) {
-	delete [] matrixWork;
-      }
-      matrixWork = new double[dataSize];
-      sizeDoubleWork = dataSize;
-      
-      if (matrixWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeDoubleWork = 0;      
-	return -3;
-      }
-    }
-
-    // check work area can hold all the data
-    if (n > sizeIntWork) {
-
-      if (intWork != 0) {
-	delete [] intWork;
-      }
-      intWork = new int[n];
-      sizeIntWork = n;
-      
-      if (intWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeIntWork = 0;      
-	return -3;
-      }
-    }
+    // get the work areas of this thread, large enough to hold all the data
+    double *matrixWork = theWorkArea.getDoubles(dataSize);
+    int *intWork = theWorkArea.getInts(n);
     
     x = b;
 
@@ -566,37 +468,9 @@ Matrix::Invert(Matrix &theInverse) const
     }
 #endif
 
-    // check work area can hold all the data
-    if (dataSize > sizeDoubleWork) {
-
-      if (matrixWork != 0) {
-	delete [] matrixWork;
-      }
-      matrixWork = new double[dataSize];
-      sizeDoubleWork = dataSize;
-      
-      if (matrixWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeDoubleWork = 0;      
-	return -3;
-      }
-    }
-
-    // check work area can hold all the data
-    if (n > sizeIntWork) {
-
-      if (intWork != 0) {
-	delete [] intWork;
-      }
-      intWork = new int[n];
-      sizeIntWork = n;
-      
-      if (intWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeIntWork = 0;      
-	return -3;
-      }
-    }
+    // get the work areas of this thread, large enough to hold all the data
+    double *matrixWork = theWorkArea.getDoubles(dataSize);
+    int *intWork = theWorkArea.getInts(n);
     
     // copy the data
     theInverse = *this;
@@ -608,7 +482,7 @@ Matrix::Invert(Matrix &theInverse) const
     int info;
     double *Wptr = matrixWork;
     double *Aptr = theInverse.data;
-    int workSize = sizeDoubleWork;
+    int workSize = dataSize;
     
     int *iPIV = intWork;
     
@@ -950,10 +824,7 @@ Matrix::addMatrixTripleProduct(double thisFact,
     int dimB = B.numCols;
     int sizeWork = dimB * numCols;
 
-    if (sizeWork > sizeDoubleWork) {
-      this->addMatrix(thisFact, T^B*T, otherFact);
-      return 0;
-    }
+    double *matrixWork = theWorkArea.getDoubles(sizeWork);
 
     // zero out the work area
     double *matrixWorkPtr = matrixWork;
@@ -1048,10 +919,7 @@ Matrix::addMatrixTripleProduct(double thisFact,
     // cheack work area can hold the temporary matrix
     int sizeWork = B.numRows * numCols;
 
-    if (sizeWork > sizeDoubleWork) {
-      this->addMatrix(thisFact, A^B*C, otherFact);
-      return 0;
-    }
+    double *matrixWork = theWorkArea.getDoubles(sizeWork);
 
     // zero out the work area
     double *matrixWorkPtr = matrixWork;
@@ -141,15 +141,13 @@ class Matrix
     friend class MPI_Channel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
+    friend class MemoryDatastore;
+    friend class CheckpointDatastore;
 
   protected:
 
   private:
     static double MATRIX_NOT_VALID_ENTRY;
-    static double *matrixWork;
-    static int *intWork;
-    static int sizeDoubleWork;
-    static int sizeIntWork;
 
     int numRows;
     int numCols;
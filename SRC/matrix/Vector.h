@@ -114,6 +114,8 @@ class Vector
     friend class MPI_Channel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
+    friend class MemoryDatastore;
+    friend class CheckpointDatastore;
     
   private:
     static double VECTOR_NOT_VALID_ENTRY;
@@ -0,0 +1,228 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/matrix/WorkArea.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of WorkArea.
+//
+// What: "@(#) WorkArea.C, revA"
+
+#include <WorkArea.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <OPS_Globals.h>
+
+#define WORK_DOUBLES  0
+#define WORK_INTS     1
+#define WORK_VECTOR   2
+#define WORK_MATRIX   3
+#define WORK_VECTORS  4
+#define WORK_MATRICES 5
+
+struct WorkAreaEntry {
+  int type;
+  int id;
+  int n1, n2;      // size of the array or object
+  void *ptr;
+  WorkAreaEntry *next;
+};
+
+bool WorkArea::audit = false;
+int WorkArea::numAuditErrors = 0;
+
+#ifdef _THREADS
+static pthread_mutex_t auditMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+WorkArea::WorkArea(const char *theName)
+  :name(theName)
+{
+  for (int i=0; i<OPS_MAX_THREADS; i++) {
+    theEntries[i] = 0;
+#ifdef _THREADS
+    theOwnerPools[i] = -1;
+#endif
+  }
+}
+
+WorkArea::~WorkArea()
+{
+  for (int i=0; i<OPS_MAX_THREADS; i++) {
+    WorkAreaEntry *theEntry = theEntries[i];
+    while (theEntry != 0) {
+      WorkAreaEntry *nextEntry = theEntry->next;
+      switch (theEntry->type) {
+      case WORK_DOUBLES:
+	delete [] (double *)theEntry->ptr;
+	break;
+      case WORK_INTS:
+	delete [] (int *)theEntry->ptr;
+	break;
+      case WORK_VECTOR:
+	delete (Vector *)theEntry->ptr;
+	break;
+      case WORK_MATRIX:
+	delete (Matrix *)theEntry->ptr;
+	break;
+      case WORK_VECTORS:
+	delete [] (Vector *)theEntry->ptr;
+	break;
+      case WORK_MATRICES:
+	delete [] (Matrix *)theEntry->ptr;
+	break;
+      }
+      delete theEntry;
+      theEntry = nextEntry;
+    }
+    theEntries[i] = 0;
+  }
+}
+
+double *
+WorkArea::getDoubles(int size, int id)
+{
+  WorkAreaEntry *theEntry = this->getEntry(WORK_DOUBLES, size, 1, id, false);
+  if (theEntry->n1 < size) {
+    if (theEntry->ptr != 0)
+      delete [] (double *)theEntry->ptr;
+    theEntry->ptr = new double[size];
+    theEntry->n1 = size;
+  }
+  return (double *)theEntry->ptr;
+}
+
+int *
+WorkArea::getInts(int size, int id)
+{
+  WorkAreaEntry *theEntry = this->getEntry(WORK_INTS, size, 1, id, false);
+  if (theEntry->n1 < size) {
+    if (theEntry->ptr != 0)
+      delete [] (int *)theEntry->ptr;
+    theEntry->ptr = new int[size];
+    theEntry->n1 = size;
+  }
+  return (int *)theEntry->ptr;
+}
+
+Vector &
+WorkArea::getVector(int size, int id)
+{
+  WorkAreaEntry *theEntry = this->getEntry(WORK_VECTOR, size, 1, id, true);
+  if (theEntry->ptr == 0)
+    theEntry->ptr = new Vector(size);
+  return *((Vector *)theEntry->ptr);
+}
+
+Matrix &
+WorkArea::getMatrix(int numRows, int numCols, int id)
+{
+  WorkAreaEntry *theEntry = this->getEntry(WORK_MATRIX, numRows, numCols, id, true);
+  if (theEntry->ptr == 0)
+    theEntry->ptr = new Matrix(numRows, numCols);
+  return *((Matrix *)theEntry->ptr);
+}
+
+Vector *
+WorkArea::getVectors(int num, int id)
+{
+  WorkAreaEntry *theEntry = this->getEntry(WORK_VECTORS, num, 1, id, false);
+  if (theEntry->n1 < num) {
+    if (theEntry->ptr != 0)
+      delete [] (Vector *)theEntry->ptr;
+    theEntry->ptr = new Vector[num];
+    theEntry->n1 = num;
+  }
+  return (Vector *)theEntry->ptr;
+}
+
+Matrix *
+WorkArea::getMatrices(int num, int id)
+{
+  WorkAreaEntry *theEntry = this->getEntry(WORK_MATRICES, num, 1, id, false);
+  if (theEntry->n1 < num) {
+    if (theEntry->ptr != 0)
+      delete [] (Matrix *)theEntry->ptr;
+    theEntry->ptr = new Matrix[num];
+    theEntry->n1 = num;
+  }
+  return (Matrix *)theEntry->ptr;
+}
+
+void
+WorkArea::setAudit(bool onOff)
+{
+  audit = onOff;
+}
+
+int
+WorkArea::getNumAuditErrors(void)
+{
+  return numAuditErrors;
+}
+
+// WorkAreaEntry *getEntry(int type, int n1, int n2, int id, bool exact);
+//	Returns the entry of the calling thread with the given type and id,
+//	creating an empty one if none exists. For objects (exact == true) the
+//	size must match as well; arrays are resized by the caller.
+
+WorkAreaEntry *
+WorkArea::getEntry(int type, int n1, int n2, int id, bool exact)
+{
+  int threadID = ThreadPool::getThreadID();
+
+#ifdef _THREADS
+  if (audit == true) {
+    pthread_t self = pthread_self();
+    int poolID = ThreadPool::getPoolID();
+    if (theOwnerPools[threadID] != poolID) {
+      theOwners[threadID] = self;
+      theOwnerPools[threadID] = poolID;
+    } else if (pthread_equal(theOwners[threadID], self) == 0) {
+      pthread_mutex_lock(&auditMutex);
+      numAuditErrors++;
+      opserr << "WARNING WorkArea::getEntry() - work area " << name;
+      opserr << " of thread " << threadID << " used by a second thread\n";
+      theOwners[threadID] = self;
+      pthread_mutex_unlock(&auditMutex);
+    }
+  }
+#endif
+
+  WorkAreaEntry *theEntry = theEntries[threadID];
+  while (theEntry != 0) {
+    if (theEntry->type == type && theEntry->id == id)
+      if (exact == false || (theEntry->n1 == n1 && theEntry->n2 == n2))
+	return theEntry;
+    theEntry = theEntry->next;
+  }
+
+  theEntry = new WorkAreaEntry;
+  theEntry->type = type;
+  theEntry->id = id;
+  theEntry->n1 = (exact == true) ? n1 : 0;
+  theEntry->n2 = n2;
+  theEntry->ptr = 0;
+  theEntry->next = theEntries[threadID];
+  theEntries[threadID] = theEntry;
+
+  return theEntry;
+}
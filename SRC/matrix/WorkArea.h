@@ -0,0 +1,82 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/matrix/WorkArea.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for WorkArea.
+// A WorkArea replaces the class wide (static) arrays, Matrix and Vector
+// objects that classes use as scratch space and to return results. Each
+// thread of a ThreadPool is given its own copy of every array or object,
+// so that the methods using them can run on several threads at once.
+// Arrays are grown on demand and identified by an id; Matrix and Vector
+// objects are identified by their size and an id, so that a class can
+// keep one object for each size, as the old class wide objects did.
+//
+// In audit mode each request checks that a thread slot is only used by
+// one thread of a pool, which catches threads created outside a
+// ThreadPool (all of which share slot 0) reusing the space of the main
+// thread. The workers of different pools may use the same slot in turn.
+//
+// What: "@(#) WorkArea.h, revA"
+
+#ifndef WorkArea_h
+#define WorkArea_h
+
+#include <ThreadPool.h>
+
+class Matrix;
+class Vector;
+struct WorkAreaEntry;
+
+class WorkArea
+{
+  public:
+    WorkArea(const char *name);
+    ~WorkArea();
+
+    double *getDoubles(int size, int id = 0);
+    int *getInts(int size, int id = 0);
+    Vector &getVector(int size, int id = 0);
+    Matrix &getMatrix(int numRows, int numCols, int id = 0);
+    Vector *getVectors(int num, int id = 0);
+    Matrix *getMatrices(int num, int id = 0);
+
+    static void setAudit(bool onOff);
+    static int getNumAuditErrors(void);
+
+  protected:
+
+  private:
+    WorkAreaEntry *getEntry(int type, int n1, int n2, int id, bool exact);
+
+    const char *name;
+    WorkAreaEntry *theEntries[OPS_MAX_THREADS];
+#ifdef _THREADS
+    pthread_t theOwners[OPS_MAX_THREADS];
+    int theOwnerPools[OPS_MAX_THREADS];   // -1 if the slot is not used
+#endif
+
+    static bool audit;
+    static int numAuditErrors;
+};
+
+#endif
@@ -38,6 +38,7 @@
 #include <ID.h>
 #include <string.h>
 #include <Response.h>
+#include <ResponseBatch.h>
 #include <FE_Datastore.h>
 #include <OPS_Globals.h>
 #include <Message.h>
@@ -46,7 +47,7 @@
 
 ElementRecorder::ElementRecorder()
 :Recorder(RECORDER_TAGS_ElementRecorder),
- numEle(0), eleID(0), theResponses(0), 
+ numEle(0), eleID(0), theResponses(0), theBatch(0),
  theDomain(0), theOutputHandler(0),
  echoTimeFlag(true), deltaT(0), nextTimeStampToRecord(0.0), data(0), 
  initializationDone(false), responseArgs(0), numArgs(0), addColumnInfo(0)
@@ -62,7 +63,7 @@ ElementRecorder::ElementRecorder(const ID *ele,
 				 OPS_Stream &theOutputHandler,
 				 double dT)
 :Recorder(RECORDER_TAGS_ElementRecorder),
- numEle(0), eleID(0), theResponses(0), 
+ numEle(0), eleID(0), theResponses(0), theBatch(0),
  theDomain(&theDom), theOutputHandler(&theOutputHandler),
  echoTimeFlag(echoTime), deltaT(dT), nextTimeStampToRecord(0.0), data(0),
  initializationDone(false), responseArgs(0), numArgs(0), addColumnInfo(0)
@@ -113,6 +114,9 @@ ElementRecorder::~ElementRecorder()
   if (eleID != 0)
     delete eleID;
 
+  if (theBatch != 0)
+    delete theBatch;
+
   if (theResponses != 0) {
     for (int i = 0; i < numEle; i++)
       delete theResponses[i];
@@ -153,27 +157,14 @@ ElementRecorder::record(int commitTag, double timeStamp)
     if (deltaT != 0.0) 
       nextTimeStampToRecord = timeStamp + deltaT;
 
-    int loc = 0;
     if (echoTimeFlag == true) 
-      (*data)(loc++) = timeStamp;
+      (*data)(0) = timeStamp;
     
     //
-    // for each element if responses exist, put them in response vector
+    // the responses write themselves into their columns of the response vector
     //
-    for (int i=0; i< numEle; i++) {
-      if (theResponses[i] != 0) {
-	// ask the element for the reponse
-	int res;
-	if (( res = theResponses[i]->getResponse()) < 0)
-	  result += res;
-	else {
-	  Information &eleInfo = theResponses[i]->getInformation();
-	  const Vector &eleData = eleInfo.getData();
-	  for (int j=0; j<eleData.Size(); j++)
-	    (*data)(loc++) = eleData(j);
-	}
-      } 
-    }
+
+    result = theBatch->getResponse();
 
     //
     // send the response vector to the output handler for o/p
@@ -459,12 +450,21 @@ ElementRecorder::initialize(void)
   if (theDomain == 0)
     return 0;
 
+  if (theBatch != 0)
+    delete theBatch;
+
   if (theResponses != 0) {
     for (int i = 0; i < numEle; i++)
       delete theResponses[i];
     delete [] theResponses;
   }
 
+  theBatch = new ResponseBatch();
+  if (theBatch == 0) {
+    opserr << "ElementRecorder::initialize() - out of memory\n";
+    return -1;
+  }
+
   int numDbColumns = 0;
 
   // Set the response objects:
@@ -536,6 +536,7 @@ ElementRecorder::initialize(void)
       } else {
 	theResponses[i] = theEle->setResponse((const char **)responseArgs, numArgs, *theOutputHandler);
 	if (theResponses[i] != 0) {
+	  theBatch->addResponse(theResponses[i], theEle);
 	  // from the response type determine no of cols for each
 	  Information &eleInfo = theResponses[i]->getInformation();
 	  const Vector &eleData = eleInfo.getData();
@@ -586,18 +587,21 @@ ElementRecorder::initialize(void)
       Response *theResponse = theEle->setResponse((const char **)responseArgs, numArgs, *theOutputHandler);
       if (theResponse != 0) {
 	if (numResponse == numEle) {
-	  // Why is this created locally and not used? -- MHS
 	  Response **theNextResponses = new Response *[numEle*2];
-	  if (theNextResponses != 0) {
-	    for (int i=0; i<numEle; i++)
-	      theNextResponses[i] = theResponses[i];
-	    for (int j=numEle; j<2*numEle; j++)
-	      theNextResponses[j] = 0;
+	  if (theNextResponses == 0) {
+	    opserr << "ElementRecorder::initialize() - out of memory\n";
+	    return -1;
 	  }
+	  for (int i=0; i<numEle; i++)
+	    theNextResponses[i] = theResponses[i];
+	  for (int j=numEle; j<2*numEle; j++)
+	    theNextResponses[j] = 0;
+	  delete [] theResponses;
+	  theResponses = theNextResponses;
 	  numEle = 2*numEle;
-	  delete [] theNextResponses;
 	}
 	theResponses[numResponse] = theResponse;
+	theBatch->addResponse(theResponse, theEle);
 
 	// from the response type determine no of cols for each
 	Information &eleInfo = theResponses[numResponse]->getInformation();
@@ -612,12 +616,20 @@ ElementRecorder::initialize(void)
   }
 
   // create the vector to hold the data
+  if (data != 0)
+    delete data;
   data = new Vector(numDbColumns);
 
   if (data == 0) {
     opserr << "ElementRecorder::initialize() - out of memory\n";
     return -1;
   }
+
+  // each response is given its columns of data, after the time
+  if (theBatch->setOutput(*data, (echoTimeFlag == true) ? 1 : 0) < 0) {
+    opserr << "ElementRecorder::initialize() - failed to set the response columns\n";
+    return -1;
+  }
   
   theOutputHandler->tag("Data");
   initializationDone = true;
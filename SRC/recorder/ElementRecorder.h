@@ -47,6 +47,7 @@ class Matrix;
 class Element;
 class Response;
 class FE_Datastore;
+class ResponseBatch;
 
 class ElementRecorder: public Recorder
 {
@@ -80,6 +81,7 @@ class ElementRecorder: public Recorder
     ID *eleID;
 
     Response **theResponses;
+    ResponseBatch *theBatch;   // writes the responses into data
 
     Domain *theDomain;
     OPS_Stream *theOutputHandler;
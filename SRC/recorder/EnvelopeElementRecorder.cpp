@@ -38,6 +38,7 @@
 #include <ID.h>
 #include <string.h>
 #include <Response.h>
+#include <ResponseBatch.h>
 #include <FE_Datastore.h>
 #include <Information.h>
 
@@ -48,7 +49,7 @@
 
 EnvelopeElementRecorder::EnvelopeElementRecorder()
 :Recorder(RECORDER_TAGS_EnvelopeElementRecorder),
- numEle(0), eleID(0), theResponses(0), theDomain(0),
+ numEle(0), eleID(0), theResponses(0), theBatch(0), theDomain(0),
  theHandler(0), deltaT(0), nextTimeStampToRecord(0.0), 
  data(0), currentData(0), first(true),
  initializationDone(false), responseArgs(0), numArgs(0), echoTimeFlag(false), addColumnInfo(0)
@@ -64,7 +65,7 @@ EnvelopeElementRecorder::EnvelopeElementRecorder(const ID *ele,
 						 OPS_Stream &theOutputHandler,
 						 double dT, bool echoTime)
 :Recorder(RECORDER_TAGS_EnvelopeElementRecorder),
- numEle(0), eleID(0), theResponses(0), theDomain(&theDom),
+ numEle(0), eleID(0), theResponses(0), theBatch(0), theDomain(&theDom),
  theHandler(&theOutputHandler), deltaT(dT), nextTimeStampToRecord(0.0), 
  data(0), currentData(0), first(true),
  initializationDone(false), responseArgs(0), numArgs(0), echoTimeFlag(echoTime), addColumnInfo(0)
@@ -136,6 +137,9 @@ EnvelopeElementRecorder::~EnvelopeElementRecorder()
   // clean up the memory
   //
 
+  if (theBatch != 0)
+    delete theBatch;
+
   if (theResponses != 0) {
     for (int i = 0; i < numEle; i++) 
       if (theResponses[i] != 0)
@@ -176,23 +180,8 @@ EnvelopeElementRecorder::record(int commitTag, double timeStamp)
     if (deltaT != 0.0) 
       nextTimeStampToRecord = timeStamp + deltaT;
     
-    int loc = 0;
-    // for each element do a getResponse() & put the result in current data
-    for (int i=0; i< numEle; i++) {
-      if (theResponses[i] != 0) {
-	// ask the element for the reponse
-	int res;
-	if (( res = theResponses[i]->getResponse()) < 0)
-	  result += res;
-	else {
-	  // from the response determine no of cols for each
-	  Information &eleInfo = theResponses[i]->getInformation();
-	  const Vector &eleData = eleInfo.getData();
-	  for (int j=0; j<eleData.Size(); j++) 
-	    (*currentData)(loc++) = eleData(j);
-	}
-      }
-    }
+    // for each element do a getResponse(), the result lands in current data
+    result = theBatch->getResponse();
 
 
     int sizeData = currentData->Size();
@@ -544,12 +533,21 @@ EnvelopeElementRecorder::initialize(void)
   if (theDomain == 0)
     return 0;
 
+  if (theBatch != 0)
+    delete theBatch;
+
   if (theResponses != 0) {
     for (int i = 0; i < numEle; i++)
       delete theResponses[i];
     delete [] theResponses;
   }
 
+  theBatch = new ResponseBatch();
+  if (theBatch == 0) {
+    opserr << "EnvelopeElementRecorder::initialize() - out of memory\n";
+    return -1;
+  }
+
   int numDbColumns = 0;
 
   //
@@ -600,6 +598,7 @@ EnvelopeElementRecorder::initialize(void)
 	
 	theResponses[ii] = theEle->setResponse((const char **)responseArgs, numArgs, *theHandler);
 	if (theResponses[ii] != 0) {
+	  theBatch->addResponse(theResponses[ii], theEle);
 	  // from the response type determine no of cols for each      
 	  Information &eleInfo = theResponses[ii]->getInformation();
 	  const Vector &eleData = eleInfo.getData();
@@ -659,15 +658,20 @@ EnvelopeElementRecorder::initialize(void)
       if (theResponse != 0) {
 	if (numResponse == numEle) {
 	  Response **theNextResponses = new Response *[numEle*2];
-	  if (theNextResponses != 0) {
-	    for (int i=0; i<numEle; i++)
-	      theNextResponses[i] = theResponses[i];
-	    for (int j=numEle; j<2*numEle; j++)
-	      theNextResponses[j] = 0;
+	  if (theNextResponses == 0) {
+	    opserr << "EnvelopeElementRecorder::initialize() - out of memory\n";
+	    return -1;
 	  }
+	  for (int i=0; i<numEle; i++)
+	    theNextResponses[i] = theResponses[i];
+	  for (int j=numEle; j<2*numEle; j++)
+	    theNextResponses[j] = 0;
+	  delete [] theResponses;
+	  theResponses = theNextResponses;
 	  numEle = 2*numEle;
 	}
 	theResponses[numResponse] = theResponse;
+	theBatch->addResponse(theResponse, theEle);
 
 	// from the response type determine no of cols for each
 	Information &eleInfo = theResponses[numResponse]->getInformation();
@@ -695,6 +699,11 @@ EnvelopeElementRecorder::initialize(void)
     numDbColumns *= 2;
   }
 
+  if (data != 0)
+    delete data;
+  if (currentData != 0)
+    delete currentData;
+
   data = new Matrix(3, numDbColumns);
   currentData = new Vector(numDbColumns);
   if (data == 0 || currentData == 0) {
@@ -702,6 +711,12 @@ EnvelopeElementRecorder::initialize(void)
     exit(-1);
   }
 
+  // the responses fill the front of currentData, one slice each
+  if (theBatch->setOutput(*currentData) < 0) {
+    opserr << "EnvelopeElementRecorder::initialize() - failed to set the response slices\n";
+    return -1;
+  }
+
   initializationDone = true;  
   return 0;
 }
@@ -41,6 +41,7 @@ class Matrix;
 class Element;
 class Response;
 class FE_Datastore;
+class ResponseBatch;
 
 class EnvelopeElementRecorder: public Recorder
 {
@@ -73,6 +74,7 @@ class EnvelopeElementRecorder: public Recorder
     int numEle;
     ID *eleID;
     Response **theResponses;
+    ResponseBatch *theBatch;   // writes the responses into currentData
 
     Domain *theDomain;
     OPS_Stream *theHandler;
@@ -68,6 +68,8 @@
 #include <DataFileStream.h>
 #include <XmlFileStream.h>
 #include <BinaryFileStream.h>
+#include <ColumnarFileStream.h>
+#include <AsyncStream.h>
 #include <DatabaseStream.h>
 #include <DummyStream.h>
 #include <TCP_Stream.h>
@@ -97,7 +99,7 @@ typedef struct externalRecorderCommand {
 
 static ExternalRecorderCommand *theExternalRecorderCommands = NULL;
 
-enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM};
+enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, COLUMNAR_STREAM};
 
 
 #include <EquiSolnAlgo.h>
@@ -118,18 +120,29 @@ extern SimulationInformation simulationInfo;
 
 
 static EquiSolnAlgo *theAlgorithm =0;
+
+// puts an AsyncStream in front of a file or socket stream when the
+// recorder was given -async; asyncBufferSize is 0 if it was not. Output
+// to the console stays synchronous.
+static OPS_Stream *
+createAsyncStream(OPS_Stream *theStream, int asyncBufferSize, int asyncPolicy)
+{
+    if (asyncBufferSize == 0 || theStream == 0)
+        return theStream;
+
+    if (theStream->getClassTag() == OPS_STREAM_TAGS_StandardStream)
+        return theStream;
+
+    return new AsyncStream(theStream, asyncBufferSize, asyncPolicy);
+}
 extern FE_Datastore *theDatabase;
 extern FEM_ObjectBroker theBroker;
 
-int
-TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
-                  TCL_Char **argv, Domain &theDomain, Recorder **theRecorder)
+static int
+createRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
+               TCL_Char **argv, Domain &theDomain, Recorder **theRecorder,
+               int asyncBufferSize, int asyncPolicy)
 {
-    // make sure at least one other argument to contain integrator
-    if (argc < 2) {
-        opserr << "WARNING need to specify a Recorder type\n";
-        return TCL_ERROR;
-    }
 
     //
     // check argv[1] for type of Recorder, parse in rest of arguments
@@ -140,6 +153,8 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
 
     TCL_Char *fileName = 0;
     TCL_Char *tableName = 0;
+    int columnarChunkSize = 1024;
+    bool columnarCompress = false;
 
     // an Element Recorder or ElementEnvelope Recorder
     if ((strcmp(argv[1],"Element") == 0) || (strcmp(argv[1],"EnvelopeElement") == 0)
@@ -352,6 +367,26 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 loc += 2;
             }	    
 
+            else if ((strcmp(argv[loc],"-binaryColumnar") == 0)) {
+                // binary file with a header, chunk size and compression optional
+                fileName = argv[loc+1];
+                const char *pwd = getInterpPWD(interp);
+                simulationInfo.addOutputFile(fileName, pwd);
+                eMode = COLUMNAR_STREAM;
+                loc += 2;
+                while (loc < argc) {
+                    if (strcmp(argv[loc],"-compress") == 0) {
+                        columnarCompress = true;
+                        loc++;
+                    } else if (strcmp(argv[loc],"-chunk") == 0 && loc+1 < argc) {
+                        if (Tcl_GetInt(interp, argv[loc+1], &columnarChunkSize) != TCL_OK)
+                            return TCL_ERROR;
+                        loc += 2;
+                    } else
+                        break;
+                }
+            }
+
             else {
                 // first unknown string then is assumed to start 
                 // element response request starts
@@ -383,6 +418,8 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new DatabaseStream(theDatabase, tableName);
         } else if (eMode == BINARY_STREAM && fileName != 0) {
             theOutputStream = new BinaryFileStream(fileName);
+        } else if (eMode == COLUMNAR_STREAM && fileName != 0) {
+            theOutputStream = new ColumnarFileStream(fileName, columnarChunkSize, columnarCompress);
         } else if (eMode == TCP_STREAM && inetAddr != 0) {
             theOutputStream = new TCP_Stream(inetPort, inetAddr);
         } else 
@@ -390,6 +427,7 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
 
 
         theOutputStream->setPrecision(precision);
+        theOutputStream = createAsyncStream(theOutputStream, asyncBufferSize, asyncPolicy);
 
         if (strcmp(argv[1],"Element") == 0) 
             (*theRecorder) = new ElementRecorder(eleIDs, 
@@ -1052,6 +1090,26 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 pos += 2;
             }	    
 
+            else if ((strcmp(argv[pos],"-binaryColumnar") == 0)) {
+                // binary file with a header, chunk size and compression optional
+                fileName = argv[pos+1];
+                const char *pwd = getInterpPWD(interp);
+                simulationInfo.addOutputFile(fileName, pwd);
+                eMode = COLUMNAR_STREAM;
+                pos += 2;
+                while (pos < argc) {
+                    if (strcmp(argv[pos],"-compress") == 0) {
+                        columnarCompress = true;
+                        pos++;
+                    } else if (strcmp(argv[pos],"-chunk") == 0 && pos+1 < argc) {
+                        if (Tcl_GetInt(interp, argv[pos+1], &columnarChunkSize) != TCL_OK)
+                            return TCL_ERROR;
+                        pos += 2;
+                    } else
+                        break;
+                }
+            }
+
 
             else if (strcmp(argv[pos],"-dT") == 0) {
                 pos ++;
@@ -1201,6 +1259,8 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new DatabaseStream(theDatabase, tableName);
         } else if (eMode == BINARY_STREAM && fileName != 0) {
             theOutputStream = new BinaryFileStream(fileName);
+        } else if (eMode == COLUMNAR_STREAM && fileName != 0) {
+            theOutputStream = new ColumnarFileStream(fileName, columnarChunkSize, columnarCompress);
         } else if (eMode == TCP_STREAM && inetAddr != 0) {
             theOutputStream = new TCP_Stream(inetPort, inetAddr);
         } else {
@@ -1208,6 +1268,7 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
         }
 
         theOutputStream->setPrecision(precision);
+        theOutputStream = createAsyncStream(theOutputStream, asyncBufferSize, asyncPolicy);
 
         if (strcmp(argv[1],"Node") == 0) {
 
@@ -1317,6 +1378,26 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
                 pos += 2;
             }	    
 
+            else if ((strcmp(argv[pos],"-binaryColumnar") == 0)) {
+                // binary file with a header, chunk size and compression optional
+                fileName = argv[pos+1];
+                const char *pwd = getInterpPWD(interp);
+                simulationInfo.addOutputFile(fileName, pwd);
+                eMode = COLUMNAR_STREAM;
+                pos += 2;
+                while (pos < argc) {
+                    if (strcmp(argv[pos],"-compress") == 0) {
+                        columnarCompress = true;
+                        pos++;
+                    } else if (strcmp(argv[pos],"-chunk") == 0 && pos+1 < argc) {
+                        if (Tcl_GetInt(interp, argv[pos+1], &columnarChunkSize) != TCL_OK)
+                            return TCL_ERROR;
+                        pos += 2;
+                    } else
+                        break;
+                }
+            }
+
             else if ((strcmp(argv[pos],"-nees") == 0) || (strcmp(argv[pos],"-xml") == 0)) {
                 // allow user to specify load pattern other than current
                 fileName = argv[pos+1];
@@ -1397,9 +1478,13 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
             theOutputStream = new DatabaseStream(theDatabase, tableName);
         } else if (eMode == BINARY_STREAM) {
             theOutputStream = new BinaryFileStream(fileName);
+        } else if (eMode == COLUMNAR_STREAM && fileName != 0) {
+            theOutputStream = new ColumnarFileStream(fileName, columnarChunkSize, columnarCompress);
         } else
             theOutputStream = new StandardStream();
 
+        theOutputStream = createAsyncStream(theOutputStream, asyncBufferSize, asyncPolicy);
+
         // Subtract one from dof and perpDirn for C indexing
         if (strcmp(argv[1],"Drift") == 0) 
             (*theRecorder) = new DriftRecorder(iNodes, jNodes, dof-1, perpDirn-1,
@@ -1771,6 +1856,59 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
 }
 
 
+int
+TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
+                  TCL_Char **argv, Domain &theDomain, Recorder **theRecorder)
+{
+    // -async, -asyncBuffer numValues and -asyncPolicy block|drop may be
+    // given anywhere, remove them and create the recorder from the rest
+    int asyncBufferSize = 0;
+    int asyncPolicy = ASYNC_STREAM_BLOCK;
+    TCL_Char **otherArgv = new TCL_Char *[argc];
+    int otherArgc = 0;
+
+    for (int i=0; i<argc; i++) {
+        if (strcmp(argv[i],"-async") == 0) {
+            if (asyncBufferSize == 0)
+                asyncBufferSize = ASYNC_STREAM_BUFFER_SIZE;
+        } else if (strcmp(argv[i],"-asyncBuffer") == 0 && i+1 < argc) {
+            if (Tcl_GetInt(interp, argv[++i], &asyncBufferSize) != TCL_OK || asyncBufferSize < 1) {
+                opserr << "WARNING recorder -asyncBuffer " << argv[i] << " - invalid number of values\n";
+                delete [] otherArgv;
+                return TCL_ERROR;
+            }
+        } else if (strcmp(argv[i],"-asyncPolicy") == 0 && i+1 < argc) {
+            if (asyncBufferSize == 0)
+                asyncBufferSize = ASYNC_STREAM_BUFFER_SIZE;
+            i++;
+            if (strcmp(argv[i],"drop") == 0)
+                asyncPolicy = ASYNC_STREAM_DROP;
+            else if (strcmp(argv[i],"block") == 0)
+                asyncPolicy = ASYNC_STREAM_BLOCK;
+            else {
+                opserr << "WARNING recorder -asyncPolicy " << argv[i] << " - use block or drop\n";
+                delete [] otherArgv;
+                return TCL_ERROR;
+            }
+        } else
+            otherArgv[otherArgc++] = argv[i];
+    }
+
+    // make sure at least one other argument to contain integrator
+    if (otherArgc < 2) {
+        opserr << "WARNING need to specify a Recorder type\n";
+        delete [] otherArgv;
+        return TCL_ERROR;
+    }
+
+    int result = createRecorder(clientData, interp, otherArgc, otherArgv, theDomain,
+                                theRecorder, asyncBufferSize, asyncPolicy);
+
+    delete [] otherArgv;
+    return result;
+}
+
+
 int 
 TclAddRecorder(ClientData clientData, Tcl_Interp *interp, int argc, 
                TCL_Char **argv, Domain &theDomain)
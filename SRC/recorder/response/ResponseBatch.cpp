@@ -0,0 +1,205 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// $Source: /usr/local/cvs/OpenSees/SRC/recorder/response/ResponseBatch.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of ResponseBatch.
+//
+// What: "@(#) ResponseBatch.C, revA"
+
+#include <ResponseBatch.h>
+#include <Response.h>
+#include <Information.h>
+#include <Element.h>
+#include <Vector.h>
+#include <ThreadPool.h>
+#include <OPS_Globals.h>
+
+#include <algorithm>
+
+struct ResponseBatchTask {
+  ResponseBatchEntry **theEntries;
+  double *theOutput;
+  int result[OPS_MAX_THREADS];
+};
+
+// thread safe entries first, then by element class so that the elements
+// of one class are gathered together, then in the order added
+struct ResponseBatchOrder {
+  bool operator()(const ResponseBatchEntry *a, const ResponseBatchEntry *b) const {
+    if (a->threadSafe != b->threadSafe)
+      return a->threadSafe;
+    if (a->classTag != b->classTag)
+      return a->classTag < b->classTag;
+    return a->index < b->index;
+  }
+};
+
+static void
+gatherTask(int start, int end, int threadID, void *data)
+{
+  ResponseBatchTask *theTask = (ResponseBatchTask *)data;
+  for (int i=start; i<end; i++) {
+    ResponseBatchEntry *theEntry = theTask->theEntries[i];
+    int res = theEntry->theResponse->getResponse();
+    if (res < 0) {
+      theTask->result[threadID] += res;
+      continue;
+    }
+
+    // the data is already in place unless the response has changed size
+    // and its Information let go of the output
+    Information &eleInfo = theEntry->theResponse->getInformation();
+    const Vector &eleData = eleInfo.getData();
+    double *slice = theTask->theOutput + theEntry->loc;
+    if (eleInfo.theLocation != slice) {
+      int numCopy = eleData.Size();
+      if (numCopy > theEntry->size)
+	numCopy = theEntry->size;
+      for (int j=0; j<numCopy; j++)
+	slice[j] = eleData(j);
+    }
+  }
+}
+
+ResponseBatch::ResponseBatch()
+:theEntries(0), theGather(0), numEntries(0), sizeEntries(0), 
+ numSafe(0), theOutput(0)
+{
+
+}
+
+ResponseBatch::~ResponseBatch()
+{
+  if (theEntries != 0)
+    delete [] theEntries;
+  if (theGather != 0)
+    delete [] theGather;
+}
+
+int 
+ResponseBatch::addResponse(Response *theResponse, Element *theElement)
+{
+  if (theResponse == 0 || theElement == 0)
+    return 0;
+
+  if (numEntries == sizeEntries) {
+    int newSize = (sizeEntries == 0) ? 16 : 2*sizeEntries;
+    ResponseBatchEntry *newEntries = new ResponseBatchEntry[newSize];
+    ResponseBatchEntry **newGather = new ResponseBatchEntry *[newSize];
+    if (newEntries == 0 || newGather == 0) {
+      opserr << "ResponseBatch::addResponse() - out of memory\n";
+      return -1;
+    }
+    for (int i=0; i<numEntries; i++)
+      newEntries[i] = theEntries[i];
+    if (theEntries != 0)
+      delete [] theEntries;
+    if (theGather != 0)
+      delete [] theGather;
+    theEntries = newEntries;
+    theGather = newGather;
+    sizeEntries = newSize;
+  }
+
+  ResponseBatchEntry &theEntry = theEntries[numEntries];
+  theEntry.theResponse = theResponse;
+  theEntry.classTag = theElement->getClassTag();
+  theEntry.threadSafe = theElement->isThreadSafe();
+  theEntry.index = numEntries;
+  theEntry.loc = 0;
+  theEntry.size = theResponse->getInformation().getData().Size();
+  numEntries++;
+
+  // the output must be set again
+  theOutput = 0;
+
+  return 0;
+}
+
+int 
+ResponseBatch::setOutput(Vector &output, int startLoc)
+{
+  theOutput = 0;
+
+  // the slices follow one another in the order the responses were added
+  int loc = startLoc;
+  for (int i=0; i<numEntries; i++) {
+    ResponseBatchEntry &theEntry = theEntries[i];
+    if (loc + theEntry.size > output.Size()) {
+      opserr << "ResponseBatch::setOutput() - output of size " << output.Size();
+      opserr << " too small for the responses\n";
+      return -1;
+    }
+    theEntry.loc = loc;
+    if (theEntry.size > 0 && 
+	theEntry.theResponse->getInformation().setData(&output(loc), theEntry.size) < 0)
+      return -1;
+    loc += theEntry.size;
+    theGather[i] = &theEntry;
+  }
+
+  std::sort(theGather, theGather + numEntries, ResponseBatchOrder());
+  numSafe = 0;
+  while (numSafe < numEntries && theGather[numSafe]->threadSafe == true)
+    numSafe++;
+
+  theOutput = &output;
+  return 0;
+}
+
+int 
+ResponseBatch::getResponse(void)
+{
+  if (numEntries == 0)
+    return 0;
+
+  if (theOutput == 0) {
+    opserr << "ResponseBatch::getResponse() - setOutput() has not been called\n";
+    return -1;
+  }
+
+  ResponseBatchTask theTask;
+  theTask.theEntries = theGather;
+  theTask.theOutput = (theOutput->Size() > 0) ? &(*theOutput)(0) : 0;
+  for (int i=0; i<OPS_MAX_THREADS; i++)
+    theTask.result[i] = 0;
+
+  ThreadPool *thePool = ThreadPool::getDefault();
+  if (thePool != 0 && numSafe > 1) {
+    thePool->parallelFor(numSafe, gatherTask, &theTask);
+    gatherTask(numSafe, numEntries, 0, &theTask);
+  } else
+    gatherTask(0, numEntries, 0, &theTask);
+
+  int result = 0;
+  for (int i=0; i<OPS_MAX_THREADS; i++)
+    result += theTask.result[i];
+
+  return result;
+}
+
+int 
+ResponseBatch::getNumResponses(void) const
+{
+  return numEntries;
+}
@@ -0,0 +1,74 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// $Source: /usr/local/cvs/OpenSees/SRC/recorder/response/ResponseBatch.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for ResponseBatch.
+// A ResponseBatch gathers the Response objects of a recorder into one 
+// output Vector. Each response is given its own contiguous slice of the
+// Vector once, so that the element writes its data directly into the
+// recorder's output; the responses of elements that are thread safe are
+// gathered on the threads of the default ThreadPool, grouped by element 
+// class, and the remaining ones on the calling thread.
+//
+// What: "@(#) ResponseBatch.h, revA"
+
+#ifndef ResponseBatch_h
+#define ResponseBatch_h
+
+class Response;
+class Element;
+class Vector;
+
+struct ResponseBatchEntry {
+  Response *theResponse;
+  int classTag;     // class tag of the element the response belongs to
+  bool threadSafe;  // true if the element's response can be obtained on any thread
+  int index;        // order in which the response was added
+  int loc;          // start of the response's slice in the output
+  int size;
+};
+
+class ResponseBatch
+{
+  public:
+    ResponseBatch();
+    ~ResponseBatch();
+
+    int addResponse(Response *theResponse, Element *theElement);
+    int setOutput(Vector &theOutput, int startLoc = 0);
+    int getResponse(void);
+
+    int getNumResponses(void) const;
+    
+  protected:
+    
+  private:
+    ResponseBatchEntry *theEntries;   // in the order added
+    ResponseBatchEntry **theGather;   // in the order gathered
+    int numEntries;
+    int sizeEntries;
+    int numSafe;                      // no. of thread safe entries, first in theGather
+    Vector *theOutput;
+};
+
+#endif
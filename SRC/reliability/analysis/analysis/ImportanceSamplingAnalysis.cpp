@@ -31,6 +31,7 @@
 //
 
 #include <ImportanceSamplingAnalysis.h>
+#include <SampleWorkerPool.h>
 #include <ReliabilityDomain.h>
 #include <ReliabilityAnalysis.h>
 #include <LimitStateFunction.h>
@@ -42,6 +43,7 @@
 #include <NormalRV.h>
 #include <Vector.h>
 #include <Matrix.h>
+#include <ID.h>
 #include <MatrixOperations.h>
 
 #include <math.h>
@@ -66,7 +68,8 @@ ImportanceSamplingAnalysis::ImportanceSamplingAnalysis(ReliabilityDomain *passed
 							long int passedNumberOfSimulations,
                             double passedTargetCOV, double passedSamplingStdv,
 							int passedPrintFlag, TCL_Char *passedFileName,
-							int passedAnalysisTypeTag)
+							int passedAnalysisTypeTag,
+							int passedNumWorkers)
 :ReliabilityAnalysis(), theReliabilityDomain(passedReliabilityDomain), 
 theOpenSeesDomain(passedOpenSeesDomain)
 {
@@ -80,6 +83,7 @@ theOpenSeesDomain(passedOpenSeesDomain)
 	printFlag = passedPrintFlag;
 	strcpy(fileName,passedFileName);
 	analysisTypeTag = passedAnalysisTypeTag;
+	numWorkers = passedNumWorkers;
 }
 
 
@@ -206,13 +210,30 @@ ImportanceSamplingAnalysis::analyze(void)
 	double govCov = 999.0;
 	//Vector temp1;
 	double temp2, denumerator;
-	bool FEconvergence;
 
 
 	// Prepare output file
 	ofstream resultsOutputFile( fileName, ios::out );
 
 
+	// The samples are drawn in batches, in the order of the samples, and the
+	// limit-state functions of a batch are evaluated by the workers; the
+	// estimates are then updated one sample at a time as before, so the
+	// results do not depend on the number of workers
+	SampleWorkerPool theWorkers(theReliabilityDomain, theOpenSeesDomain, theGFunEvaluator, numWorkers);
+	int batchSize = 1;
+	if (theWorkers.getNumWorkers() > 1)
+		batchSize = theWorkers.getNumWorkers()*SAMPLE_WORKER_BATCH_SIZE;
+	long int lastSimulation = (numberOfSimulations > 2) ? numberOfSimulations : 2;
+
+	Vector uBatch(batchSize*numRV);
+	Vector xBatch(batchSize*numRV);
+	Vector gBatch(batchSize*numLsf);
+	ID seedBatch(batchSize);
+	int numInBatch = 0;
+	int sampleInBatch = 0;
+
+
 	bool isFirstSimulation = true;
 	while( ( k <= numberOfSimulations && govCov > targetCOV || k <= 2 ) ) {
 
@@ -222,61 +243,63 @@ ImportanceSamplingAnalysis::analyze(void)
 			opserr << "Sample #" << myString << ":" << endln;
 		}
 
-		
-		// Create array of standard normal random numbers
-		if (isFirstSimulation) {
-			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV,seed);
-		}
-		else {
-			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
-		}
-		seed = theRandomNumberGenerator->getSeed();
-		if (result < 0) {
-			opserr << "ImportanceSamplingAnalysis::analyze() - could not generate" << endln
-				<< " random numbers for simulation." << endln;
-			return -1;
-		}
-		randomArray = theRandomNumberGenerator->getGeneratedNumbers();
-
-		// Compute the point in standard normal space
-		//u = startPointY + chol_covariance * randomArray;
-        u = startPointY;
-		u.addVector(1.0, randomArray, samplingStdv);
-
-		// Transform into original space
-		result = theProbabilityTransformation->transform_u_to_x(u, x);
-		if (result < 0) {
-		  opserr << "ImportanceSamplingAnalysis::analyze() - could not transform u to x. " << endln;
-		  return -1;
-		}
-        
-        // update domain with new x values
-        for (int j = 0; j < numRV; j++) {
-            RandomVariable *theRV = theReliabilityDomain->getRandomVariablePtrFromIndex(j);
-            int param_indx = theReliabilityDomain->getParameterIndexFromRandomVariableIndex(j);
-            Parameter *theParam = theOpenSeesDomain->getParameterFromIndex(param_indx);
-            
-            // now we should update the parameter value
-            theParam->update( x(j) );
-        }
-		
-        
-        // set values in the variable namespace
-        if (theGFunEvaluator->setVariables() < 0) {
-            opserr << "ImportanceSamplingAnalysis::analyze() - " << endln
-                << " could not set variables in namespace. " << endln;
-            return -1;
-        }
-        
-		// Evaluate limit-state function
-		FEconvergence = true;
-		if (theGFunEvaluator -> runAnalysis() < 0) {
-			// In this case a failure happened during the analysis
-			// Hence, register this as failure
-            opserr << "ERROR ImportanceSamplingAnalysis -- error running analysis" << endln;
-			FEconvergence = false;
+
+		if (sampleInBatch == numInBatch) {
+
+			numInBatch = batchSize;
+			if (lastSimulation - k + 1 < batchSize)
+				numInBatch = lastSimulation - k + 1;
+
+			for (int b = 0; b < numInBatch; b++) {
+
+				// Create array of standard normal random numbers
+				if (isFirstSimulation) {
+					result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV,seed);
+				}
+				else {
+					result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
+				}
+				seedBatch(b) = theRandomNumberGenerator->getSeed();
+				isFirstSimulation = false;
+				if (result < 0) {
+					opserr << "ImportanceSamplingAnalysis::analyze() - could not generate" << endln
+						<< " random numbers for simulation." << endln;
+					return -1;
+				}
+				randomArray = theRandomNumberGenerator->getGeneratedNumbers();
+
+				// Compute the point in standard normal space
+				//u = startPointY + chol_covariance * randomArray;
+				u = startPointY;
+				u.addVector(1.0, randomArray, samplingStdv);
+
+				// Transform into original space
+				result = theProbabilityTransformation->transform_u_to_x(u, x);
+				if (result < 0) {
+				  opserr << "ImportanceSamplingAnalysis::analyze() - could not transform u to x. " << endln;
+				  return -1;
+				}
+
+				for (int j = 0; j < numRV; j++) {
+					uBatch(b*numRV+j) = u(j);
+					xBatch(b*numRV+j) = x(j);
+				}
+			}
+
+			// update domain with the x values, run the analyses and
+			// evaluate the limit-state functions
+			if (theWorkers.evaluate(&xBatch(0), &gBatch(0), numInBatch) < 0) {
+				opserr << "ImportanceSamplingAnalysis::analyze() - could not evaluate" << endln
+					<< " the limit-state functions. " << endln;
+				return -1;
+			}
+			sampleInBatch = 0;
 		}
 
+		seed = seedBatch(sampleInBatch);
+		for (int j = 0; j < numRV; j++)
+			u(j) = uBatch(sampleInBatch*numRV+j);
+
 
 		LimitStateFunctionIter &lsfIter = theReliabilityDomain->getLimitStateFunctions();
 		LimitStateFunction *theLimitStateFunction;
@@ -286,17 +309,7 @@ ImportanceSamplingAnalysis::analyze(void)
             theLimitStateFunction = theReliabilityDomain->getLimitStateFunctionPtrFromIndex(lsf);
             int lsfTag = theLimitStateFunction->getTag();
 
-			// Set tag of "active" limit-state function
-			theReliabilityDomain->setTagOfActiveLimitStateFunction(lsfTag);
-
-            // set and evaluate LSF
-            const char *lsfExpression = theLimitStateFunction->getExpression();
-            theGFunEvaluator->setExpression(lsfExpression);
-            
-            gFunctionValue = theGFunEvaluator->evaluateExpression();
-            if (!FEconvergence) {
-				gFunctionValue = -1.0;
-			}
+            gFunctionValue = gBatch(sampleInBatch*numLsf+lsf);
 
 			
 			// ESTIMATION OF FAILURE PROBABILITY
@@ -467,7 +480,7 @@ ImportanceSamplingAnalysis::analyze(void)
 
 		// Increment k (the simulation number counter)
 		k++;
-		isFirstSimulation = false;
+		sampleInBatch++;
 
 	}
 
@@ -38,6 +38,9 @@
 #include <RandomVariable.h>
 //#include <RandomVariablePositioner.h>
 #include <NormalRV.h>
+#include <Domain.h>
+#include <Parameter.h>
+#include <MemoryDatastore.h>
 #include <Vector.h>
 #include <Matrix.h>
 #include <math.h>
@@ -77,6 +80,8 @@ MonteCarloResponseAnalysis::MonteCarloResponseAnalysis(
 	}
 	else tclFileToRun = 0;
 
+	theOpenSeesDomain = 0;
+	theSnapshot = 0;
 }
 
 
@@ -84,6 +89,21 @@ MonteCarloResponseAnalysis::MonteCarloResponseAnalysis(
 MonteCarloResponseAnalysis::~MonteCarloResponseAnalysis()
 {
 	if (tclFileToRun !=0) delete [] tclFileToRun;
+	if (theSnapshot != 0) delete theSnapshot;
+}
+
+int MonteCarloResponseAnalysis::setDomainSnapshot(Domain *passedDomain, FEM_ObjectBroker &theBroker)
+{
+	if (theSnapshot != 0) {
+		delete theSnapshot;
+		theSnapshot = 0;
+	}
+
+	theOpenSeesDomain = passedDomain;
+	if (theOpenSeesDomain != 0)
+		theSnapshot = new MemoryDatastore(*theOpenSeesDomain, theBroker);
+
+	return 0;
 }
 
 int MonteCarloResponseAnalysis::analyze(){
@@ -132,6 +152,32 @@ int MonteCarloResponseAnalysis::analyze(){
 	ofstream resultsOutputFile( fileName, ios::out );
 
 
+	// Take the snapshot of the model built before the analysis; each sample
+	// then restores it in memory and only the parameters mapped to random
+	// variables are changed, the file being left with the analysis only;
+	// the file must not add to or remove from the model, as restoring a
+	// changed domain rebuilds it and the parameters lose their objects
+	int *parameterIndex = 0;
+	int snapshotGeoTag = 0;
+	if (theSnapshot != 0) {
+		if (tclFileToRun == 0 || theOpenSeesDomain->getNumNodes() == 0 || theSnapshot->commitState(0) < 0) {
+			opserr << "MonteCarloResponseAnalysis::analyze() - could not take a snapshot of the domain," << endln
+				<< " the file will be run without it." << endln;
+			delete theSnapshot;
+			theSnapshot = 0;
+		}
+		else {
+			snapshotGeoTag = theOpenSeesDomain->hasDomainChanged();
+			int numParameters = theOpenSeesDomain->getNumParameters();
+			parameterIndex = new int[numRV];
+			for (int ii=0; ii<numRV; ii++) {
+				int index = theReliabilityDomain->getParameterIndexFromRandomVariableIndex(ii);
+				parameterIndex[ii] = (index >= 0 && index < numParameters) ? index : -1;
+			}
+		}
+	}
+
+
 
 	while( kk< numberOfSimulations){ // && govCov>targetCOV || k<=2) ) {
 
@@ -218,7 +264,35 @@ int MonteCarloResponseAnalysis::analyze(){
 		// ---------------------- run tcl file and  recorder ---------------------
 
 
-		if (tclFileToRun != 0) {     
+		if (theSnapshot != 0) {
+			char theWipeAnalysis[15] = "wipeAnalysis";
+			Tcl_Eval( theTclInterp, theWipeAnalysis );
+
+			if (theSnapshot->restoreState(0) < 0) {
+				opserr << "MonteCarloResponseAnalysis::analyze() - could not restore the domain snapshot" << endln;
+				delete [] parameterIndex;
+				return -1;
+			}
+
+			for (int ii=0; ii<numRV; ii++) {
+				if (parameterIndex[ii] >= 0)
+					theOpenSeesDomain->getParameterFromIndex(parameterIndex[ii])->update(x(ii));
+			}
+
+			if(Tcl_EvalFile(theTclInterp, tclFileToRun) !=TCL_OK){
+				opserr<<"MonteCarloResponseAnalysis: the file "<<tclFileToRun<<" can not be run!"<<endln;
+				exit(-1);
+			}  //if
+
+			if (theOpenSeesDomain->hasDomainChanged() != snapshotGeoTag) {
+				opserr << "MonteCarloResponseAnalysis::analyze() - the file " << tclFileToRun << endln
+				       << " changed the model taken in the snapshot; define the model before" << endln
+				       << " the analysis or run without -snapshot" << endln;
+				delete [] parameterIndex;
+				return -1;
+			}
+		}
+		else if (tclFileToRun != 0) {     
 			char theRevertToStartCommand[10] = "reset";
 			Tcl_Eval( theTclInterp, theRevertToStartCommand );
 			char theWipeAnalysis[15] = "wipeAnalysis";
@@ -262,6 +336,9 @@ int MonteCarloResponseAnalysis::analyze(){
 	if (outputFile != 0) {
 		delete outputFile;
 	}
+	if (parameterIndex != 0) {
+		delete [] parameterIndex;
+	}
 
 
 	// Print summary of results to screen 
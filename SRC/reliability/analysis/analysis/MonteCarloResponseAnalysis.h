@@ -9,6 +9,9 @@
 #include <ProbabilityTransformation.h>
 #include <RandomNumberGenerator.h>
 
+class Domain;
+class FE_Datastore;
+class FEM_ObjectBroker;
 
 class MonteCarloResponseAnalysis  
 {
@@ -28,6 +31,10 @@ public:
 	virtual ~MonteCarloResponseAnalysis();
 	int analyze();
 
+	// restore the domain from an in memory snapshot for each sample
+	// instead of sourcing the model again
+	int setDomainSnapshot(Domain *theDomain, FEM_ObjectBroker &theBroker);
+
 private:
 	ReliabilityDomain *theReliabilityDomain;
 	Tcl_Interp *theTclInterp;
@@ -39,6 +46,9 @@ private:
 	char * tclFileToRun;
 	int seed;
 
+	Domain *theOpenSeesDomain;
+	FE_Datastore *theSnapshot;
+
 
 
 };
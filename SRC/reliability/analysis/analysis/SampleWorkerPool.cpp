@@ -0,0 +1,503 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// $Source: /usr/local/cvs/OpenSees/SRC/reliability/analysis/analysis/SampleWorkerPool.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of SampleWorkerPool.
+//
+// What: "@(#) SampleWorkerPool.C, revA"
+
+#include <SampleWorkerPool.h>
+#include <ReliabilityDomain.h>
+#include <LimitStateFunction.h>
+#include <FunctionEvaluator.h>
+#include <Domain.h>
+#include <Parameter.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+static int
+writeData(int fd, const void *data, int numBytes)
+{
+	const char *ptr = (const char *)data;
+	while (numBytes > 0) {
+		int numWritten = write(fd, ptr, numBytes);
+		if (numWritten < 0 && errno == EINTR)
+			continue;
+		if (numWritten <= 0)
+			return -1;
+		ptr += numWritten;
+		numBytes -= numWritten;
+	}
+	return 0;
+}
+
+static int
+readData(int fd, void *data, int numBytes)
+{
+	char *ptr = (char *)data;
+	while (numBytes > 0) {
+		int numRead = read(fd, ptr, numBytes);
+		if (numRead < 0 && errno == EINTR)
+			continue;
+		if (numRead <= 0)
+			return -1;
+		ptr += numRead;
+		numBytes -= numRead;
+	}
+	return 0;
+}
+#endif
+
+
+SampleWorkerPool::SampleWorkerPool(ReliabilityDomain *passedReliabilityDomain,
+				   Domain *passedOpenSeesDomain,
+				   FunctionEvaluator *passedGFunEvaluator,
+				   int passedNumWorkers)
+:theReliabilityDomain(passedReliabilityDomain), theOpenSeesDomain(passedOpenSeesDomain),
+ theGFunEvaluator(passedGFunEvaluator), numWorkers(passedNumWorkers),
+ workerPID(0), toWorker(0), fromWorker(0), numSamplesWorker(0)
+{
+	numRV = theReliabilityDomain->getNumberOfRandomVariables();
+	numLsf = theReliabilityDomain->getNumberOfLimitStateFunctions();
+
+	// parameter of each random variable, -1 if it has none
+	int numParam = theOpenSeesDomain->getNumParameters();
+	parameterIndex = new int[numRV];
+	for (int j = 0; j < numRV; j++) {
+		int index = theReliabilityDomain->getParameterIndexFromRandomVariableIndex(j);
+		parameterIndex[j] = (index >= 0 && index < numParam) ? index : -1;
+	}
+
+#ifdef _WIN32
+	if (numWorkers > 1) {
+		opserr << "WARNING SampleWorkerPool - workers need fork(), the samples are evaluated in process" << endln;
+		numWorkers = 1;
+	}
+#endif
+	if (numWorkers < 1)
+		numWorkers = 1;
+}
+
+
+SampleWorkerPool::~SampleWorkerPool()
+{
+	this->stopWorkers();
+
+	if (parameterIndex != 0)
+		delete [] parameterIndex;
+}
+
+
+int
+SampleWorkerPool::getNumWorkers(void)
+{
+	return numWorkers;
+}
+
+
+int
+SampleWorkerPool::evaluateSample(const double *x, double *g)
+{
+	// update domain with new x values
+	for (int j = 0; j < numRV; j++) {
+		if (parameterIndex[j] >= 0)
+			theOpenSeesDomain->getParameterFromIndex(parameterIndex[j])->update(x[j]);
+	}
+
+	// set values in the variable namespace
+	if (theGFunEvaluator->setVariables() < 0) {
+		opserr << "SampleWorkerPool::evaluateSample() - " << endln
+			<< " could not set variables in namespace. " << endln;
+		return -1;
+	}
+
+	// Evaluate limit-state function
+	bool FEconvergence = true;
+	if (theGFunEvaluator->runAnalysis() < 0) {
+		// In this case a failure happened during the analysis
+		// Hence, register this as failure
+		opserr << "ERROR SampleWorkerPool -- error running analysis" << endln;
+		FEconvergence = false;
+	}
+
+	for (int lsf = 0; lsf < numLsf; lsf++) {
+		LimitStateFunction *theLimitStateFunction = theReliabilityDomain->getLimitStateFunctionPtrFromIndex(lsf);
+
+		// Set tag of "active" limit-state function
+		theReliabilityDomain->setTagOfActiveLimitStateFunction(theLimitStateFunction->getTag());
+
+		// set and evaluate LSF
+		theGFunEvaluator->setExpression(theLimitStateFunction->getExpression());
+		g[lsf] = theGFunEvaluator->evaluateExpression();
+		if (!FEconvergence)
+			g[lsf] = -1.0;
+	}
+
+	return 0;
+}
+
+
+int
+SampleWorkerPool::evaluatePerturbation(int lsfTag, const double *base, int index, double value, double &g)
+{
+	// the parameters set by the random variables are those of the caller
+	int numParam = theOpenSeesDomain->getNumParameters();
+	for (int j = 0; j < numParam; j++) {
+		Parameter *theParam = theOpenSeesDomain->getParameterFromIndex(j);
+		if (!theParam->isImplicit())
+			theParam->update(base[j]);
+	}
+
+	Parameter *theParam = theOpenSeesDomain->getParameterFromIndex(index);
+	double original = theParam->getValue();
+	theParam->update(value);
+
+	// set perturbed values in the variable namespace
+	if (theGFunEvaluator->setVariables() < 0) {
+		opserr << "ERROR SampleWorkerPool -- error setting variables in namespace" << endln;
+		return -1;
+	}
+
+	// run analysis
+	if (theGFunEvaluator->runAnalysis() < 0) {
+		opserr << "ERROR SampleWorkerPool -- error running analysis" << endln;
+		return -1;
+	}
+
+	// evaluate LSF and obtain result
+	LimitStateFunction *theLimitStateFunction = theReliabilityDomain->getLimitStateFunctionPtr(lsfTag);
+	theGFunEvaluator->setExpression(theLimitStateFunction->getExpression());
+	g = theGFunEvaluator->evaluateExpression();
+
+	// return values to previous state
+	theParam->update(original);
+
+	return 0;
+}
+
+
+int
+SampleWorkerPool::evaluate(const double *x, double *g, int numSamples)
+{
+	if (this->useWorkers() == false) {
+		for (int i = 0; i < numSamples; i++)
+			if (this->evaluateSample(&x[i*numRV], &g[i*numLsf]) < 0)
+				return -1;
+		return 0;
+	}
+
+	return this->evaluateInWorkers(SAMPLE_WORKER_SAMPLES, 0, 0, 0, x, g, numSamples);
+}
+
+
+int
+SampleWorkerPool::evaluatePerturbations(int lsfTag, const int *index, const double *value,
+					double *g, int numPoints)
+{
+	int numParam = theOpenSeesDomain->getNumParameters();
+	double *base = new double[numParam];
+	for (int j = 0; j < numParam; j++)
+		base[j] = theOpenSeesDomain->getParameterFromIndex(j)->getValue();
+
+	int result = 0;
+	if (this->useWorkers() == false) {
+		for (int i = 0; i < numPoints && result == 0; i++)
+			result = this->evaluatePerturbation(lsfTag, base, index[i], value[i], g[i]);
+	}
+	else
+		result = this->evaluateInWorkers(SAMPLE_WORKER_PERTURBATIONS, lsfTag, base, index, value, g, numPoints);
+
+	delete [] base;
+	return result;
+}
+
+
+// the workers are started on first use; if they cannot be, the points
+// are evaluated in process from then on
+bool
+SampleWorkerPool::useWorkers(void)
+{
+	if (numWorkers == 1)
+		return false;
+
+	if (workerPID == 0 && this->startWorkers() < 0) {
+		opserr << "WARNING SampleWorkerPool - could not start the workers, the points are evaluated in process" << endln;
+		numWorkers = 1;
+		return false;
+	}
+
+	return true;
+}
+
+
+int
+SampleWorkerPool::evaluateInWorkers(int type, int lsfTag, const double *base, const int *index,
+				    const double *x, double *g, int numPoints)
+{
+#ifndef _WIN32
+	int numParam = theOpenSeesDomain->getNumParameters();
+	int sizeX = (type == SAMPLE_WORKER_SAMPLES) ? numRV : 1;
+	int sizeG = (type == SAMPLE_WORKER_SAMPLES) ? numLsf : 1;
+
+	// each worker gets a block of consecutive points
+	int numSent = 0;
+	for (int w = 0; w < numWorkers; w++) {
+		int num = numPoints/numWorkers + ((w < numPoints%numWorkers) ? 1 : 0);
+		numSamplesWorker[w] = num;
+		if (num == 0)
+			continue;
+
+		int header[3];
+		header[0] = num;
+		header[1] = type;
+		header[2] = lsfTag;
+		int result = writeData(toWorker[w], header, 3*sizeof(int));
+		if (result == 0 && type == SAMPLE_WORKER_PERTURBATIONS) {
+			result = writeData(toWorker[w], base, numParam*sizeof(double));
+			if (result == 0)
+				result = writeData(toWorker[w], &index[numSent], num*sizeof(int));
+		}
+		if (result == 0)
+			result = writeData(toWorker[w], &x[numSent*sizeX], num*sizeX*sizeof(double));
+		if (result < 0) {
+			opserr << "SampleWorkerPool::evaluate() - could not send the points to worker " << w << endln;
+			this->stopWorkers();
+			return -1;
+		}
+		numSent += num;
+	}
+
+	// the values are gathered in the order of the points
+	int result = 0;
+	int numReceived = 0;
+	for (int w = 0; w < numWorkers; w++) {
+		int num = numSamplesWorker[w];
+		if (num == 0)
+			continue;
+
+		int status;
+		if (readData(fromWorker[w], &status, sizeof(int)) < 0 ||
+		    readData(fromWorker[w], &g[numReceived*sizeG], num*sizeG*sizeof(double)) < 0) {
+			opserr << "SampleWorkerPool::evaluate() - could not get the results of worker " << w << endln;
+			this->stopWorkers();
+			return -1;
+		}
+		if (status < 0)
+			result = -1;
+		numReceived += num;
+	}
+
+	// the evaluations were made in the workers
+	for (int i = 0; i < numPoints*sizeG; i++)
+		theGFunEvaluator->incrementEvaluations();
+
+	return result;
+#else
+	return -1;
+#endif
+}
+
+
+int
+SampleWorkerPool::startWorkers(void)
+{
+#ifndef _WIN32
+	workerPID = new int[numWorkers];
+	toWorker = new int[numWorkers];
+	fromWorker = new int[numWorkers];
+	numSamplesWorker = new int[numWorkers];
+	for (int w = 0; w < numWorkers; w++) {
+		workerPID[w] = -1;
+		toWorker[w] = -1;
+		fromWorker[w] = -1;
+	}
+
+	// nothing buffered may be written twice by the workers
+	fflush(0);
+
+	for (int w = 0; w < numWorkers; w++) {
+		int requestPipe[2], replyPipe[2];
+		if (pipe(requestPipe) != 0) {
+			opserr << "SampleWorkerPool::startWorkers() - could not create a pipe" << endln;
+			this->stopWorkers();
+			return -1;
+		}
+		if (pipe(replyPipe) != 0) {
+			opserr << "SampleWorkerPool::startWorkers() - could not create a pipe" << endln;
+			close(requestPipe[0]);
+			close(requestPipe[1]);
+			this->stopWorkers();
+			return -1;
+		}
+
+		pid_t pid = fork();
+		if (pid < 0) {
+			opserr << "SampleWorkerPool::startWorkers() - could not start worker " << w << endln;
+			close(requestPipe[0]); close(requestPipe[1]);
+			close(replyPipe[0]); close(replyPipe[1]);
+			this->stopWorkers();
+			return -1;
+		}
+
+		if (pid == 0) {
+			// the worker only keeps its own ends of its own pipes
+			for (int i = 0; i < w; i++) {
+				close(toWorker[i]);
+				close(fromWorker[i]);
+			}
+			close(requestPipe[1]);
+			close(replyPipe[0]);
+
+			// the recorders and their files belong to the parent; the
+			// thread pools fall back to serial loops in the child
+			theOpenSeesDomain->detachRecorders();
+
+			this->runWorker(requestPipe[0], replyPipe[1]);
+
+			// leave without the destructors and exit handlers of the parent
+			_exit(0);
+		}
+
+		close(requestPipe[0]);
+		close(replyPipe[1]);
+		workerPID[w] = pid;
+		toWorker[w] = requestPipe[1];
+		fromWorker[w] = replyPipe[0];
+	}
+
+	return 0;
+#else
+	return -1;
+#endif
+}
+
+
+void
+SampleWorkerPool::stopWorkers(void)
+{
+#ifndef _WIN32
+	if (workerPID == 0)
+		return;
+
+	int stop[3] = {-1, 0, 0};
+	for (int w = 0; w < numWorkers; w++) {
+		if (toWorker[w] >= 0) {
+			writeData(toWorker[w], stop, 3*sizeof(int));
+			close(toWorker[w]);
+		}
+		if (fromWorker[w] >= 0)
+			close(fromWorker[w]);
+		if (workerPID[w] > 0)
+			waitpid(workerPID[w], 0, 0);
+	}
+
+	delete [] workerPID;
+	delete [] toWorker;
+	delete [] fromWorker;
+	delete [] numSamplesWorker;
+	workerPID = 0;
+	toWorker = 0;
+	fromWorker = 0;
+	numSamplesWorker = 0;
+#endif
+}
+
+
+void
+SampleWorkerPool::runWorker(int fdIn, int fdOut)
+{
+#ifndef _WIN32
+	int numParam = theOpenSeesDomain->getNumParameters();
+	double *base = new double[numParam];
+	int *index = 0;
+	double *x = 0;
+	double *g = 0;
+	int maxNum = 0;
+
+	int header[3];
+	while (readData(fdIn, header, 3*sizeof(int)) == 0 && header[0] > 0) {
+		int num = header[0];
+		int type = header[1];
+		int lsfTag = header[2];
+		int sizeX = (type == SAMPLE_WORKER_SAMPLES) ? numRV : 1;
+		int sizeG = (type == SAMPLE_WORKER_SAMPLES) ? numLsf : 1;
+
+		if (num > maxNum) {
+			if (x != 0) {
+				delete [] index;
+				delete [] x;
+				delete [] g;
+			}
+			maxNum = num;
+			index = new int[maxNum];
+			x = new double[maxNum*((numRV > 1) ? numRV : 1)];
+			g = new double[maxNum*((numLsf > 1) ? numLsf : 1)];
+		}
+
+		int result = 0;
+		if (type == SAMPLE_WORKER_PERTURBATIONS) {
+			result = readData(fdIn, base, numParam*sizeof(double));
+			if (result == 0)
+				result = readData(fdIn, index, num*sizeof(int));
+		}
+		if (result == 0)
+			result = readData(fdIn, x, num*sizeX*sizeof(double));
+		if (result < 0)
+			break;
+
+		int status = 0;
+		for (int i = 0; i < num*sizeG; i++)
+			g[i] = 0.0;
+		for (int i = 0; i < num && status == 0; i++) {
+			if (type == SAMPLE_WORKER_SAMPLES)
+				status = this->evaluateSample(&x[i*numRV], &g[i*numLsf]);
+			else
+				status = this->evaluatePerturbation(lsfTag, base, index[i], x[i], g[i]);
+		}
+
+		if (writeData(fdOut, &status, sizeof(int)) < 0 ||
+		    writeData(fdOut, g, num*sizeG*sizeof(double)) < 0)
+			break;
+	}
+
+	delete [] base;
+	if (x != 0) {
+		delete [] index;
+		delete [] x;
+		delete [] g;
+	}
+	close(fdIn);
+	close(fdOut);
+#endif
+}
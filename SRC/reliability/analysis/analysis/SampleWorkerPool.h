@@ -0,0 +1,103 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// $Source: /usr/local/cvs/OpenSees/SRC/reliability/analysis/analysis/SampleWorkerPool.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for SampleWorkerPool.
+// A SampleWorkerPool evaluates the limit-state functions of a reliability
+// domain at a number of sample points. With more than one worker the
+// process is forked once the model is built, each worker gets a block of
+// the points over a pipe and sends the g values back. As every sample
+// starts from the reverted domain the values do not depend on the number
+// of workers. Without fork (Windows) the samples are evaluated in process.
+// The workers run their loops serially, as the threads of the parent's
+// pools are not forked, and without the recorders of the domain.
+//
+// The same workers evaluate the points of a finite difference gradient,
+// each point being one parameter set to its perturbed value.
+//
+// What: "@(#) SampleWorkerPool.h, revA"
+
+#ifndef SampleWorkerPool_h
+#define SampleWorkerPool_h
+
+class ReliabilityDomain;
+class Domain;
+class FunctionEvaluator;
+
+// number of samples given to each worker at a time
+#define SAMPLE_WORKER_BATCH_SIZE 8
+
+#define SAMPLE_WORKER_SAMPLES       1
+#define SAMPLE_WORKER_PERTURBATIONS 2
+
+class SampleWorkerPool
+{
+
+public:
+	SampleWorkerPool(ReliabilityDomain *passedReliabilityDomain,
+			 Domain *passedOpenSeesDomain,
+			 FunctionEvaluator *passedGFunEvaluator,
+			 int numWorkers);
+	~SampleWorkerPool();
+
+	int getNumWorkers(void);
+
+	// x holds numRV values and g gets numLsf values for each sample
+	int evaluate(const double *x, double *g, int numSamples);
+
+	// g of limit-state function lsfTag with parameter index[i] set to
+	// value[i], the other parameters keeping the values of the caller
+	int evaluatePerturbations(int lsfTag, const int *index, const double *value,
+				  double *g, int numPoints);
+
+protected:
+
+private:
+	int evaluateSample(const double *x, double *g);
+	int evaluatePerturbation(int lsfTag, const double *base, int index, double value, double &g);
+	int evaluateInWorkers(int type, int lsfTag, const double *base, const int *index,
+			      const double *x, double *g, int numPoints);
+	bool useWorkers(void);
+	int startWorkers(void);
+	void stopWorkers(void);
+	void runWorker(int fdIn, int fdOut);
+
+	ReliabilityDomain *theReliabilityDomain;
+	Domain *theOpenSeesDomain;
+	FunctionEvaluator *theGFunEvaluator;
+	int numRV;
+	int numLsf;
+	int *parameterIndex;
+
+	int numWorkers;
+	int *workerPID;
+	int *toWorker;
+	int *fromWorker;
+	int *numSamplesWorker;
+};
+
+#endif
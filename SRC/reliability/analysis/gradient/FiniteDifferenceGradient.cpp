@@ -37,15 +37,17 @@
 #include <GradientEvaluator.h>
 #include <ReliabilityDomain.h>
 #include <LimitStateFunction.h>
+#include <SampleWorkerPool.h>
 #include <string.h>
 
 
 FiniteDifferenceGradient::FiniteDifferenceGradient(FunctionEvaluator *passedGFunEvaluator,
 						   ReliabilityDomain *passedReliabilityDomain,
-						   Domain *passedOpenSeesDomain)
+						   Domain *passedOpenSeesDomain,
+						   int passedNumWorkers)
 
 :GradientEvaluator(passedReliabilityDomain, passedGFunEvaluator), 
-theOpenSeesDomain(passedOpenSeesDomain)
+theOpenSeesDomain(passedOpenSeesDomain), numWorkers(passedNumWorkers), theWorkers(0)
 {
 	
 	int nparam = theOpenSeesDomain->getNumParameters();
@@ -58,6 +60,8 @@ FiniteDifferenceGradient::~FiniteDifferenceGradient()
 {
 	if (grad_g != 0) 
 		delete grad_g;
+	if (theWorkers != 0)
+		delete theWorkers;
 	
 }
 
@@ -87,6 +91,9 @@ FiniteDifferenceGradient::computeGradient(double g)
 	// get parameters created in the domain
 	int nparam = theOpenSeesDomain->getNumParameters();
 
+	if (numWorkers > 1)
+		return this->computeGradientInWorkers(g, lsf, lsfExpression);
+
     
 	// now loop through to create gradient vector
 	// note this is a for loop because there may be some conflict from a nested iterator already 
@@ -153,3 +160,65 @@ FiniteDifferenceGradient::computeGradient(double g)
 	
 }
 
+
+int
+FiniteDifferenceGradient::computeGradientInWorkers(double g, int lsf, const char *lsfExpression)
+{
+	if (theWorkers == 0)
+		theWorkers = new SampleWorkerPool(theReliabilityDomain, theOpenSeesDomain,
+						  theFunctionEvaluator, numWorkers);
+
+	LimitStateFunction *theLimitStateFunction = theReliabilityDomain->getLimitStateFunctionPtr(lsf);
+	int nparam = theOpenSeesDomain->getNumParameters();
+
+	int *index = new int[nparam];
+	double *perturbedValue = new double[nparam];
+	double *g_perturbed = new double[nparam];
+	int numPerturbed = 0;
+
+	// analytic gradients are evaluated here, the perturbed points are
+	// collected and evaluated by the workers in one call
+	for (int i = 0; i < nparam; i++) {
+		Parameter *theParam = theOpenSeesDomain->getParameterFromIndex(i);
+		int tag = theParam->getTag();
+
+		const char *gradExpression = theLimitStateFunction->getGradientExpression(tag);
+		if (gradExpression != 0) {
+			theFunctionEvaluator->setExpression(gradExpression);
+
+			if (theFunctionEvaluator->setVariables() < 0) {
+				opserr << "ERROR FiniteDifferenceGradient -- error setting variables in namespace" << endln;
+				delete [] index;
+				delete [] perturbedValue;
+				delete [] g_perturbed;
+				return -1;
+			}
+
+			(*grad_g)(i) = theFunctionEvaluator->evaluateExpression();
+
+			// Reset limit state function in evaluator -- subsequent calls could receive gradient expression
+			theFunctionEvaluator->setExpression(lsfExpression);
+		}
+		else {
+			index[numPerturbed] = i;
+			perturbedValue[numPerturbed] = theParam->getValue() + theParam->getPerturbation();
+			numPerturbed++;
+		}
+	}
+
+	int result = theWorkers->evaluatePerturbations(lsf, index, perturbedValue, g_perturbed, numPerturbed);
+	if (result < 0)
+		opserr << "ERROR FiniteDifferenceGradient -- error running the perturbed analyses" << endln;
+	else {
+		for (int j = 0; j < numPerturbed; j++) {
+			double h = theOpenSeesDomain->getParameterFromIndex(index[j])->getPerturbation();
+			(*grad_g)(index[j]) = (g_perturbed[j]-g)/h;
+		}
+	}
+
+	delete [] index;
+	delete [] perturbedValue;
+	delete [] g_perturbed;
+
+	return result;
+}
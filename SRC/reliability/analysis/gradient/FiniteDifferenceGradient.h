@@ -41,13 +41,16 @@
 #include <Domain.h>
 #include <FunctionEvaluator.h>
 
+class SampleWorkerPool;
+
 class FiniteDifferenceGradient : public GradientEvaluator
 {
 	
 public:
 	FiniteDifferenceGradient(FunctionEvaluator *passedGFunEvaluator,
 				 ReliabilityDomain *passedReliabilityDomain,
-				 Domain *passedOpenSeesDomain);
+				 Domain *passedOpenSeesDomain,
+				 int numWorkers = 1);
 	~FiniteDifferenceGradient();
 	
 	int		computeGradient(double gFunValue);
@@ -56,8 +59,16 @@ public:
 protected:
 	
 private:
+	int computeGradientInWorkers(double gFunValue, int lsf, const char *lsfExpression);
+
 	Domain *theOpenSeesDomain;
 	Vector *grad_g;
+
+	// the perturbed analyses are run by forked workers if numWorkers > 1;
+	// these run their loops serially and without recorders, and if they
+	// cannot be started the perturbations are run in process as before
+	int numWorkers;
+	SampleWorkerPool *theWorkers;
 	
 };
 
@@ -47,6 +47,7 @@ using std::setiosflags;
 #include <ID.h>
 #include <ArrayOfTaggedObjects.h>
 #include <Domain.h>
+#include <FEM_ObjectBroker.h>
 
 #include <ReliabilityDomain.h>
 #include <RandomVariable.h>
@@ -197,6 +198,8 @@ extern SensitivityIntegrator* theSensitivityIntegrator;
 /////E Modified by K Fujimura /////////////////////////////
 /////////////////////////////////////////////////////////
 
+extern FEM_ObjectBroker theBroker;
+
 //
 // SOME STATIC POINTERS USED IN THE FUNCTIONS INVOKED BY THE INTERPRETER
 //
@@ -3033,6 +3036,7 @@ TclReliabilityModelBuilder_addGradientEvaluator(ClientData clientData, Tcl_Inter
 
 		double perturbationFactor = 1000.0;
 		bool doGradientCheck = false;
+		int numWorkers = 1;
 
 		// Check that the necessary ingredients are present
 		if (theFunctionEvaluator == 0 ) {
@@ -3040,46 +3044,40 @@ TclReliabilityModelBuilder_addGradientEvaluator(ClientData clientData, Tcl_Inter
 			return TCL_ERROR;
 		}
 
-		// Possibly read perturbation factor
-		if (argc>2) {
-			int numExtras;
-			if (argc==3 || argc==4) {
-				numExtras = 1;
-			}
-			else if (argc==5) {
-				numExtras = 2;
-			}
-			else {
-				opserr << "ERROR: Wrong number of arguments to FiniteDifferenceGradient. " << endln;
-				return TCL_ERROR;
-			}
-
-			int counter = 2;
-
-			for (int i=1; i<=numExtras; i++) {
+		// Possibly read perturbation factor and number of workers
+		int counter = 2;
+		while (counter < argc) {
 
-				if (strcmp(argv[counter],"-pert") == 0) {
-					counter ++;
+			if (strcmp(argv[counter],"-pert") == 0 && counter+1 < argc) {
+				counter ++;
 
-					if (Tcl_GetDouble(interp, argv[counter], &perturbationFactor) != TCL_OK) {
-						opserr << "ERROR: invalid input: perturbationFactor \n";
-						return TCL_ERROR;
-					}
-					counter++;
-				}
-				else if (strcmp(argv[counter],"-check") == 0) {
-					counter++;
-					doGradientCheck = true;
+				if (Tcl_GetDouble(interp, argv[counter], &perturbationFactor) != TCL_OK) {
+					opserr << "ERROR: invalid input: perturbationFactor \n";
+					return TCL_ERROR;
 				}
-				else {
-					opserr << "ERROR: Error in input to FiniteDifferenceGradient. " << endln;
+				counter++;
+			}
+			else if (strcmp(argv[counter],"-check") == 0) {
+				counter++;
+				doGradientCheck = true;
+			}
+			else if (strcmp(argv[counter],"-workers") == 0 && counter+1 < argc) {
+				counter ++;
+
+				if (Tcl_GetInt(interp, argv[counter], &numWorkers) != TCL_OK || numWorkers < 1) {
+					opserr << "ERROR: invalid input: numWorkers \n";
 					return TCL_ERROR;
 				}
+				counter++;
+			}
+			else {
+				opserr << "ERROR: Error in input to FiniteDifferenceGradient. " << endln;
+				return TCL_ERROR;
 			}
 		}
 
 		theGradientEvaluator = new FiniteDifferenceGradient(theFunctionEvaluator, theReliabilityDomain, 
-								    theStructuralDomain);
+								    theStructuralDomain, numWorkers);
 	}
 
 	else if (strcmp(argv[1],"OpenSees") == 0 || strcmp(argv[1],"Implicit") == 0) {
@@ -4091,8 +4089,10 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 	//     -print 1   (print to screen)
 	//     -print 2   (print to restart file)
 	//
+	//     -workers 1  .......................... this is the default
+	//
 
-	if (argc!=2 && argc!=4 && argc!=6 && argc!=8 && argc!=10 && argc!=12) {
+	if (argc!=2 && argc!=4 && argc!=6 && argc!=8 && argc!=10 && argc!=12 && argc!=14) {
 		opserr << "ERROR: Wrong number of arguments to Sampling analysis" << endln;
 		return TCL_ERROR;
 	}
@@ -4104,6 +4104,7 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 	double samplingVariance	= 1.0;
 	int printFlag			= 0;
 	int analysisTypeTag		= 1;
+	int numWorkers			= 1;
 
 
 	for (int i=2; i<argc; i=i+2) {
@@ -4173,6 +4174,13 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 				return TCL_ERROR;
 			}
 		}
+		else if (strcmp(argv[i],"-workers") == 0) {
+			// GET INPUT PARAMETER (integer)
+			if (Tcl_GetInt(interp, argv[i+1], &numWorkers) != TCL_OK || numWorkers < 1) {
+				opserr << "ERROR: invalid input: numWorkers \n";
+				return TCL_ERROR;
+			}
+		}
 		else {
 			opserr << "ERROR: invalid input to sampling analysis. " << endln;
 			return TCL_ERROR;
@@ -4196,7 +4204,8 @@ TclReliabilityModelBuilder_runImportanceSamplingAnalysis(ClientData clientData,
 							 numberOfSimulations, targetCOV, samplingVariance,
 							 printFlag,
 							 argv[1],
-							 analysisTypeTag);
+							 analysisTypeTag,
+							 numWorkers);
 
 	if (theImportanceSamplingAnalysis == 0) {
 		opserr << "ERROR: could not create theImportanceSamplingAnalysis \n";
@@ -5087,7 +5096,7 @@ TclReliabilityModelBuilder_printReliability(ClientData clientData, Tcl_Interp *i
 // ---------- Quan Gu ------------------------
 
 
-///Command:  runMonteCarloResponseAnalysis  -outPutFile  m.out -maxNum 1000 -print 1 -tclFileToRun test.tcl <-seed 1>
+///Command:  runMonteCarloResponseAnalysis  -outPutFile  m.out -maxNum 1000 -print 1 -tclFileToRun test.tcl <-seed 1> <-snapshot>
 int 
 TclReliabilityModelBuilder_runMonteCarloResponseAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
@@ -5126,6 +5135,7 @@ TclReliabilityModelBuilder_runMonteCarloResponseAnalysis(ClientData clientData,
 	int printFlag			= 0;
 	char outPutFile[25]="";
 	char * tclFileName = 0;
+	bool useSnapshot = false;
 
 	int argvCounter = 1;
 	while (argc > argvCounter) {
@@ -5178,6 +5188,11 @@ TclReliabilityModelBuilder_runMonteCarloResponseAnalysis(ClientData clientData,
 			argvCounter++;
 		}// else if
 
+		else if (strcmp(argv[argvCounter],"-snapshot") == 0) {
+			useSnapshot = true;
+			argvCounter++;
+		}// else if
+
 		else {
 			opserr<<"warning: unknown command: "<<argv[argvCounter]<<endln;
 			argvCounter++;
@@ -5207,6 +5222,10 @@ TclReliabilityModelBuilder_runMonteCarloResponseAnalysis(ClientData clientData,
 
 	if (tclFileName !=0) delete [] tclFileName;
 
+	// the model is in the domain already, the file only runs the analysis
+	if (useSnapshot)
+		theMonteCarloResponseAnalysis->setDomainSnapshot(theStructuralDomain, theBroker);
+
 	// Now run analysis
 	theMonteCarloResponseAnalysis->analyze();
 	
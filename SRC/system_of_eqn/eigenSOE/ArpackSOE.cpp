@@ -43,7 +43,7 @@
 ArpackSOE::ArpackSOE(LinearSOE &theLinSOE,
 		     double theShift)
 :EigenSOE(EigenSOE_TAGS_ArpackSOE),
- M(0), Msize(0), mDiagonal(false), shift(theShift), theModel(0), theSOE(&theLinSOE),
+ M(0), Msize(0), mDiagonal(false), shift(theShift), printTiming(false), theModel(0), theSOE(&theLinSOE),
  processID(-1), numChannels(0), theChannels(0), localCol(0), sizeLocal(0)
 {
   ArpackSolver *theSolvr = new ArpackSolver();
@@ -54,7 +54,7 @@ ArpackSOE::ArpackSOE(LinearSOE &theLinSOE,
 
 ArpackSOE::ArpackSOE()
 :EigenSOE(EigenSOE_TAGS_ArpackSOE),
- M(0), Msize(0), mDiagonal(false), shift(0), theModel(0), theSOE(0),
+ M(0), Msize(0), mDiagonal(false), shift(0), printTiming(false), theModel(0), theSOE(0),
  processID(-1), numChannels(0), theChannels(0), localCol(0), sizeLocal(0)
 {
   ArpackSolver *theSolvr = new ArpackSolver();
@@ -252,6 +252,20 @@ ArpackSOE::getShift(void)
     return shift;
 }
 
+int
+ArpackSOE::setShift(double newShift)
+{
+  // A = K - shift*M is formed again before the next solve
+  shift = newShift;
+  return 0;
+}
+
+void
+ArpackSOE::setPrintTiming(bool print)
+{
+  printTiming = print;
+}
+
 
 int 
 ArpackSOE::sendSelf(int commitTag, Channel &theChannel)
@@ -61,6 +61,8 @@ class ArpackSOE : public EigenSOE
     void zeroM(void);
 
     double getShift(void);
+    int setShift(double newShift);
+    void setPrintTiming(bool print);
     
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
@@ -74,6 +76,7 @@ class ArpackSOE : public EigenSOE
     int Msize;
     bool mDiagonal;
     double shift;
+    bool printTiming;
     AnalysisModel *theModel;
     LinearSOE *theSOE;
 
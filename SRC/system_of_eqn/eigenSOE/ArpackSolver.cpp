@@ -54,13 +54,14 @@
 #include <Integrator.h>
 #include <string.h>
 #include <Channel.h>
+#include <ThreadPool.h>
 
 static double *workArea = 0;
 static int sizeWork = 0;
 
 ArpackSolver::ArpackSolver()
 :EigenSolver(EigenSOLVER_TAGS_ArpackSolver),
- theSOE(0), numModesMax(0), numMode(0), size(0),
+ theSOE(0), numModesMax(0), numMode(0), size(0), sizeVectors(0),
  eigenvalues(0), eigenvectors(0), 
  v(0), workl(0), workd(0), resid(0), select(0)
 {
@@ -135,6 +136,9 @@ ArpackSolver::solve(int numModes, bool generalized)
   }
 
   theSOE = theArpackSOE->theSOE;
+  shift = theArpackSOE->getShift();
+
+  double startTime = ThreadPool::getWallTime();
 
   if (theSOE == 0) {
     opserr << "ArpackSolver::setSize() - no LinearSOE set\n";
@@ -152,16 +156,24 @@ ArpackSolver::solve(int numModes, bool generalized)
 
   int processID = theArpackSOE->processID;
   
+  // the eigenvectors of the last solve, which for a model that has not
+  // changed much since are a good place to start the iterations from
+  double *lastVectors = 0;
+  int numLast = 0;
+  if (numMode > 0 && eigenvectors != 0 && sizeVectors == n) {
+    lastVectors = eigenvectors;
+    numLast = (numMode < nev) ? numMode : nev;
+  }
+  double *oldVectors = eigenvectors;
   
   // set up the space for ARPACK functions.
   // this is done each time method is called!! .. this needs to be cleaned up
-  if (numModes > numModesMax) {
+  if (numModes > numModesMax || n != sizeVectors) {
     
     if (v != 0) delete [] v;
     if (workl != 0) delete [] workl;
     if (workd != 0) delete [] workd;
     if (eigenvalues != 0) delete [] eigenvalues;
-    if (eigenvectors != 0) delete [] eigenvectors;
     if (resid != 0) delete [] resid;
     if (select != 0) delete [] select;
     
@@ -184,13 +196,27 @@ ArpackSolver::solve(int numModes, bool generalized)
     numModesMax = numModes;
   }
 
+  int info = 0;
+  if (lastVectors != 0) {
+    for (int i=0; i<n; i++)
+      resid[i] = 0.0;
+    for (int j=0; j<numLast; j++) {
+      const double *phi = &lastVectors[j*n];
+      for (int i=0; i<n; i++)
+	resid[i] += phi[i];
+    }
+    info = 1;
+  }
+
+  if (oldVectors != 0 && oldVectors != eigenvectors)
+    delete [] oldVectors;
+
   static char which[3]; strcpy(which, "LM");
   char bmat = 'G';
   char howmy = 'A';
   
   // some more variables
   double tol = 0.0;
-  int info = 0;
   int maxitr = 1000;
   int mode = 3;
   
@@ -203,6 +229,7 @@ ArpackSolver::solve(int numModes, bool generalized)
   
   int ido = 0;
   int ierr = 0;
+  int numSolves = 0;
   
   while (1) { 
 
@@ -228,6 +255,7 @@ ArpackSolver::solve(int numModes, bool generalized)
       theVector.setData(&workd[ipntr[1] - 1], size);
       theSOE->setB(theVector);
       ierr = theSOE->solve();
+      numSolves++;
       const Vector &X = theSOE->getX();
       theVector = X;
       
@@ -245,6 +273,7 @@ ArpackSolver::solve(int numModes, bool generalized)
 	theSOE->setB(theVector);
 
       theSOE->solve();
+      numSolves++;
       const Vector &X = theSOE->getX();
       theVector = X;
       //      theVector.setData(&workd[ipntr[1] - 1], size);
@@ -316,8 +345,13 @@ ArpackSolver::solve(int numModes, bool generalized)
       opserr << "unrecognised return value\n";
     }
     
+    // nothing to start from, and space allocated again, on the next call
+    delete [] eigenvalues;
+    delete [] eigenvectors;
     eigenvalues = 0;
     eigenvectors = 0;
+    numModesMax = 0;
+    numMode = 0;
     
     return info;
   } else {
@@ -406,6 +440,16 @@ ArpackSolver::solve(int numModes, bool generalized)
   }
   
   numMode = numModes;
+  sizeVectors = n;
+
+  if (theArpackSOE->printTiming == true) {
+    opserr << "ArpackSolver::solve - modes: " << nev << " shift: " << shift;
+    opserr << " iterations: " << iparam[2] << " solves: " << numSolves;
+    opserr << " time: " << ThreadPool::getWallTime() - startTime;
+    if (lastVectors != 0)
+      opserr << " (started from last eigenvectors)";
+    opserr << endln;
+  }
   
   // clean up the memory
   return 0;
@@ -75,6 +75,7 @@ class ArpackSolver : public EigenSolver
     int numModesMax;
     int numMode;
     int size;
+    int sizeVectors;     // size of the eigenvectors found, 0 if none
     double *eigenvalues;
     double *eigenvectors;
     Vector theVector;
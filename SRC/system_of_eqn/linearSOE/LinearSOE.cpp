@@ -62,6 +62,13 @@ LinearSOE::solve(void)
 }
 
 
+bool
+LinearSOE::isThreadSafe(void)
+{
+  return false;
+}
+
+
 double
 LinearSOE::getDeterminant(void)
 {
@@ -66,6 +66,10 @@ class LinearSOE : public MovableObject
     virtual int addB(const Vector &, const ID &, double fact = 1.0) =0;    
     virtual int setB(const Vector &, double fact = 1.0) =0;        
 
+    // true if addA() and addB() can be invoked at the same time from
+    // several threads for IDs having no equation in common
+    virtual bool isThreadSafe(void);
+
     virtual void zeroA(void) =0;
     virtual void zeroB(void) =0;
 
@@ -49,6 +49,11 @@ class LinearSOESolver : public MovableObject
     virtual int solve(void) = 0;
     virtual int setSize(void) = 0;
     virtual double getDeterminant(void) {return 1.0;};
+
+    // number of numeric factorizations and of those that also analysed
+    // the sparsity pattern, for solvers that keep count
+    virtual int getNumFactorizations(void) {return 0;};
+    virtual int getNumSymbolicFactorizations(void) {return 0;};
     
   protected:
     
@@ -0,0 +1,117 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/system_of_eqn/linearSOE/ScatterMap.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of ScatterMap.
+//
+// What: "@(#) ScatterMap.C, revA"
+
+#include <ScatterMap.h>
+#include <ID.h>
+
+struct ScatterMapEntry {
+  int idSize;
+  int *theID;          // copy of the ID the locations were built for
+  double **theLocs;    // idSize*idSize locations in A, 0 if not in A
+};
+
+ScatterMap::ScatterMap()
+{
+
+}
+
+ScatterMap::~ScatterMap()
+{
+  this->clear();
+}
+
+double **
+ScatterMap::getLocations(const ID &id)
+{
+  std::map<const ID *, ScatterMapEntry *>::iterator theEle = theEntries.find(&id);
+  if (theEle == theEntries.end())
+    return 0;
+
+  ScatterMapEntry *theEntry = theEle->second;
+  int idSize = id.Size();
+  if (theEntry->idSize != idSize)
+    return 0;
+
+  const int *theID = theEntry->theID;
+  for (int i=0; i<idSize; i++)
+    if (theID[i] != id(i))
+      return 0;
+
+  return theEntry->theLocs;
+}
+
+double **
+ScatterMap::newLocations(const ID &id)
+{
+  int idSize = id.Size();
+
+  ScatterMapEntry *theEntry = 0;
+  std::map<const ID *, ScatterMapEntry *>::iterator theEle = theEntries.find(&id);
+  if (theEle != theEntries.end()) {
+    theEntry = theEle->second;
+    if (theEntry->idSize != idSize) {
+      delete [] theEntry->theID;
+      delete [] theEntry->theLocs;
+      theEntry->theID = 0;
+      theEntry->theLocs = 0;
+    }
+  } else {
+    theEntry = new ScatterMapEntry;
+    theEntry->theID = 0;
+    theEntry->theLocs = 0;
+    theEntries[&id] = theEntry;
+  }
+
+  if (theEntry->theID == 0) {
+    theEntry->theID = new int[idSize];
+    theEntry->theLocs = new double *[idSize*idSize];
+    theEntry->idSize = idSize;
+  }
+
+  for (int i=0; i<idSize; i++)
+    theEntry->theID[i] = id(i);
+  for (int j=0; j<idSize*idSize; j++)
+    theEntry->theLocs[j] = 0;
+
+  return theEntry->theLocs;
+}
+
+void
+ScatterMap::clear(void)
+{
+  std::map<const ID *, ScatterMapEntry *>::iterator theEle;
+  for (theEle = theEntries.begin(); theEle != theEntries.end(); theEle++) {
+    ScatterMapEntry *theEntry = theEle->second;
+    if (theEntry->theID != 0)
+      delete [] theEntry->theID;
+    if (theEntry->theLocs != 0)
+      delete [] theEntry->theLocs;
+    delete theEntry;
+  }
+  theEntries.clear();
+}
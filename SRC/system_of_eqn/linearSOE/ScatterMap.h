@@ -0,0 +1,67 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/system_of_eqn/linearSOE/ScatterMap.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for ScatterMap.
+// A ScatterMap is used by the sparse LinearSOE classes to remember, for
+// each ID passed to addA(), the location in the storage of A of every
+// entry of the matrix being added, so that the search through the row or
+// column indices of A is only done the first time an ID is seen. The
+// locations are keyed by the address of the ID, which for FE_Element and
+// DOF_Group objects stays the same from one assembly to the next; as the
+// contents of the ID are stored as well, an ID whose equation numbers have
+// changed is detected and its locations rebuilt. The owner must clear()
+// the map whenever the storage of A is reallocated, i.e. in setSize().
+//
+// What: "@(#) ScatterMap.h, revA"
+
+#ifndef ScatterMap_h
+#define ScatterMap_h
+
+#include <map>
+
+class ID;
+struct ScatterMapEntry;
+
+class ScatterMap
+{
+  public:
+    ScatterMap();
+    ~ScatterMap();
+
+    // returns the idSize*idSize locations stored for id, entry (i,j) at
+    // i*idSize+j, or 0 if none are stored for the current contents of id
+    double **getLocations(const ID &id);
+
+    // returns zeroed space for the locations of id, to be filled by caller
+    double **newLocations(const ID &id);
+
+    void clear(void);
+
+  protected:
+
+  private:
+    std::map<const ID *, ScatterMapEntry *> theEntries;
+};
+
+#endif
@@ -0,0 +1,443 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/system_of_eqn/linearSOE/SkylineLDLT.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of SkylineLDLT.
+//
+// What: "@(#) SkylineLDLT.C, revA"
+
+#include <SkylineLDLT.h>
+#include <OPS_Globals.h>
+#include <math.h>
+
+// u_ji -= sum_k l_kj u_ki for the rows j in [jStart, jEnd) of column i, 
+// the columns j must be final
+static inline void
+updateColumn(int i, int jStart, int jEnd, int *RowTop, double **topRowPtr)
+{
+    int rowitop = RowTop[i];
+    double *ajiPtr = topRowPtr[i] + (jStart - rowitop);
+
+    for (int j=jStart; j<jEnd; j++) {
+	int rowjtop = RowTop[j];
+	double tmp = *ajiPtr;
+	double *akjPtr, *akiPtr;
+	int k;
+
+	if (rowitop > rowjtop) {
+	    akjPtr = topRowPtr[j] + (rowitop-rowjtop);
+	    akiPtr = topRowPtr[i];
+	    k = rowitop;
+	} else {
+	    akjPtr = topRowPtr[j];
+	    akiPtr = topRowPtr[i] + (rowjtop-rowitop);
+	    k = rowjtop;
+	}
+
+	for (; k<j; k++) 
+	    tmp -= *akjPtr++ * *akiPtr++;
+
+	*ajiPtr++ = tmp;
+    }
+}
+
+SkylineLDLT::SkylineLDLT(int numThrds, int blckSize, double tol)
+:theThreadPool(0), numThreads(1), blockSize(blckSize), minDiagTol(tol),
+ size(0), RowTop(0), topRowPtr(0), invD(0), X(0),
+ numBlocks(0), firstBlock(0), lastColumn(0), blockDone(0),
+ blocksClaimed(0), result(0)
+{
+    if (blockSize < 1)
+	blockSize = 1;
+
+    // with one thread the blocks are simply done in order
+    if (numThrds > 1) {
+	theThreadPool = new ThreadPool(numThrds);
+	numThreads = theThreadPool->getNumThreads();
+	if (numThreads == 1) {
+	    delete theThreadPool;
+	    theThreadPool = 0;
+	}
+    }
+
+#ifdef _THREADS
+    pthread_mutex_init(&theMutex, 0);
+    pthread_cond_init(&doneCond, 0);
+#endif
+}
+
+
+SkylineLDLT::~SkylineLDLT()
+{
+    if (theThreadPool != 0)
+	delete theThreadPool;
+
+    if (firstBlock != 0) delete [] firstBlock;
+    if (lastColumn != 0) delete [] lastColumn;
+    if (blockDone != 0) delete [] blockDone;
+
+#ifdef _THREADS
+    pthread_cond_destroy(&doneCond);
+    pthread_mutex_destroy(&theMutex);
+#endif
+}
+
+
+int
+SkylineLDLT::setSize(int n, int *rowTop, double **topRow, double *theInvD)
+{
+    size = n;
+    RowTop = rowTop;
+    topRowPtr = topRow;
+    invD = theInvD;
+
+    int newNumBlocks = (n + blockSize - 1)/blockSize;
+    if (newNumBlocks != numBlocks) {
+	if (firstBlock != 0) delete [] firstBlock;
+	if (lastColumn != 0) delete [] lastColumn;
+	if (blockDone != 0) delete [] blockDone;
+	firstBlock = 0;
+	lastColumn = 0;
+	blockDone = 0;
+	numBlocks = newNumBlocks;
+
+	if (numBlocks > 0) {
+	    firstBlock = new int[numBlocks];
+	    lastColumn = new int[numBlocks];
+	    blockDone = new char[numBlocks];
+	}
+    }
+
+    if (numBlocks == 0)
+	return 0;
+
+    for (int b=0; b<numBlocks; b++) {
+	firstBlock[b] = b;
+	lastColumn[b] = -1;
+    }
+
+    for (int k=0; k<n; k++) {
+	int b = k/blockSize;
+	int topBlock = RowTop[k]/blockSize;
+	if (topBlock < firstBlock[b])
+	    firstBlock[b] = topBlock;
+	if (k > lastColumn[topBlock])
+	    lastColumn[topBlock] = k;
+    }
+
+    // a column reaching into block b reaches into all blocks below it
+    for (int b=1; b<numBlocks; b++)
+	if (lastColumn[b-1] > lastColumn[b])
+	    lastColumn[b] = lastColumn[b-1];
+
+    return 0;
+}
+
+
+int
+SkylineLDLT::factor(void)
+{
+    if (size == 0)
+	return 0;
+
+    this->run(SkylineLDLT::factorTask);
+
+    return result;
+}
+
+
+int
+SkylineLDLT::solve(double *theX)
+{
+    if (size == 0)
+	return 0;
+
+    X = theX;
+    this->run(SkylineLDLT::forwardTask);
+    this->run(SkylineLDLT::backTask);
+    X = 0;
+
+    return result;
+}
+
+
+int
+SkylineLDLT::getNumThreads(void) const
+{
+    return numThreads;
+}
+
+
+int
+SkylineLDLT::getBlockSize(void) const
+{
+    return blockSize;
+}
+
+
+void
+SkylineLDLT::factorTask(int start, int end, int threadID, void *data)
+{
+    SkylineLDLT *theSolver = (SkylineLDLT *)data;
+
+    int block;
+    while ((block = theSolver->nextBlock()) >= 0) {
+	int res = theSolver->factorBlock(block);
+	theSolver->setBlockDone(block, res);
+    }
+}
+
+
+void
+SkylineLDLT::forwardTask(int start, int end, int threadID, void *data)
+{
+    SkylineLDLT *theSolver = (SkylineLDLT *)data;
+
+    int block;
+    while ((block = theSolver->nextBlock()) >= 0) {
+	theSolver->forwardBlock(block);
+	theSolver->setBlockDone(block, 0);
+    }
+}
+
+
+void
+SkylineLDLT::backTask(int start, int end, int threadID, void *data)
+{
+    SkylineLDLT *theSolver = (SkylineLDLT *)data;
+
+    // blocks are claimed from the last one up
+    int block;
+    while ((block = theSolver->nextBlock()) >= 0) {
+	block = theSolver->numBlocks - 1 - block;
+	theSolver->backBlock(block);
+	theSolver->setBlockDone(block, 0);
+    }
+}
+
+
+void
+SkylineLDLT::run(ThreadPoolFunction theFunction)
+{
+    for (int b=0; b<numBlocks; b++)
+	blockDone[b] = 0;
+    blocksClaimed = 0;
+    result = 0;
+
+    if (theThreadPool != 0)
+	theThreadPool->parallelFor(numThreads, theFunction, this);
+    else
+	(*theFunction)(0, 1, 0, this);
+}
+
+
+int
+SkylineLDLT::nextBlock(void)
+{
+    int block = -1;
+
+#ifdef _THREADS
+    pthread_mutex_lock(&theMutex);
+#endif
+
+    if (result == 0 && blocksClaimed < numBlocks)
+	block = blocksClaimed++;
+
+#ifdef _THREADS
+    pthread_mutex_unlock(&theMutex);
+#endif
+
+    return block;
+}
+
+
+int
+SkylineLDLT::waitForBlock(int block)
+{
+#ifdef _THREADS
+    pthread_mutex_lock(&theMutex);
+    while (blockDone[block] == 0 && result == 0)
+	pthread_cond_wait(&doneCond, &theMutex);
+    int res = result;
+    pthread_mutex_unlock(&theMutex);
+    return res;
+#else
+    // blocks are done in order by the one thread
+    return result;
+#endif
+}
+
+
+void
+SkylineLDLT::setBlockDone(int block, int res)
+{
+#ifdef _THREADS
+    pthread_mutex_lock(&theMutex);
+#endif
+
+    // keep the first error, a later block must not overwrite it
+    blockDone[block] = 1;
+    if (res < 0 && result == 0)
+	result = res;
+
+#ifdef _THREADS
+    pthread_cond_broadcast(&doneCond);
+    pthread_mutex_unlock(&theMutex);
+#endif
+}
+
+
+int
+SkylineLDLT::factorBlock(int block)
+{
+    int colStart = block*blockSize;
+    int colEnd = colStart + blockSize;
+    if (colEnd > size)
+	colEnd = size;
+
+    // updates from the blocks to the left, in order
+    for (int b=firstBlock[block]; b<block; b++) {
+	if (this->waitForBlock(b) < 0)
+	    return -1;
+
+	int jStart = b*blockSize;
+	int jEnd = jStart + blockSize;
+
+	for (int i=colStart; i<colEnd; i++) {
+	    int rowitop = RowTop[i];
+	    if (rowitop < jEnd)
+		updateColumn(i, (rowitop > jStart) ? rowitop : jStart, jEnd, 
+			     RowTop, topRowPtr);
+	}
+    }
+
+    // now the columns of the block itself
+    for (int i=colStart; i<colEnd; i++) {
+	int rowitop = RowTop[i];
+	updateColumn(i, (rowitop > colStart) ? rowitop : colStart, i, 
+		     RowTop, topRowPtr);
+
+	// form i'th col of [U] and determine [dii]
+	double *ajiPtr = topRowPtr[i];
+	double aii = ajiPtr[i-rowitop];
+	for (int jj=rowitop; jj<i; jj++) {
+	    double aji = *ajiPtr;
+	    double lij = aji * invD[jj];
+	    *ajiPtr++ = lij;
+	    aii = aii - lij*aji;
+	}
+
+	// check that the diag > the tolerance specified
+	if (aii == 0.0) {
+	    opserr << "SkylineLDLT::factor() - ";
+	    opserr << " aii < 0 (i, aii): (" << i << ", " << aii << ")\n"; 
+	    return -2;
+	}
+	if (fabs(aii) <= minDiagTol) {
+	    opserr << "SkylineLDLT::factor() - ";
+	    opserr << " aii < minDiagTol (i, aii): (" << i;
+	    opserr << ", " << aii << ")\n"; 
+	    return -2;
+	}		
+	invD[i] = 1.0/aii; 
+    }
+
+    return 0;
+}
+
+
+void
+SkylineLDLT::forwardBlock(int block)
+{
+    int colStart = block*blockSize;
+    int colEnd = colStart + blockSize;
+    if (colEnd > size)
+	colEnd = size;
+
+    for (int b=firstBlock[block]; b<=block; b++) {
+	if (b < block && this->waitForBlock(b) < 0)
+	    return;
+
+	int jStart = b*blockSize;
+	int jEnd = jStart + blockSize;
+
+	for (int i=colStart; i<colEnd; i++) {
+	    int rowitop = RowTop[i];
+	    int j = (rowitop > jStart) ? rowitop : jStart;
+	    int last = (jEnd < i) ? jEnd : i;
+	    double *ajiPtr = topRowPtr[i] + (j - rowitop);
+	    double tmp = 0.0;
+
+	    for (; j<last; j++)
+		tmp -= *ajiPtr++ * X[j];
+
+	    X[i] += tmp;
+	}
+    }
+}
+
+
+void
+SkylineLDLT::backBlock(int block)
+{
+    int rowStart = block*blockSize;
+    int rowEnd = rowStart + blockSize;
+    if (rowEnd > size)
+	rowEnd = size;
+
+    // divide by diag term 
+    for (int j=rowStart; j<rowEnd; j++)
+	X[j] *= invD[j];
+
+    // gather the terms of the columns to the right reaching these rows,
+    // from the last one as those blocks are done first
+    int blockWaited = numBlocks;
+    for (int k=lastColumn[block]; k>=rowEnd; k--) {
+	int rowktop = RowTop[k];
+	if (rowktop >= rowEnd)
+	    continue;
+
+	int b = k/blockSize;
+	if (b != blockWaited) {
+	    if (this->waitForBlock(b) < 0)
+		return;
+	    blockWaited = b;
+	}
+
+	int j = (rowktop > rowStart) ? rowktop : rowStart;
+	double *ajkPtr = topRowPtr[k] + (j - rowktop);
+	double bk = X[k];
+	for (; j<rowEnd; j++)
+	    X[j] -= *ajkPtr++ * bk;
+    }
+
+    // now the back substitution within the block
+    for (int k=rowEnd-1; k>rowStart; k--) {
+	int rowktop = RowTop[k];
+	int j = (rowktop > rowStart) ? rowktop : rowStart;
+	double *ajkPtr = topRowPtr[k] + (j - rowktop);
+	double bk = X[k];
+	for (; j<k; j++)
+	    X[j] -= *ajkPtr++ * bk;
+    }
+}
@@ -0,0 +1,115 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/system_of_eqn/linearSOE/SkylineLDLT.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for SkylineLDLT.
+// A SkylineLDLT factors a symmetric matrix stored by columns in a
+// skyline, i.e. column j holds the rows RowTop[j] through j with
+// topRowPtr[j] pointing at row RowTop[j], into L D L^t in place and
+// solves with the factors. The layout is the one set up by the
+// ProfileSPD solvers; a symmetric band matrix in LAPACK upper storage
+// fits it as well, which is how the BandSPD thread solver uses it.
+//
+// The columns are split into blocks of blockSize columns. Each thread
+// of a ThreadPool claims the next block in order and, for every block
+// to the left that the profile of its columns reaches, waits until that
+// block is done before applying its updates; the columns of the block
+// itself are then finished in order. As blocks are claimed in order and
+// only depend on blocks claimed before them, the scheme cannot deadlock.
+// The updates of a column are summed block by block in the same order
+// for any number of threads, so the factors do not depend on the number
+// of threads; they can however differ in the last digits from those of
+// the unblocked ProfileSPD solvers, which sum in another order. The forward
+// substitution uses the same scheme, the back substitution runs it from
+// the last block to the first with each block gathering the terms of
+// the columns to its right.
+//
+// What: "@(#) SkylineLDLT.h, revA"
+
+#ifndef SkylineLDLT_h
+#define SkylineLDLT_h
+
+#include <ThreadPool.h>
+
+class SkylineLDLT
+{
+  public:
+    SkylineLDLT(int numThreads = 1, int blockSize = 64, double tol = 1.0e-12);
+    ~SkylineLDLT();
+
+    // RowTop, topRowPtr and invD are owned by the caller and must stay
+    // valid until the next call to setSize()
+    int setSize(int size, int *RowTop, double **topRowPtr, double *invD);
+
+    // returns -2 if a diagonal term is smaller than the tolerance
+    int factor(void);
+    int solve(double *X);
+
+    int getNumThreads(void) const;
+    int getBlockSize(void) const;
+
+  protected:
+
+  private:
+    static void factorTask(int start, int end, int threadID, void *data);
+    static void forwardTask(int start, int end, int threadID, void *data);
+    static void backTask(int start, int end, int threadID, void *data);
+
+    void run(ThreadPoolFunction theFunction);
+    int nextBlock(void);
+    int waitForBlock(int block);
+    void setBlockDone(int block, int res);
+
+    int factorBlock(int block);
+    void forwardBlock(int block);
+    void backBlock(int block);
+
+    ThreadPool *theThreadPool;
+    int numThreads;
+    int blockSize;
+    double minDiagTol;
+
+    int size;
+    int *RowTop;
+    double **topRowPtr;
+    double *invD;
+    double *X;
+
+    // first block reached by the profile of the columns of each block and
+    // last column whose profile reaches into the rows of each block
+    int numBlocks;
+    int *firstBlock;
+    int *lastColumn;
+
+    // state of the current phase
+    char *blockDone;
+    int blocksClaimed;
+    int result;
+
+#ifdef _THREADS
+    pthread_mutex_t theMutex;
+    pthread_cond_t doneCond;
+#endif
+};
+
+#endif
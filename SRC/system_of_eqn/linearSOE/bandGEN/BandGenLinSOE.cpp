@@ -355,6 +355,12 @@ BandGenLinSOE::addB(const Vector &v, const ID &id, double fact)
 }
 
 
+bool
+BandGenLinSOE::isThreadSafe(void)
+{
+    return true;
+}
+
 int
 BandGenLinSOE::setB(const Vector &v, double fact)
 {
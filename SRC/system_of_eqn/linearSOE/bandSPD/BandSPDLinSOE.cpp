@@ -328,6 +328,12 @@ BandSPDLinSOE::addB(const Vector &v, const ID &id, double fact)
     return 0;
 }
 
+bool
+BandSPDLinSOE::isThreadSafe(void)
+{
+    return true;
+}
+
 int
 BandSPDLinSOE::setB(const Vector &v, double fact)
 {
@@ -31,7 +31,9 @@
 //
 // Description: This file contains the class definition for 
 // BandSPDLinThreadSolver. It solves the BandSPDLinSOE in parallel
-// using solaris threads.
+// using threads. The band, stored in the LAPACK upper scheme, is viewed
+// as a profile with column j starting at row max(0, j-kd), and factored
+// into L D L^t in place by a SkylineLDLT.
 //
 // What: "@(#) BandSPDLinThreadSolver.h, revA"
 
@@ -39,26 +41,33 @@
 #define BandSPDLinThreadSolver_h
 
 #include <BandSPDLinSolver.h>
+class SkylineLDLT;
 
 class BandSPDLinThreadSolver : public BandSPDLinSolver
 {
   public:
     BandSPDLinThreadSolver();    
-    BandSPDLinThreadSolver(int numProcessors, int blockSize);        
+    BandSPDLinThreadSolver(int numProcessors, int blockSize, double tol = 1.0e-12);
     ~BandSPDLinThreadSolver();
 
     int solve(void);
     int setSize(void);
     
-    int sendSelf(Channel &theChannel, FEM_ObjectBroker &theBroker);
-    int recvSelf(Channel &theChannel, FEM_ObjectBroker &theBroker);    
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel, 
+		 FEM_ObjectBroker &theBroker);
     
   protected:
 
   private:
     int NP;
-    int running;
     int blockSize;
+    double minDiagTol;
+
+    int size;
+    int *RowTop;
+    double **topRowPtr, *invD;
+    SkylineLDLT *theFactor;
 };
 
 #endif
@@ -250,6 +250,12 @@ DiagonalSOE::addB(const Vector &v, const ID &id, double fact)
 }
 
 
+bool
+DiagonalSOE::isThreadSafe(void)
+{
+    return true;
+}
+
 int
 DiagonalSOE::setB(const Vector &v, double fact)
 {
@@ -51,6 +51,7 @@ class DiagonalSOE : public LinearSOE
     int setSize(Graph &theGraph);
     int addA(const Matrix &, const ID &, double fact = 1.0);
     int addB(const Vector &, const ID &, double fact = 1.0);    
+    bool isThreadSafe(void);
     int setB(const Vector &, double fact = 1.0);        
     
     void zeroA(void);
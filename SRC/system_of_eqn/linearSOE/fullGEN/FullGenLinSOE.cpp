@@ -291,6 +291,12 @@ FullGenLinSOE::addB(const Vector &v, const ID &id, double fact)
 
 
 
+bool
+FullGenLinSOE::isThreadSafe(void)
+{
+    return true;
+}
+
 int
 FullGenLinSOE::setB(const Vector &v, double fact)
 {
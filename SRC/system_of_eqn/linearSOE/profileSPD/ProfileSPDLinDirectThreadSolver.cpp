@@ -33,72 +33,36 @@
 // ProfileSPDLinDirectThreadSolver. ProfileSPDLinDirectThreadSolver will solve
 // a linear system of equations stored using the profile scheme using threads.
 // It solves a ProfileSPDLinSOE object using the LDL^t factorization and a block approach.
+//
+// Modified: 10/26 the solaris threads have been replaced by a SkylineLDLT,
+// which runs the block factorization and the substitutions on a ThreadPool.
 
 // What: "@(#) ProfileSPDLinDirectThreadSolver.C, revA"
 
 #include <ProfileSPDLinDirectThreadSolver.h>
 #include <ProfileSPDLinSOE.h>
-#include <math.h>
+#include <SkylineLDLT.h>
+#include <stdlib.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 
-#define _REENTRANT    /* basic 3-lines for threads */
-// #include <pthread.h>
-#include <thread.h>
-
-#include <Timer.h>
-
-
-// global data that will be needed by the threads
-struct thread_control_block {
-  mutex_t start_mutex;
-  mutex_t end_mutex;
-  mutex_t startBlock_mutex;
-  mutex_t endBlock_mutex;
-
-  cond_t start_cond;
-  cond_t end_cond;
-  cond_t startBlock_cond;
-  cond_t endBlock_cond;
-
-  double *A,*X,*B;
-  int *iDiagLoc;
-  int size;
-  int blockSize;
-  int  maxColHeight;
-  double minDiagTol;
-  int *RowTop;
-  double **topRowPtr, *invD;
-
-  int currentBlock;
-  int workToDo;
-  int info;
-  int threadID;
-  int numThreads;
-  int threadsDone;
-  int threadsDoneBlock;
-} TCB_ProfileSPDDirectThreadSolver;
-
-
-void *ProfileSPDLinDirectThreadSolver_Worker(void *arg);
-
 ProfileSPDLinDirectThreadSolver::ProfileSPDLinDirectThreadSolver()
 :ProfileSPDLinSolver(SOLVER_TAGS_ProfileSPDLinDirectThreadSolver),
- NP(2), running(false),
- minDiagTol(1.0e-12), blockSize(4), maxColHeight(0), 
- size(0), RowTop(0), topRowPtr(0), invD(0)
+ NP(1), minDiagTol(1.0e-12), blockSize(64), 
+ size(0), RowTop(0), topRowPtr(0), invD(0), theFactor(0)
 {
-
+    theFactor = new SkylineLDLT(NP, blockSize, minDiagTol);
 }
 
 ProfileSPDLinDirectThreadSolver::ProfileSPDLinDirectThreadSolver
          (int numProcessors, int blckSize, double tol) 
 :ProfileSPDLinSolver(SOLVER_TAGS_ProfileSPDLinDirectThreadSolver),
- NP(numProcessors), running(false),
- minDiagTol(tol), blockSize(blckSize), maxColHeight(0), 
- size(0), RowTop(0), topRowPtr(0), invD(0)
+ NP(numProcessors), minDiagTol(tol), blockSize(blckSize), 
+ size(0), RowTop(0), topRowPtr(0), invD(0), theFactor(0)
 {
-
+    theFactor = new SkylineLDLT(NP, blockSize, minDiagTol);
+    NP = theFactor->getNumThreads();
+    blockSize = theFactor->getBlockSize();
 }
 
     
@@ -107,6 +71,7 @@ ProfileSPDLinDirectThreadSolver::~ProfileSPDLinDirectThreadSolver()
     if (RowTop != 0) delete [] RowTop;
     if (topRowPtr != 0) free((void *)topRowPtr);
     if (invD != 0) delete [] invD;
+    if (theFactor != 0) delete theFactor;
 }
 
 int
@@ -121,11 +86,12 @@ ProfileSPDLinDirectThreadSolver::setSize(void)
     // check for quick return 
     if (theSOE->size == 0)
 	return 0;
+
     if (size != theSOE->size) {    
       size = theSOE->size;
     
       if (RowTop != 0) delete [] RowTop;
-      if (topRowPtr != 0) delete [] topRowPtr;
+      if (topRowPtr != 0) free((void *)topRowPtr);
       if (invD != 0) delete [] invD;
 
       RowTop = new int[size];
@@ -142,25 +108,20 @@ ProfileSPDLinDirectThreadSolver::setSize(void)
       }
     }
 
-
     // set some pointers
     double *A = theSOE->A;
     int *iDiagLoc = theSOE->iDiagLoc;
 
     // set RowTop and topRowPtr info
-
-    maxColHeight = 0;
     RowTop[0] = 0;
     topRowPtr[0] = A;
     for (int j=1; j<size; j++) {
 	int icolsz = iDiagLoc[j] - iDiagLoc[j-1];
-        if (icolsz > maxColHeight) maxColHeight = icolsz;
 	RowTop[j] = j - icolsz +  1;
 	topRowPtr[j] = &A[iDiagLoc[j-1]]; // FORTRAN array indexing in iDiagLoc
     }
 
-    size = theSOE->size;
-    return 0;
+    return theFactor->setSize(size, RowTop, topRowPtr, invD);
 }
 
 
@@ -177,137 +138,43 @@ ProfileSPDLinDirectThreadSolver::solve(void)
     if (theSOE->size == 0)
 	return 0;
 
-    // set some pointers
-    double *A = theSOE->A;
+    // copy B into X
     double *B = theSOE->B;
     double *X = theSOE->X;
-    int *iDiagLoc = theSOE->iDiagLoc;
-    int size = theSOE->size;
-
-    // copy B into X
-    for (int ii=0; ii<size; ii++)
+    int theSize = theSOE->size;
+    for (int ii=0; ii<theSize; ii++)
 	X[ii] = B[ii];
-    
-    if (theSOE->isAfactored == false)  {
-      // start threads running
-      if (running == false) {
-	mutex_init(&TCB_ProfileSPDDirectThreadSolver.start_mutex, USYNC_THREAD, 0);
-	mutex_init(&TCB_ProfileSPDDirectThreadSolver.end_mutex, USYNC_THREAD, 0);
-	mutex_init(&TCB_ProfileSPDDirectThreadSolver.startBlock_mutex, USYNC_THREAD, 0);
-	mutex_init(&TCB_ProfileSPDDirectThreadSolver.endBlock_mutex, USYNC_THREAD, 0);
-	cond_init(&TCB_ProfileSPDDirectThreadSolver.start_cond, USYNC_THREAD, 0);
-	cond_init(&TCB_ProfileSPDDirectThreadSolver.end_cond, USYNC_THREAD, 0);
-	cond_init(&TCB_ProfileSPDDirectThreadSolver.startBlock_cond, USYNC_THREAD, 0);
-	cond_init(&TCB_ProfileSPDDirectThreadSolver.endBlock_cond, USYNC_THREAD, 0);
-	TCB_ProfileSPDDirectThreadSolver.workToDo = 0;
 
-        
-	// Create the threads - Bound daemon threads
-	for (int j = 0; j < NP; j++) 
-	  thr_create(NULL,0, ProfileSPDLinDirectThreadSolver_Worker, 
-		     NULL, THR_BOUND|THR_DAEMON, NULL);
-
-        running = true;
-      }
-      
-  
-      mutex_lock(&TCB_ProfileSPDDirectThreadSolver.start_mutex); 
-
-	invD[0] = 1.0/A[0];	
-
-        // assign the global variables the threads will need
-        TCB_ProfileSPDDirectThreadSolver.A = A;
-	TCB_ProfileSPDDirectThreadSolver.X = X;
-	TCB_ProfileSPDDirectThreadSolver.B = B;
-	TCB_ProfileSPDDirectThreadSolver.size = size;
-	TCB_ProfileSPDDirectThreadSolver.minDiagTol = minDiagTol;
-	TCB_ProfileSPDDirectThreadSolver.maxColHeight = maxColHeight;
-	TCB_ProfileSPDDirectThreadSolver.RowTop = RowTop;
-	TCB_ProfileSPDDirectThreadSolver.topRowPtr = topRowPtr;
-	TCB_ProfileSPDDirectThreadSolver.invD = invD;
-        TCB_ProfileSPDDirectThreadSolver.blockSize = blockSize;
-        TCB_ProfileSPDDirectThreadSolver.iDiagLoc = iDiagLoc;
-	
-	TCB_ProfileSPDDirectThreadSolver.info = 0;
-        TCB_ProfileSPDDirectThreadSolver.workToDo = NP;
-        TCB_ProfileSPDDirectThreadSolver.currentBlock = -1;
-	TCB_ProfileSPDDirectThreadSolver.threadID = 0;
-	TCB_ProfileSPDDirectThreadSolver.numThreads = NP;
-        TCB_ProfileSPDDirectThreadSolver.threadsDone = 0;
-        TCB_ProfileSPDDirectThreadSolver.threadsDoneBlock = NP;
-
-        // wake up the threads
-        cond_broadcast(&TCB_ProfileSPDDirectThreadSolver.start_cond);
-      mutex_unlock(&TCB_ProfileSPDDirectThreadSolver.start_mutex); 
-
-      // yield the LWP
-      thr_yield();
- 
-      // wait for all the threads to finish
-      mutex_lock(&TCB_ProfileSPDDirectThreadSolver.end_mutex);
-
-         while (TCB_ProfileSPDDirectThreadSolver.threadsDone < NP) 
-           cond_wait(&TCB_ProfileSPDDirectThreadSolver.end_cond, &TCB_ProfileSPDDirectThreadSolver.end_mutex);
-
-      mutex_unlock(&TCB_ProfileSPDDirectThreadSolver.end_mutex);
-
-
-      theSOE->isAfactored = true;
-	
-      // divide by diag term 
-      double *bjPtr = X; 
-      double *aiiPtr = invD;
-      for (int j=0; j<size; j++) 
-	*bjPtr++ = *aiiPtr++ * X[j];
+    // if the matrix has not been factored already factor it into U^t D U
+    // storing D^-1 in invD
+    if (theSOE->isAfactored == false)  {
+	int res = theFactor->factor();
+	if (res < 0) {
+	    opserr << "ProfileSPDLinDirectThreadSolver::solve(void): ";
+	    opserr << " - factorization failed\n";
+	    return res;
+	}
 
-    
-      // now do the back substitution storing result in X
-      for (int k=(size-1); k>0; k--) {
-      
-	int rowktop = RowTop[k];
-	double bk = X[k];
-	double *ajiPtr = topRowPtr[k]; 		
-      
-	for (int j=rowktop; j<k; j++) 
-	  X[j] -= *ajiPtr++ * bk;
-      }   	 
-    } else { // just do forward and back substitution
-      
-      // do forward substitution 
-      for (int i=1; i<size; i++) {
-	    
-	int rowitop = RowTop[i];	    
-	double *ajiPtr = topRowPtr[i];
-	double *bjPtr  = &X[rowitop];  
-	double tmp = 0;	    
-	    
-	for (int j=rowitop; j<i; j++) 
-	  tmp -= *ajiPtr++ * *bjPtr++; 
-	    
-	X[i] += tmp;
-      }
+	theSOE->isAfactored = true;
+	theSOE->numInt = 0;
+    }
 
-      // divide by diag term 
-      double *bjPtr = X; 
-      double *aiiPtr = invD;
-      for (int j=0; j<size; j++) 
-	*bjPtr++ = *aiiPtr++ * X[j];
+    return theFactor->solve(X);
+}
 
-    
-      // now do the back substitution storing result in X
-      for (int k=(size-1); k>0; k--) {
-      
-	int rowktop = RowTop[k];
-	double bk = X[k];
-	double *ajiPtr = topRowPtr[k]; 		
 
-	for (int j=rowktop; j<k; j++) 
-	  X[j] -= *ajiPtr++ * bk;
-      }   	 
-    }    
-    return 0;
+double
+ProfileSPDLinDirectThreadSolver::getDeterminant(void) 
+{
+   int theSize = theSOE->size;
+   double determinant = 1.0;
+   for (int i=0; i<theSize; i++)
+     determinant *= invD[i];
+   determinant = 1.0/determinant;
+   return determinant;
 }
 
+
 int 
 ProfileSPDLinDirectThreadSolver::setProfileSOE(ProfileSPDLinSOE &theNewSOE)
 {
@@ -321,12 +188,11 @@ ProfileSPDLinDirectThreadSolver::setProfileSOE(ProfileSPDLinSOE &theNewSOE)
     return 0;
 }
 	
+
 int
 ProfileSPDLinDirectThreadSolver::sendSelf(int cTag,
 					  Channel &theChannel)
 {
-    if (size != 0)
-	opserr << "ProfileSPDLinDirectThreadSolver::sendSelf - does not send itself YET\n"; 
     return 0;
 }
 
@@ -338,272 +204,3 @@ ProfileSPDLinDirectThreadSolver::recvSelf(int cTag,
 {
     return 0;
 }
-
-
-
-void *ProfileSPDLinDirectThreadSolver_Worker(void *arg)
-{
-  // Do this loop forever - or until all the Non-Daemon threads have exited
-  while(true)
-    {
-
-      // Wait for some work to do
-      mutex_lock(&TCB_ProfileSPDDirectThreadSolver.start_mutex);
-
-        while (TCB_ProfileSPDDirectThreadSolver.workToDo == 0)
-          cond_wait(&TCB_ProfileSPDDirectThreadSolver.start_cond, &TCB_ProfileSPDDirectThreadSolver.start_mutex);
-
-        TCB_ProfileSPDDirectThreadSolver.workToDo--;
-
-        // get an id;
-	int myID = TCB_ProfileSPDDirectThreadSolver.threadID++;
-
-      mutex_unlock(&TCB_ProfileSPDDirectThreadSolver.start_mutex);
-
-      // do some initialisation for the factorization
-      double *A = TCB_ProfileSPDDirectThreadSolver.A;
-      double *B = TCB_ProfileSPDDirectThreadSolver.B;
-      double *X = TCB_ProfileSPDDirectThreadSolver.X;
-      int *iDiagLoc = TCB_ProfileSPDDirectThreadSolver.iDiagLoc;
-      int size = TCB_ProfileSPDDirectThreadSolver.size;
-      double minDiagTol = TCB_ProfileSPDDirectThreadSolver.minDiagTol;
-      int maxColHeight = TCB_ProfileSPDDirectThreadSolver.maxColHeight;
-      int *RowTop = TCB_ProfileSPDDirectThreadSolver.RowTop;
-      double **topRowPtr = TCB_ProfileSPDDirectThreadSolver.topRowPtr;
-      double *invD = TCB_ProfileSPDDirectThreadSolver.invD;
-      int blockSize = TCB_ProfileSPDDirectThreadSolver.blockSize;
-
-      int currentBlock =0;
-      int numThreads = TCB_ProfileSPDDirectThreadSolver.numThreads;
-
-
-      // FACTOR 
-      int startRow = 0;
-      int lastRow = startRow+blockSize-1;
-      int lastColEffected = lastRow+maxColHeight -1;
-      int nBlck = size/blockSize;
-      if ((size % blockSize) != 0)
-	nBlck++;
-
-      // for every block across      
-      for (int i=0; i<nBlck; i++) {
-
-        int currentDiagThread = i%numThreads;
-        if (myID == currentDiagThread) {
-
-	  // first factor the diagonal block int Ui,i and Di
-          int j;
-	  for (j=0; j<blockSize; j++) {
-            int currentRow = startRow + j;
-
-	    if (currentRow < size) { // this is for case when size%blockSize != 0
-
-	      int rowjTop = RowTop[currentRow];
-	      //	      double *akjPtr = &A[iDiagLoc[currentRow-1]];
-	      double *akjPtr = topRowPtr[currentRow];
-	      int maxRowijTop;
-	      if (rowjTop < startRow) {
-		akjPtr += startRow-rowjTop; // pointer to start of block row
-		maxRowijTop = startRow;
-	      } else
-		maxRowijTop = rowjTop;
-
-	      int k;
-	      for (k=maxRowijTop; k<currentRow; k++) {
-		double tmp = *akjPtr;
-		int rowkTop = RowTop[k];
-		int maxRowkjTop;
-		double *alkPtr, *aljPtr;
-		if (rowkTop < rowjTop) {
-		  alkPtr = topRowPtr[k] + (rowjTop - rowkTop);
-		  aljPtr = topRowPtr[currentRow];
-		  maxRowkjTop = rowjTop;
-		} else {
-		  alkPtr = topRowPtr[k];
-		  aljPtr = topRowPtr[currentRow] + (rowkTop - rowjTop);
-		  maxRowkjTop = rowkTop;
-		}
-
-		for (int l = maxRowkjTop; l<k; l++) 
-		  tmp -= *alkPtr++ * *aljPtr++;
-		
-		*akjPtr++ = tmp;
-	      }
-
-	      double ajj = *akjPtr;
-	      akjPtr = topRowPtr[currentRow];
-	      //	      akjPtr = &A[iDiagLoc[currentRow-1]];
-	      double *bjPtr  = &X[rowjTop];  
-	      double tmp = 0;	    
-
-	      for (k=rowjTop; k<currentRow; k++){
-		double akj = *akjPtr;
-		double lkj = akj * invD[k];
-		tmp -= lkj * *bjPtr++; 		
-		*akjPtr++ = lkj;
-		ajj = ajj -lkj * akj;
-	      }
-
-	      X[currentRow] += tmp;
-
-	      // check that the diag > the tolerance specified
-	      if (ajj <= 0.0) {
-		opserr << "ProfileSPDLinDirectThreadSolver::solve() - ";
-		opserr << " aii < 0 (i, aii): (" << currentRow << ", " << ajj << ")\n"; 
-		TCB_ProfileSPDDirectThreadSolver.info = -2;
-		return NULL;
-	      }
-	      if (ajj <= minDiagTol) {
-		opserr << "ProfileSPDLinDirectThreadSolver::solve() - ";
-		opserr << " aii < minDiagTol (i, aii): (" << currentRow;
-		opserr << ", " << ajj << ")\n"; 
-		TCB_ProfileSPDDirectThreadSolver.info = -2;
-		return NULL;
-	      }		
-	      invD[currentRow] = 1.0/ajj; 
-
-	    } else 
-	      j = blockSize;
-
-	  }
-
-          // allow other threads to now proceed
-          mutex_lock(&TCB_ProfileSPDDirectThreadSolver.startBlock_mutex);
-	    TCB_ProfileSPDDirectThreadSolver.currentBlock = i;
-
-            cond_broadcast(&TCB_ProfileSPDDirectThreadSolver.startBlock_cond);
-          mutex_unlock(&TCB_ProfileSPDDirectThreadSolver.startBlock_mutex);        
-
-
-	  // now do rest of i'th block row belonging to thread
-	  // doing a block of columns at a time forming Ui,j*Di
-	  int currentCol = startRow + blockSize;
-	  for (j=i+1; j<nBlck; j++) {
-
-	    if (j%numThreads == myID) {
-
-	      for (int k=0; k<blockSize; k++) {
-
-		if (currentCol < size) { // this is for case when size%blockSize != 0
-
-		  int rowkTop = RowTop[currentCol];
-		  double *alkPtr = topRowPtr[currentCol];
-		  // double *alkPtr = &A[iDiagLoc[currentCol-1]];
-		  int maxRowikTop;
-		  if (rowkTop < startRow) {
-		    alkPtr += startRow-rowkTop; // pointer to start of block row
-		    maxRowikTop = startRow;
-		  } else
-		    maxRowikTop = rowkTop;
-
-		  for (int l=maxRowikTop; l<=lastRow; l++) {
-		    double tmp = *alkPtr;
-		    int rowlTop = RowTop[l];
-		    int maxRowklTop;
-		    double *amlPtr, *amkPtr;
-		    if (rowlTop < rowkTop) {
-		      amlPtr = topRowPtr[l] + (rowkTop - rowlTop);
-		      amkPtr = topRowPtr[currentCol];
-		      maxRowklTop = rowkTop;
-		    } else {
-		      amlPtr = topRowPtr[l];
-		      amkPtr = topRowPtr[currentCol] + (rowlTop - rowkTop);
-		      maxRowklTop = rowlTop;
-		    }
-		  
-		    for (int m = maxRowklTop; m<l; m++) 
-		      tmp -= *amkPtr++ * *amlPtr++;
-		  
-		    *alkPtr++ = tmp;
-		  }
-		  currentCol++;
-		  if (currentCol > lastColEffected) {
-		    k = blockSize;
-		    j = nBlck;
-		  }
-		  
-		} else
-		  k = blockSize;
-	      }
-	    } else
-	      currentCol += blockSize;
-	  }
-	} else {
-          // wait till diag i is done 
-          mutex_lock(&TCB_ProfileSPDDirectThreadSolver.startBlock_mutex);
-             while (TCB_ProfileSPDDirectThreadSolver.currentBlock < i)
-                cond_wait(&TCB_ProfileSPDDirectThreadSolver.startBlock_cond, &TCB_ProfileSPDDirectThreadSolver.startBlock_mutex);
-          mutex_unlock(&TCB_ProfileSPDDirectThreadSolver.startBlock_mutex);
-
-          // FACTOR REST OF BLOCK ROW BELONGING TO THREAD
-	  // now do rest of i'th block row belonging to thread
-	  // doing a block of columns at a time forming Ui,j*Di
-	  int currentCol = startRow + blockSize;
-	  for (int j=i+1; j<nBlck; j++) {
-
-	    if (j%numThreads == myID) {
-
-	      for (int k=0; k<blockSize; k++) {
-
-		if (currentCol < size) { // this is for case when size%blockSize != 0
-
-		  int rowkTop = RowTop[currentCol];
-		  double *alkPtr = topRowPtr[currentCol];
-		  // double *alkPtr = &A[iDiagLoc[currentCol-1]];
-		  int maxRowikTop;
-		  if (rowkTop < startRow) {
-		    alkPtr += startRow-rowkTop; // pointer to start of block row
-		    maxRowikTop = startRow;
-		  } else
-		    maxRowikTop = rowkTop;
-
-		  for (int l=maxRowikTop; l<=lastRow; l++) {
-		    double tmp = *alkPtr;
-		    int rowlTop = RowTop[l];
-		    int maxRowklTop;
-		    double *amlPtr, *amkPtr;
-		    if (rowlTop < rowkTop) {
-		      amlPtr = topRowPtr[l] + (rowkTop - rowlTop);
-		      amkPtr = topRowPtr[currentCol];
-		      maxRowklTop = rowkTop;
-		    } else {
-		      amlPtr = topRowPtr[l];
-		      amkPtr = topRowPtr[currentCol] + (rowlTop - rowkTop);
-		      maxRowklTop = rowlTop;
-		    } 
-
-		    for (int m = maxRowklTop; m<l; m++) 
-		      tmp -= *amkPtr++ * *amlPtr++;
-		  
-		    *alkPtr++ = tmp;
-		  }
-		  currentCol++;
-		  if (currentCol > lastColEffected) {
-		    k = blockSize;
-		    j = nBlck;
-		  }
-		  
-		} else
-		  k = blockSize;
-	      }
-	    } else
-	      currentCol += blockSize;
-	  
-	  }
-
-	}
-
-	// update the data for the next block
-	startRow += blockSize;
-	lastRow = startRow + blockSize -1;
-	lastColEffected = lastRow + maxColHeight -1;
-      }
-
-      // signal the main thread that this thread is done with the work
-      mutex_lock(&TCB_ProfileSPDDirectThreadSolver.end_mutex);
-         TCB_ProfileSPDDirectThreadSolver.threadsDone++;
-
-         cond_signal(&TCB_ProfileSPDDirectThreadSolver.end_cond);
-      mutex_unlock(&TCB_ProfileSPDDirectThreadSolver.end_mutex);
-    } 
-}
@@ -32,7 +32,8 @@
 // Description: This file contains the class definition for 
 // ProfileSPDLinDirectThreadSolver. ProfileSPDLinDirectThreadSolver is a subclass 
 // of LinearSOESOlver. It solves a ProfileSPDLinSOE object using
-// the LDL^t factorization.
+// the LDL^t factorization, the columns being factored in blocks by a
+// number of threads.
 
 // What: "@(#) ProfileSPDLinDirectThreadSolver.h, revA"
 
@@ -41,6 +42,7 @@
 
 #include <ProfileSPDLinSolver.h>
 class ProfileSPDLinSOE;
+class SkylineLDLT;
 
 class ProfileSPDLinDirectThreadSolver : public ProfileSPDLinSolver
 {
@@ -51,6 +53,7 @@ class ProfileSPDLinDirectThreadSolver : public ProfileSPDLinSolver
 
     virtual int solve(void);        
     virtual int setSize(void);    
+    double getDeterminant(void);
 
     virtual int setProfileSOE(ProfileSPDLinSOE &theSOE);
 
@@ -60,16 +63,15 @@ class ProfileSPDLinDirectThreadSolver : public ProfileSPDLinSolver
 
   protected:
     int NP;
-    int running;
     
     double minDiagTol;
     int blockSize;
-    int maxColHeight;
     int size;
     int *RowTop;
     double **topRowPtr, *invD;
     
   private:
+    SkylineLDLT *theFactor;
 
 };
 
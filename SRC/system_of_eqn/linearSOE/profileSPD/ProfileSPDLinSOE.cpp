@@ -387,6 +387,12 @@ ProfileSPDLinSOE::addB(const Vector &v, const ID &id, double fact)
 }
 
 
+bool
+ProfileSPDLinSOE::isThreadSafe(void)
+{
+    return true;
+}
+
 int
 ProfileSPDLinSOE::setB(const Vector &v, double fact)
 {
@@ -53,6 +53,7 @@ class ProfileSPDLinSOE : public LinearSOE
     virtual int setSize(Graph &theGraph);
     virtual int addA(const Matrix &, const ID &, double fact = 1.0);
     virtual int addB(const Vector &, const ID &, double fact = 1.0);    
+    virtual bool isThreadSafe(void);
     virtual int setB(const Vector &, double fact = 1.0);
     
     virtual void zeroA(void);
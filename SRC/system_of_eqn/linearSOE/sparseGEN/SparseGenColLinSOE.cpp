@@ -166,6 +166,9 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
     int oldSize = size;
     size = theGraph.getNumVertex();
 
+    // the locations of the entries of A change with the new graph
+    theScatterMap.clear();
+
     // fist itearte through the vertices of the graph to get nnz
     Vertex *theVertex;
     int newNNZ = 0;
@@ -318,7 +321,11 @@ SparseGenColLinSOE::addA(const Matrix &m, const ID &id, double fact)
 	return -1;
     }
     
-    if (fact == 1.0) { // do not need to multiply 
+    // get the locations in A of the entries of m, finding them with rowA
+    // only the first time this ID is assembled after setSize()
+    double **theLocs = theScatterMap.getLocations(id);
+    if (theLocs == 0) {
+      theLocs = theScatterMap.newLocations(id);
       for (int i=0; i<idSize; i++) {
 	int col = id(i);
 	if (col < size && col >= 0) {
@@ -330,31 +337,28 @@ SparseGenColLinSOE::addA(const Matrix &m, const ID &id, double fact)
 	      // find place in A using rowA
 	      for (int k=startColLoc; k<endColLoc; k++)
 		if (rowA[k] == row) {
-		  A[k] += m(j,i);
+		  theLocs[i*idSize+j] = &A[k];
 		  k = endColLoc;
 		}
 	    }
 	  }  // for j		
 	} 
       }  // for i
+    }
+
+    if (fact == 1.0) { // do not need to multiply 
+      for (int i=0; i<idSize; i++) {
+	double **colLocs = &theLocs[i*idSize];
+	for (int j=0; j<idSize; j++)
+	  if (colLocs[j] != 0)
+	    *colLocs[j] += m(j,i);
+      }  // for i
     } else {
       for (int i=0; i<idSize; i++) {
-	int col = id(i);
-	if (col < size && col >= 0) {
-	  int startColLoc = colStartA[col];
-	  int endColLoc = colStartA[col+1];
-	  for (int j=0; j<idSize; j++) {
-	    int row = id(j);
-	    if (row <size && row >= 0) {
-	      // find place in A using rowA
-	      for (int k=startColLoc; k<endColLoc; k++)
-		if (rowA[k] == row) {
-		  A[k] += fact * m(j,i);
-		  k = endColLoc;
-		}
-	    }
-	  }  // for j		
-	} 
+	double **colLocs = &theLocs[i*idSize];
+	for (int j=0; j<idSize; j++)
+	  if (colLocs[j] != 0)
+	    *colLocs[j] += fact * m(j,i);
       }  // for i
     }
     return 0;
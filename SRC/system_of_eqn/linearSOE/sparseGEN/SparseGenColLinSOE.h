@@ -38,6 +38,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <ScatterMap.h>
 
 class SparseGenColLinSolver;
 
@@ -97,6 +98,7 @@ class SparseGenColLinSOE : public LinearSOE
     bool factored;
     
   private:
+    ScatterMap theScatterMap; // locations in A of the entries of each ID
 
 };
 
@@ -38,6 +38,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <ScatterMap.h>
 
 class SparseGenRowLinSolver;
 
@@ -80,6 +81,7 @@ class SparseGenRowLinSOE : public LinearSOE
     Vector *vectB;    
     int Asize, Bsize;    // size of the 1d array holding A
     bool factored;
+    ScatterMap theScatterMap; // locations in A of the entries of each ID
 };
 
 
@@ -124,6 +124,9 @@ int SymSparseLinSOE::setSize(Graph &theGraph)
     int oldSize = size;
     size = theGraph.getNumVertex();
 
+    // the factor storage is reallocated by symFactorization()
+    theScatterMap.clear();
+
     // first itearte through the vertices of the graph to get nnz
     Vertex *theVertex;
     int newNNZ = 0;
@@ -239,6 +242,9 @@ int SymSparseLinSOE::setSize(Graph &theGraph)
 
 
 /* Perform the element stiffness assembly here.
+ * The location in diag, penv or the row segments of each entry of the
+ * upper triangle of in_m is found the first time in_id is assembled after
+ * setSize() and is kept in theScatterMap for later assemblies.
  */
 int SymSparseLinSOE::addA(const Matrix &in_m, const ID &in_id, double fact)
 {
@@ -256,34 +262,53 @@ int SymSparseLinSOE::addA(const Matrix &in_m, const ID &in_id, double fact)
        return -1;
    }
 
-   // construct m and id based on non-negative id values.
+   double **theLocs = theScatterMap.getLocations(in_id);
+   if (theLocs == 0) {
+       theLocs = theScatterMap.newLocations(in_id);
+       if (this->setLocations(in_id, theLocs) < 0)
+	   return -1;
+   }
+
+   // add the upper triangle of in_m, diagonal included
+   for (int ii = 0; ii < idSize; ii++) {
+       double **rowLocs = &theLocs[ii*idSize];
+       for (int jj = ii; jj < idSize; jj++)
+	   if (rowLocs[jj] != 0)
+	       *rowLocs[jj] += in_m(ii, jj) * fact;
+   }
+
+   return 0;
+}
+
+
+/* Find the locations in the factor storage of the entries of an element
+ * matrix with equation numbers in_id. The location of entry (ii,jj),
+ * ii <= jj, of the upper triangle is placed in theLocs[ii*idSize+jj].
+ */
+int SymSparseLinSOE::setLocations(const ID &in_id, double **theLocs)
+{
+   int idSize = in_id.Size();
+
+   // construct id based on non-negative id values, remembering the
+   // position of each in in_id.
    int newPt = 0;
    int *id = new int[idSize];
+   int *oldPos = new int[idSize];
    
    for (int jj = 0; jj < idSize; jj++) {
        if (in_id(jj) >= 0 && in_id(jj) < size) {
 	   id[newPt] = in_id(jj);
+	   oldPos[newPt] = jj;
 	   newPt++;
        }
    }
 
+   int oldIdSize = idSize;
    idSize = newPt;
-   if (idSize == 0)  return 0;
-   double *m = new double[idSize*idSize];
-
-   int newII = 0;
-   for (int ii = 0; ii < in_id.Size(); ii++) {
-       if (in_id(ii) >= 0 && in_id(ii) < size) {
-
-	   int newJJ = 0;
-	   for (int jj = 0; jj < in_id.Size(); jj++) {
-	       if (in_id(jj) >= 0 && in_id(jj) < size) {
-		   m[newII*idSize + newJJ] = in_m(ii, jj);
-		   newJJ++;
-	       }
-	   }
-	   newII++;
-       }
+   if (idSize == 0) {
+       delete [] id;
+       delete [] oldPos;
+       return 0;
    }
 
    // forming the new id based on invp.
@@ -347,7 +372,7 @@ int SymSparseLinSOE::addA(const Matrix &in_m, const ID &in_id, double fact)
       k = rowblks[newID[ipos]] ;
       saveblk  = begblk[k] ;
 
-      /* iterate through the element stiffness matrix, assemble each entry */
+      /* iterate through the element stiffness matrix, locate each entry */
       for (i=0; i<lnee; i++)
       { 
 	 ipos = isort[i] ;
@@ -374,22 +399,22 @@ int SymSparseLinSOE::addA(const Matrix &in_m, const ID &in_id, double fact)
 	    if (j_eq >= xblk[iblk]) /* diagonal block (profile) */
 	    {  
 	        loc = iloc + j_eq ;
-		*loc += m[it*idSize + jt] * fact;
             } 
 	    else /* row segment */
 	    { 
 	        while((j_eq >= (ptr->next)->beg) && ((ptr->next)->row == i_eq))
 		    ptr = ptr->next ;
 		fpt = ptr->nz ;
-		fpt[j_eq - ptr->beg] += m[it*idSize + jt] * fact;
+		loc = &fpt[j_eq - ptr->beg];
             }
+	    theLocs[oldPos[it]*oldIdSize + oldPos[jt]] = loc;
          }
-	 diag[i_eq] += m[ipos*idSize + ipos] * fact; /* diagonal element */
+	 theLocs[oldPos[ipos]*oldIdSize + oldPos[ipos]] = &diag[i_eq]; /* diagonal element */
       }
   	  
     delete [] newID;
     delete [] isort;
-    delete [] m;
+    delete [] oldPos;
     delete [] id;
 
     return 0;
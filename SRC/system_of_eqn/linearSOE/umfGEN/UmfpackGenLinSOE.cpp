@@ -97,6 +97,9 @@ UmfpackGenLinSOE::setSize(Graph &theGraph)
     int oldSize = size;
     size = theGraph.getNumVertex();
 
+    // the locations of the entries of A change with the new graph
+    theScatterMap.clear();
+
     // fist itearte through the vertices of the graph to get nnz
     Vertex *theVertex;
     int newNNZ = 0;
@@ -275,7 +278,11 @@ UmfpackGenLinSOE::addA(const Matrix &m, const ID &id, double fact)
 	return -1;
     }
     
-    if (fact == 1.0) { // do not need to multiply 
+    // get the locations in A of the entries of m, finding them with colA
+    // only the first time this ID is assembled after setSize()
+    double **theLocs = theScatterMap.getLocations(id);
+    if (theLocs == 0) {
+	theLocs = theScatterMap.newLocations(id);
 	for (int i=0; i<idSize; i++) {
 	    int row = id(i);
 	    if (row < size && row >= 0) {
@@ -287,31 +294,28 @@ UmfpackGenLinSOE::addA(const Matrix &m, const ID &id, double fact)
 			// find place in A using colA
 			for (int k=startRowLoc; k<endRowLoc; k++)
 			    if (colA[k] == col) {
-				A[k] += m(i,j);
+				theLocs[i*idSize+j] = &A[k];
 				k = endRowLoc;
 			    }
 		     }
 		}  // for j		
 	    } 
 	}  // for i
+    }
+
+    if (fact == 1.0) { // do not need to multiply 
+	for (int i=0; i<idSize; i++) {
+	    double **rowLocs = &theLocs[i*idSize];
+	    for (int j=0; j<idSize; j++)
+		if (rowLocs[j] != 0)
+		    *rowLocs[j] += m(i,j);
+	}  // for i
     } else {
 	for (int i=0; i<idSize; i++) {
-	    int row = id(i);
-	    if (row < size && row >= 0) {
-		int startRowLoc = rowStartA[row];
-		int endRowLoc = rowStartA[row+1];
-		for (int j=0; j<idSize; j++) {
-		    int col = id(j);
-		    if (col <size && col >= 0) {
-			// find place in A using colA
-			for (int k=startRowLoc; k<endRowLoc; k++)
-			    if (colA[k] == col) {
-				A[k] += fact * m(i,j);
-				k = endRowLoc;
-			    }
-		     }
-		}  // for j		
-	    } 
+	    double **rowLocs = &theLocs[i*idSize];
+	    for (int j=0; j<idSize; j++)
+		if (rowLocs[j] != 0)
+		    *rowLocs[j] += fact * m(i,j);
 	}  // for i
     }
 
@@ -37,6 +37,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <ScatterMap.h>
 
 class UmfpackGenLinSolver;
 
@@ -92,6 +93,7 @@ class UmfpackGenLinSOE : public LinearSOE
     int factLVALUE;
 	int factorOnce;
 	int printSolveTime;
+    ScatterMap theScatterMap; // locations in A of the entries of each ID
 };
 
 
@@ -47,10 +47,17 @@ extern "C" int umd21i_(int *keep, double *cntl, int *icntl);
 #endif
 
 
+// largest backward error accepted for a solution computed with the factors
+// of a numeric only refactorization; a larger one indicates the pivots
+// chosen for an earlier matrix have led to too much growth
+#define UMFPACK_REFACTOR_TOL 1.0e-12
+
 UmfpackGenLinSolver::
 UmfpackGenLinSolver()
 :LinearSOESolver(SOLVER_TAGS_UmfpackGenLinSolver),
- copyIndex(0), lIndex(0), work(0), theSOE(0)
+ copyIndex(0), lIndex(0), work(0), 
+ copyValue(0), sizeCopyValue(0), haveSymbolic(false), checkRefactor(false),
+ numSymbolic(0), numNumeric(0), theSOE(0)
 {
   // perform the initialisation needed in UMFpack
 #ifdef _WIN32
@@ -68,6 +75,9 @@ UmfpackGenLinSolver::~UmfpackGenLinSolver()
 
   if (work != 0)
     delete [] work;
+
+  if (copyValue != 0)
+    delete [] copyValue;
 }
 
 #ifdef _WIN32
@@ -76,12 +86,11 @@ extern "C" int UMD2FA(int *n, int *ne, int *job, logical *transa,
 		       int *index, int *keep, double *cntl, int *icntl,
 		       int *info, double *rinfo);
 
-/*
-extern "C" int umd2rf_(int *n, int *ne, int *job, logical *transa,
+extern "C" int UMD2RF(int *n, int *ne, int *job, logical *transa,
 		       int *lvalue, int *lindex, double *value,
 		       int *index, int *keep, double *cntl, int *icntl,
 		       int *info, double *rinfo);
-*/
+
 extern "C" int  UMD2SO(int *n, int *job, logical *transa,
 		       int *lvalue, int *lindex, double *value,
 		       int *index, int *keep, double *b, double *x, 
@@ -93,6 +102,11 @@ extern "C" int umd2fa_(int *n, int *ne, int *job, logical *transa,
 		       int *index, int *keep, double *cntl, int *icntl,
 		       int *info, double *rinfo);
 
+extern "C" int umd2rf_(int *n, int *ne, int *job, logical *transa,
+		       int *lvalue, int *lindex, double *value,
+		       int *index, int *keep, double *cntl, int *icntl,
+		       int *info, double *rinfo);
+
 extern "C" int umd2so_(int *n, int *job, logical *transa,
 		       int *lvalue, int *lindex, double *value,
 		       int *index, int *keep, double *b, double *x, 
@@ -132,24 +146,32 @@ UmfpackGenLinSolver::solve(void)
 
     if (theSOE->factored == false) {
 
-      // make a copy of index
-      for (int i=0; i<2*ne; i++) {
-	copyIndex[i] = theSOE->index[i];
+      // keep the assembled values, needed to check a refactorization and
+      // to start again if it fails; the factorization overwrites them
+      for (int i=0; i<ne; i++)
+	copyValue[i] = Aptr[i];
+
+      // if the pattern has been analysed, only compute new numeric factors
+      // using the pivot order and symbolic factorization of the last one
+      if (haveSymbolic == true) {
+	if (this->factor(false) == 0) {
+	  numNumeric++;
+	  checkRefactor = true;
+	} else {
+	  haveSymbolic = false;
+	  for (int i=0; i<ne; i++)
+	    Aptr[i] = copyValue[i];
+	}
       }
 
-      // factor the matrix
-#ifdef _WIN32
-      UMD2FA(&n, &ne, &job, &trans, &lValue, &lIndex, Aptr,
-	      copyIndex, keep, cntl, icntl, info, rinfo);
-#else
-      umd2fa_(&n, &ne, &job, &trans, &lValue, &lIndex, Aptr,
-	      copyIndex, keep, cntl, icntl, info, rinfo);
-#endif      
-      
-      if (info[0] != 0) {	
-	opserr << "WARNING UmfpackGenLinSolver::solve(void)- ";
-	opserr << info[0] << " returned in factorization UMD2FA()\n";
-	return -info[0];
+      if (haveSymbolic == false) {
+	int res = this->factor(true);
+	if (res != 0)
+	  return res;
+	numSymbolic++;
+	numNumeric++;
+	haveSymbolic = true;
+	checkRefactor = false;
       }
       theSOE->factored = true;
     }	
@@ -173,10 +195,159 @@ UmfpackGenLinSolver::solve(void)
        return -info[0];
     }
 
+    // check the first solution with refactored factors, if the backward
+    // error is too large do a full factorization with new pivots
+    if (checkRefactor == true) {
+      checkRefactor = false;
+      if (this->getBackwardError() > UMFPACK_REFACTOR_TOL) {
+	for (int i=0; i<ne; i++)
+	  Aptr[i] = copyValue[i];
+	int res = this->factor(true);
+	if (res != 0)
+	  return res;
+	numSymbolic++;
+	numNumeric++;
+#ifdef _WIN32
+	UMD2SO(&n, &job, &trans, &lValue, &lIndex, Aptr, copyIndex, 
+	       keep, Bptr, Xptr, work, cntl, icntl, info, rinfo);    
+#else
+	umd2so_(&n, &job, &trans, &lValue, &lIndex, Aptr, copyIndex, 
+		keep, Bptr, Xptr, work, cntl, icntl, info, rinfo);
+#endif
+	if (info[0] != 0) {	
+	  opserr << "WARNING UmfpackGenLinSolver::solve(void)- ";
+	  opserr << info[0] << " returned in substitution dgstrs()\n";
+	  return -info[0];
+	}
+      }
+    }
+
     return 0;
 }
 
 
+// int factor(bool analyse);
+//	Factors A, held in the first nnz entries of the SOE A array. If analyse
+//	is true UMD2FA chooses a new pivot order, otherwise UMD2RF reuses the
+//	pivot order and pattern of the last factorization; in that case a
+//	non-zero return, with no warning printed, means the old pivots could
+//	not be used for the new values.
+
+int
+UmfpackGenLinSolver::factor(bool analyse)
+{
+    int n = theSOE->size;
+    int ne = theSOE->nnz;
+    int lValue = theSOE->lValue;
+    double *Aptr = theSOE->A;
+
+    int job =0; 
+    logical trans = FALSE_;
+
+    // copy the triplet indices into the start of copyIndex, the rest
+    // holds the pattern of the last factors needed by UMD2RF
+    for (int i=0; i<2*ne; i++) {
+      copyIndex[i] = theSOE->index[i];
+    }
+
+    if (analyse == true) {
+#ifdef _WIN32
+      UMD2FA(&n, &ne, &job, &trans, &lValue, &lIndex, Aptr,
+	      copyIndex, keep, cntl, icntl, info, rinfo);
+#else
+      umd2fa_(&n, &ne, &job, &trans, &lValue, &lIndex, Aptr,
+	      copyIndex, keep, cntl, icntl, info, rinfo);
+#endif      
+      
+      if (info[0] != 0) {	
+	opserr << "WARNING UmfpackGenLinSolver::solve(void)- ";
+	opserr << info[0] << " returned in factorization UMD2FA()\n";
+	haveSymbolic = false;
+	return -info[0];
+      }
+      return 0;
+    }
+
+#ifdef _WIN32
+    UMD2RF(&n, &ne, &job, &trans, &lValue, &lIndex, Aptr,
+	   copyIndex, keep, cntl, icntl, info, rinfo);
+#else
+    umd2rf_(&n, &ne, &job, &trans, &lValue, &lIndex, Aptr,
+	    copyIndex, keep, cntl, icntl, info, rinfo);
+#endif      
+
+    // an error or warning (entries outside the old factors, zero pivots)
+    // or fewer acceptable pivots than equations means new pivots are needed
+    if (info[0] != 0 || info[16] < n)
+      return -1;
+
+    return 0;
+}
+
+
+// double getBackwardError(void);
+//	Returns the backward error |B - A X| / (|A| |X| + |B|), infinity norms,
+//	of the current solution, computed with the values of A saved before
+//	the factorization.
+
+double
+UmfpackGenLinSolver::getBackwardError(void)
+{
+    int n = theSOE->size;
+    int ne = theSOE->nnz;
+    double *Xptr = theSOE->X;
+    double *Bptr = theSOE->B;
+    const int *rowIndex = &(theSOE->index[0]);
+    const int *colIndex = &(theSOE->index[ne]);
+
+    // work holds 4*n doubles and is free once the solution is computed
+    double *resid = work;
+    double *rowSum = &work[n];
+    for (int i=0; i<n; i++) {
+      resid[i] = Bptr[i];
+      rowSum[i] = 0.0;
+    }
+
+    for (int k=0; k<ne; k++) {
+      int row = rowIndex[k]-1;   // -1 for fortran indexing
+      int col = colIndex[k]-1;
+      resid[row] -= copyValue[k]*Xptr[col];
+      rowSum[row] += fabs(copyValue[k]);
+    }
+
+    double normR = 0.0;
+    double normA = 0.0;
+    double normX = 0.0;
+    double normB = 0.0;
+    for (int j=0; j<n; j++) {
+      if (fabs(resid[j]) > normR) normR = fabs(resid[j]);
+      if (rowSum[j] > normA) normA = rowSum[j];
+      if (fabs(Xptr[j]) > normX) normX = fabs(Xptr[j]);
+      if (fabs(Bptr[j]) > normB) normB = fabs(Bptr[j]);
+    }
+
+    double denom = normA*normX + normB;
+    if (denom == 0.0)
+      return 0.0;
+
+    return normR/denom;
+}
+
+
+int
+UmfpackGenLinSolver::getNumFactorizations(void)
+{
+    return numNumeric;
+}
+
+
+int
+UmfpackGenLinSolver::getNumSymbolicFactorizations(void)
+{
+    return numSymbolic;
+}
+
+
 int
 UmfpackGenLinSolver::setSize()
 {
@@ -193,7 +364,19 @@ UmfpackGenLinSolver::setSize()
 	delete [] copyIndex;
 
       copyIndex = new int[lIndex];
+
+      if (ne > sizeCopyValue) {
+	if (copyValue != 0)
+	  delete [] copyValue;
+	copyValue = new double[ne];
+	sizeCopyValue = ne;
+      }
     }	
+
+    // a new graph, the next factorization must choose the pivots again
+    haveSymbolic = false;
+    checkRefactor = false;
+
     return 0;
 }
 
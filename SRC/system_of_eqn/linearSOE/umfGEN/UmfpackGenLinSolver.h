@@ -49,6 +49,9 @@ class UmfpackGenLinSolver : public LinearSOESolver
     int setSize(void);
 
     int setLinearSOE(UmfpackGenLinSOE &theSOE);
+
+    int getNumFactorizations(void);
+    int getNumSymbolicFactorizations(void);
     
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, 
@@ -57,6 +60,9 @@ class UmfpackGenLinSolver : public LinearSOESolver
   protected:
 
   private:
+    int factor(bool analyse);
+    double getBackwardError(void);
+
     int icntl[20];
     int keep[20];
     double cntl[10];
@@ -66,6 +72,13 @@ class UmfpackGenLinSolver : public LinearSOESolver
     int *copyIndex;
     int lIndex;
     double *work;
+
+    double *copyValue;    // values of A before the last factorization
+    int sizeCopyValue;
+    bool haveSymbolic;    // true if pivot order & pattern are for this graph
+    bool checkRefactor;   // true if next solution to be checked
+    int numSymbolic;      // number of factorizations choosing new pivots
+    int numNumeric;       // number of numeric factorizations (all of them)
     
     UmfpackGenLinSOE *theSOE;
 };
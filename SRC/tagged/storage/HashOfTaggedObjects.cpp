@@ -0,0 +1,336 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/tagged/storage/HashOfTaggedObjects.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of the 
+// HashOfTaggedObjects class.
+//
+// What: "@(#) HashOfTaggedObjects.C, revA"
+
+#include <TaggedObject.h>
+#include <HashOfTaggedObjects.h>
+
+#include <OPS_Globals.h>
+
+#define HASH_MIN_TABLE_SIZE 16
+
+// multiplicative hashing, the top bits of the product index the table
+static inline int
+hashTag(int tag, int shift)
+{
+  return (int)(((unsigned int)tag * 2654435761U) >> shift);
+}
+
+HashOfTaggedObjects::HashOfTaggedObjects(int size)
+:theComponents(0), sizeComponents(0), numEntries(0), numComponents(0),
+ tableTags(0), tablePositions(0), sizeTable(0), shift(32), myIter(*this)
+{
+  if (size < HASH_MIN_TABLE_SIZE/2)
+    size = HASH_MIN_TABLE_SIZE/2;
+
+  if (this->setSize(size) < 0) 
+    opserr << "HashOfTaggedObjects::HashOfTaggedObjects - out of memory for size " << size << endln;
+}
+
+HashOfTaggedObjects::~HashOfTaggedObjects()
+{
+  if (theComponents != 0)
+    delete [] theComponents;
+  if (tableTags != 0)
+    delete [] tableTags;
+  if (tablePositions != 0)
+    delete [] tablePositions;
+}
+
+
+int
+HashOfTaggedObjects::setSize(int newSize)
+{
+  if (newSize <= sizeComponents)
+    return 0;
+
+  // first make the table large enough, so it stays at most half full
+  if (this->setSizeTable(2*newSize) < 0)
+    return -1;
+
+  TaggedObject **newComponents = new TaggedObject *[newSize];
+  if (newComponents == 0) {
+    opserr << "HashOfTaggedObjects::setSize - out of memory for size " << newSize << endln;
+    return -1;
+  }
+
+  for (int i=0; i<numEntries; i++)
+    newComponents[i] = theComponents[i];
+
+  if (theComponents != 0)
+    delete [] theComponents;
+
+  theComponents = newComponents;
+  sizeComponents = newSize;
+
+  return 0;
+}
+
+
+bool 
+HashOfTaggedObjects::addComponent(TaggedObject *newComponent)
+{
+  int tag = newComponent->getTag();
+
+  // check if the component already stored, if not we add
+  if (this->findEntry(tag) >= 0) {
+    opserr << "HashOfTaggedObjects::addComponent - not adding as one with similar tag exists, tag: " <<
+      tag << endln;
+    return false;
+  }
+
+  // make room at the end of the array, squeezing out the holes if 
+  // there are many, otherwise doubling its size
+  if (numEntries == sizeComponents) {
+    if (4*(numEntries - numComponents) > numEntries)
+      this->squeeze();
+    else if (this->setSize(2*sizeComponents) < 0) {
+      opserr << "HashOfTaggedObjects::addComponent - out of memory adding tag: " << tag << endln;
+      return false;
+    }
+  }
+
+  theComponents[numEntries] = newComponent;
+  this->insertEntry(tag, numEntries);
+  numEntries++;
+  numComponents++;
+
+  return true;  // o.k.
+}
+
+
+TaggedObject *
+HashOfTaggedObjects::removeComponent(int tag)
+{
+  int i = this->findEntry(tag);
+  if (i < 0) // the object has not been added
+    return 0;
+
+  int position = tablePositions[i];
+  TaggedObject *removed = theComponents[position];
+  theComponents[position] = 0;
+  numComponents--;
+
+  if (numComponents == 0)
+    numEntries = 0;
+  else if (position == numEntries-1)
+    numEntries--;
+
+  // remove the table entry, moving back the entries that follow it in
+  // the probe sequence and could have used its place
+  int mask = sizeTable - 1;
+  tablePositions[i] = -1;
+  int j = i;
+  while (true) {
+    j = (j+1) & mask;
+    if (tablePositions[j] == -1)
+      break;
+    int k = hashTag(tableTags[j], shift);
+    bool canMove = (j > i) ? (k <= i || k > j) : (k <= i && k > j);
+    if (canMove == true) {
+      tableTags[i] = tableTags[j];
+      tablePositions[i] = tablePositions[j];
+      tablePositions[j] = -1;
+      i = j;
+    }
+  }
+
+  return removed;
+}
+
+
+int
+HashOfTaggedObjects::getNumComponents(void) const
+{
+  return numComponents;
+}
+
+
+TaggedObject *
+HashOfTaggedObjects::getComponentPtr(int tag)
+{
+  int i = this->findEntry(tag);
+  if (i < 0) 
+    return 0;
+
+  return theComponents[tablePositions[i]];
+}
+
+
+TaggedObjectIter &
+HashOfTaggedObjects::getComponents()
+{
+  myIter.reset();
+  return myIter;
+}
+
+
+HashOfTaggedObjectsIter 
+HashOfTaggedObjects::getIter()
+{
+  return HashOfTaggedObjectsIter(*this);
+}
+
+
+TaggedObjectStorage *
+HashOfTaggedObjects::getEmptyCopy(void)
+{
+  HashOfTaggedObjects *theCopy = new HashOfTaggedObjects();
+    
+  if (theCopy == 0) {
+    opserr << "HashOfTaggedObjects::getEmptyCopy-out of memory\n";
+  }	
+
+  return theCopy;
+}
+
+
+void
+HashOfTaggedObjects::clearAll(bool invokeDestructor)
+{
+  // invoke the destructor on all the tagged objects stored
+  if (invokeDestructor == true) {
+    for (int i=0; i<numEntries; i++)
+      if (theComponents[i] != 0)
+	delete theComponents[i];
+  }
+
+  numEntries = 0;
+  numComponents = 0;
+  for (int j=0; j<sizeTable; j++)
+    tablePositions[j] = -1;
+}
+
+
+void
+HashOfTaggedObjects::Print(OPS_Stream &s, int flag)
+{
+  // go through the array invoking Print on non-zero entries
+  for (int i=0; i<numEntries; i++)
+    if (theComponents[i] != 0)
+      theComponents[i]->Print(s, flag);
+}
+
+
+// returns the location of tag in the table, -1 if not there
+int
+HashOfTaggedObjects::findEntry(int tag) const
+{
+  if (sizeTable == 0)
+    return -1;
+
+  int mask = sizeTable - 1;
+  int i = hashTag(tag, shift);
+  while (tablePositions[i] != -1) {
+    if (tableTags[i] == tag)
+      return i;
+    i = (i+1) & mask;
+  }
+
+  return -1;
+}
+
+
+// adds tag to the table, the tag must not be there already
+int
+HashOfTaggedObjects::insertEntry(int tag, int position)
+{
+  int mask = sizeTable - 1;
+  int i = hashTag(tag, shift);
+  while (tablePositions[i] != -1)
+    i = (i+1) & mask;
+
+  tableTags[i] = tag;
+  tablePositions[i] = position;
+
+  return i;
+}
+
+
+int
+HashOfTaggedObjects::setSizeTable(int newSize)
+{
+  int size = HASH_MIN_TABLE_SIZE;
+  int bits = 4;
+  while (size < newSize) {
+    size *= 2;
+    bits++;
+  }
+
+  if (size <= sizeTable)
+    return 0;
+
+  int *newTags = new int[size];
+  int *newPositions = new int[size];
+  if (newTags == 0 || newPositions == 0) {
+    opserr << "HashOfTaggedObjects::setSizeTable - out of memory for size " << size << endln;
+    if (newTags != 0)
+      delete [] newTags;
+    if (newPositions != 0)
+      delete [] newPositions;
+    return -1;
+  }
+
+  if (tableTags != 0)
+    delete [] tableTags;
+  if (tablePositions != 0)
+    delete [] tablePositions;
+
+  tableTags = newTags;
+  tablePositions = newPositions;
+  sizeTable = size;
+  shift = 32 - bits;
+
+  // enter the components again
+  for (int j=0; j<sizeTable; j++)
+    tablePositions[j] = -1;
+  for (int i=0; i<numEntries; i++)
+    if (theComponents[i] != 0)
+      this->insertEntry(theComponents[i]->getTag(), i);
+
+  return 0;
+}
+
+
+// removes the holes from the array, keeping the order of the components
+int
+HashOfTaggedObjects::squeeze(void)
+{
+  int numLeft = 0;
+  for (int i=0; i<numEntries; i++)
+    if (theComponents[i] != 0)
+      theComponents[numLeft++] = theComponents[i];
+  numEntries = numLeft;
+
+  for (int j=0; j<sizeTable; j++)
+    tablePositions[j] = -1;
+  for (int k=0; k<numEntries; k++)
+    this->insertEntry(theComponents[k]->getTag(), k);
+
+  return 0;
+}
@@ -0,0 +1,89 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/tagged/storage/HashOfTaggedObjects.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for 
+// HashOfTaggedObjects. HashOfTaggedObjects is a storage class. The class 
+// is responsible for holding and providing access to objects of type 
+// TaggedObject. The pointers to the objects are kept in one array in the
+// order they were added, and an open addressing hash table maps each tag
+// to its position in that array, so adding, removing and finding a
+// component take constant time whatever the tags and iterating over the
+// components is a walk along one array.
+//
+// A removed component leaves a hole in the array, skipped by the iter;
+// the holes are squeezed out, keeping the order, when the array is full.
+//
+// What: "@(#) HashOfTaggedObjects.h, revA"
+
+#ifndef HashOfTaggedObjects_h
+#define HashOfTaggedObjects_h
+
+#include <TaggedObjectStorage.h>
+#include <HashOfTaggedObjectsIter.h>
+
+class HashOfTaggedObjects : public TaggedObjectStorage
+{
+  public:
+    HashOfTaggedObjects(int size = 0);
+    ~HashOfTaggedObjects();    
+
+    // public methods to populate a domain
+    int  setSize(int newSize);
+    bool addComponent(TaggedObject *newComponent);
+    TaggedObject *removeComponent(int tag);    
+    int getNumComponents(void) const;
+    
+    TaggedObject     *getComponentPtr(int tag);
+    TaggedObjectIter &getComponents();
+
+    HashOfTaggedObjectsIter getIter();
+    
+    TaggedObjectStorage *getEmptyCopy(void);
+    void clearAll(bool invokeDestructor = true);
+    
+    void Print(OPS_Stream &s, int flag =0);
+    friend class HashOfTaggedObjectsIter;
+    
+  protected:    
+    
+  private:
+    int findEntry(int tag) const;
+    int insertEntry(int tag, int position);
+    int setSizeTable(int newSize);
+    int squeeze(void);
+
+    TaggedObject **theComponents; // the pointers, in the order added
+    int sizeComponents;           // size of the array
+    int numEntries;               // positions used, including holes
+    int numComponents;            // num of components stored
+
+    int *tableTags;               // hash table: tag and position of 
+    int *tablePositions;          // the component, position -1 if free
+    int sizeTable;                // power of 2, at least 2*numEntries
+    int shift;                    // 32 - log2(sizeTable)
+
+    HashOfTaggedObjectsIter myIter; // the iter for this object
+};
+
+#endif
@@ -0,0 +1,63 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/tagged/storage/HashOfTaggedObjectsIter.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of 
+// HashOfTaggedObjectsIter.
+//
+// What: "@(#) HashOfTaggedObjectsIter.C, revA"
+
+#include <HashOfTaggedObjectsIter.h>
+#include <HashOfTaggedObjects.h>
+
+HashOfTaggedObjectsIter::HashOfTaggedObjectsIter(HashOfTaggedObjects &theComponents)
+:myComponents(theComponents), currIndex(0)
+{
+
+}
+
+HashOfTaggedObjectsIter::~HashOfTaggedObjectsIter()
+{
+
+}    
+
+void
+HashOfTaggedObjectsIter::reset(void)
+{
+    currIndex = 0;
+}
+
+TaggedObject *
+HashOfTaggedObjectsIter::operator()(void)
+{
+    // skip the holes left by removed components
+    TaggedObject **theComponents = myComponents.theComponents;
+    int numEntries = myComponents.numEntries;
+    while (currIndex < numEntries) {
+	TaggedObject *result = theComponents[currIndex++];
+	if (result != 0)
+	    return result;
+    }
+
+    return 0;
+}
@@ -23,90 +23,154 @@
 // $Source: /usr/local/cvs/OpenSees/SRC/tagged/storage/main.cpp,v $
                                                                         
                                                                         
-#include <Node.h>
+// Description: This file is a driver to compare the storage classes
+// ArrayOfTaggedObjects, MapOfTaggedObjects and HashOfTaggedObjects. For
+// dense tags (1,2,3,..) and sparse tags (multiples of a large number,
+// added in shuffled order) it times adding the components, finding each
+// of them, iterating over all of them and removing half of them.
+//
+//   test <numComponents?> <numIterations?>
+//
+// ArrayOfTaggedObjects is skipped for more than 100000 sparse tags.
+
+#include <stdlib.h>
+
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+#include <Timer.h>
+#include <TaggedObject.h>
+#include <TaggedObjectIter.h>
 #include <ArrayOfTaggedObjects.h>
 #include <MapOfTaggedObjects.h>
-#include <MapOfTaggedObjectsIter.h>
+#include <HashOfTaggedObjects.h>
 
-#include <stdlib.h>
-#include <ZZZ>
+double ops_Dt;
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+// smallest object that can be stored
+class BenchmarkObject : public TaggedObject
+{
+  public:
+    BenchmarkObject(int tag) :TaggedObject(tag) {};
+    void Print(OPS_Stream &s, int flag =0) {s << "BenchmarkObject " << this->getTag() << endln;};
+};
+
+static int
+runBenchmark(const char *name, TaggedObjectStorage &theHolder, 
+	     const int *tags, const int *order, int numComponents, int numIterations)
+{
+  Timer theTimer;
+  int numErrors = 0;
+  int i;
+
+  theTimer.start();
+  for (i=0; i<numComponents; i++)
+    if (theHolder.addComponent(new BenchmarkObject(tags[i])) == false)
+      numErrors++;
+  theTimer.pause();
+  double timeAdd = theTimer.getReal();
+
+  theTimer.start();
+  for (i=0; i<numComponents; i++) {
+    TaggedObject *theObject = theHolder.getComponentPtr(tags[order[i]]);
+    if (theObject == 0 || theObject->getTag() != tags[order[i]])
+      numErrors++;
+  }
+  theTimer.pause();
+  double timeFind = theTimer.getReal();
+
+  theTimer.start();
+  for (int j=0; j<numIterations; j++) {
+    int count = 0;
+    TaggedObject *theObject;
+    TaggedObjectIter &theObjects = theHolder.getComponents();
+    while ((theObject = theObjects()) != 0)
+      count++;
+    if (count != numComponents)
+      numErrors++;
+  }
+  theTimer.pause();
+  double timeIter = theTimer.getReal();
+
+  theTimer.start();
+  for (i=0; i<numComponents; i+=2) {
+    TaggedObject *theObject = theHolder.removeComponent(tags[order[i]]);
+    if (theObject == 0)
+      numErrors++;
+    else
+      delete theObject;
+  }
+  theTimer.pause();
+  double timeRemove = theTimer.getReal();
+
+  if (theHolder.getNumComponents() != numComponents/2)
+    numErrors++;
+  theHolder.clearAll();
+
+  opserr << name << ": add " << timeAdd << " find " << timeFind 
+	 << " iterate " << timeIter << " remove " << timeRemove;
+  if (numErrors != 0)
+    opserr << " ERRORS " << numErrors;
+  opserr << endln;
+
+  return numErrors;
+}
 
 int main(int argc, char **argv)
 {
-    int startID = 1;
-    int i;
+  int numComponents = 20000;
+  int numIterations = 100;
+  if (argc > 1)
+    numComponents = atoi(argv[1]);
+  if (argc > 2)
+    numIterations = atoi(argv[2]);
+  if (numComponents < 2)
+    numComponents = 2;
 
-    MapOfTaggedObjects *theHolder = new MapOfTaggedObjects();
-    opserr << "adding 5 components starting with id 1 to an object of initial size 5\n";
+  int *tags = new int[numComponents];
+  int *order = new int[numComponents];
 
-    for (i=0; i<5; i++) {
-	Node *theNode = new Node(i+startID,1,i+startID);
-	theHolder->addComponent(theNode);
-    }
-    
-    opserr << "the contents\n";    
-    theHolder->Print(opserr);
-
-    TaggedObject *theNode;
-    
-    opserr << "removing node with id 4\n";
-    theNode = theHolder->removeComponent(4); 
-    if (theNode != 0) opserr << *theNode; else opserr << "Not There\n";        
-
-    opserr << "the contents\n";    
-    theHolder->Print(opserr);
-
-    opserr << "adding 3 more components 10,11,12\n";        
-    for (i=0; i<3; i++) {
-	Node *theNode = new Node(i+10,1,i+10);
-	theHolder->addComponent(theNode);
-    }
+  // the components are looked up and removed in shuffled order
+  srand(12345);
+  int i;
+  for (i=0; i<numComponents; i++)
+    order[i] = i;
+  for (i=numComponents-1; i>0; i--) {
+    int j = rand() % (i+1);
+    int tmp = order[i]; order[i] = order[j]; order[j] = tmp;
+  }
 
-    opserr << "the contents\n";    
-    theHolder->Print(opserr);
-    
-    // destroying the holder
-    opserr << "invoking the object destructor\n";        
-    delete theHolder;
-    
-    opserr << "end of test1\n";
-    double a; cin >> a;
-    
-    startID = 0;
-    theHolder = new MapOfTaggedObjects();
-    opserr << "adding 5 components starting with id 0 to an object of initial size 5\n";
-
-    for (i=0; i<5; i++) {
-	Node *theNode = new Node(i+startID,1,i+startID);
-	theHolder->addComponent(theNode);
-    }
-    
-    opserr << "the contents\n";    
-    theHolder->Print(opserr);
-
-    opserr << "removing node with id 4\n";
-    theNode = theHolder->removeComponent(4); 
-    if (theNode != 0) opserr << *theNode; else opserr << "Not There\n";        
-
-    opserr << "the contents\n";    
-    theHolder->Print(opserr);    
-    
-    opserr << "adding 3 more components 10,11,12\n";        
-    for (i=0; i<3; i++) {
-	Node *theNode = new Node(i+startID,1,i+10);
-	theHolder->addComponent(theNode);
+  opserr << numComponents << " components, " << numIterations 
+	 << " iterations, times in seconds\n";
+
+  int numErrors = 0;
+  for (int sparse=0; sparse<2; sparse++) {
+    if (sparse == 0) {
+      opserr << "dense tags\n";
+      for (i=0; i<numComponents; i++)
+	tags[i] = i+1;
+    } else {
+      opserr << "sparse tags\n";
+      for (i=0; i<numComponents; i++)
+	tags[order[i]] = 1000*(i+1) + 7;
     }
 
-    opserr << "the contents using print\n";    
-    theHolder->Print(opserr);    
-
-    opserr << "now check that the iterator works - should see contents\n";
-    TaggedObject *theItem;
-    TaggedObjectIter &theItems = theHolder->getComponents();
-    while ((theItem = theItems()) != 0)
-	opserr << *theItem;
-    
-    theHolder->clearAll();
-    opserr << "the contetnts after clearAll\n";            
-    theHolder->Print(opserr);
+    ArrayOfTaggedObjects theArray(1024);
+    MapOfTaggedObjects theMap;
+    HashOfTaggedObjects theHash;
+
+    // the array searches all the entries for a tag not at its own position
+    if (sparse == 0 || numComponents <= 100000)
+      numErrors += runBenchmark("  ArrayOfTaggedObjects", theArray, tags, order, numComponents, numIterations);
+    else
+      opserr << "  ArrayOfTaggedObjects: skipped, too slow for sparse tags\n";
+    numErrors += runBenchmark("  MapOfTaggedObjects  ", theMap, tags, order, numComponents, numIterations);
+    numErrors += runBenchmark("  HashOfTaggedObjects ", theHash, tags, order, numComponents, numIterations);
+  }
+
+  delete [] tags;
+  delete [] order;
+
+  return (numErrors == 0) ? 0 : -1;
 }
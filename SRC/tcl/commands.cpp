@@ -44,6 +44,9 @@ extern "C" {
 #include <OPS_Globals.h>
 #include <TclModelBuilder.cpp>
 #include <Matrix.h>
+#include <WorkArea.h>
+#include <ThreadPool.h>
+#include <ElementColoring.h>
 
 // the following is a little kludgy but it works!
 #ifdef _USING_STL_STREAMS
@@ -69,6 +72,8 @@ OPS_Stream *opserrPtr = &sserr;
 #include <string.h>
 
 #include <packages.h>
+#include <ColumnarFileStream.h>
+#include <TimeSeriesCache.h>
 
 #include <FEM_ObjectBrokerAllClasses.h>
 
@@ -83,6 +88,11 @@ OPS_Stream *opserrPtr = &sserr;
 #include <Domain.h>
 #endif
 
+// storage for the domain components
+#include <ArrayOfTaggedObjects.h>
+#include <MapOfTaggedObjects.h>
+#include <HashOfTaggedObjects.h>
+
 #include <Information.h>
 #include <Element.h>
 #include <Node.h>
@@ -221,9 +231,9 @@ extern TransientIntegrator *OPS_NewGeneralizedAlpha(void);
 #include <DiagonalDirectSolver.h>
 
 // #include <ProfileSPDLinDirectBlockSolver.h>
-// #include <ProfileSPDLinDirectThreadSolver.h>
+#include <ProfileSPDLinDirectThreadSolver.h>
 // #include <ProfileSPDLinDirectSkypackSolver.h>
-// #include <BandSPDLinThreadSolver.h>
+#include <BandSPDLinThreadSolver.h>
 
 #include <SparseGenColLinSOE.h>
 #ifdef _THREADS
@@ -277,6 +287,7 @@ extern TransientIntegrator *OPS_NewGeneralizedAlpha(void);
 // graph
 #include <RCM.h>
 #include <AMDNumberer.h>
+#include <NestedDissection.h>
 
 #include <ErrorHandler.h>
 #include <ConsoleErrorHandler.h>
@@ -672,6 +683,12 @@ int OpenSeesAppInit(Tcl_Interp *interp) {
 			(Tcl_CmdDeleteProc *) NULL);
 	Tcl_CreateCommand(interp, "getTime", &getTime, (ClientData) NULL,
 			(Tcl_CmdDeleteProc *) NULL);
+	Tcl_CreateCommand(interp, "nodeStateStore", &setNodeStateStore,
+			(ClientData) NULL, (Tcl_CmdDeleteProc *) NULL);
+	Tcl_CreateCommand(interp, "domainStorage", &setDomainStorage,
+			(ClientData) NULL, (Tcl_CmdDeleteProc *) NULL);
+	Tcl_CreateCommand(interp, "threads", &setNumThreads,
+			(ClientData) NULL, (Tcl_CmdDeleteProc *) NULL);
 	Tcl_CreateCommand(interp, "getLoadFactor", &getLoadFactor,
 			(ClientData) NULL, (Tcl_CmdDeleteProc *) NULL);
 
@@ -1365,6 +1382,103 @@ int getTime(ClientData clientData, Tcl_Interp *interp, int argc,
 	return TCL_OK;
 }
 
+// command invoked to keep the nodal disp, vel and accel values of the
+// domain in contiguous buffers: nodeStateStore on|off
+int setNodeStateStore(ClientData clientData, Tcl_Interp *interp, int argc,
+		TCL_Char **argv) {
+	if (argc < 2) {
+		opserr << "WARNING illegal command - nodeStateStore on|off \n";
+		return TCL_ERROR;
+	}
+
+	bool useStore;
+	if (strcmp(argv[1], "on") == 0 || strcmp(argv[1], "1") == 0)
+		useStore = true;
+	else if (strcmp(argv[1], "off") == 0 || strcmp(argv[1], "0") == 0)
+		useStore = false;
+	else {
+		opserr << "WARNING nodeStateStore on|off - unknown option " << argv[1]
+				<< endln;
+		return TCL_ERROR;
+	}
+
+	if (theDomain.setNodeStateStore(useStore) < 0) {
+		opserr << "WARNING nodeStateStore - failed to set the store\n";
+		return TCL_ERROR;
+	}
+
+	return TCL_OK;
+}
+
+// command invoked to choose the container for the domain components, 
+// given before the model is built or after a wipe:
+//   domainStorage map|array|hash <-size numComponents?>
+int setDomainStorage(ClientData clientData, Tcl_Interp *interp, int argc,
+		TCL_Char **argv) {
+	if (argc < 2) {
+		opserr << "WARNING illegal command - domainStorage map|array|hash <-size n?> \n";
+		return TCL_ERROR;
+	}
+
+	int size = 0;
+	if (argc > 3 && strcmp(argv[2], "-size") == 0) {
+		if (Tcl_GetInt(interp, argv[3], &size) != TCL_OK || size < 0) {
+			opserr << "WARNING domainStorage - invalid size " << argv[3] << endln;
+			return TCL_ERROR;
+		}
+	}
+
+	TaggedObjectStorage *theStorage = 0;
+	if (strcmp(argv[1], "map") == 0 || strcmp(argv[1], "Map") == 0)
+		theStorage = new MapOfTaggedObjects();
+	else if (strcmp(argv[1], "array") == 0 || strcmp(argv[1], "Array") == 0)
+		theStorage = new ArrayOfTaggedObjects((size > 0) ? size : 1024);
+	else if (strcmp(argv[1], "hash") == 0 || strcmp(argv[1], "Hash") == 0)
+		theStorage = new HashOfTaggedObjects(size);
+	else {
+		opserr << "WARNING domainStorage - unknown type " << argv[1]
+				<< ", want map, array or hash\n";
+		return TCL_ERROR;
+	}
+
+	if (theStorage == 0) {
+		opserr << "WARNING domainStorage - out of memory\n";
+		return TCL_ERROR;
+	}
+
+	if (theDomain.setStorage(*theStorage) < 0) {
+		opserr << "WARNING domainStorage - must be given before any component is added\n";
+		delete theStorage;
+		return TCL_ERROR;
+	}
+
+	return TCL_OK;
+}
+
+// command invoked to set the number of threads of the default pool used
+// by the element and node loops of the domain and the analysis:
+//   threads <numThreads?>
+// without an argument the current number is returned
+int setNumThreads(ClientData clientData, Tcl_Interp *interp, int argc,
+		TCL_Char **argv) {
+	if (argc > 1) {
+		int numThreads;
+		if (Tcl_GetInt(interp, argv[1], &numThreads) != TCL_OK || numThreads < 1) {
+			opserr << "WARNING threads - invalid number of threads " << argv[1] << endln;
+			return TCL_ERROR;
+		}
+		if (ThreadPool::setDefaultNumThreads(numThreads) < numThreads)
+			opserr << "WARNING threads - only " << ThreadPool::getDefaultNumThreads()
+					<< " thread(s) available\n";
+	}
+
+	char buffer[20];
+	sprintf(buffer, "%d", ThreadPool::getDefaultNumThreads());
+	Tcl_SetResult(interp, buffer, TCL_VOLATILE);
+
+	return TCL_OK;
+}
+
 int getLoadFactor(ClientData clientData, Tcl_Interp *interp, int argc,
 		TCL_Char **argv) {
 	if (argc < 2) {
@@ -2281,7 +2395,29 @@ int specifySOE(ClientData clientData, Tcl_Interp *interp, int argc,
 
 	// BAND SPD SOE & SOLVER
 	else if (strcmp(argv[1], "BandSPD") == 0) {
-		BandSPDLinSolver *theSolver = new BandSPDLinLapackSolver();
+		int numThreads = 1;
+		int blockSize = 64;
+		for (int i = 2; i < argc; i++) {
+			if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc) {
+				if (Tcl_GetInt(interp, argv[i + 1], &numThreads) != TCL_OK) {
+					opserr << "WARNING system BandSPD - invalid numThreads " << argv[i + 1] << endln;
+					return TCL_ERROR;
+				}
+				i++;
+			} else if (strcmp(argv[i], "-blockSize") == 0 && i + 1 < argc) {
+				if (Tcl_GetInt(interp, argv[i + 1], &blockSize) != TCL_OK) {
+					opserr << "WARNING system BandSPD - invalid blockSize " << argv[i + 1] << endln;
+					return TCL_ERROR;
+				}
+				i++;
+			}
+		}
+
+		BandSPDLinSolver *theSolver = 0;
+		if (numThreads > 1)
+			theSolver = new BandSPDLinThreadSolver(numThreads, blockSize);
+		else
+			theSolver = new BandSPDLinLapackSolver();
 #ifdef _PARALLEL_PROCESSING
 		theSOE = new DistributedBandSPDLinSOE(*theSolver);
 #else
@@ -2317,7 +2453,29 @@ int specifySOE(ClientData clientData, Tcl_Interp *interp, int argc,
 	// PROFILE SPD SOE * SOLVER
 	else if (strcmp(argv[1], "ProfileSPD") == 0) {
 		// now must determine the type of solver to create from rest of args
-		ProfileSPDLinSolver *theSolver = new ProfileSPDLinDirectSolver();
+		int numThreads = 1;
+		int blockSize = 64;
+		for (int i = 2; i < argc; i++) {
+			if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc) {
+				if (Tcl_GetInt(interp, argv[i + 1], &numThreads) != TCL_OK) {
+					opserr << "WARNING system ProfileSPD - invalid numThreads " << argv[i + 1] << endln;
+					return TCL_ERROR;
+				}
+				i++;
+			} else if (strcmp(argv[i], "-blockSize") == 0 && i + 1 < argc) {
+				if (Tcl_GetInt(interp, argv[i + 1], &blockSize) != TCL_OK) {
+					opserr << "WARNING system ProfileSPD - invalid blockSize " << argv[i + 1] << endln;
+					return TCL_ERROR;
+				}
+				i++;
+			}
+		}
+
+		ProfileSPDLinSolver *theSolver = 0;
+		if (numThreads > 1)
+			theSolver = new ProfileSPDLinDirectThreadSolver(numThreads, blockSize, 1.0e-12);
+		else
+			theSolver = new ProfileSPDLinDirectSolver();
 
 		/* *********** Some misc solvers i play with ******************
 		 else if (strcmp(argv[2],"Normal") == 0) {
@@ -2768,8 +2926,30 @@ int specifyNumberer(ClientData clientData, Tcl_Interp *interp, int argc,
 		RCM *theRCM = new RCM(false);
 		theNumberer = new DOF_Numberer(*theRCM);
 	} else if (strcmp(argv[1], "AMD") == 0) {
-		AMD *theAMD = new AMD();
+		// numberer AMD <-print>
+		bool printCost = false;
+		if (argc > 2 && strcmp(argv[2], "-print") == 0)
+			printCost = true;
+		AMD *theAMD = new AMD(printCost);
 		theNumberer = new DOF_Numberer(*theAMD);
+	} else if ((strcmp(argv[1], "NestedDissection") == 0) || (strcmp(argv[1], "ND") == 0)) {
+		// numberer NestedDissection <-leafSize size> <-print>
+		int leafSize = 64;
+		bool printCost = false;
+		int count = 2;
+		while (count < argc) {
+			if (strcmp(argv[count], "-leafSize") == 0 && count+1 < argc) {
+				if (Tcl_GetInt(interp, argv[count+1], &leafSize) != TCL_OK) {
+					opserr << "WARNING numberer NestedDissection - invalid leafSize " << argv[count+1] << endln;
+					return TCL_ERROR;
+				}
+				count++;
+			} else if (strcmp(argv[count], "-print") == 0)
+				printCost = true;
+			count++;
+		}
+		NestedDissection *theND = new NestedDissection(leafSize, printCost);
+		theNumberer = new DOF_Numberer(*theND);
 	}
 
 #ifdef _PARALLEL_INTERPRETERS
@@ -2790,7 +2970,7 @@ int specifyNumberer(ClientData clientData, Tcl_Interp *interp, int argc,
 #endif
 
 	else {
-		opserr << "WARNING No Numberer type exists (Plain, RCM only) \n";
+		opserr << "WARNING No Numberer type exists (Plain, RCM, AMD, NestedDissection only) \n";
 		return TCL_ERROR;
 	}
 #endif
@@ -3449,6 +3629,46 @@ int specifyCTest(ClientData clientData, Tcl_Interp *interp, int argc,
 int specifyIntegrator(ClientData clientData, Tcl_Interp *interp, int argc,
 		TCL_Char **argv) {
 
+	// remove the options, common to all integrators, that set the number of
+	// threads used to form the element tangents and residuals, whether they
+	// are added to the system one color of elements at a time, and that check
+	// the work areas of the elements are not shared between threads
+	int numThreads = 0;
+	bool printTiming = false;
+	int coloring = -1;
+	int numArgs = 0;
+	for (int i = 0; i < argc; i++) {
+		if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc) {
+			if (Tcl_GetInt(interp, argv[i + 1], &numThreads) != TCL_OK) {
+				opserr << "WARNING integrator - invalid numThreads " << argv[i + 1] << endln;
+				return TCL_ERROR;
+			}
+			i++;
+		} else if (strcmp(argv[i], "-coloring") == 0 && i + 1 < argc) {
+			if (strcmp(argv[i + 1], "greedy") == 0 || strcmp(argv[i + 1], "Greedy") == 0)
+				coloring = ELEMENT_COLORING_GREEDY;
+			else if (strcmp(argv[i + 1], "JP") == 0 || strcmp(argv[i + 1], "JonesPlassmann") == 0)
+				coloring = ELEMENT_COLORING_JP;
+			else if (strcmp(argv[i + 1], "none") == 0)
+				coloring = 0;
+			else {
+				opserr << "WARNING integrator - unknown coloring " << argv[i + 1]
+						<< ", want greedy, JP or none\n";
+				return TCL_ERROR;
+			}
+			i++;
+		} else if (strcmp(argv[i], "-printTime") == 0)
+			printTiming = true;
+		else if (strcmp(argv[i], "-auditWorkArea") == 0)
+			WorkArea::setAudit(true);
+		else
+			argv[numArgs++] = argv[i];
+	}
+	argc = numArgs;
+
+	StaticIntegrator *oldStaticIntegrator = theStaticIntegrator;
+	TransientIntegrator *oldTransientIntegrator = theTransientIntegrator;
+
 	OPS_ResetInput(clientData, interp, 2, argc, argv, &theDomain,
 			theTclBuilder);
 
@@ -5508,7 +5728,12 @@ int specifyIntegrator(ClientData clientData, Tcl_Interp *interp, int argc,
 	}
 
 	else if (strcmp(argv[1], "CentralDifferenceNoDamping") == 0) {
-		theTransientIntegrator = new CentralDifferenceNoDamping();
+		bool reuseMass = false;
+		for (int i = 2; i < argc; i++) {
+			if (strcmp(argv[i], "-reuseMass") == 0)
+				reuseMass = true;
+		}
+		theTransientIntegrator = new CentralDifferenceNoDamping(reuseMass);
 
 		// if the analysis exists - we want to change the Integrator
 		if (theTransientAnalysis != 0)
@@ -5668,6 +5893,20 @@ int specifyIntegrator(ClientData clientData, Tcl_Interp *interp, int argc,
 		return TCL_ERROR;
 	}
 
+	if (numThreads > 1 || printTiming == true) {
+		if (theStaticIntegrator != oldStaticIntegrator && theStaticIntegrator != 0)
+			theStaticIntegrator->setNumThreads(numThreads, printTiming);
+		else if (theTransientIntegrator != oldTransientIntegrator && theTransientIntegrator != 0)
+			theTransientIntegrator->setNumThreads(numThreads, printTiming);
+	}
+
+	if (coloring >= 0) {
+		if (theStaticIntegrator != oldStaticIntegrator && theStaticIntegrator != 0)
+			theStaticIntegrator->setElementColoring(coloring);
+		else if (theTransientIntegrator != oldTransientIntegrator && theTransientIntegrator != 0)
+			theTransientIntegrator->setElementColoring(coloring);
+	}
+
 #ifdef _PARALLEL_PROCESSING
 
 	if (theStaticAnalysis != 0 && theStaticIntegrator != 0) {
@@ -5786,6 +6025,7 @@ int eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 	int typeSolver = 2; // 0 - SymmBandLapack, 1 - SymmSparseArpack, 2 - GenBandArpack (default)
 	int loc = 1;
 	double shift = 0.0;
+	bool printTiming = false;
 
 	// Check type of eigenvalue analysis
 	while (loc < (argc - 1)) {
@@ -5837,6 +6077,17 @@ int eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 				|| (strcmp(argv[loc], "-ProfileSPD") == 0))
 			typeSolver = 8;
 
+		else if ((strcmp(argv[loc], "-shift") == 0) && (loc + 1 < argc - 1)) {
+			if (Tcl_GetDouble(interp, argv[loc + 1], &shift) != TCL_OK) {
+				opserr << "WARNING eigen -shift shift? - invalid shift " << argv[loc + 1] << endln;
+				return TCL_ERROR;
+			}
+			loc++;
+		}
+
+		else if (strcmp(argv[loc], "-printTime") == 0)
+			printTiming = true;
+
 		else if ((strcmp(argv[loc], "fullGenLapack") == 0)
 				|| (strcmp(argv[loc], "-fullGenLapack") == 0))
 			typeSolver = 3;
@@ -6033,6 +6284,15 @@ int eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 
 	} // theEIgenSOE != 0
 
+	// the Arpack system is kept from one call to the next, along with the
+	// ordering and the last eigenvectors, only the shift and output change
+	if (theEigenSOE->getClassTag() == EigenSOE_TAGS_ArpackSOE) {
+		ArpackSOE *theArpackSOE = (ArpackSOE *) theEigenSOE;
+		theArpackSOE->setShift(shift);
+		theArpackSOE->setPrintTiming(printTiming);
+	} else if (shift != 0.0)
+		opserr << "WARNING eigen - -shift ignored, only used with the Arpack solvers\n";
+
 	int requiredDataSize = 20 * numEigen;
 	if (requiredDataSize > resDataSize) {
 		if (resDataPtr != 0) {
@@ -8396,18 +8656,42 @@ int stripOpenSeesXML(ClientData clientData, Tcl_Interp *interp, int argc,
 
 extern int binaryToText(const char *inputFilename, const char *outputFilename);
 extern int textToBinary(const char *inputFilename, const char *outputFilename);
+#include <DRMInputFile.h>
 
 int convertBinaryToText(ClientData clientData, Tcl_Interp *interp, int argc,
 		TCL_Char **argv) {
 	if (argc < 3) {
 		opserr
-				<< "ERROR incorrect # args - convertBinaryToText inputFile outputFile\n";
+				<< "ERROR incorrect # args - convertBinaryToText inputFile outputFile <-schema schemaFile> <-precision p>\n";
 		return -1;
 	}
 
 	const char *inputFile = argv[1];
 	const char *outputFile = argv[2];
 
+	// files of -binaryColumnar recorders start with a header
+	if (isColumnarFile(inputFile) == true) {
+		const char *schemaFile = 0;
+		int precision = 0;
+		for (int i = 3; i < argc; i++) {
+			if (strcmp(argv[i], "-schema") == 0 && i + 1 < argc)
+				schemaFile = argv[++i];
+			else if (strcmp(argv[i], "-precision") == 0 && i + 1 < argc) {
+				if (Tcl_GetInt(interp, argv[++i], &precision) != TCL_OK)
+					return TCL_ERROR;
+			}
+		}
+		return columnarToText(inputFile, outputFile, schemaFile, precision);
+	}
+
+	// binary files of the time series
+	if (isTimeSeriesFile(inputFile) == true)
+		return timeSeriesFileToText(inputFile, outputFile);
+
+	// binary files of the DRM free field motions
+	if (isDRMInputFile(inputFile) == true)
+		return drmInputFileToText(inputFile, outputFile);
+
 	return binaryToText(inputFile, outputFile);
 }
 
@@ -8415,13 +8699,31 @@ int convertTextToBinary(ClientData clientData, Tcl_Interp *interp, int argc,
 		TCL_Char **argv) {
 	if (argc < 3) {
 		opserr
-				<< "ERROR incorrect # args - convertTextToBinary inputFile outputFile\n";
+				<< "ERROR incorrect # args - convertTextToBinary inputFile outputFile <-timeSeries> <-peerNGA> <-drm>\n";
 		return -1;
 	}
 
 	const char *inputFile = argv[1];
 	const char *outputFile = argv[2];
 
+	// binary files read by Path series and ground motions, optionally
+	// from the records of the PEER NGA database (.AT2)
+	bool timeSeries = false;
+	bool peerNGA = false;
+	for (int i = 3; i < argc; i++) {
+		if (strcmp(argv[i], "-drm") == 0)
+			// files of the free field motions read by the DRM load pattern
+			return textToDRMInputFile(inputFile, outputFile);
+		else if (strcmp(argv[i], "-timeSeries") == 0)
+			timeSeries = true;
+		else if (strcmp(argv[i], "-peerNGA") == 0) {
+			timeSeries = true;
+			peerNGA = true;
+		}
+	}
+	if (timeSeries == true)
+		return textToTimeSeriesFile(inputFile, outputFile, peerNGA);
+
 	return textToBinary(inputFile, outputFile);
 }
 
@@ -8554,7 +8856,21 @@ int accelCPU(ClientData clientData, Tcl_Interp *interp, int argc,
 
 int numFact(ClientData clientData, Tcl_Interp *interp, int argc,
 		TCL_Char **argv) {
-	char buffer[20];
+	char buffer[40];
+
+	// numFact -solver: factorizations done by the solver, as the number that
+	// analysed the sparsity pattern followed by the total number
+	if (argc > 1 && strcmp(argv[1], "-solver") == 0) {
+		if (theSOE == 0 || theSOE->getSolver() == 0)
+			return TCL_ERROR;
+
+		LinearSOESolver *theSolver = theSOE->getSolver();
+		sprintf(buffer, "%d %d", theSolver->getNumSymbolicFactorizations(),
+				theSolver->getNumFactorizations());
+		Tcl_SetResult(interp, buffer, TCL_VOLATILE );
+
+		return TCL_OK;
+	}
 
 	if (theAlgorithm == 0)
 		return TCL_ERROR;
@@ -9247,6 +9563,15 @@ int printModelGID(ClientData clientData, Tcl_Interp *interp, int argc,
 }
 // Talledo End
 
+// Export some objects for commands extensions: Li Ge, UCSD
+DirectIntegrationAnalysis *getDirectIntegrationAnalysis(void) {
+	return theTransientAnalysis;
+}
+
+StaticAnalysis *getStaticAnalysis(void) {
+	return theStaticAnalysis;
+}
+
 // Add JSON interface: Li Ge, UCSD
 // #define RESULT_LEN 5000000
 // #define BUFFER_LEN 3000000
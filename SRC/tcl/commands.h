@@ -68,6 +68,15 @@ setTime(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 int 
 getTime(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
+int 
+setNodeStateStore(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+int 
+setDomainStorage(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+int 
+setNumThreads(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
 int 
 getLoadFactor(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
@@ -0,0 +1,303 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Domain.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Vector.h>
+#include <OPS_Stream.h>
+#include "NodeResponseStreamer.h"
+
+// the buffer is passed on to the stream once it holds this many bytes
+#define NODE_STREAM_FLUSH_SIZE 65536
+
+NodeResponseStreamer::NodeResponseStreamer(int theFormat,
+					   NodeResponseType theResponseType)
+  :theStream(0), deleteStream(false), format(theFormat),
+   responseType(theResponseType), buffer(0), bufferSize(0), bufferCapacity(0),
+   lastGeoTag(-1), numNodes(0), numValues(0), numSteps(0)
+{
+
+}
+
+NodeResponseStreamer::~NodeResponseStreamer()
+{
+  this->flush();
+
+  if (deleteStream == true && theStream != 0)
+    delete theStream;
+
+  if (buffer != 0)
+    free(buffer);
+}
+
+void
+NodeResponseStreamer::setStream(OPS_Stream *newStream, bool deleteIt)
+{
+  this->flush();
+
+  if (deleteStream == true && theStream != 0)
+    delete theStream;
+
+  theStream = newStream;
+  deleteStream = deleteIt;
+
+  // a new receiver needs the header and a fresh JSON list
+  this->reset();
+}
+
+OPS_Stream *
+NodeResponseStreamer::getStream(void)
+{
+  return theStream;
+}
+
+void
+NodeResponseStreamer::setFormat(int newFormat)
+{
+  if (newFormat != format) {
+    this->flush();
+    format = newFormat;
+    this->reset();
+  }
+}
+
+int
+NodeResponseStreamer::getFormat(void) const
+{
+  return format;
+}
+
+void
+NodeResponseStreamer::setResponseType(NodeResponseType newType)
+{
+  responseType = newType;
+}
+
+int
+NodeResponseStreamer::writeStep(Domain &theDomain)
+{
+  int geoTag = theDomain.hasDomainChanged();
+  if (geoTag != lastGeoTag || theDomain.getNumNodes() != numNodes) {
+    if (this->writeHeader(theDomain) < 0)
+      return -1;
+    lastGeoTag = geoTag;
+  }
+
+  double time = theDomain.getCurrentTime();
+  NodeIter &theNodes = theDomain.getNodes();
+  Node *theNode;
+
+  if (format == NODE_STREAM_JSON) {
+
+    char text[64];
+    if (numSteps != 0)
+      this->appendText(",");
+    sprintf(text, "\"%4.3f\":{", time);
+    this->appendText(text);
+
+    int count = 0;
+    while ((theNode = theNodes()) != 0) {
+      const Vector *theResponse = theNode->getResponse(responseType);
+      int size = (theResponse != 0) ? theResponse->Size() : 0;
+
+      sprintf(text, (count == 0) ? "\"%d\":[" : ",\"%d\":[", theNode->getTag());
+      if (this->appendText(text) < 0)
+	return -1;
+      for (int i=0; i<size; i++) {
+	sprintf(text, (i == 0) ? "%.15g" : ",%.15g", (*theResponse)(i));
+	this->appendText(text);
+      }
+      this->appendText("]");
+
+      if (theStream != 0 && bufferSize > NODE_STREAM_FLUSH_SIZE)
+	this->flush();
+      count++;
+    }
+    this->appendText("}");
+
+  } else {
+
+    int valueSize = (format == NODE_STREAM_FLOAT32) ? sizeof(float) : sizeof(double);
+    this->appendInt(NODE_STREAM_STEP);
+    this->appendInt(sizeof(double) + numValues*valueSize);
+    if (this->append(&time, sizeof(double)) < 0)
+      return -1;
+
+    // make sure the values of a node never force a reallocation
+    int count = 0;
+    while ((theNode = theNodes()) != 0 && count < numValues) {
+      const Vector *theResponse = theNode->getResponse(responseType);
+      int size = (theResponse != 0) ? theResponse->Size() : 0;
+      if (count + size > numValues)
+	size = numValues - count;
+
+      if (this->grow(size*valueSize) < 0)
+	return -1;
+      // the values need not be aligned in the buffer, so they are copied
+      char *data = buffer + bufferSize;
+      for (int i=0; i<size; i++) {
+	if (format == NODE_STREAM_FLOAT32) {
+	  float value = (float)(*theResponse)(i);
+	  memcpy(data, &value, sizeof(float));
+	} else {
+	  double value = (*theResponse)(i);
+	  memcpy(data, &value, sizeof(double));
+	}
+	data += valueSize;
+      }
+      bufferSize += size*valueSize;
+      count += size;
+
+      if (theStream != 0 && bufferSize > NODE_STREAM_FLUSH_SIZE)
+	this->flush();
+    }
+
+    // keep the frame length given above if nodes lost values
+    if (count < numValues) {
+      int numMissing = (numValues - count)*valueSize;
+      if (this->grow(numMissing) < 0)
+	return -1;
+      memset(buffer + bufferSize, 0, numMissing);
+      bufferSize += numMissing;
+    }
+  }
+
+  numSteps++;
+
+  if (theStream != 0)
+    return this->flush();
+
+  return 0;
+}
+
+int
+NodeResponseStreamer::flush(void)
+{
+  if (theStream == 0 || bufferSize == 0)
+    return 0;
+
+  int result = theStream->writeBytes(buffer, bufferSize);
+  bufferSize = 0;
+  buffer[0] = '\0';
+
+  return result;
+}
+
+void
+NodeResponseStreamer::reset(void)
+{
+  lastGeoTag = -1;
+  numSteps = 0;
+}
+
+const char *
+NodeResponseStreamer::getBuffer(int &numBytes)
+{
+  if (buffer == 0)
+    this->grow(0);
+
+  numBytes = bufferSize;
+  return buffer;
+}
+
+void
+NodeResponseStreamer::clearBuffer(void)
+{
+  bufferSize = 0;
+  if (buffer != 0)
+    buffer[0] = '\0';
+}
+
+int
+NodeResponseStreamer::writeHeader(Domain &theDomain)
+{
+  NodeIter &theNodes = theDomain.getNodes();
+  Node *theNode;
+
+  numNodes = theDomain.getNumNodes();
+  numValues = 0;
+  while ((theNode = theNodes()) != 0) {
+    const Vector *theResponse = theNode->getResponse(responseType);
+    if (theResponse != 0)
+      numValues += theResponse->Size();
+  }
+  numSteps = 0;
+
+  if (format == NODE_STREAM_JSON)
+    return 0;
+
+  int valueSize = (format == NODE_STREAM_FLOAT32) ? sizeof(float) : sizeof(double);
+  this->appendInt(NODE_STREAM_HEADER);
+  this->appendInt((4 + 2*numNodes)*sizeof(int));
+  this->appendInt(0x01020304);
+  this->appendInt(valueSize);
+  this->appendInt(numNodes);
+  if (this->appendInt(numValues) < 0)
+    return -1;
+
+  NodeIter &theNodes2 = theDomain.getNodes();
+  while ((theNode = theNodes2()) != 0) {
+    const Vector *theResponse = theNode->getResponse(responseType);
+    this->appendInt(theNode->getTag());
+    if (this->appendInt((theResponse != 0) ? theResponse->Size() : 0) < 0)
+      return -1;
+  }
+
+  return 0;
+}
+
+int
+NodeResponseStreamer::append(const void *data, int numBytes)
+{
+  if (this->grow(numBytes) < 0)
+    return -1;
+
+  memcpy(buffer + bufferSize, data, numBytes);
+  bufferSize += numBytes;
+  buffer[bufferSize] = '\0';
+
+  return 0;
+}
+
+int
+NodeResponseStreamer::appendInt(int value)
+{
+  return this->append(&value, sizeof(int));
+}
+
+int
+NodeResponseStreamer::appendText(const char *text)
+{
+  return this->append(text, strlen(text));
+}
+
+// int grow(int numBytes);
+//	Makes room for numBytes more bytes and a terminating null; the
+//	capacity is doubled so that the cost of appending stays linear.
+
+int
+NodeResponseStreamer::grow(int numBytes)
+{
+  int needed = bufferSize + numBytes + 1;
+  if (buffer != 0 && needed <= bufferCapacity)
+    return 0;
+
+  int newCapacity = (bufferCapacity < 1024) ? 1024 : bufferCapacity;
+  while (newCapacity < needed)
+    newCapacity *= 2;
+
+  char *newBuffer = (char *)realloc(buffer, newCapacity);
+  if (newBuffer == 0) {
+    opserr << "WARNING NodeResponseStreamer - out of memory for a buffer of ";
+    opserr << newCapacity << " bytes\n";
+    return -1;
+  }
+
+  buffer = newBuffer;
+  bufferCapacity = newCapacity;
+  if (bufferSize == 0)
+    buffer[0] = '\0';
+
+  return 0;
+}
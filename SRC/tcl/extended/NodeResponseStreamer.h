@@ -0,0 +1,83 @@
+#ifndef _NODERESPONSESTREAMER_H_
+#define _NODERESPONSESTREAMER_H_
+
+// NodeResponseStreamer encodes a nodal response (Disp, Vel, ...) of all the
+// nodes in the Domain one step at a time and writes it to an OPS_Stream,
+// e.g. the TCP_Stream set with json-set-tcp. The encoded data is kept in a
+// growing buffer that is passed on to the stream whenever it gets large,
+// so the cost of a step is linear in the number of nodes and there is no
+// limit on the size of the model.
+//
+// Formats:
+//   NODE_STREAM_JSON    "time":{"tag":[v,..],..} per step, steps separated
+//                       by ',' as the old allNodeDisp output
+//   NODE_STREAM_FLOAT64 binary frames of doubles
+//   NODE_STREAM_FLOAT32 binary frames of floats
+//
+// Every binary frame starts with two 32 bit ints, the frame type and the
+// number of bytes following them:
+//   header (type 1): 0x01020304 (byte order mark), bytes per value, number
+//                    of nodes, number of values per step, then a pair
+//                    (node tag, number of values) for each node
+//   step   (type 2): time as a double, then the values of all the nodes in
+//                    the order of the header
+// A header is sent before the first step and again whenever the Domain
+// has changed, so the node tags are not repeated with every step.
+
+#include <OPS_Globals.h>
+
+class Domain;
+class OPS_Stream;
+
+#define NODE_STREAM_JSON    0
+#define NODE_STREAM_FLOAT64 1
+#define NODE_STREAM_FLOAT32 2
+
+#define NODE_STREAM_HEADER  1
+#define NODE_STREAM_STEP    2
+
+class NodeResponseStreamer
+{
+  public:
+    NodeResponseStreamer(int format = NODE_STREAM_FLOAT64,
+			 NodeResponseType responseType = Disp);
+    ~NodeResponseStreamer();
+
+    // with no stream the data is kept in the buffer, see getBuffer()
+    void setStream(OPS_Stream *theStream, bool deleteStream = false);
+    OPS_Stream *getStream(void);
+    void setFormat(int format);
+    int getFormat(void) const;
+    void setResponseType(NodeResponseType responseType);
+
+    int writeStep(Domain &theDomain);
+    int flush(void);
+    void reset(void);
+
+    // the text in the buffer is always null terminated
+    const char *getBuffer(int &numBytes);
+    void clearBuffer(void);
+
+  private:
+    int writeHeader(Domain &theDomain);
+    int append(const void *data, int numBytes);
+    int appendInt(int value);
+    int appendText(const char *text);
+    int grow(int numBytes);
+
+    OPS_Stream *theStream;
+    bool deleteStream;
+    int format;
+    NodeResponseType responseType;
+
+    char *buffer;
+    int bufferSize;    // bytes in use
+    int bufferCapacity;
+
+    int lastGeoTag;    // domain stamp of the last header, -1 if none sent
+    int numNodes;
+    int numValues;
+    int numSteps;      // steps written since the last header or reset
+};
+
+#endif /* _NODERESPONSESTREAMER_H_ */
@@ -6,175 +6,210 @@
 #include <commands.h>
 #include <Domain.h>
 #include <Node.h>
-#include <Element.h>
-#include <Truss.h>
 #include <NodeIter.h>
-#include <ElementIter.h>
-#include <SP_ConstraintIter.h>
-#include <SP_Constraint.h>
-#include <MP_ConstraintIter.h>
-#include <MP_Constraint.h>
 #include <DirectIntegrationAnalysis.h>
+#include <StaticAnalysis.h>
+#include <FileStream.h>
+#include <BinaryFileStream.h>
+#include <TCP_Stream.h>
 
 extern Domain theDomain;
-//extern ModelBuilder *theBuilder;
-//extern StaticAnalysis *theStaticAnalysis;
-//extern DirectIntegrationAnalysis *theTransientAnalysis;
-//extern int ops_ringbuffer_head;
-//extern struct a_message *ops_ringbuffer;
-//static int ops_ringbuffer_head;
-//#define MAX_MESSAGE_QUEUE 640
+extern double ops_Dt;
+
 #include "analyzeAndStreamNodeDisp.h"
-#define MAX_RESULT_BUFFER_LEN 10000000
-char *allNodeDispToJson(char *strptr);
+#include "jsonTCPStream.h"
+#include "NodeResponseStreamer.h"
+
+// used by streamNodeResponse and analyzeAndStreamNodeDisp
+static NodeResponseStreamer theStreamer;
+
+// name of the file given with -file, 0 if the stream is not a file
+static char *streamFileName = 0;
+
+// the file is opened as text for JSON and as binary otherwise, so it is
+// opened again whenever the format of the streamer changes
+static void
+openStreamFile(const char *fileName, openMode mode)
+{
+	if (fileName != streamFileName) {
+		if (streamFileName != 0)
+			delete [] streamFileName;
+		streamFileName = new char[strlen(fileName)+1];
+		strcpy(streamFileName, fileName);
+	}
+
+	OPS_Stream *theFileStream;
+	if (theStreamer.getFormat() == NODE_STREAM_JSON)
+		theFileStream = new FileStream(streamFileName, mode);
+	else
+		theFileStream = new BinaryFileStream(streamFileName, mode);
+	theStreamer.setStream(theFileStream, true);
+}
+
+// allNodeDisp
+//	Returns "time":{"tag":[disp,..],..} for the current step. The text
+//	is built in a buffer that grows as needed, so there is no limit on
+//	the number of nodes.
 
 int allNodeDisp(ClientData clientData, Tcl_Interp *interp, int argc,
 		TCL_Char **argv) {
 
-	char result[MAX_RESULT_BUFFER_LEN];
-	allNodeDispToJson(result);
-	Tcl_AppendResult(interp, result, NULL);
+	static NodeResponseStreamer theEncoder(NODE_STREAM_JSON, Disp);
+	int numBytes;
+
+	theEncoder.clearBuffer();
+	theEncoder.reset();
+	if (theEncoder.writeStep(theDomain) < 0)
+		return TCL_ERROR;
+
+	Tcl_AppendResult(interp, theEncoder.getBuffer(numBytes), NULL);
 
 	return TCL_OK;
 }
 
-char *allNodeDispToJson(char *strptr) {
-	NodeIter &theNodes = theDomain.getNodes();
-	Node *theNode;
-	const Vector *nodalResponse;
-	char buffer[40];
-	double ctime = theDomain.getCurrentTime();
-	int size;
-	int nn=theDomain.getNumNodes();
-	int nid;
-	int i,j;
-
-//	memset(strptr,0,sizeof(strptr));
-	sprintf(buffer, "\"%4.3f\":{", ctime);
-	strcat(strptr,buffer);
-
-	j=0;
-	while ((theNode = theNodes()) != 0) {
-		j++;
-		nodalResponse=theNode->getResponse(Disp);
-		nid = theNode->getTag();
-		size = nodalResponse->Size();
-		sprintf(buffer, "\"%d\":[", nid);
-		strcat(strptr,buffer);
-
-		for (i = 0; i < size; i++) {
-			if (i==size-1) {
-				sprintf(buffer, "%15.15f", (*nodalResponse)(i));
-			} else {
-				sprintf(buffer, "%15.15f,", (*nodalResponse)(i));
-			}
-			strcat(strptr,buffer);
+// streamNodeResponse <-json|-float64|-float32> <-disp|-vel|-accel|-incrDisp|-reaction>
+//                    <-tcp|-file fileName>
+//	With options, sets up the format, the response and the stream used by
+//	analyzeAndStreamNodeDisp; -tcp uses the stream of json-set-tcp. With
+//	no options, writes the response of the current step to the stream.
+
+int streamNodeResponse(ClientData clientData, Tcl_Interp *interp, int argc,
+		       TCL_Char **argv) {
+
+	if (argc == 1) {
+		if (theStreamer.getStream() == 0) {
+			opserr << "WARNING streamNodeResponse - no stream has been set\n";
+			return TCL_ERROR;
+		}
+		if (theStreamer.writeStep(theDomain) < 0)
+			return TCL_ERROR;
+		return TCL_OK;
+	}
+
+	int format = -1;
+	const char *fileName = 0;
+	bool useTCP = false;
+
+	int i = 1;
+	while (i < argc) {
+		if (strcmp(argv[i], "-json") == 0)
+			format = NODE_STREAM_JSON;
+		else if (strcmp(argv[i], "-float64") == 0 || strcmp(argv[i], "-binary") == 0)
+			format = NODE_STREAM_FLOAT64;
+		else if (strcmp(argv[i], "-float32") == 0)
+			format = NODE_STREAM_FLOAT32;
+		else if (strcmp(argv[i], "-disp") == 0)
+			theStreamer.setResponseType(Disp);
+		else if (strcmp(argv[i], "-vel") == 0)
+			theStreamer.setResponseType(Vel);
+		else if (strcmp(argv[i], "-accel") == 0)
+			theStreamer.setResponseType(Accel);
+		else if (strcmp(argv[i], "-incrDisp") == 0)
+			theStreamer.setResponseType(IncrDisp);
+		else if (strcmp(argv[i], "-reaction") == 0)
+			theStreamer.setResponseType(Reaction);
+		else if (strcmp(argv[i], "-tcp") == 0)
+			useTCP = true;
+		else if (strcmp(argv[i], "-file") == 0 && i+1 < argc)
+			fileName = argv[++i];
+		else {
+			opserr << "WARNING streamNodeResponse - unknown option " << argv[i] << endln;
+			opserr << "streamNodeResponse <-json|-float64|-float32> ";
+			opserr << "<-disp|-vel|-accel|-incrDisp|-reaction> <-tcp|-file fileName>\n";
+			return TCL_ERROR;
 		}
-		if (j<nn) {
-			strcat(strptr,"],");
-		} else {
-			strcat(strptr,"]");
+		i++;
+	}
+
+	int oldFormat = theStreamer.getFormat();
+	if (format != -1)
+		theStreamer.setFormat(format);
+
+	if (useTCP == true) {
+		TCP_Stream *theTCPStream = getTheTCPStream();
+		if (theTCPStream == 0) {
+			opserr << "WARNING streamNodeResponse -tcp - use json-set-tcp first\n";
+			return TCL_ERROR;
 		}
+		theStreamer.setStream(theTCPStream, false);
+		if (streamFileName != 0)
+			delete [] streamFileName;
+		streamFileName = 0;
+	} else if (fileName != 0) {
+		// the format may have been set by an earlier streamNodeResponse
+		openStreamFile(fileName, OVERWRITE);
+	} else if (streamFileName != 0 && theStreamer.getFormat() != oldFormat) {
+		// the output so far is kept, the new format follows it
+		openStreamFile(streamFileName, APPEND);
 	}
-	strcat(strptr,"}");
-	return strptr;
+
+	return TCL_OK;
 }
-//
-//int analyzeAndStreamNodeDisp(ClientData clientData, Tcl_Interp *interp,
-//                             int argc,TCL_Char **argv) {
-//	int result = 0;
-//	int i,j;
-//	struct per_session_data__ops *pss = (per_session_data__ops *) clientData;
-//	//TODO: do something to auto decide chunk sinze
-//	int chunk = 1;
-//
-//	char resultStr[MAX_RESULT_BUFFER_LEN];
-//	int result_length;
-//	DirectIntegrationAnalysis *theTransientAnalysis = getDirectIntegrationAnalysis();
-//	StaticAnalysis *theStaticAnalysis = getStaticAnalysis();
-//	int numIncr;
-//	double dT;
-//	int analysisType=0;
-//	char header[3];
-//
-//	header[0]='f';
-//	header[1]='n';
-//	header[2]='u';
-//
-//	if (theStaticAnalysis != 0) {
-//		if (argc < 2) {
-//			opserr << "WARNING static analysis: analysis numIncr?\n";
-//			return TCL_ERROR;
-//		}
-//		if (Tcl_GetInt(interp, argv[1], &numIncr) != TCL_OK
-//		)
-//			return TCL_ERROR;
-//		analysisType = 1;
-//	} else if (theTransientAnalysis != 0) {
-//		if (argc < 3) {
-//			opserr << "WARNING transient analysis: analysis numIncr? deltaT?\n";
-//			return TCL_ERROR;
-//		}
-//		if (Tcl_GetInt(interp, argv[1], &numIncr) != TCL_OK
-//		)
-//			return TCL_ERROR;
-//		if (Tcl_GetDouble(interp, argv[2], &dT) != TCL_OK
-//		)
-//			return TCL_ERROR;
-//		// Set global timestep variable
-//		ops_Dt = dT;
-//		analysisType = 2;
-//	}
-//
-//	memset(resultStr,0,sizeof(resultStr));
-//
-//	//print header
-//	strcpy(resultStr,header);
-//	strcat(resultStr,"({");
-//
-//	j=1;
-//	for (i=0;i<numIncr;i++) {
-//		if (analysisType == 1) {
-//			result = theStaticAnalysis->analyze(1);
-//		} else if (analysisType == 2){
-//			result = theTransientAnalysis->analyze(1, dT);
-//		} else {
-//			opserr << "WARNING No Analysis type has been specified \n";
-//					return TCL_ERROR;
-//		}
-//		if (result < 0) {
-//			opserr << "OpenSees > analyze failed, returned: " << result
-//					<< " error flag\n";
-//			return result;
-//		}
-//
-//		allNodeDispToJson(resultStr);
-//
-//		j++;
-//		if (j>chunk || i==numIncr-1){
-//			strcat(resultStr,"})");
-//			result_length=strlen(resultStr);
-//			if (pss->result_buffer->payload) {
-//				free(pss->result_buffer->payload);
-//			}
-//
-//			pss->result_buffer->payload = malloc(LWS_SEND_BUFFER_PRE_PADDING+ result_length + LWS_SEND_BUFFER_POST_PADDING);
-//			pss->result_buffer->len = result_length;
-//			memcpy((char *)(pss->result_buffer->payload)+ LWS_SEND_BUFFER_PRE_PADDING,resultStr,result_length);
-//			libwebsocket_write(
-//												pss->wsi,
-//												(unsigned char *) pss->result_buffer->payload
-//														+ LWS_SEND_BUFFER_PRE_PADDING,
-//														pss->result_buffer->len,
-//												LWS_WRITE_TEXT);
-//			j=0;
-//			memset(resultStr,0,sizeof(resultStr));
-//			strcpy(resultStr,header);
-//			strcat(resultStr,"({");
-//		} else {
-//			strcat(resultStr,",");
-//		}
-//	}
-//	return result;
-//}
 
+// analyzeAndStreamNodeDisp numIncr <dt>
+//	Runs the current analysis one step at a time and writes the response
+//	of every step with streamNodeResponse, or as binary data to the stream
+//	of json-set-tcp if streamNodeResponse has not been given a stream.
+
+int analyzeAndStreamNodeDisp(ClientData clientData, Tcl_Interp *interp,
+			     int argc, TCL_Char **argv) {
+
+	DirectIntegrationAnalysis *theTransientAnalysis = getDirectIntegrationAnalysis();
+	StaticAnalysis *theStaticAnalysis = getStaticAnalysis();
+	int numIncr;
+	double dT = 0.0;
+
+	if (argc < 2) {
+		opserr << "WARNING analyzeAndStreamNodeDisp numIncr <deltaT>\n";
+		return TCL_ERROR;
+	}
+	if (Tcl_GetInt(interp, argv[1], &numIncr) != TCL_OK)
+		return TCL_ERROR;
+
+	if (theStaticAnalysis == 0) {
+		if (theTransientAnalysis == 0) {
+			opserr << "WARNING analyzeAndStreamNodeDisp - no Analysis type has been specified\n";
+			return TCL_ERROR;
+		}
+		if (argc < 3) {
+			opserr << "WARNING transient analysis: analyzeAndStreamNodeDisp numIncr deltaT\n";
+			return TCL_ERROR;
+		}
+		if (Tcl_GetDouble(interp, argv[2], &dT) != TCL_OK)
+			return TCL_ERROR;
+		ops_Dt = dT;
+	}
+
+	if (theStreamer.getStream() == 0) {
+		TCP_Stream *theTCPStream = getTheTCPStream();
+		if (theTCPStream == 0) {
+			opserr << "WARNING analyzeAndStreamNodeDisp - use streamNodeResponse or json-set-tcp first\n";
+			return TCL_ERROR;
+		}
+		theStreamer.setStream(theTCPStream, false);
+	}
+
+	int result = 0;
+	for (int i=0; i<numIncr; i++) {
+		if (theStaticAnalysis != 0)
+			result = theStaticAnalysis->analyze(1);
+		else
+			result = theTransientAnalysis->analyze(1, dT);
+
+		if (result < 0) {
+			opserr << "OpenSees > analyze failed, returned: " << result << " error flag\n";
+			break;
+		}
+
+		if (theStreamer.writeStep(theDomain) < 0) {
+			result = -1;
+			break;
+		}
+	}
+
+	char buffer[10];
+	sprintf(buffer, "%d", result);
+	Tcl_SetResult(interp, buffer, TCL_VOLATILE);
+
+	return TCL_OK;
+}
@@ -4,7 +4,10 @@
 int allNodeDisp(ClientData clientData, Tcl_Interp *interp, int argc,
                 TCL_Char **argv);
 
-//int analyzeAndStreamNodeDisp(ClientData clientData, Tcl_Interp *interp,
-//                             int argc,TCL_Char **argv);
+int streamNodeResponse(ClientData clientData, Tcl_Interp *interp, int argc,
+                       TCL_Char **argv);
+
+int analyzeAndStreamNodeDisp(ClientData clientData, Tcl_Interp *interp,
+                             int argc,TCL_Char **argv);
 
 #endif /* _ANALYZEANDSTREAMNODEDISP_H_ */
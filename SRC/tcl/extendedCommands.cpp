@@ -1,6 +1,7 @@
 #include "extendedCommands.h"
 #include "extended/jsonDomain.h"
 #include "extended/jsonTCPStream.h"
+#include "extended/analyzeAndStreamNodeDisp.h"
 /* #include "extended/jsonModelBuilder.h" */
 /* #include "extended/jsonAnalyze.h" */
 
@@ -39,11 +40,14 @@ int createExtendedCommands(Tcl_Interp *interp){
 	Tcl_CreateCommand(interp, "json-echo-disp", jsonEchoDisp,
 			      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
 
-	/* Tcl_CreateCommand(interp, "allNodeDisp", allNodeDisp, */
-	/* 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL); */
+	Tcl_CreateCommand(interp, "allNodeDisp", allNodeDisp,
+			      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
 
-	/* Tcl_CreateCommand(interp, "analyzeAndStreamNodeDisp", analyzeAndStreamNodeDisp, */
-	/* 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL); */
+	Tcl_CreateCommand(interp, "streamNodeResponse", streamNodeResponse,
+			      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
+
+	Tcl_CreateCommand(interp, "analyzeAndStreamNodeDisp", analyzeAndStreamNodeDisp,
+			      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
 
 	/* Tcl_CreateCommand(interp, "echoModel", echoModel, */
 	/* 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL); */
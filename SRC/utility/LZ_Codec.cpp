@@ -0,0 +1,226 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/utility/LZ_Codec.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of the LZ codec.
+//
+// What: "@(#) LZ_Codec.C, revA"
+
+#include <LZ_Codec.h>
+#include <string.h>
+
+#define LZ_MIN_MATCH  4
+#define LZ_MAX_OFFSET 65535
+#define LZ_HASH_BITS  12
+#define LZ_HASH_SIZE  (1 << LZ_HASH_BITS)
+
+static inline unsigned int
+readInt32(const unsigned char *p)
+{
+  unsigned int value;
+  memcpy(&value, p, 4);
+  return value;
+}
+
+static inline int
+hashInt32(unsigned int value)
+{
+  return (int)((value * 2654435761U) >> (32 - LZ_HASH_BITS));
+}
+
+// writes a length that did not fit in its 4 bit field of the token
+static inline unsigned char *
+writeLength(unsigned char *out, const unsigned char *outEnd, int length)
+{
+  while (length >= 255) {
+    if (out >= outEnd)
+      return 0;
+    *out++ = 255;
+    length -= 255;
+  }
+  if (out >= outEnd)
+    return 0;
+  *out++ = (unsigned char)length;
+  return out;
+}
+
+static unsigned char *
+writeSequence(unsigned char *out, const unsigned char *outEnd,
+	      const unsigned char *literals, int numLiterals,
+	      int offset, int matchLength)
+{
+  if (out >= outEnd)
+    return 0;
+
+  unsigned char *token = out++;
+  int matchCode = (matchLength > 0) ? matchLength - LZ_MIN_MATCH : 0;
+  *token = (unsigned char)(((numLiterals < 15) ? numLiterals : 15) << 4);
+  *token |= (unsigned char)((matchCode < 15) ? matchCode : 15);
+
+  if (numLiterals >= 15)
+    if ((out = writeLength(out, outEnd, numLiterals - 15)) == 0)
+      return 0;
+
+  if (out + numLiterals > outEnd)
+    return 0;
+  memcpy(out, literals, numLiterals);
+  out += numLiterals;
+
+  if (matchLength == 0)
+    return out;
+
+  if (out + 2 > outEnd)
+    return 0;
+  *out++ = (unsigned char)(offset & 0xff);
+  *out++ = (unsigned char)(offset >> 8);
+
+  if (matchCode >= 15)
+    if ((out = writeLength(out, outEnd, matchCode - 15)) == 0)
+      return 0;
+
+  return out;
+}
+
+int
+LZ_MaxCompressedSize(int srcSize)
+{
+  return srcSize + srcSize/255 + 16;
+}
+
+int
+LZ_Compress(const char *src, int srcSize, char *dst, int dstCapacity)
+{
+  const unsigned char *in = (const unsigned char *)src;
+  unsigned char *out = (unsigned char *)dst;
+  const unsigned char *outEnd = out + dstCapacity;
+
+  int table[LZ_HASH_SIZE];
+  for (int i=0; i<LZ_HASH_SIZE; i++)
+    table[i] = -1;
+
+  int anchor = 0;
+  int pos = 0;
+  while (pos + LZ_MIN_MATCH <= srcSize) {
+    unsigned int sequence = readInt32(in + pos);
+    int h = hashInt32(sequence);
+    int ref = table[h];
+    table[h] = pos;
+
+    if (ref >= 0 && pos - ref <= LZ_MAX_OFFSET && readInt32(in + ref) == sequence) {
+      int length = LZ_MIN_MATCH;
+      while (pos + length < srcSize && in[ref + length] == in[pos + length])
+	length++;
+
+      out = writeSequence(out, outEnd, in + anchor, pos - anchor, pos - ref, length);
+      if (out == 0)
+	return -1;
+
+      pos += length;
+      anchor = pos;
+    } else
+      pos++;
+  }
+
+  out = writeSequence(out, outEnd, in + anchor, srcSize - anchor, 0, 0);
+  if (out == 0)
+    return -1;
+
+  return (int)(out - (unsigned char *)dst);
+}
+
+int
+LZ_Decompress(const char *src, int srcSize, char *dst, int dstCapacity)
+{
+  const unsigned char *in = (const unsigned char *)src;
+  const unsigned char *inEnd = in + srcSize;
+  unsigned char *out = (unsigned char *)dst;
+  unsigned char *outEnd = out + dstCapacity;
+
+  while (in < inEnd) {
+    int token = *in++;
+
+    int numLiterals = token >> 4;
+    if (numLiterals == 15) {
+      int byte;
+      do {
+	if (in >= inEnd)
+	  return -1;
+	byte = *in++;
+	numLiterals += byte;
+      } while (byte == 255);
+    }
+
+    if (in + numLiterals > inEnd || out + numLiterals > outEnd)
+      return -1;
+    memcpy(out, in, numLiterals);
+    in += numLiterals;
+    out += numLiterals;
+
+    // the last sequence has no match
+    if (in == inEnd)
+      break;
+
+    if (in + 2 > inEnd)
+      return -1;
+    int offset = in[0] | (in[1] << 8);
+    in += 2;
+
+    int length = (token & 15);
+    if (length == 15) {
+      int byte;
+      do {
+	if (in >= inEnd)
+	  return -1;
+	byte = *in++;
+	length += byte;
+      } while (byte == 255);
+    }
+    length += LZ_MIN_MATCH;
+
+    if (offset == 0 || offset > out - (unsigned char *)dst || out + length > outEnd)
+      return -1;
+
+    // byte by byte, the match may overlap the bytes being written
+    const unsigned char *match = out - offset;
+    for (int i=0; i<length; i++)
+      *out++ = *match++;
+  }
+
+  return (int)(out - (unsigned char *)dst);
+}
+
+void
+LZ_Shuffle(const char *src, char *dst, int numElements, int elementSize)
+{
+  for (int i=0; i<numElements; i++)
+    for (int j=0; j<elementSize; j++)
+      dst[j*numElements + i] = src[i*elementSize + j];
+}
+
+void
+LZ_Unshuffle(const char *src, char *dst, int numElements, int elementSize)
+{
+  for (int i=0; i<numElements; i++)
+    for (int j=0; j<elementSize; j++)
+      dst[i*elementSize + j] = src[j*numElements + i];
+}
@@ -0,0 +1,51 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/utility/LZ_Codec.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the interface of a small LZ77 style
+// codec, used to compress blocks of binary output without an external
+// library. A compressed block is a series of sequences, each made of a
+// token byte (literal count in the high 4 bits, match length - 4 in the
+// low 4 bits, 15 meaning more length bytes follow), the literals and a
+// 2 byte offset to the match; the last sequence has literals only.
+//
+// Floating point data compresses much better once the bytes of equal
+// significance are grouped, which LZ_Shuffle() does before compression
+// and LZ_Unshuffle() undoes after decompression.
+//
+// What: "@(#) LZ_Codec.h, revA"
+
+#ifndef LZ_Codec_h
+#define LZ_Codec_h
+
+// largest size LZ_Compress() can produce from srcSize bytes
+int LZ_MaxCompressedSize(int srcSize);
+
+// return the size of the result, or -1 if it does not fit in dst
+int LZ_Compress(const char *src, int srcSize, char *dst, int dstCapacity);
+int LZ_Decompress(const char *src, int srcSize, char *dst, int dstCapacity);
+
+void LZ_Shuffle(const char *src, char *dst, int numElements, int elementSize);
+void LZ_Unshuffle(const char *src, char *dst, int numElements, int elementSize);
+
+#endif
@@ -0,0 +1,438 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/utility/ThreadPool.cpp,v $
+
+// Created: 10/26
+//
+// Description: This file contains the implementation of ThreadPool.
+//
+// What: "@(#) ThreadPool.C, revA"
+
+#include <ThreadPool.h>
+#include <OPS_Globals.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#ifdef _THREADS
+
+struct ThreadPoolWorker {
+  ThreadPool *thePool;
+  int threadID;
+  int poolID;
+};
+
+// the tasks [next, end) still to be done by a thread, padded so that
+// the ranges of different threads are on different cache lines
+struct ThreadPoolRange {
+  pthread_mutex_t theMutex;
+  int next;
+  int end;
+  char pad[64];
+};
+
+// key used to store the ThreadPoolWorker of each worker thread; the main
+// thread never sets it and so gets thread id 0 and pool id 0
+static pthread_key_t threadIDKey;
+static pthread_once_t threadIDOnce = PTHREAD_ONCE_INIT;
+
+static void
+createThreadIDKey(void)
+{
+  pthread_key_create(&threadIDKey, 0);
+}
+
+static pthread_once_t atForkOnce = PTHREAD_ONCE_INIT;
+
+// pools are numbered from 1 in the order they are created
+static int numPoolsCreated = 0;
+
+static long
+getProcessID(void)
+{
+#ifdef _WIN32
+  return 0;
+#else
+  return (long)getpid();
+#endif
+}
+
+#endif
+
+ThreadPool *ThreadPool::theDefault = 0;
+
+ThreadPool::ThreadPool(int numThr)
+  :numThreads(numThr), numTasks(0), theFunction(0), theData(0)
+{
+  if (numThreads < 1)
+    numThreads = 1;
+  if (numThreads > OPS_MAX_THREADS) {
+    opserr << "WARNING ThreadPool::ThreadPool() - number of threads limited to ";
+    opserr << OPS_MAX_THREADS << endln;
+    numThreads = OPS_MAX_THREADS;
+  }
+
+#ifdef _THREADS
+  pthread_once(&threadIDOnce, createThreadIDKey);
+  pthread_once(&atForkOnce, ThreadPool::registerAtFork);
+  creatorPID = getProcessID();
+
+  pthread_mutex_init(&theMutex, 0);
+  pthread_cond_init(&startCond, 0);
+  pthread_cond_init(&doneCond, 0);
+  generation = 0;
+  numBusy = 0;
+  shutDown = false;
+
+  theThreads = new pthread_t[numThreads];
+  theWorkers = new ThreadPoolWorker[numThreads];
+  theRanges = new ThreadPoolRange[numThreads];
+  for (int i=0; i<numThreads; i++) {
+    pthread_mutex_init(&theRanges[i].theMutex, 0);
+    theRanges[i].next = 0;
+    theRanges[i].end = 0;
+  }
+  pieceSize = 1;
+
+  // thread 0 is the caller of parallelFor(), start the others
+  numPoolsCreated++;
+  for (int i=1; i<numThreads; i++) {
+    theWorkers[i].thePool = this;
+    theWorkers[i].threadID = i;
+    theWorkers[i].poolID = numPoolsCreated;
+    if (pthread_create(&theThreads[i], 0, ThreadPool::workerMain, &theWorkers[i]) != 0) {
+      opserr << "WARNING ThreadPool::ThreadPool() - could only start ";
+      opserr << i << " threads\n";
+      numThreads = i;
+      break;
+    }
+  }
+#else
+  if (numThreads != 1) {
+    opserr << "WARNING ThreadPool::ThreadPool() - program built without _THREADS, ";
+    opserr << "loops will run on 1 thread\n";
+    numThreads = 1;
+  }
+#endif
+}
+
+ThreadPool::~ThreadPool()
+{
+#ifdef _THREADS
+  // the threads were left behind in the parent
+  if (this->isForked() == true) {
+    delete [] theThreads;
+    delete [] theWorkers;
+    delete [] theRanges;
+    return;
+  }
+
+  pthread_mutex_lock(&theMutex);
+  shutDown = true;
+  pthread_cond_broadcast(&startCond);
+  pthread_mutex_unlock(&theMutex);
+
+  for (int i=1; i<numThreads; i++)
+    pthread_join(theThreads[i], 0);
+
+  for (int i=0; i<numThreads; i++)
+    pthread_mutex_destroy(&theRanges[i].theMutex);
+
+  delete [] theThreads;
+  delete [] theWorkers;
+  delete [] theRanges;
+
+  pthread_cond_destroy(&doneCond);
+  pthread_cond_destroy(&startCond);
+  pthread_mutex_destroy(&theMutex);
+#endif
+}
+
+int
+ThreadPool::getNumThreads(void) const
+{
+  return numThreads;
+}
+
+int
+ThreadPool::parallelFor(int n, ThreadPoolFunction func, void *data)
+{
+  if (n <= 0 || func == 0)
+    return 0;
+
+  // run serially if there is nothing to share or if called from inside
+  // a worker, in which case the caller keeps its own thread id
+  int callerID = ThreadPool::getThreadID();
+  bool serial = (numThreads == 1 || n == 1 || callerID != 0);
+#ifdef _THREADS
+  if (this->isForked() == true)
+    serial = true;
+#endif
+  if (serial == true) {
+    (*func)(0, n, callerID, data);
+    return 0;
+  }
+
+  numTasks = n;
+  theFunction = func;
+  theData = data;
+
+#ifdef _THREADS
+  // each thread starts on its own contiguous chunk
+  for (int i=0; i<numThreads; i++) {
+    theRanges[i].next = (int)(((long long)numTasks * i) / numThreads);
+    theRanges[i].end = (int)(((long long)numTasks * (i+1)) / numThreads);
+  }
+  pieceSize = numTasks / (numThreads * THREAD_POOL_PIECES_PER_CHUNK);
+  if (pieceSize < 1)
+    pieceSize = 1;
+
+  pthread_mutex_lock(&theMutex);
+  numBusy = numThreads - 1;
+  generation++;
+  pthread_cond_broadcast(&startCond);
+  pthread_mutex_unlock(&theMutex);
+
+  this->runTasks(0);
+
+  pthread_mutex_lock(&theMutex);
+  while (numBusy != 0)
+    pthread_cond_wait(&doneCond, &theMutex);
+  pthread_mutex_unlock(&theMutex);
+#endif
+
+  theFunction = 0;
+  theData = 0;
+
+  return 0;
+}
+
+void
+ThreadPool::runTasks(int threadID)
+{
+#ifdef _THREADS
+  ThreadPoolRange &myRange = theRanges[threadID];
+
+  do {
+    // take the next piece of the own range
+    while (true) {
+      pthread_mutex_lock(&myRange.theMutex);
+      int start = myRange.next;
+      int end = start + pieceSize;
+      if (end > myRange.end)
+	end = myRange.end;
+      myRange.next = end;
+      pthread_mutex_unlock(&myRange.theMutex);
+
+      if (start >= end)
+	break;
+      (*theFunction)(start, end, threadID, theData);
+    }
+  } while (this->steal(threadID) == true);
+#else
+  (*theFunction)(0, numTasks, threadID, theData);
+#endif
+}
+
+#ifdef _THREADS
+
+// moves the second half of the largest range left to the range of
+// threadID, false if no tasks are left to be started
+bool
+ThreadPool::steal(int threadID)
+{
+  while (true) {
+    // the sizes are only used to choose the victim, they may change
+    // before it is locked again
+    int victim = -1;
+    int maxLeft = 0;
+    for (int i=0; i<numThreads; i++) {
+      if (i == threadID)
+	continue;
+      pthread_mutex_lock(&theRanges[i].theMutex);
+      int left = theRanges[i].end - theRanges[i].next;
+      pthread_mutex_unlock(&theRanges[i].theMutex);
+      if (left > maxLeft) {
+	maxLeft = left;
+	victim = i;
+      }
+    }
+    if (victim < 0)
+      return false;
+
+    ThreadPoolRange &theVictim = theRanges[victim];
+    pthread_mutex_lock(&theVictim.theMutex);
+    int left = theVictim.end - theVictim.next;
+    int start = theVictim.next + left/2;
+    int end = theVictim.end;
+    if (left > 0)
+      theVictim.end = start;
+    pthread_mutex_unlock(&theVictim.theMutex);
+
+    // the victim may have finished in the meantime, look again
+    if (left > 0) {
+      ThreadPoolRange &myRange = theRanges[threadID];
+      pthread_mutex_lock(&myRange.theMutex);
+      myRange.next = start;
+      myRange.end = end;
+      pthread_mutex_unlock(&myRange.theMutex);
+      return true;
+    }
+  }
+}
+
+#endif
+
+int
+ThreadPool::getThreadID(void)
+{
+#ifdef _THREADS
+  pthread_once(&threadIDOnce, createThreadIDKey);
+  ThreadPoolWorker *theWorker = (ThreadPoolWorker *)pthread_getspecific(threadIDKey);
+  if (theWorker != 0)
+    return theWorker->threadID;
+#endif
+  return 0;
+}
+
+int
+ThreadPool::getPoolID(void)
+{
+#ifdef _THREADS
+  pthread_once(&threadIDOnce, createThreadIDKey);
+  ThreadPoolWorker *theWorker = (ThreadPoolWorker *)pthread_getspecific(threadIDKey);
+  if (theWorker != 0)
+    return theWorker->poolID;
+#endif
+  return 0;
+}
+
+int
+ThreadPool::setDefaultNumThreads(int numThr)
+{
+  if (theDefault != 0) {
+    delete theDefault;
+    theDefault = 0;
+  }
+
+  // with one thread the serial loops are used
+  if (numThr > 1) {
+    theDefault = new ThreadPool(numThr);
+    if (theDefault->getNumThreads() == 1) {
+      delete theDefault;
+      theDefault = 0;
+    }
+  }
+
+  return ThreadPool::getDefaultNumThreads();
+}
+
+int
+ThreadPool::getDefaultNumThreads(void)
+{
+  if (theDefault == 0)
+    return 1;
+  return theDefault->getNumThreads();
+}
+
+ThreadPool *
+ThreadPool::getDefault(void)
+{
+  return theDefault;
+}
+
+double
+ThreadPool::getWallTime(void)
+{
+#ifdef _WIN32
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&count);
+  return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + 1.0e-6 * tv.tv_usec;
+#endif
+}
+
+#ifdef _THREADS
+
+void
+ThreadPool::registerAtFork(void)
+{
+#ifndef _WIN32
+  pthread_atfork(0, 0, ThreadPool::atForkChild);
+#endif
+}
+
+// the default pool of the parent is dropped, not deleted, as its
+// threads and their locks are not in the child
+void
+ThreadPool::atForkChild(void)
+{
+  theDefault = 0;
+}
+
+bool
+ThreadPool::isForked(void) const
+{
+  return creatorPID != getProcessID();
+}
+
+void *
+ThreadPool::workerMain(void *arg)
+{
+  ThreadPoolWorker *theWorker = (ThreadPoolWorker *)arg;
+  ThreadPool *thePool = theWorker->thePool;
+  int threadID = theWorker->threadID;
+
+  pthread_setspecific(threadIDKey, theWorker);
+
+  int lastGeneration = 0;
+  while (true) {
+    pthread_mutex_lock(&thePool->theMutex);
+    while (thePool->generation == lastGeneration && thePool->shutDown == false)
+      pthread_cond_wait(&thePool->startCond, &thePool->theMutex);
+    if (thePool->shutDown == true) {
+      pthread_mutex_unlock(&thePool->theMutex);
+      break;
+    }
+    lastGeneration = thePool->generation;
+    pthread_mutex_unlock(&thePool->theMutex);
+
+    thePool->runTasks(threadID);
+
+    pthread_mutex_lock(&thePool->theMutex);
+    thePool->numBusy--;
+    if (thePool->numBusy == 0)
+      pthread_cond_signal(&thePool->doneCond);
+    pthread_mutex_unlock(&thePool->theMutex);
+  }
+
+  return 0;
+}
+
+#endif
@@ -0,0 +1,121 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// $Source: /usr/local/cvs/OpenSees/SRC/utility/ThreadPool.h,v $
+
+// Created: 10/26
+//
+// Description: This file contains the class definition for ThreadPool.
+// A ThreadPool owns a fixed team of worker threads that are started once
+// and then reused by parallelFor(), which splits the range [0, numTasks)
+// into contiguous chunks, one per thread. The calling thread takes part
+// as thread 0. Each thread works through its chunk a few tasks at a time;
+// a thread that runs out of work steals the second half of what is left
+// of the fullest chunk, so uneven tasks do not leave threads idle. The
+// function may thus be invoked several times on each thread. When the
+// program is built without _THREADS the loop is run serially by the
+// calling thread, so callers need no conditional code.
+//
+// The default pool is the one set from the interpreter with "threads N";
+// it is used by the Domain and AnalysisModel loops and by integrators
+// without threads of their own.
+//
+// A process forked from one with pools has none of their threads: in the
+// child the default pool is reset and every pool of the parent runs its
+// loops serially on the calling thread.
+//
+// What: "@(#) ThreadPool.h, revA"
+
+#ifndef ThreadPool_h
+#define ThreadPool_h
+
+#ifdef _THREADS
+#include <pthread.h>
+#endif
+
+#define OPS_MAX_THREADS 64
+
+// each chunk is worked through in about this many pieces
+#define THREAD_POOL_PIECES_PER_CHUNK 8
+
+// signature of the function invoked by parallelFor() on each chunk
+typedef void (*ThreadPoolFunction)(int start, int end, int threadID, void *data);
+
+class ThreadPool
+{
+  public:
+    ThreadPool(int numThreads);
+    ~ThreadPool();
+
+    int getNumThreads(void) const;
+    int parallelFor(int numTasks, ThreadPoolFunction theFunction, void *data);
+
+    // id of the calling thread: 0 for the main thread, 1..numThreads-1
+    // for the workers of the pool currently running it
+    static int getThreadID(void);
+
+    // pool of the calling thread: 0 for the main thread, otherwise the
+    // number of the pool the worker belongs to
+    static int getPoolID(void);
+
+    // wall clock time in seconds, used for timing parallel phases
+    static double getWallTime(void);
+
+    // the default pool, 0 if it has one thread
+    static int setDefaultNumThreads(int numThreads);
+    static int getDefaultNumThreads(void);
+    static ThreadPool *getDefault(void);
+
+  protected:
+
+  private:
+    void runTasks(int threadID);
+
+    int numThreads;
+    int numTasks;
+    ThreadPoolFunction theFunction;
+    void *theData;
+
+    static ThreadPool *theDefault;
+
+#ifdef _THREADS
+    static void *workerMain(void *arg);
+    static void registerAtFork(void);
+    static void atForkChild(void);
+    bool isForked(void) const;
+    bool steal(int threadID);
+
+    long creatorPID;   // process that started the threads
+
+    struct ThreadPoolRange *theRanges;
+    int pieceSize;
+
+    pthread_t *theThreads;
+    struct ThreadPoolWorker *theWorkers;
+    pthread_mutex_t theMutex;
+    pthread_cond_t startCond;
+    pthread_cond_t doneCond;
+    int generation;
+    int numBusy;
+    bool shutDown;
+#endif
+};
+
+#endif
@@ -0,0 +1,112 @@
+# Sampling and finite difference gradients in forked workers after the
+# default thread pool and an -async recorder have started their threads.
+# The workers must not hang, must give the serial results and must not
+# write to the recorder of the parent.
+
+wipe all
+threads 2
+
+model basic -ndm 2 -ndf 2
+
+node 1   0.0   0.0
+node 2 144.0   0.0
+node 3 288.0   0.0
+node 4 144.0  96.0
+
+fix 1 1 1
+fix 3 0 1
+
+uniaxialMaterial Elastic 1 30000.0
+
+element truss 1 1 4 10.0 1
+element truss 2 2 4  5.0 1
+element truss 3 3 4 10.0 1
+element truss 4 1 2  8.0 1
+element truss 5 2 3  8.0 1
+
+pattern Plain 1 Linear {
+    load 4 100.0 -50.0
+}
+
+recorder Node -file samplingAfterThreads.out -time -node 4 -dof 1 2 disp -async
+
+system BandSPD
+numberer RCM
+constraints Plain
+integrator LoadControl 1.0
+algorithm Linear
+analysis Static
+
+analyze 1
+reset
+
+reliability
+
+randomVariable 1 lognormal -mean 30000.0 -stdv 3000.0
+randomVariable 2 lognormal -mean 10.0 -stdv 1.0
+
+parameter 1 randomVariable 1 element 1 E
+addToParameter 1 element 2 E
+addToParameter 1 element 3 E
+parameter 2 randomVariable 2 element 1 A
+
+performanceFunction 1 "0.15-\[nodeDisp 4 1\]"
+
+randomNumberGenerator        CStdLib
+probabilityTransformation    Nataf -print 0
+functionEvaluator            Tcl -file "analyze 1"
+
+proc sampleResult {workers} {
+    set fileName samplingAfterThreads_$workers.txt
+    runImportanceSamplingAnalysis $fileName -type failureProbability -variance 1.0 \
+        -maxNum 200 -targetCOV 0.0 -print 0 -workers $workers
+    set f [open $fileName r]
+    set result [read $f]
+    close $f
+    file delete $fileName
+    return $result
+}
+
+set failed 0
+
+# the workers leave the recorder alone, only the analysis above is in it
+set parallel [sampleResult 2]
+remove recorders
+set f [open samplingAfterThreads.out r]
+set lines [split [string trim [read $f]] "\n"]
+close $f
+file delete samplingAfterThreads.out
+if {[llength $lines] != 1} {
+    puts "FAILED the workers wrote [expr [llength $lines]-1] lines to the recorder of the parent"
+    set failed 1
+}
+
+set serial [sampleResult 1]
+if {$parallel != $serial} {
+    puts "FAILED sampling with 2 workers differs from 1 worker"
+    set failed 1
+}
+
+# the perturbed analyses of a FORM gradient go to the same workers
+foreach workers {2 1} {
+    gradientEvaluator            FiniteDifference -workers $workers
+    searchDirection              iHLRF
+    meritFunctionCheck           AdkZhang -multi 2.0 -add 10.0 -factor 0.5
+    stepSizeRule                 Fixed -stepSize 1.0
+    reliabilityConvergenceCheck  Standard -e1 1.0e-3 -e2 1.0e-3 -print 0
+    startPoint                   Mean
+    findDesignPoint              StepSearch -maxNumIter 20
+    runFORMAnalysis              samplingAfterThreads_FORM.txt
+    set beta($workers) [betaFORM 1]
+    file delete samplingAfterThreads_FORM.txt
+}
+if {$beta(2) != $beta(1)} {
+    puts "FAILED FORM with 2 gradient workers: beta $beta(2), serial $beta(1)"
+    set failed 1
+}
+
+if {$failed == 0} {
+    puts "PASSED"
+} else {
+    exit 1
+}